@@ -0,0 +1,85 @@
+#include "../include/FutureEventSet.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+/**
+ * @file fes_benchmark.cpp
+ * @brief Hold-model benchmark of the future-event set implementations
+ *
+ * Classic hold model: fill the set with N events, then repeatedly pop the
+ * earliest event and push a new one at its time plus an exponential
+ * increment with mean N, so the set stays at N pending events with about
+ * one event per tick. Reports nanoseconds per hold (pop + push) for each
+ * implementation, for N = 10^3 up to 10^maxExponent.
+ *
+ * Usage: fes_benchmark [maxExponent]   (default 6; 8 needs several GB)
+ */
+
+/**
+ * @brief Run the hold model on one event set
+ *
+ * @return double Nanoseconds per hold operation
+ */
+static double holdBenchmark(FutureEventSet& events, size_t pending, size_t holds) {
+    std::mt19937_64 engine(12345);
+    std::exponential_distribution<double> increment(1.0 / static_cast<double>(pending));
+
+    events.clear();
+    for (size_t i = 0; i < pending; i++) {
+        events.push(static_cast<int64_t>(increment(engine)), i);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    FutureEvent event;
+    uint64_t checksum = 0;
+    for (size_t i = 0; i < holds; i++) {
+        events.pop(event);
+        checksum += event.payload;
+        events.push(event.time + 1 + static_cast<int64_t>(increment(engine)), event.payload);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // Keep the loop observable
+    if (checksum == 1) {
+        std::cout << "";
+    }
+    return std::chrono::duration<double, std::nano>(elapsed).count() / holds;
+}
+
+int main(int argc, char* argv[]) {
+    int maxExponent = argc > 1 ? std::atoi(argv[1]) : 6;
+    if (maxExponent < 3) {
+        maxExponent = 3;
+    }
+
+    std::cout << "Future-event set hold benchmark (ns per pop + push)\n";
+    std::cout << std::string(60, '-') << "\n";
+    std::cout << std::setw(12) << "Pending"
+              << std::setw(14) << "Binary Heap"
+              << std::setw(14) << "Timing Wheel"
+              << std::setw(16) << "AUTO selects" << "\n";
+    std::cout << std::string(60, '-') << "\n";
+
+    size_t pending = 1000;
+    for (int exponent = 3; exponent <= maxExponent; exponent++, pending *= 10) {
+        size_t holds = std::max<size_t>(pending, 2000000);
+
+        HeapEventSet heap;
+        WheelEventSet wheel;
+        double heapTime = holdBenchmark(heap, pending, holds);
+        heap.clear();
+        double wheelTime = holdBenchmark(wheel, pending, holds);
+        wheel.clear();
+
+        auto selected = createFutureEventSet(FutureEventSetType::AUTO, pending);
+        std::cout << std::setw(12) << pending
+                  << std::setw(14) << std::fixed << std::setprecision(1) << heapTime
+                  << std::setw(14) << wheelTime
+                  << std::setw(16) << selected->getName() << "\n";
+    }
+    std::cout << std::string(60, '-') << "\n";
+    return 0;
+}
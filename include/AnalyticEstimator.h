@@ -0,0 +1,153 @@
+#ifndef ANALYTIC_ESTIMATOR_H
+#define ANALYTIC_ESTIMATOR_H
+
+#include "MonteCarloComparison.h"
+#include "Workload.h"
+#include <string>
+#include <vector>
+
+/**
+ * @file AnalyticEstimator.h
+ * @brief Queueing-theory predictions of mean waiting and turnaround times
+ *
+ * Closed-form steady-state results for Poisson arrivals: M/G/1 under FCFS
+ * (Pollaczek-Khinchine), processor sharing (the small-quantum limit of Round
+ * Robin), non-preemptive priority (Cobham) and preemptive-resume priority,
+ * plus M/M/c with the Allen-Cunneen correction for general service. They
+ * answer coarse planning questions instantly and serve as a sanity check on
+ * simulation results.
+ */
+
+/**
+ * @enum QueueDiscipline
+ * @brief Service discipline assumed by a prediction
+ */
+enum class QueueDiscipline {
+    FCFS,                       ///< First come first served
+    PROCESSOR_SHARING,          ///< Egalitarian processor sharing (Round Robin, quantum -> 0)
+    NONPREEMPTIVE_PRIORITY,     ///< Head-of-line priority (Cobham's formula)
+    PREEMPTIVE_PRIORITY         ///< Preemptive-resume priority
+};
+
+/**
+ * @struct QueueingParameters
+ * @brief Parameters of a G/G/c-style queue with Poisson arrivals
+ *
+ * Priority classes all share the same service distribution; classShares
+ * gives the fraction of arrivals in each class, highest priority first.
+ */
+struct QueueingParameters {
+    double arrivalRate;                 ///< Arrival rate (lambda)
+    double meanService;                 ///< Mean service time E[S]
+    double serviceSecondMoment;         ///< Second moment E[S^2]
+    int servers;                        ///< Number of identical servers (c)
+    std::vector<double> classShares;    ///< Arrival share per priority class
+
+    QueueingParameters()
+        : arrivalRate(0), meanService(0), serviceSecondMoment(0), servers(1),
+          classShares(1, 1.0) {}
+
+    /**
+     * @brief Offered load per server (rho)
+     */
+    double utilization() const { return arrivalRate * meanService / servers; }
+
+    /**
+     * @brief Squared coefficient of variation of service time
+     */
+    double serviceSCV() const {
+        return meanService > 0
+            ? serviceSecondMoment / (meanService * meanService) - 1.0 : 0.0;
+    }
+};
+
+/**
+ * @struct AnalyticPrediction
+ * @brief Steady-state prediction for one discipline
+ */
+struct AnalyticPrediction {
+    QueueDiscipline discipline;         ///< Discipline assumed
+    std::string model;                  ///< Model used, e.g. "M/G/1 P-K"
+    bool stable;                        ///< False if utilization >= 1
+    bool exact;                         ///< False for approximations
+    double utilization;                 ///< Offered load per server
+    double meanWaitingTime;             ///< Mean time in queue
+    double meanTurnaroundTime;          ///< Mean time in system
+    std::vector<double> classTurnaroundTimes;  ///< Per class (priority disciplines)
+};
+
+/**
+ * @struct AnalyticCheck
+ * @brief Result of comparing a prediction with a simulated estimate
+ */
+struct AnalyticCheck {
+    double predicted;           ///< Analytic value
+    double simulated;           ///< Simulated mean
+    double relativeError;       ///< (simulated - predicted) / predicted
+    bool disagrees;             ///< Difference exceeds tolerance plus sampling error
+};
+
+/**
+ * @class AnalyticEstimator
+ * @brief Static queueing formulas and simulation cross-checks
+ */
+class AnalyticEstimator {
+public:
+    /**
+     * @brief Derive queueing parameters from a workload distribution
+     *
+     * Service moments are computed for the discretized bursts the generator
+     * actually produces (rounded, at least 1), and priorities are treated as
+     * equally likely classes.
+     *
+     * @param distribution Workload distribution
+     * @param servers Number of CPUs
+     * @return QueueingParameters Equivalent queue
+     */
+    static QueueingParameters fromWorkload(const WorkloadDistribution& distribution,
+                                           int servers = 1);
+
+    /**
+     * @brief Predict mean waiting and turnaround time
+     *
+     * Multi-server queues are supported for FCFS only; for the other
+     * disciplines with servers > 1 the prediction is marked unstable and its
+     * model reads "unsupported".
+     *
+     * @param parameters Queue parameters
+     * @param discipline Service discipline
+     * @return AnalyticPrediction Prediction (stable == false if rho >= 1)
+     */
+    static AnalyticPrediction predict(const QueueingParameters& parameters,
+                                      QueueDiscipline discipline);
+
+    /**
+     * @brief Erlang C probability that an arrival has to wait in M/M/c
+     *
+     * @param servers Number of servers
+     * @param offeredLoad Offered load in Erlangs (lambda * E[S])
+     * @return double Probability of waiting
+     */
+    static double erlangC(int servers, double offeredLoad);
+
+    /**
+     * @brief Compare a prediction with a simulated interval estimate
+     *
+     * The simulation disagrees when it differs from the prediction by more
+     * than tolerance (relative) plus the half-width of its confidence interval.
+     *
+     * @param predicted Analytic value
+     * @param simulated Simulated estimate
+     * @param tolerance Allowed relative model error (e.g. 0.15)
+     * @return AnalyticCheck Comparison result
+     */
+    static AnalyticCheck check(double predicted, const IntervalEstimate& simulated,
+                               double tolerance);
+
+    /**
+     * @brief Human-readable name of a discipline
+     */
+    static std::string disciplineName(QueueDiscipline discipline);
+};
+
+#endif // ANALYTIC_ESTIMATOR_H
@@ -0,0 +1,152 @@
+#ifndef AVAILABILITY_PROFILE_H
+#define AVAILABILITY_PROFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file AvailabilityProfile.h
+ * @brief Free-processor profile over future time for backfilling schedulers
+ *
+ * A step function free(t): the number of processors not held by running
+ * jobs or reservations at time t. Backfilling asks two questions of it,
+ * "does a job of p processors and duration d fit at time s?" and "when is
+ * the earliest such s?", millions of times per log.
+ */
+
+/**
+ * @class AvailabilityProfile
+ * @brief Step function of free processors, stored in a treap of breakpoints
+ *
+ * Each node is a breakpoint: free(t) equals the value of the last
+ * breakpoint at or before t. Nodes carry the minimum and maximum value of
+ * their subtree and a lazy addend, so reserving or releasing a time range,
+ * the minimum over a range and the first breakpoint above or below a
+ * threshold are all O(log n) expected in the number of breakpoints.
+ * Breakpoints before the profile's origin are dropped by advance().
+ */
+class AvailabilityProfile {
+public:
+    static constexpr int64_t NEVER = INT64_MAX;     ///< earliestStart() when a job can never fit
+
+private:
+    /**
+     * @struct Node
+     * @brief One breakpoint
+     */
+    struct Node {
+        int64_t key;        ///< Time the step starts
+        int value;          ///< Free processors from key to the next breakpoint
+        int add;            ///< Pending addend for both children
+        int subMin;         ///< Minimum value in this subtree
+        int subMax;         ///< Maximum value in this subtree
+        uint32_t priority;  ///< Heap priority (random)
+        int left;           ///< Left child (-1 = none)
+        int right;          ///< Right child (-1 = none)
+    };
+
+    std::vector<Node> nodes;        ///< Node storage
+    std::vector<int> freeNodes;     ///< Reusable node indices
+    int root;                       ///< Root node (-1 = empty)
+    int capacity;                   ///< Processors of the machine
+    int64_t origin;                 ///< Earliest time still represented
+    size_t count;                   ///< Number of breakpoints
+    uint64_t randomState;           ///< xorshift64 state for priorities
+
+    int newNode(int64_t key, int value);
+    void apply(int node, int delta);
+    void push(int node);
+    void pull(int node);
+
+    /**
+     * @brief Split a subtree into keys < key and keys >= key
+     */
+    void split(int node, int64_t key, int& left, int& right);
+
+    /**
+     * @brief Join two subtrees; every key in a is below every key in b
+     */
+    int merge(int a, int b);
+
+    /**
+     * @brief Leftmost node of a subtree whose value is >= procs (-1 = none)
+     */
+    int firstAtLeast(int node, int procs);
+
+    /**
+     * @brief Rightmost node of a subtree whose value is < procs (-1 = none)
+     */
+    int lastBelow(int node, int procs);
+
+    /**
+     * @brief Add a breakpoint at @p time if there is none, keeping free(t)
+     */
+    void ensureBreakpoint(int64_t time);
+
+    /**
+     * @brief Add @p delta to free(t) for t in [start, end)
+     */
+    void addRange(int64_t start, int64_t end, int delta);
+
+    /**
+     * @brief Return a subtree's nodes to the free list
+     */
+    void release(int node);
+
+public:
+    /**
+     * @brief Construct a profile with every processor free from @p origin on
+     */
+    explicit AvailabilityProfile(int capacity = 0, int64_t origin = 0);
+
+    /**
+     * @brief Reset to every processor free from @p origin on
+     */
+    void clear(int capacity, int64_t origin = 0);
+
+    /**
+     * @brief Take @p procs processors during [start, end)
+     */
+    void reserve(int64_t start, int64_t end, int procs) { addRange(start, end, -procs); }
+
+    /**
+     * @brief Give back @p procs processors during [start, end)
+     */
+    void release(int64_t start, int64_t end, int procs) { addRange(start, end, procs); }
+
+    /**
+     * @brief Free processors at @p time
+     */
+    int freeAt(int64_t time);
+
+    /**
+     * @brief Minimum free processors over [start, end)
+     */
+    int minFree(int64_t start, int64_t end);
+
+    /**
+     * @brief Earliest start at or after @p after where @p procs processors
+     *        are free for @p duration
+     *
+     * @return int64_t Start time, or NEVER if procs exceeds the capacity
+     */
+    int64_t earliestStart(int64_t after, int64_t duration, int procs);
+
+    /**
+     * @brief Forget the profile before @p time
+     */
+    void advance(int64_t time);
+
+    /**
+     * @brief Number of breakpoints
+     */
+    size_t size() const { return count; }
+
+    /**
+     * @brief Processors of the machine
+     */
+    int getCapacity() const { return capacity; }
+};
+
+#endif // AVAILABILITY_PROFILE_H
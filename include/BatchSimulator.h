@@ -0,0 +1,210 @@
+#ifndef BATCH_SIMULATOR_H
+#define BATCH_SIMULATOR_H
+
+#include "AvailabilityProfile.h"
+#include "SwfReader.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @file BatchSimulator.h
+ * @brief Space-sharing batch scheduling of rigid parallel jobs with backfilling
+ *
+ * The CPU schedulers time-share single processors among processes; HPC batch
+ * systems instead give each job a fixed number of processors for its whole
+ * run, in the order of a wait queue. This simulator replays such jobs (for
+ * example from an SWF log) on an N-processor machine under FCFS, EASY
+ * backfilling or conservative backfilling.
+ */
+
+/**
+ * @enum BackfillPolicy
+ * @brief How the wait queue is served
+ */
+enum class BackfillPolicy {
+    FCFS,           ///< Strict arrival order; the head blocks everyone behind it
+    EASY,           ///< Only the head holds a reservation; later jobs may jump ahead if they do not delay it
+    CONSERVATIVE    ///< Every job holds a reservation; later jobs may jump ahead if they delay no one
+};
+
+/**
+ * @struct BatchJob
+ * @brief A rigid parallel job
+ */
+struct BatchJob {
+    int64_t id;             ///< Job number
+    int64_t submitTime;     ///< Arrival at the wait queue
+    int64_t runTime;        ///< Actual run time (at most the estimate)
+    int64_t estimate;       ///< User's runtime estimate, used for reservations
+    int procs;              ///< Processors needed for the whole run
+    int userId;             ///< Owning user (-1 = unknown)
+    int groupId;            ///< Owning group (-1 = unknown)
+};
+
+/**
+ * @struct BatchMetrics
+ * @brief Aggregate results of a run
+ */
+struct BatchMetrics {
+    size_t jobs;                    ///< Jobs completed
+    size_t backfilled;              ///< Jobs started ahead of an earlier-queued job
+    size_t rejected;                ///< Jobs refused (wider than the machine or malformed)
+    double averageWait;             ///< Mean time from submit to start
+    double averageBoundedSlowdown;  ///< Mean bounded slowdown
+    double maxBoundedSlowdown;      ///< Worst bounded slowdown
+    double utilization;             ///< Processor-time used / processor-time available
+    int64_t makespan;               ///< First submit to last completion
+};
+
+/**
+ * @class BatchSimulator
+ * @brief Event-driven batch scheduler over an AvailabilityProfile
+ *
+ * Jobs are fed in submit order with submit(); the simulation advances to
+ * each submit time as it arrives, so a log of any length is replayed with
+ * memory proportional to the jobs queued or running at once. Completed jobs
+ * are folded into running sums.
+ *
+ * Running jobs hold [start, start + estimate) in the profile. EASY
+ * temporarily reserves the head's earliest start and lets a later job start
+ * now if the profile has room for it over its whole estimate; conservative
+ * keeps a reservation for every queued job and, when a job ends before its
+ * estimate, moves each reservation (in queue order) to its new earliest
+ * start. Every fit test and earliest-start search is O(log n) in the number
+ * of profile breakpoints.
+ *
+ * Bounded slowdown is max(1, (wait + run) / max(run, threshold)), the
+ * usual guard against very short jobs dominating the mean.
+ */
+class BatchSimulator {
+private:
+    /**
+     * @struct Waiting
+     * @brief A queued job
+     */
+    struct Waiting {
+        BatchJob job;               ///< The job
+        int64_t reservedStart;      ///< Conservative reservation (-1 = none)
+        uint64_t sequence;          ///< Arrival order
+    };
+
+    /**
+     * @struct Running
+     * @brief A started job
+     */
+    struct Running {
+        int64_t end;            ///< Actual completion
+        int64_t expectedEnd;    ///< start + estimate, the end held in the profile
+        int64_t wait;           ///< Time spent queued
+        int64_t runTime;        ///< Actual run time
+        int procs;              ///< Processors held
+    };
+
+    int cores;                          ///< Machine size
+    BackfillPolicy policy;              ///< Queue discipline
+    int64_t slowdownThreshold;          ///< Bounded-slowdown runtime floor
+    AvailabilityProfile profile;        ///< Free processors over time
+    std::list<Waiting> queue;           ///< Wait queue in arrival order
+    std::multimap<int64_t, std::list<Waiting>::iterator> reservations;  ///< Conservative: queued jobs by reserved start
+    uint64_t nextSequence;              ///< Sequence for the next arrival
+    std::vector<Running> running;       ///< Min-heap on end
+    int64_t now;                        ///< Simulation clock
+
+    size_t completed;                   ///< Jobs finished
+    size_t backfilled;                  ///< Jobs started out of order
+    size_t rejected;                    ///< Jobs refused
+    double waitSum;                     ///< Sum of waits
+    double slowdownSum;                 ///< Sum of bounded slowdowns
+    double slowdownMax;                 ///< Largest bounded slowdown
+    double busy;                        ///< Sum of procs * runTime
+    int64_t firstSubmit;                ///< Earliest submit seen (-1 = none)
+    int64_t lastEnd;                    ///< Latest completion
+
+    /**
+     * @brief Min-heap order on completion time
+     */
+    static bool endsLater(const Running& a, const Running& b) { return a.end > b.end; }
+
+    /**
+     * @brief Start a queued job now and remove it from the queue
+     */
+    std::list<Waiting>::iterator start(std::list<Waiting>::iterator it, bool outOfOrder);
+
+    /**
+     * @brief Process every completion (and conservative reservation start)
+     *        at or before @p time, scheduling after each instant
+     */
+    void completeUntil(int64_t time);
+
+    /**
+     * @brief Start whatever the policy allows at the current time
+     */
+    void schedulePass();
+
+    /**
+     * @brief Move every conservative reservation to its earliest start, in queue order
+     */
+    void compress();
+
+public:
+    /// Default bounded-slowdown threshold (seconds), as in the literature
+    static constexpr int64_t DEFAULT_SLOWDOWN_THRESHOLD = 10;
+
+    /**
+     * @brief Construct a simulator for an N-processor machine
+     *
+     * @param cores Processors
+     * @param policy Queue discipline
+     * @param slowdownThreshold Runtime floor for bounded slowdown
+     */
+    BatchSimulator(int cores, BackfillPolicy policy,
+                   int64_t slowdownThreshold = DEFAULT_SLOWDOWN_THRESHOLD);
+
+    /**
+     * @brief Queue a job, first advancing the simulation to its submit time
+     *
+     * Jobs must come in non-decreasing submit order; an earlier submit time
+     * is treated as "now".
+     *
+     * @return bool false if the job was rejected
+     */
+    bool submit(const BatchJob& job);
+
+    /**
+     * @brief Run until every queued job has completed and return the results
+     */
+    BatchMetrics finish();
+
+    /**
+     * @brief Jobs waiting right now
+     */
+    size_t queued() const { return queue.size(); }
+
+    /**
+     * @brief Simulation clock
+     */
+    int64_t getTime() const { return now; }
+
+    /**
+     * @brief Policy name for reports
+     */
+    std::string getName() const;
+
+    /**
+     * @brief Convert an SWF record to a BatchJob
+     *
+     * Processors are the requested count, or the allocated count if no
+     * request was logged; the estimate is the requested time, or the run
+     * time if none was logged. Jobs are killed at their estimate, so the run
+     * time is capped by it.
+     *
+     * @return bool false if the record has no usable size or run time
+     */
+    static bool fromSwf(const SwfJob& record, BatchJob& job);
+};
+
+#endif // BATCH_SIMULATOR_H
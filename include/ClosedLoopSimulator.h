@@ -0,0 +1,161 @@
+#ifndef CLOSED_LOOP_SIMULATOR_H
+#define CLOSED_LOOP_SIMULATOR_H
+
+#include "QuantileSketch.h"
+#include "Workload.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file ClosedLoopSimulator.h
+ * @brief Closed-loop interactive workloads: users who submit, wait and think
+ *
+ * Generated workloads and imported traces are open-loop: arrivals happen
+ * whatever the system does. An interactive system is closed-loop. Each of
+ * N users submits a request, waits for its response, thinks, then submits
+ * the next one, so a slow system also slows its own arrivals. Response time
+ * against the number of users is the classic capacity curve: flat until
+ * the CPUs saturate, then rising by D/c for every extra user.
+ */
+
+/**
+ * @enum ClosedLoopDiscipline
+ * @brief How queued requests share the CPUs
+ */
+enum class ClosedLoopDiscipline {
+    FCFS,           ///< Submission order, each request runs to completion
+    ROUND_ROBIN,    ///< Submission order, at most one quantum per turn
+    SHORTEST_FIRST  ///< Shortest service first, non-preemptive
+};
+
+/**
+ * @struct ClosedLoopConfig
+ * @brief Users, service and think times, and the simulated interval
+ *
+ * Service times follow the BurstDistribution conventions of
+ * WorkloadDistribution (rounded, at least 1). Think times use the same
+ * shapes with a minimum of 0; a UNIFORM think time is uniform on
+ * [0, 2 * meanThink]. Only requests that complete in [warmup, horizon)
+ * are measured.
+ */
+struct ClosedLoopConfig {
+    int users;                              ///< Users for run() without an explicit count
+    double meanThink;                       ///< Mean think time (Z)
+    BurstDistribution thinkDistribution;    ///< Shape of think times
+    double meanService;                     ///< Mean CPU demand of a request (D)
+    BurstDistribution serviceDistribution;  ///< Shape of service times
+    int cpus;                               ///< Identical CPUs (c)
+    ClosedLoopDiscipline discipline;        ///< Queueing discipline
+    int quantum;                            ///< ROUND_ROBIN time slice
+    int64_t warmup;                         ///< Completions before this time are not measured
+    int64_t horizon;                        ///< Simulation stops at this time
+    int numThreads;                         ///< Sweep worker threads (0 = hardware concurrency)
+    uint64_t seed;                          ///< Seed of every user's request stream
+
+    ClosedLoopConfig()
+        : users(100), meanThink(1000.0), thinkDistribution(BurstDistribution::EXPONENTIAL),
+          meanService(10.0), serviceDistribution(BurstDistribution::EXPONENTIAL), cpus(1),
+          discipline(ClosedLoopDiscipline::FCFS), quantum(4), warmup(10000), horizon(110000),
+          numThreads(0), seed(1) {}
+};
+
+/**
+ * @struct ClosedLoopMetrics
+ * @brief Results for one user count
+ */
+struct ClosedLoopMetrics {
+    int users;                      ///< Users simulated (N)
+    uint64_t completed;             ///< Requests completed in the measured interval
+    double throughput;              ///< Completed requests per time unit (X)
+    double utilization;             ///< Busy CPU time / (CPUs * measured interval), in %
+    QuantileSketch response;        ///< Submission-to-completion times
+    double responseTimeLaw;         ///< N / X - Z, the interactive response time law
+    double predictedResponse;       ///< Mean value analysis estimate of the mean response
+    double predictedThroughput;     ///< Mean value analysis estimate of X
+};
+
+/**
+ * @class ClosedLoopSimulator
+ * @brief Event-driven simulation of N interactive users on c CPUs
+ *
+ * Arrivals are never materialized: a user's next submission exists only
+ * as one entry in the think heap, created when its previous request
+ * completes. The k-th think and service time of user u are drawn from a
+ * counter-based stream keyed by (seed, u, k), so the state per user is a
+ * few words, runs of different user counts, disciplines or thread counts
+ * see the same request sequence per user (common random numbers), and
+ * memory is O(users + CPUs) however long the horizon. Each event costs
+ * O(log users).
+ *
+ * Events at the same time are handled in a fixed order: slices that end,
+ * then users that finish thinking, then requests whose quantum expired (so
+ * new arrivals queue ahead of them, as in RoundRobinScheduler), then
+ * dispatch to idle CPUs.
+ *
+ * The predicted columns come from exact mean value analysis of a
+ * delay station (think) and a queueing station (CPUs) for one CPU, and
+ * Seidmann's approximation (a queue with demand D/c plus a delay of
+ * D(c-1)/c) for several. They are exact for exponential times under
+ * processor sharing, which ROUND_ROBIN approaches for small quanta, and
+ * under FCFS with exponential service.
+ */
+class ClosedLoopSimulator {
+private:
+    ClosedLoopConfig config;        ///< Parameters
+
+public:
+    /**
+     * @brief Construct a simulator (non-positive sizes are raised to 1)
+     *
+     * @param config Parameters
+     */
+    explicit ClosedLoopSimulator(const ClosedLoopConfig& config);
+
+    /**
+     * @brief Simulate config.users users
+     */
+    ClosedLoopMetrics run() const { return run(config.users); }
+
+    /**
+     * @brief Simulate @p users users
+     */
+    ClosedLoopMetrics run(int users) const;
+
+    /**
+     * @brief Simulate every user count in parallel
+     *
+     * Results are in the order of @p userCounts and do not depend on the
+     * thread count.
+     */
+    std::vector<ClosedLoopMetrics> sweep(const std::vector<int>& userCounts) const;
+
+    /**
+     * @brief Mean value analysis of @p users users
+     *
+     * @param response Set to the estimated mean response time
+     * @param throughput Set to the estimated throughput
+     */
+    void meanValueAnalysis(int users, double& response, double& throughput) const;
+
+    /**
+     * @brief Users at which the asymptotic bounds cross, c * (D + Z) / D
+     *
+     * Below it response time stays near D; above it every extra user adds
+     * about D / c.
+     */
+    double saturationUsers() const;
+
+    /**
+     * @brief Parameters after validation
+     */
+    const ClosedLoopConfig& getConfig() const { return config; }
+
+    /**
+     * @brief Discipline name
+     */
+    static std::string disciplineName(ClosedLoopDiscipline discipline);
+};
+
+#endif // CLOSED_LOOP_SIMULATOR_H
@@ -0,0 +1,140 @@
+#ifndef CLUSTER_SIMULATOR_H
+#define CLUSTER_SIMULATOR_H
+
+#include "MonteCarloComparison.h"
+#include "QuantileSketch.h"
+#include "Scheduler.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file ClusterSimulator.h
+ * @brief Many hosts, each running a Scheduler, behind a job placement policy
+ *
+ * Every node is an ordinary Scheduler (any policy, from a SchedulerFactory).
+ * Arriving jobs are routed to nodes by a placement policy that sees node
+ * load reports refreshed once per epoch; the nodes are then simulated in
+ * parallel and their per-process times summarized in per-node sketches that
+ * are merged into cluster-wide percentiles.
+ */
+
+/**
+ * @enum PlacementPolicy
+ * @brief How an arriving job picks its node
+ */
+enum class PlacementPolicy {
+    LEAST_LOADED,   ///< Node with the least unfinished work (lowest index on ties)
+    POWER_OF_TWO,   ///< Less loaded of two nodes drawn at random
+    BIN_PACKING     ///< First node whose load stays within binCapacity; least loaded if none
+};
+
+/**
+ * @struct ClusterConfig
+ * @brief Cluster shape and simulation parameters
+ */
+struct ClusterConfig {
+    int numNodes;           ///< Hosts
+    int epochLength;        ///< Time between load reports (>= 1)
+    int binCapacity;        ///< BIN_PACKING: unfinished work per CPU a node may hold
+    int numThreads;         ///< Worker threads (0 = hardware concurrency)
+    uint64_t seed;          ///< Seed for randomized placement
+
+    ClusterConfig()
+        : numNodes(100), epochLength(10), binCapacity(20), numThreads(0), seed(1) {}
+};
+
+/**
+ * @struct ClusterMetrics
+ * @brief Cluster-wide results
+ */
+struct ClusterMetrics {
+    size_t processes;           ///< Processes completed
+    size_t busiestNode;         ///< Most processes placed on one node
+    size_t activeNodes;         ///< Nodes that received at least one process
+    QuantileSketch waiting;     ///< Waiting times, merged over nodes
+    QuantileSketch turnaround;  ///< Turnaround times, merged over nodes
+    QuantileSketch response;    ///< Response times, merged over nodes
+    double utilization;         ///< Busy CPU time / (nodes * CPUs * makespan), in %
+    int makespan;               ///< First arrival to last completion
+    size_t epochs;              ///< Load-report epochs that had arrivals
+};
+
+/**
+ * @class ClusterSimulator
+ * @brief Routes a job stream over a cluster of Scheduler nodes
+ *
+ * A Scheduler runs its processes to completion in one call, so a node
+ * cannot be paused mid-run to answer a placement query. What the router
+ * sees instead is each node's unfinished work, a quantity every
+ * work-conserving policy drains at the same rate whatever order it runs
+ * processes in. The simulation proceeds in synchronized epochs:
+ *
+ *  1. at the epoch boundary, all nodes report their unfinished work
+ *     (computed in parallel, one contiguous block of nodes per thread);
+ *  2. jobs arriving during the epoch are placed, in arrival order, on
+ *     those reports plus the router's own placements since the boundary.
+ *
+ * Longer epochs mean staler load information, as with periodic heartbeats
+ * in a real cluster. Once every job is placed, the nodes run their
+ * Scheduler in parallel. Least-loaded and bin-packing decisions use a
+ * min-tree over the reports, so each placement is O(log nodes).
+ *
+ * Results are independent of the thread count.
+ */
+class ClusterSimulator {
+private:
+    ClusterConfig config;               ///< Cluster parameters
+    SchedulerFactory nodeFactory;       ///< Creates each node's scheduler
+    PlacementPolicy placement;          ///< Routing policy
+    std::vector<int> assignment;        ///< Node of each input job, after run()
+
+    /**
+     * @struct NodeResult
+     * @brief What one node reports after its simulation
+     */
+    struct NodeResult {
+        QuantileSketch waiting;         ///< Waiting times
+        QuantileSketch turnaround;      ///< Turnaround times
+        QuantileSketch response;        ///< Response times
+        int firstArrival;               ///< Earliest arrival (INT_MAX if idle)
+        int lastCompletion;             ///< Latest completion (0 if idle)
+        int64_t busy;                   ///< Sum of burst times
+    };
+
+public:
+    /**
+     * @brief Construct a cluster
+     *
+     * @param config Cluster parameters
+     * @param nodeFactory Creates the scheduler of each node (called from several threads)
+     * @param placement Routing policy
+     */
+    ClusterSimulator(const ClusterConfig& config, SchedulerFactory nodeFactory,
+                     PlacementPolicy placement);
+
+    /**
+     * @brief Place and simulate a job stream
+     *
+     * The jobs are copied, so the same set can be run under several
+     * placements.
+     *
+     * @param jobs Processes in any order
+     * @return ClusterMetrics Merged results
+     */
+    ClusterMetrics run(const std::vector<std::shared_ptr<Process>>& jobs);
+
+    /**
+     * @brief Node chosen for each job of the last run (same order as the input)
+     */
+    const std::vector<int>& getAssignment() const { return assignment; }
+
+    /**
+     * @brief Placement policy name
+     */
+    static std::string placementName(PlacementPolicy placement);
+};
+
+#endif // CLUSTER_SIMULATOR_H
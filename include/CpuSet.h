@@ -0,0 +1,135 @@
+#ifndef CPU_SET_H
+#define CPU_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file CpuSet.h
+ * @brief cpumask-style set of CPUs, sized to the simulated machine
+ *
+ * Affinity masks, the idle mask and the online mask of a multi-CPU
+ * simulation are CpuSets. Every operation works a 64-bit word at a time, so
+ * finding an idle CPU a task may run on costs CPUs / 64 word operations,
+ * not a loop over CPUs.
+ */
+
+/**
+ * @class CpuSet
+ * @brief Fixed-size bitset of CPUs, bit c = CPU c
+ *
+ * Bits past the last CPU are always clear, so whole-word operations need no
+ * masking. Operations between sets assume equal sizes.
+ */
+class CpuSet {
+private:
+    std::vector<uint64_t> words;    ///< Bit c % 64 of word c / 64 = CPU c
+    int cpus;                       ///< Number of CPUs
+
+public:
+    /**
+     * @brief Construct a set for a machine of @p cpus CPUs
+     *
+     * @param cpus Number of CPUs (negative counts as 0)
+     * @param full Start with every CPU set (default: empty)
+     */
+    explicit CpuSet(int cpus = 0, bool full = false);
+
+    /**
+     * @brief Parse a cpulist such as "0-3,8,10-11" (taskset -c, cpuset.cpus)
+     *
+     * @param list Comma-separated CPUs and inclusive ranges
+     * @param cpus Size of the set
+     * @param set Receives the set on success
+     * @return false if the list is malformed, empty or names a missing CPU
+     */
+    static bool parse(const std::string& list, int cpus, CpuSet& set);
+
+    /**
+     * @brief The set as a cpulist ("" if empty)
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Number of CPUs the set is sized for
+     */
+    int size() const { return cpus; }
+
+    /**
+     * @brief Add a CPU
+     */
+    void set(int cpu) { words[cpu >> 6] |= 1ULL << (cpu & 63); }
+
+    /**
+     * @brief Remove a CPU
+     */
+    void clear(int cpu) { words[cpu >> 6] &= ~(1ULL << (cpu & 63)); }
+
+    /**
+     * @brief Whether a CPU is in the set (false outside 0..size()-1)
+     */
+    bool test(int cpu) const {
+        return cpu >= 0 && cpu < cpus && (words[cpu >> 6] >> (cpu & 63) & 1) != 0;
+    }
+
+    /**
+     * @brief Number of CPUs in the set
+     */
+    int count() const;
+
+    /**
+     * @brief Whether no CPU is in the set
+     */
+    bool empty() const;
+
+    /**
+     * @brief Lowest CPU in the set, or -1
+     */
+    int first() const { return next(0); }
+
+    /**
+     * @brief Lowest CPU >= @p cpu in the set, or -1
+     */
+    int next(int cpu) const;
+
+    /**
+     * @brief Lowest CPU in both this set and @p other, or -1
+     *
+     * Same as (*this & other).first() without building the intersection.
+     */
+    int firstAnd(const CpuSet& other) const;
+
+    /**
+     * @brief Whether the sets share a CPU
+     */
+    bool intersects(const CpuSet& other) const;
+
+    /**
+     * @brief Keep only CPUs also in @p other
+     */
+    CpuSet& operator&=(const CpuSet& other);
+
+    /**
+     * @brief Add every CPU of @p other
+     */
+    CpuSet& operator|=(const CpuSet& other);
+
+    /**
+     * @brief Remove every CPU of @p other
+     */
+    CpuSet& andNot(const CpuSet& other);
+
+    /**
+     * @brief Same size and same CPUs
+     */
+    bool operator==(const CpuSet& other) const { return cpus == other.cpus && words == other.words; }
+
+    /**
+     * @brief Different size or different CPUs
+     */
+    bool operator!=(const CpuSet& other) const { return !(*this == other); }
+};
+
+#endif // CPU_SET_H
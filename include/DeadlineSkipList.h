@@ -0,0 +1,107 @@
+#ifndef DEADLINE_SKIP_LIST_H
+#define DEADLINE_SKIP_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file DeadlineSkipList.h
+ * @brief Skip list of task indices ordered by virtual deadline
+ *
+ * The run-queue structure of BFS and MuQSS: insertion is O(log n) expected,
+ * and the earliest deadline is always the first node, so peeking is O(1)
+ * and popping it only unlinks the head's forward pointers.
+ */
+
+/**
+ * @class DeadlineSkipList
+ * @brief Skip list keyed by (deadline, insertion order)
+ *
+ * Node levels come from a seeded generator, so the structure (and hence the
+ * running time, never the order) is reproducible. Equal deadlines keep
+ * insertion order.
+ */
+class DeadlineSkipList {
+public:
+    static constexpr int MAX_LEVEL = 16;                ///< Maximum node level
+    static constexpr int64_t NO_DEADLINE = INT64_MAX;   ///< firstDeadline() of an empty list
+
+private:
+    /**
+     * @struct Node
+     * @brief One entry with its forward pointers
+     */
+    struct Node {
+        int64_t deadline;           ///< Sort key
+        uint64_t sequence;          ///< Insertion order, breaks deadline ties
+        int value;                  ///< Caller's task index
+        int level;                  ///< Number of forward pointers in use
+        int next[MAX_LEVEL];        ///< Forward pointers (-1 = end)
+    };
+
+    std::vector<Node> nodes;        ///< Node storage
+    std::vector<int> freeNodes;     ///< Reusable node indices
+    int head[MAX_LEVEL];            ///< Forward pointers of the head sentinel
+    int level;                      ///< Highest level in use
+    size_t count;                   ///< Number of entries
+    uint64_t randomState;           ///< xorshift64 state for node levels
+    uint64_t nextSequence;          ///< Next insertion sequence number
+
+    /**
+     * @brief Draw a node level (P(level > k) = 4^-k)
+     */
+    int randomLevel();
+
+    /**
+     * @brief Whether node a sorts before (deadline, sequence)
+     */
+    bool before(int a, int64_t deadline, uint64_t sequence) const;
+
+public:
+    /**
+     * @brief Construct an empty list
+     *
+     * @param seed Seed of the level generator
+     */
+    explicit DeadlineSkipList(uint64_t seed = 0);
+
+    /**
+     * @brief Remove all entries and reseed the level generator
+     */
+    void clear(uint64_t seed = 0);
+
+    /**
+     * @brief Insert a task
+     *
+     * @param deadline Virtual deadline
+     * @param value Task index
+     */
+    void insert(int64_t deadline, int value);
+
+    /**
+     * @brief Deadline of the first entry, or NO_DEADLINE if empty
+     */
+    int64_t firstDeadline() const {
+        return head[0] == -1 ? NO_DEADLINE : nodes[head[0]].deadline;
+    }
+
+    /**
+     * @brief Remove and return the task with the earliest deadline
+     *
+     * @return int Task index, or -1 if the list is empty
+     */
+    int popFirst();
+
+    /**
+     * @brief Number of entries
+     */
+    size_t size() const { return count; }
+
+    /**
+     * @brief Whether the list is empty
+     */
+    bool empty() const { return count == 0; }
+};
+
+#endif // DEADLINE_SKIP_LIST_H
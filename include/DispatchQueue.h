@@ -0,0 +1,207 @@
+#ifndef DISPATCH_QUEUE_H
+#define DISPATCH_QUEUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/**
+ * @file DispatchQueue.h
+ * @brief sched_ext-style dispatch queue (DSQ) of task indices
+ *
+ * A DSQ is where an ExtScheduler policy parks runnable tasks until a CPU
+ * consumes them. Like in sched_ext, a queue is either FIFO or ordered by a
+ * policy-supplied virtual time, never both.
+ */
+
+/**
+ * @enum DsqOrder
+ * @brief Ordering of a dispatch queue
+ */
+enum class DsqOrder {
+    FIFO,       ///< Insertion order (optionally at the head)
+    VTIME       ///< Ascending virtual time, ties in insertion order
+};
+
+/**
+ * @class DispatchQueue
+ * @brief FIFO or virtual-time ordered queue of task indices
+ *
+ * FIFO queues are a deque; VTIME queues are a binary heap keyed by
+ * (vtime, insertion sequence). Both insert and pop in O(1) or O(log n).
+ */
+class DispatchQueue {
+private:
+    /**
+     * @struct VtimeEntry
+     * @brief One task in a VTIME queue
+     */
+    struct VtimeEntry {
+        uint64_t vtime;     ///< Sort key
+        uint64_t sequence;  ///< Insertion order, breaks vtime ties
+        int task;           ///< Task index
+    };
+
+    uint64_t id;                        ///< DSQ id
+    DsqOrder order;                     ///< FIFO or VTIME
+    std::deque<int> fifo;               ///< Tasks of a FIFO queue
+    std::vector<VtimeEntry> heap;       ///< Tasks of a VTIME queue (min-heap)
+    uint64_t nextSequence;              ///< Next insertion sequence number
+    uint64_t maxVtime;                  ///< Largest vtime inserted since clear()
+
+    /**
+     * @brief Heap order: true if entry a comes after entry b
+     */
+    static bool after(const VtimeEntry& a, const VtimeEntry& b);
+
+public:
+    /**
+     * @brief Construct an empty dispatch queue
+     *
+     * @param id DSQ id
+     * @param order FIFO or VTIME (default: FIFO)
+     */
+    explicit DispatchQueue(uint64_t id = 0, DsqOrder order = DsqOrder::FIFO);
+
+    /**
+     * @brief Append a task to a FIFO queue
+     *
+     * On a VTIME queue the task goes behind every task inserted so far.
+     *
+     * @param task Task index
+     * @param atHead Insert at the head instead of the tail
+     */
+    void insert(int task, bool atHead = false);
+
+    /**
+     * @brief Insert a task into a VTIME queue
+     *
+     * On a FIFO queue the vtime is ignored and the task is appended.
+     *
+     * @param task Task index
+     * @param vtime Virtual time; lower runs first
+     */
+    void insertVtime(int task, uint64_t vtime);
+
+    /**
+     * @brief First task without removing it
+     *
+     * @return int Task index, or -1 if empty
+     */
+    int peek() const;
+
+    /**
+     * @brief Remove and return the first task
+     *
+     * @return int Task index, or -1 if empty
+     */
+    int pop();
+
+    /**
+     * @brief Remove and return the first task @p accept returns true for
+     *
+     * Tasks before it keep their places. Costs the same as pop() when the
+     * first task is accepted, otherwise one pass over the queue.
+     *
+     * @param accept Callable taking a task index
+     * @return int Task index, or -1 if no queued task is accepted
+     */
+    template <typename Accept>
+    int popFirst(Accept accept);
+
+    /**
+     * @brief First task @p accept returns true for, without removing it
+     *
+     * @return int Task index, or -1 if no queued task is accepted
+     */
+    template <typename Accept>
+    int findFirst(Accept accept) const;
+
+    /**
+     * @brief Remove all tasks
+     */
+    void clear();
+
+    /**
+     * @brief DSQ id
+     */
+    uint64_t getId() const { return id; }
+
+    /**
+     * @brief FIFO or VTIME
+     */
+    DsqOrder getOrder() const { return order; }
+
+    /**
+     * @brief Number of queued tasks
+     */
+    size_t size() const { return order == DsqOrder::FIFO ? fifo.size() : heap.size(); }
+
+    /**
+     * @brief Whether no task is queued
+     */
+    bool empty() const { return size() == 0; }
+};
+
+template <typename Accept>
+int DispatchQueue::popFirst(Accept accept) {
+    if (order == DsqOrder::FIFO) {
+        for (auto it = fifo.begin(); it != fifo.end(); ++it) {
+            if (accept(*it)) {
+                int task = *it;
+                fifo.erase(it);
+                return task;
+            }
+        }
+        return -1;
+    }
+
+    if (heap.empty()) {
+        return -1;
+    }
+    if (accept(heap.front().task)) {
+        return pop();
+    }
+
+    // The heap is not sorted: find the earliest accepted entry, then restore the heap
+    size_t best = heap.size();
+    for (size_t i = 1; i < heap.size(); i++) {
+        if (accept(heap[i].task) && (best == heap.size() || after(heap[best], heap[i]))) {
+            best = i;
+        }
+    }
+    if (best == heap.size()) {
+        return -1;
+    }
+    int task = heap[best].task;
+    heap[best] = heap.back();
+    heap.pop_back();
+    std::make_heap(heap.begin(), heap.end(), after);
+    return task;
+}
+
+template <typename Accept>
+int DispatchQueue::findFirst(Accept accept) const {
+    if (order == DsqOrder::FIFO) {
+        for (int task : fifo) {
+            if (accept(task)) {
+                return task;
+            }
+        }
+        return -1;
+    }
+    if (heap.empty() || accept(heap.front().task)) {
+        return heap.empty() ? -1 : heap.front().task;
+    }
+    size_t best = heap.size();
+    for (size_t i = 1; i < heap.size(); i++) {
+        if (accept(heap[i].task) && (best == heap.size() || after(heap[best], heap[i]))) {
+            best = i;
+        }
+    }
+    return best == heap.size() ? -1 : heap[best].task;
+}
+
+#endif // DISPATCH_QUEUE_H
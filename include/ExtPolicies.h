@@ -0,0 +1,114 @@
+#ifndef EXT_POLICIES_H
+#define EXT_POLICIES_H
+
+#include "ExtScheduler.h"
+
+/**
+ * @file ExtPolicies.h
+ * @brief Example ExtScheduler policies, ported from the sched_ext examples
+ *
+ * Kept short on purpose: each is a template for prototyping a policy in
+ * the simulator before writing it as BPF.
+ */
+
+/**
+ * @struct ExtVtimePolicy
+ * @brief scx_simple in weighted vtime mode
+ *
+ * All tasks share one VTIME DSQ. A task's vtime advances by the time it ran
+ * divided by its weight, so higher-weight (lower nice) tasks are picked more
+ * often. A task that slept cannot bank more than one slice of credit: its
+ * vtime is raised to at least the global vtime minus one slice.
+ */
+struct ExtVtimePolicy : ExtPolicy {
+    static constexpr uint64_t SHARED_DSQ = 0;       ///< The shared VTIME DSQ
+    static constexpr uint64_t VTIME_SCALE = 1024;   ///< Vtime units per time unit at weight 100
+
+    uint64_t vtimeNow = 0;      ///< Largest vtime of any task that started running
+
+    std::string name() const { return "Weighted Vtime"; }
+
+    void init(ExtContext& ctx) {
+        ctx.createDsq(SHARED_DSQ, DsqOrder::VTIME);
+    }
+
+    void enqueue(ExtContext& ctx, int task, uint64_t enqFlags) {
+        ExtContext::Task& state = ctx.task(task);
+        if (enqFlags & ExtContext::ENQ_WAKEUP) {
+            state.dsqVtime = vtimeNow;
+        }
+        uint64_t floor = ExtContext::SLICE_DFL * VTIME_SCALE;
+        uint64_t vtime = state.dsqVtime;
+        if (vtimeNow > floor && vtime < vtimeNow - floor) {
+            vtime = vtimeNow - floor;
+        }
+        ctx.insertVtime(task, SHARED_DSQ, ExtContext::SLICE_DFL, vtime);
+    }
+
+    void dispatch(ExtContext& ctx, int cpu) {
+        ctx.moveToLocal(SHARED_DSQ, cpu);
+    }
+
+    void running(ExtContext& ctx, int task) {
+        vtimeNow = std::max(vtimeNow, ctx.task(task).dsqVtime);
+    }
+
+    void stopping(ExtContext& ctx, int task, bool) {
+        ExtContext::Task& state = ctx.task(task);
+        uint64_t used = static_cast<uint64_t>(std::max(0, ExtContext::SLICE_DFL - state.slice));
+        state.dsqVtime += used * VTIME_SCALE * 100 / state.weight;
+    }
+};
+
+/**
+ * @struct ExtPriorityPolicy
+ * @brief One FIFO DSQ per priority band, with tick-based preemption
+ *
+ * Shows multiple DSQs and tick(): dispatch() drains the best non-empty band,
+ * and a task running while a better band has work is preempted at the next
+ * tick by setting its slice to 0.
+ */
+struct ExtPriorityPolicy : ExtPolicy {
+    static constexpr int BANDS = 4;     ///< Bands: nice < -10, < 0, < 10, rest
+
+    std::string name() const { return "Priority Bands"; }
+
+    static uint64_t band(const ExtContext& ctx, int task) {
+        int nice = ctx.process(task).getPriority();
+        return nice < -10 ? 0 : nice < 0 ? 1 : nice < 10 ? 2 : 3;
+    }
+
+    void init(ExtContext& ctx) {
+        for (int b = 0; b < BANDS; b++) {
+            ctx.createDsq(b);
+        }
+    }
+
+    int selectCpu(ExtContext& ctx, int task, int prevCpu) {
+        bool isIdle = false;
+        return ctx.selectCpuDefault(task, prevCpu, isIdle);
+    }
+
+    void enqueue(ExtContext& ctx, int task, uint64_t) {
+        ctx.insert(task, band(ctx, task), ExtContext::SLICE_DFL);
+    }
+
+    void dispatch(ExtContext& ctx, int cpu) {
+        for (int b = 0; b < BANDS; b++) {
+            if (ctx.moveToLocal(b, cpu)) {
+                return;
+            }
+        }
+    }
+
+    void tick(ExtContext& ctx, int task) {
+        for (uint64_t b = 0; b < band(ctx, task); b++) {
+            if (ctx.dsqSize(b) > 0) {
+                ctx.task(task).slice = 0;
+                return;
+            }
+        }
+    }
+};
+
+#endif // EXT_POLICIES_H
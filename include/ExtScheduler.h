@@ -0,0 +1,1173 @@
+#ifndef EXT_SCHEDULER_H
+#define EXT_SCHEDULER_H
+
+#include "Scheduler.h"
+#include "CpuSet.h"
+#include "DispatchQueue.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file ExtScheduler.h
+ * @brief sched_ext-style engine: the engine owns time, policies only decide
+ *
+ * Writing a policy as a Scheduler subclass means rewriting the whole
+ * schedule() loop: arrivals, time advance, accounting, context switches.
+ * ExtScheduler runs that loop once, on one or more CPUs, and calls a policy
+ * at the same points the Linux sched_ext framework calls a BPF scheduler:
+ *
+ *  - selectCpu(ctx, task, prevCpu)  task wakes up (arrives); pick its CPU
+ *  - enqueue(ctx, task, enqFlags)   task became runnable; insert it into a DSQ
+ *  - dispatch(ctx, cpu)             CPU found its local and the global DSQ
+ *                                   empty; move work to its local DSQ
+ *  - running(ctx, task)             task starts running
+ *  - stopping(ctx, task, runnable)  task stops (slice end, preemption, exit)
+ *  - tick(ctx, task)                periodic tick while the task runs
+ *  - init(ctx)                      start of a run; create DSQs here
+ *  - cpuOnline(ctx, cpu)            a CPU came online (hotplug)
+ *  - cpuOffline(ctx, cpu)           a CPU is going offline; its tasks are
+ *                                   then migrated through enqueue()
+ *
+ * Policies talk back through ExtContext, the counterpart of the scx_bpf_*
+ * kfuncs. The policy is a template parameter, so every callback is a direct,
+ * inlinable call; a policy derives from ExtPolicy and hides only the
+ * callbacks it needs. Policies written here map one to one onto BPF code.
+ */
+
+/**
+ * @struct HotplugEvent
+ * @brief Scripted CPU hotplug: a CPU goes offline or comes back online
+ */
+struct HotplugEvent {
+    int time;       ///< When the event takes effect
+    int cpu;        ///< CPU affected
+    bool online;    ///< true = bring online, false = take offline
+};
+
+/**
+ * @struct SmtConfig
+ * @brief Simultaneous multithreading: hardware threads per core and their interference
+ *
+ * CPUs c and c' are siblings when c / threadsPerCore == c' / threadsPerCore.
+ * A task of class a runs slowdown[a][b] times slower while a class-b task
+ * runs on a sibling (factors of several siblings multiply; classes outside
+ * the matrix do not interfere).
+ */
+struct SmtConfig {
+    int threadsPerCore;                         ///< Hardware threads per core (1 = no SMT)
+    std::vector<std::vector<double>> slowdown;  ///< slowdown[a][b] >= 1, by task class
+    bool coreScheduling;                        ///< Siblings only co-run tasks with equal cookies
+
+    SmtConfig() : threadsPerCore(1), coreScheduling(false) {}
+};
+
+/**
+ * @struct FailureConfig
+ * @brief Seeded fault injection: task crashes with retries, CPU failures
+ *
+ * Failures are sampled as times to failure, once per run of a task and
+ * once per CPU lifetime, never per time unit. A task run crashes with
+ * probability crashProbability, at a point drawn from the exponential
+ * hazard that gives that probability over the whole burst. A crashed task
+ * loses the run's progress and, after a backoff of
+ * min(maxBackoff, retryBackoff * backoffMultiplier^(k-1)) before its k-th
+ * retry, runs its burst again. A CPU fails after an exponential time with
+ * mean cpuMtbf, kills the task running on it and stays offline for
+ * cpuRepairTime; the killed task also loses its progress, but is requeued
+ * at once and does not use up a retry.
+ */
+struct FailureConfig {
+    double crashProbability;    ///< Chance that one run of a task crashes before it finishes (0 = never)
+    int maxRetries;             ///< Retries after crashes before the task fails for good
+    int retryBackoff;           ///< Delay before the first retry
+    double backoffMultiplier;   ///< Growth of the delay per further retry
+    int maxBackoff;             ///< Cap on the delay
+    double cpuMtbf;             ///< Mean time between failures of one CPU (0 = CPUs never fail)
+    int cpuRepairTime;          ///< Time a failed CPU stays offline
+    uint64_t seed;              ///< Seed of every failure draw
+
+    FailureConfig()
+        : crashProbability(0.0), maxRetries(3), retryBackoff(10), backoffMultiplier(2.0),
+          maxBackoff(1000), cpuMtbf(0.0), cpuRepairTime(100), seed(1) {}
+};
+
+/**
+ * @class ExtContext
+ * @brief State shared by the engine and a policy, with the policy-facing API
+ *
+ * Every CPU has a local DSQ it runs tasks from; there is one global DSQ and
+ * any number of policy-created ones. An idle CPU consumes its local DSQ,
+ * then the global DSQ, then calls dispatch(). A task must be inserted into
+ * exactly one DSQ by selectCpu() or enqueue().
+ *
+ * Every task has an affinity mask, and no task runs on a CPU outside it or
+ * on an offline CPU: idle-CPU selection only considers allowed CPUs, an
+ * insert into the local DSQ of a CPU the task may not use goes to the
+ * global DSQ instead, and consuming a DSQ takes its first task the CPU may
+ * run, skipping the others. A CPU going offline that leaves a task no
+ * online CPU breaks the task's affinity, as the kernel does: the mask
+ * becomes every online CPU, for good.
+ *
+ * With core scheduling on, a task may also run only where every busy
+ * sibling runs a task with the same cookie. A CPU consuming a DSQ whose
+ * first allowed task has another cookie does not look past it: it stays
+ * forced idle until the sibling changes, as the kernel's core-wide pick
+ * idles a sibling rather than run an untrusted task beside it.
+ *
+ * A policy that breaks these rules (unknown DSQ, task not inserted, tasks
+ * left stranded in DSQs) is aborted like a misbehaving BPF scheduler: the
+ * reason is recorded and the engine finishes the run with the default
+ * global FIFO behaviour.
+ *
+ * The context also keeps the engine's state that does not depend on the
+ * policy: affinities, the hotplug script, SMT, fault injection and the
+ * watchdog. That logic is compiled once in ExtScheduler.cpp, and
+ * ExtScheduler<Policy> is left with the calls into the policy.
+ */
+class ExtContext {
+public:
+    static constexpr uint64_t DSQ_FLAG_BUILTIN = 1ULL << 63;                ///< Marks built-in DSQ ids
+    static constexpr uint64_t DSQ_GLOBAL = DSQ_FLAG_BUILTIN | 1;            ///< The global DSQ
+    static constexpr uint64_t DSQ_LOCAL = DSQ_FLAG_BUILTIN | 2;             ///< Local DSQ of the task's CPU
+    static constexpr uint64_t DSQ_LOCAL_ON = DSQ_FLAG_BUILTIN | (1ULL << 62); ///< OR with a CPU number
+    static constexpr int SLICE_DFL = 5;                                     ///< Default slice
+    static constexpr uint64_t ENQ_WAKEUP = 1;       ///< enqueue(): the task just arrived
+    static constexpr uint64_t ENQ_HEAD = 2;         ///< insert(): at the head of a FIFO DSQ
+    static constexpr uint64_t ENQ_PREEMPT = 4;      ///< insert() into a local DSQ: preempt its CPU
+
+    /**
+     * @struct Task
+     * @brief Per-task state visible to the policy (p->scx in the kernel)
+     */
+    struct Task {
+        int cpu;            ///< CPU chosen by selectCpu() or last run on (-1 = none)
+        int slice;          ///< Remaining slice; a policy may set it to 0 to preempt
+        uint64_t dsqVtime;  ///< Policy-owned virtual time
+        int weight;         ///< 100 at nice 0, from the kernel's nice-to-weight table
+        int enqueuedAt;     ///< Time the task last became runnable
+        bool queued;        ///< In a DSQ
+        CpuSet allowed;     ///< CPUs the task may run on (p->cpus_ptr)
+        int smtClass;       ///< Class for SMT interference (SmtConfig::slowdown)
+        uint64_t cookie;    ///< Core-scheduling cookie; siblings co-run equal cookies only
+    };
+
+private:
+    static constexpr size_t GANTT_WIDTH = 60;   ///< Columns of the Gantt chart recorded and shown
+    static constexpr int64_t NEVER = INT64_MAX; ///< Time of an event that will not happen
+
+    /**
+     * @struct Cpu
+     * @brief State of one simulated CPU
+     */
+    struct Cpu {
+        int running;                    ///< Running task (-1 = idle)
+        int previous;                   ///< Task that ran last, for switch counting (-1 = none)
+        int readyAt;                    ///< Time the switch overhead ends
+        bool preempt;                   ///< Preemption requested
+        bool online;                    ///< Not hotplugged out
+        bool forcedIdle;                ///< Idle only because of core scheduling
+        DispatchQueue local;            ///< Local DSQ
+        std::vector<std::string> gantt; ///< Timeline of this CPU
+    };
+
+    const std::vector<std::shared_ptr<Process>>* processes;  ///< The engine's processes
+    std::vector<Task> tasks;                    ///< Indexed like 'processes'
+    std::vector<Cpu> cpus;                      ///< Simulated CPUs
+    DispatchQueue globalDsq;                    ///< DSQ_GLOBAL
+    std::map<uint64_t, DispatchQueue> userDsqs; ///< Policy-created DSQs by id
+    CpuSet idleMask;                            ///< CPUs that are idle and unclaimed
+    CpuSet onlineMask;                          ///< CPUs that are online
+    CpuSet backlog;                             ///< CPUs whose local DSQ is not empty
+    size_t brokenAffinities;                    ///< Masks widened because no allowed CPU was online
+    int threadsPerCore;                         ///< SMT width
+    bool coreScheduling;                        ///< Siblings co-run equal cookies only
+    int now;                                    ///< Current simulation time
+    int dispatchCpu;                            ///< CPU inside dispatch() (-1 = none)
+    std::string exitReason;                     ///< Why the policy was aborted ("" = not)
+
+    // Engine configuration and per-run state the policy never sees
+    std::unordered_map<const Process*, int> taskIndex;  ///< Process -> task index
+    std::unordered_map<int, CpuSet> affinity;           ///< PID -> allowed CPUs, for pinned processes
+    std::vector<HotplugEvent> hotplugEvents;            ///< Script, by time
+    size_t nextHotplug;                                 ///< First event not yet applied
+    std::vector<int> lastCpu;                           ///< CPU each task last ran on (-1 = none)
+    size_t migrations;                                  ///< Starts on a CPU other than the last one
+    SmtConfig smt;                                      ///< SMT width, interference, core scheduling
+    std::unordered_map<int, int> smtClasses;            ///< PID -> SMT class, for classified processes
+    std::unordered_map<int, uint64_t> cookies;          ///< PID -> core-scheduling cookie
+    std::vector<int> workCarry;                         ///< Progress per task below one unit, in 1/1000
+    std::vector<int> stallCarry;                        ///< Swap stall per task below one unit, in 1/1000
+    int64_t forcedIdleTime;                             ///< CPU time forced idle by core scheduling
+    FailureConfig failures;                             ///< Fault injection parameters
+    std::vector<int> attempts;                          ///< Runs started per task, retries included
+    std::vector<int> crashAt;                           ///< Work into the current run at which it crashes (INT_MAX = never)
+    std::vector<int64_t> cpuFailAt;                     ///< Next failure per CPU (NEVER while failed)
+    std::vector<int64_t> cpuRepairAt;                   ///< Repair per failed CPU (NEVER while up)
+    std::vector<int> cpuLives;                          ///< Failure draws made per CPU
+    size_t pendingRetries;                              ///< Crashed tasks waiting out their backoff
+    size_t taskCrashes;                                 ///< Task runs that crashed
+    size_t cpuFailures;                                 ///< CPU failures
+    int watchdogTimeout;                                ///< Abort once a task is READY this long (0 = off)
+
+    template <typename Policy> friend class ExtScheduler;
+
+    /**
+     * @brief Prepare for a run, applying affinities, SMT classes and cookies
+     */
+    void reset(const std::vector<std::shared_ptr<Process>>& processes, int numCpus);
+
+    /**
+     * @brief Pin a process to @p allowed; false unless it has @p numCpus bits, some set
+     */
+    bool setAffinity(int pid, const CpuSet& allowed, int numCpus);
+
+    /**
+     * @brief Add a hotplug event in time order; false for a bad CPU or time
+     */
+    bool addHotplugEvent(int time, int cpu, bool online, int numCpus);
+
+    /**
+     * @brief Set the SMT layout; false unless it divides @p numCpus and no slowdown is below 1
+     */
+    bool setSmt(const SmtConfig& config, int numCpus);
+
+    /**
+     * @brief Set the fault injection parameters; false if any is out of range
+     */
+    bool setFailures(const FailureConfig& config);
+
+    /**
+     * @brief Set the watchdog timeout (negative = 0)
+     *
+     * @return true if the watchdog is on
+     */
+    bool setWatchdogTimeout(int timeout);
+
+    /**
+     * @brief Put a task on an idle CPU at the current time
+     *
+     * Counts a migration if it last ran elsewhere, and starts the switch
+     * overhead if the CPU last ran another task.
+     *
+     * @return true if that was a context switch
+     */
+    bool place(int cpu, int task, int overhead);
+
+    /**
+     * @brief Work per time unit of the task on @p cpu, in thousandths,
+     *        given what its siblings run and the host's memory speed
+     */
+    int speedOf(int cpu, int memory) const;
+
+    /**
+     * @brief Run @p cpu from now to @p to at @p memory speed
+     *
+     * A running task progresses by its speed, with the remainder carried,
+     * and uses up its slice; an idle CPU next to work it may not co-run is
+     * counted as forced idle.
+     */
+    void advance(int cpu, int to, int memory);
+
+    /**
+     * @brief Mark the idle CPUs that core scheduling keeps from waiting work
+     */
+    void updateForcedIdle();
+
+    /**
+     * @brief Uniform [0, 1) draw @p n of stream @p id, independent of event order
+     */
+    double failureDraw(uint64_t stream, int id, int n) const;
+
+    /**
+     * @brief Draw whether, and after how much work, the task's next run crashes
+     *
+     * Crash points are rounded up to whole units of work; a crash in the
+     * last unit still loses the whole run.
+     */
+    void sampleCrash(int task);
+
+    /**
+     * @brief Time from now until a working CPU fails
+     */
+    int64_t sampleCpuLifetime(int cpu);
+
+    /**
+     * @brief An arrived task starts its first run
+     */
+    void firstAttempt(int task);
+
+    /**
+     * @brief A crashed task's backoff is over; it starts another run
+     */
+    void nextAttempt(int task);
+
+    /**
+     * @brief Whether the task running its current run has reached its crash point
+     */
+    bool crashDue(int task) const;
+
+    /**
+     * @brief Lose a crashed run's progress
+     *
+     * @return int64_t Backoff before the retry, or -1 if it has none left
+     */
+    int64_t crashRun(int task);
+
+    /**
+     * @brief Draw every CPU's first lifetime at the start of a run
+     */
+    void startFailures(int start);
+
+    /**
+     * @brief Apply the CPU failures and repairs due now through @p hotplug
+     *
+     * The task on a failing CPU loses its progress, including that of its
+     * earlier runs if it is still in its switch overhead. The last online
+     * CPU does not fail; its lifetime is drawn again.
+     */
+    void applyCpuFailures(const std::function<void(const HotplugEvent&)>& hotplug);
+
+    /**
+     * @brief Earliest scripted hotplug, CPU failure or repair, completion,
+     *        crash or slice end
+     */
+    int64_t nextCpuEvent(int memory) const;
+
+    /**
+     * @brief DSQ an id refers to for @p task, or nullptr if there is none
+     */
+    DispatchQueue* resolve(uint64_t dsqId, int task);
+
+    /**
+     * @brief Mark a CPU idle or busy (an offline CPU is never idle)
+     */
+    void setIdle(int cpu, bool idle);
+
+    /**
+     * @brief Bring a CPU online or take it offline
+     *
+     * Offlining breaks the affinity of unfinished tasks left without an
+     * online CPU. The CPU's running task and local DSQ are the engine's to
+     * migrate.
+     */
+    void setOnline(int cpu, bool online);
+
+    /**
+     * @brief Take the first task of @p dsq that @p cpu's mask allows, if
+     *        core scheduling lets it run next to the CPU's siblings
+     *
+     * A task with the wrong cookie is not skipped: it blocks the CPU, which
+     * stays forced idle, so tasks are not overtaken and starved.
+     *
+     * @return int Task index, or -1
+     */
+    int consume(DispatchQueue& dsq, int cpu);
+
+    /**
+     * @brief Pull a task that may run on idle @p cpu from a busy CPU's local DSQ
+     *
+     * The busy CPU with the longest local DSQ is tried first.
+     *
+     * @return int Task index, or -1 if no backlogged CPU has one
+     */
+    int pullTask(int cpu);
+
+    /**
+     * @brief Whether a task that @p cpu's mask allows waits in its local DSQ,
+     *        the global DSQ or a policy DSQ, ignoring cookies
+     */
+    bool hasWaiting(int cpu) const;
+
+    /**
+     * @brief Tasks stranded in policy-created DSQs
+     */
+    size_t userQueued() const;
+
+    /**
+     * @brief Move every task in policy-created DSQs to the global DSQ
+     */
+    void drainUserDsqs();
+
+    /**
+     * @brief Record a CPU's timeline for columns [from, to) after @p origin
+     */
+    void recordGantt(int cpu, int from, int to, int origin);
+
+    /**
+     * @brief One row per CPU of the recorded timelines
+     */
+    std::string ganttChart() const;
+
+public:
+    /**
+     * @brief Construct an empty context
+     */
+    ExtContext();
+
+    /**
+     * @brief DSQ id of a CPU's local DSQ (SCX_DSQ_LOCAL_ON | cpu)
+     */
+    static uint64_t localOn(int cpu) { return DSQ_LOCAL_ON | static_cast<uint64_t>(cpu); }
+
+    /**
+     * @brief Current simulation time
+     */
+    int getNow() const { return now; }
+
+    /**
+     * @brief Number of CPUs
+     */
+    int nrCpus() const { return static_cast<int>(cpus.size()); }
+
+    /**
+     * @brief Scheduling state of a task
+     */
+    Task& task(int task) { return tasks[task]; }
+
+    /**
+     * @brief The process behind a task
+     */
+    const Process& process(int task) const { return *(*processes)[task]; }
+
+    /**
+     * @brief Task running on a CPU, or -1
+     */
+    int currentTask(int cpu) const { return cpus[cpu].running; }
+
+    /**
+     * @brief Online CPUs
+     */
+    const CpuSet& onlineCpus() const { return onlineMask; }
+
+    /**
+     * @brief Whether a task may run on a CPU: allowed by its mask, online,
+     *        and with core scheduling compatible with the CPU's siblings
+     */
+    bool canRun(int task, int cpu) const {
+        return tasks[task].allowed.test(cpu) && onlineMask.test(cpu) && coreCompatible(task, cpu);
+    }
+
+    /**
+     * @brief Whether every busy sibling of @p cpu runs a task with @p task's
+     *        cookie (always true without core scheduling)
+     */
+    bool coreCompatible(int task, int cpu) const {
+        if (!coreScheduling) {
+            return true;
+        }
+        int first = cpu - cpu % threadsPerCore;
+        for (int s = first; s < first + threadsPerCore && s < nrCpus(); s++) {
+            int other = cpus[s].running;
+            if (s != cpu && other != -1 && tasks[other].cookie != tasks[task].cookie) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Create a policy DSQ (scx_bpf_create_dsq)
+     *
+     * @param id DSQ id; must not have DSQ_FLAG_BUILTIN set
+     * @param order FIFO or VTIME (default: FIFO)
+     * @return true if created, false if the id is reserved or taken
+     */
+    bool createDsq(uint64_t id, DsqOrder order = DsqOrder::FIFO);
+
+    /**
+     * @brief Insert a task into a DSQ (scx_bpf_dsq_insert)
+     *
+     * @param task Task index
+     * @param dsqId DSQ_GLOBAL, DSQ_LOCAL, localOn(cpu) or a created DSQ
+     * @param slice Time the task may run once picked (at least 1)
+     * @param enqFlags ENQ_HEAD, ENQ_PREEMPT
+     */
+    void insert(int task, uint64_t dsqId, int slice, uint64_t enqFlags = 0);
+
+    /**
+     * @brief Insert a task into a VTIME DSQ (scx_bpf_dsq_insert_vtime)
+     *
+     * Built-in DSQs and FIFO DSQs reject vtime insertion.
+     */
+    void insertVtime(int task, uint64_t dsqId, int slice, uint64_t vtime,
+                     uint64_t enqFlags = 0);
+
+    /**
+     * @brief Move the first task of a DSQ to a CPU's local DSQ
+     *        (scx_bpf_dsq_move_to_local)
+     *
+     * @return true if a task was moved
+     */
+    bool moveToLocal(uint64_t dsqId, int cpu);
+
+    /**
+     * @brief Number of tasks in a DSQ (scx_bpf_dsq_nr_queued), 0 if unknown
+     */
+    size_t dsqSize(uint64_t dsqId);
+
+    /**
+     * @brief Ask a CPU to reschedule (scx_bpf_kick_cpu)
+     *
+     * An idle CPU always looks for work; with @p preempt a busy CPU stops
+     * its task, which goes back through enqueue().
+     */
+    void kickCpu(int cpu, bool preempt = false);
+
+    /**
+     * @brief Claim a CPU if it is idle (scx_bpf_test_and_clear_cpu_idle)
+     */
+    bool testAndClearCpuIdle(int cpu);
+
+    /**
+     * @brief Claim the lowest-numbered idle CPU (scx_bpf_pick_idle_cpu)
+     *
+     * @return int CPU, or -1 if none is idle
+     */
+    int pickIdleCpu();
+
+    /**
+     * @brief Claim the lowest-numbered idle CPU in @p allowed
+     *        (scx_bpf_pick_idle_cpu with a cpumask)
+     *
+     * @return int CPU, or -1 if none of them is idle
+     */
+    int pickIdleCpu(const CpuSet& allowed);
+
+    /**
+     * @brief Default CPU selection (scx_bpf_select_cpu_dfl)
+     *
+     * Among the CPUs the task may run on: the previous CPU if it is idle,
+     * else the lowest idle CPU, else the previous CPU if still allowed and
+     * online, else the lowest allowed online CPU.
+     *
+     * @param isIdle Set to whether the returned CPU was idle (and is now claimed)
+     */
+    int selectCpuDefault(int task, int prevCpu, bool& isIdle);
+
+    /**
+     * @brief Abort the policy (scx_bpf_error); the first reason is kept
+     */
+    void error(const std::string& reason);
+
+    /**
+     * @brief Why the policy was aborted, or "" if it was not
+     */
+    const std::string& getExitReason() const { return exitReason; }
+};
+
+/**
+ * @struct ExtPolicy
+ * @brief Default callbacks: direct dispatch to idle CPUs, else global FIFO
+ *
+ * Derive from this and hide the callbacks to customize. Behaves like a
+ * sched_ext scheduler that implements no operations.
+ */
+struct ExtPolicy {
+    /**
+     * @brief Policy name shown in results
+     */
+    std::string name() const { return "Global FIFO"; }
+
+    /**
+     * @brief Start of a run
+     */
+    void init(ExtContext&) {}
+
+    /**
+     * @brief Choose the CPU of a waking task; may insert the task directly
+     */
+    int selectCpu(ExtContext& ctx, int task, int prevCpu) {
+        bool isIdle = false;
+        int cpu = ctx.selectCpuDefault(task, prevCpu, isIdle);
+        if (isIdle) {
+            ctx.insert(task, ExtContext::localOn(cpu), ExtContext::SLICE_DFL);
+        }
+        return cpu;
+    }
+
+    /**
+     * @brief Insert a runnable task into a DSQ
+     */
+    void enqueue(ExtContext& ctx, int task, uint64_t enqFlags) {
+        ctx.insert(task, ExtContext::DSQ_GLOBAL, ExtContext::SLICE_DFL, enqFlags);
+    }
+
+    /**
+     * @brief Refill an idle CPU's local DSQ
+     */
+    void dispatch(ExtContext&, int) {}
+
+    /**
+     * @brief A CPU came online
+     */
+    void cpuOnline(ExtContext&, int) {}
+
+    /**
+     * @brief A CPU is going offline; it is already out of the online mask
+     */
+    void cpuOffline(ExtContext&, int) {}
+
+    /**
+     * @brief A task starts running
+     */
+    void running(ExtContext&, int) {}
+
+    /**
+     * @brief A task stops running; @p runnable is false when it completed
+     */
+    void stopping(ExtContext&, int, bool) {}
+
+    /**
+     * @brief Periodic tick while a task runs
+     */
+    void tick(ExtContext&, int) {}
+};
+
+/**
+ * @class ExtScheduler
+ * @brief Multi-CPU event-driven engine driving a sched_ext-style policy
+ *
+ * Time advances to the next arrival, slice end, completion or tick on any
+ * CPU. Ticks are a periodic timer that runs only while some CPU is busy
+ * (tickInterval 0 disables them). Each CPU pays the context switch overhead
+ * itself; waiting time is charged from the time a task became runnable.
+ *
+ * Processes may be pinned to CPU sets (setAffinity) and CPUs taken offline
+ * and back online at scripted times (addHotplugEvent). An offline CPU's
+ * running task and local DSQ are migrated through enqueue(). A CPU that
+ * finds its local DSQ, the global DSQ and dispatch() empty pulls a task it
+ * may run from the longest local DSQ of a busy CPU, so work placed on one
+ * CPU does not wait while an allowed CPU idles.
+ *
+ * With SMT (setSmt) a task's progress per time unit is its speed given the
+ * classes running on its siblings, kept in thousandths with the remainder
+ * carried, so a slice of wall time may complete less than its length of
+ * work. Core scheduling adds cookies (setCoreCookie): an idle CPU whose
+ * only waiting work has another cookie than a busy sibling stays forced
+ * idle, and that time is counted.
+ *
+ * @tparam Policy Callback implementation, usually derived from ExtPolicy
+ */
+template <typename Policy>
+class ExtScheduler : public Scheduler {
+private:
+    static constexpr uint64_t TICK_TIMER = 1;   ///< Payload of the tick timer
+    static constexpr uint64_t RETRY_TIMER = 2;  ///< Payload of a retry timer, plus the task index
+
+    Policy prototype;                                   ///< Policy as constructed
+    Policy policy;                                      ///< Policy state of the current run
+    ExtContext ctx;                                     ///< Engine/policy shared state
+    int tickInterval;                                   ///< Tick period (0 = no ticks)
+    bool bypass;                                        ///< Policy aborted; default behaviour
+    int ganttOrigin;                                    ///< Time of the first Gantt column
+
+    /**
+     * @brief Switch to default behaviour once the policy has been aborted
+     */
+    void checkExit() {
+        if (!bypass && !ctx.exitReason.empty()) {
+            bypass = true;
+            ctx.drainUserDsqs();
+        }
+    }
+
+    /**
+     * @brief Make a task runnable through enqueue(), or the global DSQ in bypass
+     */
+    void enqueueTask(int task, uint64_t enqFlags) {
+        if (!bypass) {
+            policy.enqueue(ctx, task, enqFlags);
+            if (!ctx.tasks[task].queued) {
+                ctx.error("enqueue() did not insert " + ctx.process(task).getName());
+            }
+            checkExit();
+        }
+        if (!ctx.tasks[task].queued) {
+            ctx.insert(task, ExtContext::DSQ_GLOBAL, ExtContext::SLICE_DFL);
+        }
+    }
+
+    /**
+     * @brief Wake an arriving task: selectCpu(), then enqueue() unless inserted
+     */
+    void wakeUp(int task) {
+        if (!bypass) {
+            int cpu = policy.selectCpu(ctx, task, ctx.tasks[task].cpu);
+            if (cpu < 0 || cpu >= cpuCount) {
+                ctx.error("selectCpu() returned invalid CPU " + std::to_string(cpu));
+                cpu = 0;
+            }
+            if (!ctx.canRun(task, cpu)) {
+                // Like select_fallback_rq(): a CPU the task may use
+                cpu = ctx.tasks[task].allowed.firstAnd(ctx.onlineMask);
+            }
+            ctx.tasks[task].cpu = cpu;
+            checkExit();
+            if (ctx.tasks[task].queued) {
+                return;
+            }
+        }
+        enqueueTask(task, ExtContext::ENQ_WAKEUP);
+    }
+
+    /**
+     * @brief Next task for an idle CPU: local DSQ, global DSQ, then dispatch()
+     */
+    int pickNext(int cpu) {
+        int task = ctx.consume(ctx.cpus[cpu].local, cpu);
+        if (task == -1) {
+            task = ctx.consume(ctx.globalDsq, cpu);
+        }
+        if (task == -1 && !bypass) {
+            ctx.dispatchCpu = cpu;
+            policy.dispatch(ctx, cpu);
+            ctx.dispatchCpu = -1;
+            checkExit();
+            task = ctx.consume(ctx.cpus[cpu].local, cpu);
+            if (task == -1) {
+                task = ctx.consume(ctx.globalDsq, cpu);
+            }
+        }
+        if (task == -1) {
+            task = ctx.pullTask(cpu);
+        }
+        if (task != -1) {
+            ctx.tasks[task].queued = false;
+        }
+        return task;
+    }
+
+    /**
+     * @brief Put a task on a CPU, charging its wait and any switch overhead
+     */
+    void startTask(int cpu, int task) {
+        std::shared_ptr<Process> process = processes[task];
+        process->addWaitingTime(currentTime - ctx.tasks[task].enqueuedAt);
+        if (ctx.place(cpu, task, contextSwitchOverhead)) {
+            totalContextSwitches++;
+        }
+
+        int readyAt = ctx.cpus[cpu].readyAt;
+        markRunning(*process, readyAt);
+        if (process->isFirstSchedule()) {
+            process->setStartTime(readyAt);
+            process->setFirstSchedule(false);
+        }
+        if (!bypass) {
+            policy.running(ctx, task);
+            checkExit();
+        }
+    }
+
+    /**
+     * @brief Take the running task off a CPU and tell the policy
+     */
+    int stopTask(int cpu, bool runnable) {
+        int task = ctx.cpus[cpu].running;
+        ctx.cpus[cpu].running = -1;
+        ctx.setIdle(cpu, true);
+        if (runnable) {
+            markReady(*processes[task], currentTime);
+            ctx.tasks[task].enqueuedAt = currentTime;
+        }
+        if (!bypass) {
+            policy.stopping(ctx, task, runnable);
+            checkExit();
+        }
+        return task;
+    }
+
+    /**
+     * @brief A task run crashed: retry it after its backoff, or fail it
+     */
+    void crashTask(int cpu) {
+        int task = stopTask(cpu, false);
+        ctx.cpus[cpu].previous = -1;
+        std::shared_ptr<Process> process = processes[task];
+        int64_t backoff = ctx.crashRun(task);
+        if (backoff < 0) {
+            process->setFailed(true);
+            completeProcess(process);
+            return;
+        }
+        process->setState(ProcessState::WAITING);
+        timers.schedule(currentTime + backoff, RETRY_TIMER + static_cast<uint64_t>(task));
+    }
+
+    /**
+     * @brief Apply one hotplug event, migrating the tasks of a CPU going offline
+     *
+     * The last online CPU cannot go offline.
+     */
+    void hotplug(const HotplugEvent& event) {
+        ExtContext::Cpu& cpu = ctx.cpus[event.cpu];
+        if (event.online == cpu.online || (!event.online && ctx.onlineMask.count() == 1)) {
+            return;
+        }
+        ctx.setOnline(event.cpu, event.online);
+        if (event.online) {
+            if (!bypass) {
+                policy.cpuOnline(ctx, event.cpu);
+                checkExit();
+            }
+            return;
+        }
+        if (!bypass) {
+            policy.cpuOffline(ctx, event.cpu);
+            checkExit();
+        }
+
+        std::vector<int> displaced;
+        if (cpu.running != -1) {
+            displaced.push_back(stopTask(event.cpu, true));
+        }
+        int task;
+        while ((task = cpu.local.pop()) != -1) {
+            ctx.tasks[task].queued = false;
+            displaced.push_back(task);
+        }
+        ctx.backlog.clear(event.cpu);
+        cpu.previous = -1;
+        cpu.preempt = false;
+        for (int moved : displaced) {
+            // Re-queueing is not new waiting: keep the original timestamp
+            int runnableSince = ctx.tasks[moved].enqueuedAt;
+            enqueueTask(moved, 0);
+            ctx.tasks[moved].enqueuedAt = runnableSince;
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new engine
+     *
+     * @param numCpus Number of CPUs (default: 1)
+     * @param tickInterval Period of tick() calls, 0 for none (default: 0)
+     * @param contextSwitchOverhead Context switch time cost (default: 0)
+     * @param policy Initial policy state, copied at the start of every run
+     */
+    explicit ExtScheduler(int numCpus = 1, int tickInterval = 0, int contextSwitchOverhead = 0,
+                          const Policy& policy = Policy())
+        : Scheduler(contextSwitchOverhead), prototype(policy), policy(policy),
+          tickInterval(std::max(0, tickInterval)), bypass(false), ganttOrigin(0) {
+        cpuCount = std::max(1, numCpus);
+    }
+
+    /**
+     * @brief Get the name of this scheduling algorithm
+     *
+     * @return std::string "sched_ext: <policy name>[, N CPUs]"
+     */
+    std::string getName() const override {
+        std::string cpusLabel = cpuCount > 1 ? ", " + std::to_string(cpuCount) + " CPUs" : "";
+        return "sched_ext: " + prototype.name() + cpusLabel;
+    }
+
+    /**
+     * @brief Execute the simulation, calling the policy at each decision point
+     */
+    void schedule() override;
+
+    /**
+     * @brief Get visual Gantt chart of execution, one row per CPU
+     *
+     * @return std::string Formatted timeline showing process execution order
+     */
+    std::string getGanttChart() const override { return ctx.ganttChart(); }
+
+    /**
+     * @brief Restrict a process to a set of CPUs (sched_setaffinity)
+     *
+     * @param pid PID of a process added before schedule()
+     * @param allowed CPUs it may run on, sized to the number of CPUs
+     * @return false if @p allowed has the wrong size or is empty
+     */
+    bool setAffinity(int pid, const CpuSet& allowed) { return ctx.setAffinity(pid, allowed, cpuCount); }
+
+    /**
+     * @brief Let every process run on every CPU again
+     */
+    void clearAffinity() { ctx.affinity.clear(); }
+
+    /**
+     * @brief Script a CPU going offline or coming back online during the run
+     *
+     * Every run starts with all CPUs online. Events at the same time apply
+     * in the order added; an event that would take the last online CPU
+     * offline is ignored.
+     *
+     * @return false if @p cpu does not exist or @p time is negative
+     */
+    bool addHotplugEvent(int time, int cpu, bool online) {
+        return ctx.addHotplugEvent(time, cpu, online, cpuCount);
+    }
+
+    /**
+     * @brief Remove the hotplug script
+     */
+    void clearHotplugEvents() { ctx.hotplugEvents.clear(); }
+
+    /**
+     * @brief Group the CPUs into SMT cores
+     *
+     * @return false if threadsPerCore is below 1 or does not divide the
+     *         number of CPUs, or a slowdown is below 1
+     */
+    bool setSmt(const SmtConfig& config) { return ctx.setSmt(config, cpuCount); }
+
+    /**
+     * @brief Set a process's SMT class (default 0)
+     */
+    void setTaskClass(int pid, int smtClass) { ctx.smtClasses[pid] = smtClass; }
+
+    /**
+     * @brief Set a process's core-scheduling cookie (default 0, shared by
+     *        every process without one; prctl(PR_SCHED_CORE))
+     */
+    void setCoreCookie(int pid, uint64_t cookie) { ctx.cookies[pid] = cookie; }
+
+    /**
+     * @brief CPU time in the last run that CPUs idled next to work they
+     *        could have run but for core scheduling
+     */
+    int64_t getForcedIdleTime() const { return ctx.forcedIdleTime; }
+
+    /**
+     * @brief Inject task crashes and CPU failures into every run
+     *
+     * The injected failures depend only on the seed, the PIDs and the CPU
+     * numbers, not on the policy. Wasted CPU time and goodput are part of
+     * calculateMetrics().
+     *
+     * @return false if the crash probability is outside [0, 1), a count or
+     *         time is negative, the backoff multiplier is below 1, the MTBF
+     *         is negative or the repair time is below 1
+     */
+    bool setFailures(const FailureConfig& config) { return ctx.setFailures(config); }
+
+    /**
+     * @brief Stop injecting failures
+     */
+    void clearFailures() { ctx.failures = FailureConfig(); }
+
+    /**
+     * @brief Abort the policy once a task has been READY for @p timeout
+     *
+     * The counterpart of the sched_ext watchdog: a policy that leaves a
+     * runnable task in its queues too long is aborted with a "runnable
+     * task stall" exit reason, and the run finishes with the default global
+     * FIFO behaviour. Turns on starvation tracking, whose oldest READY task
+     * is checked in O(1) at every event and bounds the next event time.
+     *
+     * @param timeout Longest allowed wait (0 = no watchdog)
+     */
+    void setWatchdogTimeout(int timeout) {
+        if (ctx.setWatchdogTimeout(timeout)) {
+            setStarvationTracking(true);
+        }
+    }
+
+    /**
+     * @brief Task runs that crashed in the last run
+     */
+    size_t getTaskCrashes() const { return ctx.taskCrashes; }
+
+    /**
+     * @brief CPU failures in the last run
+     */
+    size_t getCpuFailures() const { return ctx.cpuFailures; }
+
+    /**
+     * @brief Task starts in the last run on a CPU other than the one the task last ran on
+     */
+    size_t getMigrations() const { return ctx.migrations; }
+
+    /**
+     * @brief Affinity masks widened in the last run because hotplug left them no online CPU
+     */
+    size_t getBrokenAffinities() const { return ctx.brokenAffinities; }
+
+    /**
+     * @brief Why the policy was aborted in the last run, or "" if it was not
+     */
+    const std::string& getExitReason() const { return ctx.getExitReason(); }
+
+    /**
+     * @brief Policy state after the last run
+     */
+    const Policy& getPolicy() const { return policy; }
+};
+
+template <typename Policy>
+void ExtScheduler<Policy>::schedule() {
+    currentTime = 0;
+    resetTimeline();
+    timers.clear(0);
+    ctx.reset(processes, cpuCount);
+    bypass = false;
+    policy = prototype;
+
+    policy.init(ctx);
+    checkExit();
+
+    currentTime = nextArrivalTime();
+    if (currentTime == INT_MAX) {
+        currentTime = 0;
+        return;
+    }
+    ganttOrigin = currentTime;
+    ctx.startFailures(currentTime);
+
+    uint64_t tickTimer = 0;
+    bool tickArmed = false;
+    while (true) {
+        ctx.now = currentTime;
+
+        // Hotplug before arrivals, so they see the new set of CPUs
+        while (ctx.nextHotplug < ctx.hotplugEvents.size() &&
+               ctx.hotplugEvents[ctx.nextHotplug].time <= currentTime) {
+            hotplug(ctx.hotplugEvents[ctx.nextHotplug++]);
+        }
+        if (ctx.failures.cpuMtbf > 0) {
+            ctx.applyCpuFailures([this](const HotplugEvent& event) { hotplug(event); });
+        }
+
+        // Wake up arrivals
+        for (auto& process : admitArrivingProcesses()) {
+            int task = ctx.taskIndex[process.get()];
+            wakeUp(task);
+            ctx.tasks[task].enqueuedAt = readyTime(*process);
+            ctx.firstAttempt(task);
+        }
+
+        // Watchdog: a task READY this long means the policy is starving it
+        const StarvationTracker* starving = getStarvation();
+        if (ctx.watchdogTimeout > 0 && !bypass && starving &&
+            starving->currentWait(currentTime) >= ctx.watchdogTimeout) {
+            ctx.error("runnable task stall (PID " + std::to_string(starving->oldest()) + " did not run for " +
+                      std::to_string(starving->currentWait(currentTime)) + ")");
+            checkExit();
+        }
+
+        // Kicked CPUs give up their task, which goes back through enqueue()
+        for (int c = 0; c < cpuCount; c++) {
+            if (ctx.cpus[c].preempt) {
+                ctx.cpus[c].preempt = false;
+                if (ctx.cpus[c].running != -1) {
+                    enqueueTask(stopTask(c, true), 0);
+                }
+            }
+        }
+
+        // Idle CPUs pick work
+        bool anyRunning = false;
+        for (int c = 0; c < cpuCount; c++) {
+            if (ctx.cpus[c].running == -1 && ctx.cpus[c].online) {
+                int task = pickNext(c);
+                if (task != -1) {
+                    startTask(c, task);
+                } else {
+                    ctx.setIdle(c, true);
+                }
+            }
+            anyRunning = anyRunning || ctx.cpus[c].running != -1;
+        }
+        ctx.updateForcedIdle();
+
+        // Ticks only while some CPU is busy (NO_HZ idle)
+        if (tickInterval > 0 && anyRunning && !tickArmed) {
+            int64_t firstTick = (static_cast<int64_t>(currentTime) / tickInterval + 1) * tickInterval;
+            tickTimer = timers.schedule(firstTick, TICK_TIMER, tickInterval);
+            tickArmed = true;
+        } else if (tickArmed && !anyRunning) {
+            timers.cancel(tickTimer);
+            tickArmed = false;
+        }
+
+        // Next event: arrival, timer, watchdog, or a hotplug, CPU failure,
+        // completion, crash or slice end
+        int memory = memorySpeed();
+        int64_t nextEvent = std::min<int64_t>(nextArrivalTime(), timers.nextExpiry());
+        if (ctx.watchdogTimeout > 0 && !bypass && starving && !starving->empty()) {
+            nextEvent = std::min<int64_t>(nextEvent, starving->oldestSince() + ctx.watchdogTimeout);
+        }
+        nextEvent = std::min(nextEvent, ctx.nextCpuEvent(memory));
+        if (!anyRunning && nextArrivalTime() == INT_MAX && ctx.pendingRetries == 0) {
+            if (ctx.userQueued() > 0 && !bypass) {
+                ctx.error("runnable tasks stalled in dispatch queues");
+                checkExit();
+                continue;
+            }
+            break;
+        }
+        int eventTime = static_cast<int>(nextEvent);
+        if (memory < 1000 && anyRunning && !memoryHeld()) {
+            addMemoryPressureTime(eventTime - currentTime);
+        }
+
+        // Advance every CPU to the event
+        for (int c = 0; c < cpuCount; c++) {
+            if (currentTime - ganttOrigin < static_cast<int>(ExtContext::GANTT_WIDTH)) {
+                ctx.recordGantt(c, currentTime - ganttOrigin, eventTime - ganttOrigin, ganttOrigin);
+            }
+            const ExtContext::Cpu& cpu = ctx.cpus[c];
+            int start = std::max(currentTime, cpu.readyAt);
+            if (cpu.running != -1 && eventTime > start) {
+                recordExecution(processes[cpu.running], start, eventTime - start);
+            }
+            ctx.advance(c, eventTime, memory);
+        }
+        currentTime = eventTime;
+        ctx.now = currentTime;
+
+        // Retries and ticks; a policy preempts by setting the slice to 0
+        TimerEvent event;
+        while (timers.popExpired(currentTime, event)) {
+            if (event.payload >= RETRY_TIMER) {
+                int task = static_cast<int>(event.payload - RETRY_TIMER);
+                ctx.nextAttempt(task);
+                markReady(*processes[task], currentTime);
+                wakeUp(task);
+                ctx.tasks[task].enqueuedAt = currentTime;
+                continue;
+            }
+            if (bypass) {
+                continue;
+            }
+            for (int c = 0; c < cpuCount; c++) {
+                const ExtContext::Cpu& cpu = ctx.cpus[c];
+                if (cpu.running != -1 && currentTime >= cpu.readyAt) {
+                    policy.tick(ctx, cpu.running);
+                }
+            }
+            checkExit();
+        }
+
+        // Completions and slice ends, in CPU order
+        for (int c = 0; c < cpuCount; c++) {
+            ExtContext::Cpu& cpu = ctx.cpus[c];
+            if (cpu.running == -1 || currentTime < cpu.readyAt) {
+                continue;
+            }
+            std::shared_ptr<Process> process = processes[cpu.running];
+            if (ctx.crashDue(cpu.running)) {
+                crashTask(c);
+            } else if (process->isComplete()) {
+                stopTask(c, false);
+                cpu.previous = -1;
+                completeProcess(process);
+            } else if (ctx.tasks[cpu.running].slice <= 0) {
+                enqueueTask(stopTask(c, true), 0);
+            }
+        }
+    }
+
+}
+
+#endif // EXT_SCHEDULER_H
@@ -0,0 +1,134 @@
+#ifndef FAIRNESS_STATS_H
+#define FAIRNESS_STATS_H
+
+#include "QuantileSketch.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file FairnessStats.h
+ * @brief Streaming slowdown, Jain's fairness index and starvation per priority class
+ *
+ * Averages hide who pays for them: a policy can have a good mean turnaround
+ * because it starves its least urgent processes. These statistics show how
+ * the service was shared. Each one is updated once per completion or per
+ * dispatch and never recomputed from the process set.
+ */
+
+/**
+ * @struct ClassFairness
+ * @brief Running totals for one priority class (or for all of them)
+ *
+ * A process's CPU share is burst / turnaround, the fraction of its time in
+ * the system it spent running (1 / slowdown). Jain's index over n shares x
+ * is (sum x)^2 / (n * sum x^2): 1 when every process got the same share,
+ * 1/n when one process got all of it.
+ */
+struct ClassFairness {
+    uint64_t completed;         ///< Processes that completed
+    double shareSum;            ///< Sum of the CPU shares
+    double shareSquares;        ///< Sum of the squared CPU shares
+    int64_t burstSum;           ///< CPU time received by the completed processes
+    int64_t turnaroundSum;      ///< Time the completed processes spent in the system
+    int maxStarvation;          ///< Longest READY wait before a dispatch
+    QuantileSketch slowdown;    ///< Turnaround / burst of each completed process
+
+    explicit ClassFairness(double relativeAccuracy = QuantileSketch::DEFAULT_ACCURACY)
+        : completed(0), shareSum(0), shareSquares(0), burstSum(0), turnaroundSum(0),
+          maxStarvation(0), slowdown(relativeAccuracy) {}
+
+    /**
+     * @brief Jain's index over the processes' CPU shares (1 if none completed)
+     */
+    double jainIndex() const;
+
+    /**
+     * @brief CPU share of the class as a whole: burst time / turnaround time
+     */
+    double share() const;
+
+    /**
+     * @brief Add another class's totals
+     */
+    void merge(const ClassFairness& other);
+};
+
+/**
+ * @class FairnessStats
+ * @brief ClassFairness per priority class, plus one over all classes
+ *
+ * Classes are stored like LatencyHistogram's, in a vector indexed from the
+ * lowest class seen, so every update is O(1). Statistics with the same
+ * accuracy merge exactly, so replicas can be combined.
+ */
+class FairnessStats {
+private:
+    double relativeAccuracy;            ///< Accuracy of the slowdown sketches
+    std::vector<ClassFairness> classes; ///< classes[i] = class lowest + i
+    int lowest;                         ///< Class of classes[0]
+    ClassFairness all;                  ///< Every process, whatever its class
+
+    /**
+     * @brief Totals of @p priorityClass, created if missing
+     */
+    ClassFairness& totalsFor(int priorityClass);
+
+public:
+    /**
+     * @brief Construct empty statistics
+     *
+     * @param relativeAccuracy Maximum relative error of slowdown quantiles, in (0, 1)
+     */
+    explicit FairnessStats(double relativeAccuracy = QuantileSketch::DEFAULT_ACCURACY);
+
+    /**
+     * @brief Record a completed process
+     *
+     * @param priorityClass Class of the process
+     * @param burst CPU time it received
+     * @param turnaround Time from arrival to completion
+     */
+    void recordCompletion(int priorityClass, int burst, int turnaround);
+
+    /**
+     * @brief Record a READY wait that ended in a dispatch
+     */
+    void recordWait(int priorityClass, int wait);
+
+    /**
+     * @brief Add the totals of statistics with the same accuracy
+     *
+     * @return bool false (and nothing merged) if the accuracies differ
+     */
+    bool merge(const FairnessStats& other);
+
+    /**
+     * @brief Forget everything
+     */
+    void clear();
+
+    /**
+     * @brief Classes with at least one completion or wait, lowest first
+     */
+    std::vector<int> getClasses() const;
+
+    /**
+     * @brief Totals of one class (empty totals if it has none)
+     */
+    const ClassFairness& forClass(int priorityClass) const;
+
+    /**
+     * @brief Totals over every class
+     */
+    const ClassFairness& overall() const { return all; }
+
+    /**
+     * @brief Jain's index over the classes' shares (ClassFairness::share)
+     *
+     * Measures whether priority classes as groups were served alike,
+     * whatever their sizes. 1 with fewer than two classes.
+     */
+    double classJainIndex() const;
+};
+
+#endif // FAIRNESS_STATS_H
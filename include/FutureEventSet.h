@@ -0,0 +1,171 @@
+#ifndef FUTURE_EVENT_SET_H
+#define FUTURE_EVENT_SET_H
+
+#include "TimerWheel.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file FutureEventSet.h
+ * @brief Pending-event containers for the simulation engine
+ *
+ * The future-event set holds everything that will happen later: process
+ * arrivals today, and I/O completions or wakeups as the engine grows. Two
+ * implementations share one interface: a binary heap (O(log n) per
+ * operation, compact, best for small sets) and the hierarchical timing wheel
+ * (O(1) amortized insert and pop, best for large sets). createFutureEventSet()
+ * picks one from the expected number of pending events.
+ */
+
+/**
+ * @struct FutureEvent
+ * @brief A pending event
+ */
+struct FutureEvent {
+    int64_t time;       ///< Event time
+    uint64_t payload;   ///< Caller-defined value (e.g. a process index)
+};
+
+/**
+ * @enum FutureEventSetType
+ * @brief Implementation of a future-event set
+ */
+enum class FutureEventSetType {
+    AUTO,           ///< Choose from the expected number of pending events
+    BINARY_HEAP,    ///< Binary min-heap
+    TIMING_WHEEL    ///< Hierarchical timing wheel
+};
+
+/**
+ * @class FutureEventSet
+ * @brief Priority queue of events ordered by time
+ *
+ * Events with equal times are popped in insertion order, so simulations are
+ * deterministic whichever implementation is used. Events may not be pushed
+ * earlier than the last popped event; the timing wheel treats such events as
+ * due at the last popped time.
+ */
+class FutureEventSet {
+public:
+    static constexpr int64_t NO_EVENT = INT64_MAX;  ///< nextTime() of an empty set
+
+    virtual ~FutureEventSet() = default;
+
+    /**
+     * @brief Insert an event
+     *
+     * @param time Event time
+     * @param payload Caller-defined value
+     */
+    virtual void push(int64_t time, uint64_t payload) = 0;
+
+    /**
+     * @brief Time of the earliest event
+     *
+     * @return int64_t Event time, or NO_EVENT if the set is empty
+     */
+    virtual int64_t nextTime() = 0;
+
+    /**
+     * @brief Remove the earliest event
+     *
+     * @param event Receives the event
+     * @return true if an event was removed, false if the set is empty
+     */
+    virtual bool pop(FutureEvent& event) = 0;
+
+    /**
+     * @brief Remove all events
+     */
+    virtual void clear() = 0;
+
+    /**
+     * @brief Number of pending events
+     */
+    virtual size_t size() const = 0;
+
+    /**
+     * @brief Name of the implementation
+     */
+    virtual std::string getName() const = 0;
+
+    /**
+     * @brief Whether no events are pending
+     */
+    bool empty() const { return size() == 0; }
+};
+
+/**
+ * @class HeapEventSet
+ * @brief Future-event set backed by a binary min-heap
+ */
+class HeapEventSet : public FutureEventSet {
+private:
+    /**
+     * @struct Node
+     * @brief Heap node; sequence keeps equal times in insertion order
+     */
+    struct Node {
+        int64_t time;       ///< Event time
+        uint64_t sequence;  ///< Insertion order
+        uint64_t payload;   ///< Caller-defined value
+    };
+
+    std::vector<Node> heap;     ///< Min-heap on (time, sequence)
+    uint64_t nextSequence;      ///< Next insertion sequence number
+
+    /**
+     * @brief Heap order: true if node a comes after node b
+     */
+    static bool after(const Node& a, const Node& b);
+
+public:
+    HeapEventSet() : nextSequence(0) {}
+
+    void push(int64_t time, uint64_t payload) override;
+    int64_t nextTime() override;
+    bool pop(FutureEvent& event) override;
+    void clear() override;
+    size_t size() const override { return heap.size(); }
+    std::string getName() const override { return "Binary Heap"; }
+};
+
+/**
+ * @class WheelEventSet
+ * @brief Future-event set backed by the hierarchical timing wheel
+ */
+class WheelEventSet : public FutureEventSet {
+private:
+    TimerWheel wheel;   ///< One-shot timers, one per event
+
+public:
+    void push(int64_t time, uint64_t payload) override;
+    int64_t nextTime() override;
+    bool pop(FutureEvent& event) override;
+    void clear() override { wheel.clear(); }
+    size_t size() const override { return wheel.size(); }
+    std::string getName() const override { return "Timing Wheel"; }
+};
+
+/**
+ * @brief Pending-event count from which AUTO selects the timing wheel
+ *
+ * Crossover measured with bench/fes_benchmark.cpp: below it the heap's
+ * smaller footprint wins, above it the heap's O(log n) cache misses dominate.
+ */
+const size_t WHEEL_SELECTION_THRESHOLD = 10000;
+
+/**
+ * @brief Create a future-event set
+ *
+ * @param type Implementation, or AUTO
+ * @param expectedPending Expected number of simultaneously pending events
+ * @return std::unique_ptr<FutureEventSet> Empty event set
+ */
+std::unique_ptr<FutureEventSet> createFutureEventSet(FutureEventSetType type,
+                                                     size_t expectedPending = 0);
+
+#endif // FUTURE_EVENT_SET_H
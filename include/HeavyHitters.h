@@ -0,0 +1,106 @@
+#ifndef HEAVY_HITTERS_H
+#define HEAVY_HITTERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file HeavyHitters.h
+ * @brief Top-K CPU consumers in bounded memory (Space-Saving)
+ *
+ * A replay of 10^8 processes cannot keep a counter per process to find
+ * the ones that used the most CPU. Space-Saving keeps k counters whatever
+ * the number of processes, and every process that used more than 1/k of
+ * the CPU time is guaranteed to be among them.
+ */
+
+/**
+ * @struct HeavyHitter
+ * @brief One monitored id and its estimated weight
+ *
+ * The true weight lies in [count - error, count].
+ */
+struct HeavyHitter {
+    int id;             ///< Monitored id (a PID)
+    int64_t count;      ///< Estimated weight, never below the true one
+    int64_t error;      ///< Maximum overestimation
+};
+
+/**
+ * @class SpaceSaving
+ * @brief Weighted Space-Saving summary (Metwally, Agrawal and El Abbadi)
+ *
+ * Holds at most k counters. An update of a monitored id adds to its
+ * counter. An update of another id, once k are monitored, takes over the
+ * smallest counter: the new id inherits its count as error and adds the
+ * weight. Counters live in a min-heap indexed by id, so an update is
+ * O(log k) and the smallest counter is found in O(1). Every estimate
+ * overshoots by at most total / k.
+ */
+class SpaceSaving {
+private:
+    size_t capacity;                            ///< k: counters kept
+    std::vector<HeavyHitter> heap;              ///< Counters, min-heap on (count, id)
+    std::unordered_map<int, size_t> position;   ///< id -> index in heap
+    int64_t total;                              ///< Weight of every update
+
+    /**
+     * @brief Heap order: true if a belongs below b
+     */
+    static bool after(const HeavyHitter& a, const HeavyHitter& b);
+
+    /**
+     * @brief Restore the heap below index @p i after its count grew
+     */
+    void siftDown(size_t i);
+
+public:
+    /**
+     * @brief Construct an empty summary
+     *
+     * @param capacity Counters kept (at least 1)
+     */
+    explicit SpaceSaving(size_t capacity = 64);
+
+    /**
+     * @brief Add @p weight (> 0) to @p id
+     */
+    void add(int id, int64_t weight);
+
+    /**
+     * @brief The @p n largest counters, largest first (ties: lower id first)
+     */
+    std::vector<HeavyHitter> top(size_t n) const;
+
+    /**
+     * @brief Upper bound on the weight of @p id
+     *
+     * Its counter if monitored, otherwise the smallest counter (0 while
+     * fewer than k ids are monitored).
+     */
+    int64_t estimate(int id) const;
+
+    /**
+     * @brief Forget every update
+     */
+    void clear();
+
+    /**
+     * @brief Counters kept at most
+     */
+    size_t getCapacity() const { return capacity; }
+
+    /**
+     * @brief Ids monitored
+     */
+    size_t size() const { return heap.size(); }
+
+    /**
+     * @brief Weight of every update
+     */
+    int64_t getTotal() const { return total; }
+};
+
+#endif // HEAVY_HITTERS_H
@@ -0,0 +1,144 @@
+#ifndef HYPERVISOR_SIMULATOR_H
+#define HYPERVISOR_SIMULATOR_H
+
+#include "MonteCarloComparison.h"
+#include "QuantileSketch.h"
+#include "Scheduler.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file HypervisorSimulator.h
+ * @brief Two-level scheduling: guest schedulers on vCPUs, a host policy on pCPUs
+ *
+ * Each virtual machine's tasks are scheduled by ordinary guest Schedulers,
+ * one per vCPU, and a host policy multiplexes all vCPUs onto the physical
+ * CPUs. Time a vCPU has work but no physical CPU is steal time: the guest's
+ * clock does not advance, so it shows up in the tasks' real turnaround and
+ * response times and stretches any critical section a task was in
+ * (lock-holder preemption).
+ */
+
+/**
+ * @enum HostPolicy
+ * @brief How the host picks the next runnable vCPU
+ */
+enum class HostPolicy {
+    ROUND_ROBIN,    ///< FIFO run queue of vCPUs, one timeslice per turn
+    FAIR_SHARE      ///< Lowest pCPU time / VM weight first (credit / CFS style)
+};
+
+/**
+ * @struct VirtualMachine
+ * @brief One guest
+ *
+ * Tasks are placed on vCPUs round-robin in arrival order (ties by PID), as
+ * a guest with per-CPU run queues and no migration would.
+ */
+struct VirtualMachine {
+    int vcpus;                                      ///< Virtual CPUs (>= 1)
+    int weight;                                     ///< FAIR_SHARE weight (>= 1)
+    std::vector<std::shared_ptr<Process>> tasks;    ///< Arrival times are real (host) time
+
+    VirtualMachine() : vcpus(1), weight(1) {}
+};
+
+/**
+ * @struct HostConfig
+ * @brief Physical host and host policy
+ */
+struct HostConfig {
+    int pcpus;              ///< Physical CPUs
+    int timeslice;          ///< Host timeslice (>= 1)
+    HostPolicy policy;      ///< vCPU selection
+    int numThreads;         ///< Guest simulation threads (0 = hardware concurrency)
+
+    HostConfig() : pcpus(4), timeslice(5), policy(HostPolicy::ROUND_ROBIN), numThreads(0) {}
+};
+
+/**
+ * @struct HypervisorMetrics
+ * @brief Guest-visible results in real time, plus host-side steal accounting
+ */
+struct HypervisorMetrics {
+    size_t processes;               ///< Guest tasks completed
+    size_t vcpus;                   ///< vCPUs simulated
+    QuantileSketch waiting;         ///< Guest waiting time plus steal, per task
+    QuantileSketch turnaround;      ///< Real completion - real arrival, per task
+    QuantileSketch response;        ///< Real first run - real arrival, per task
+    QuantileSketch steal;           ///< Stolen time inside each task's turnaround
+    int64_t stolenTime;             ///< Time vCPUs were runnable without a pCPU
+    double stealPercent;            ///< stolenTime / (stolenTime + vCPU run time), in %
+    size_t criticalSections;        ///< Critical sections executed by guests
+    size_t preemptedSections;       ///< Sections during which the holder's vCPU lost its pCPU
+    int64_t lockHolderDelay;        ///< Total time added to lock hold times by steal
+    int maxLockHolderDelay;         ///< Largest delay of one section
+    double utilization;             ///< pCPU busy time / (pCPUs * makespan), in %
+    int makespan;                   ///< First arrival to last completion
+};
+
+/**
+ * @class HypervisorSimulator
+ * @brief Simulates VMs on a host, exchanging events between levels in one batch
+ *
+ * A vCPU has work exactly when its guest does, and for a work-conserving
+ * guest policy that depends only on the arrivals and bursts placed on it,
+ * not on the order the guest runs them. So the levels need to exchange
+ * little, and only once:
+ *
+ *  1. The host simulation sees each vCPU as a stream of (arrival, work)
+ *     and schedules vCPUs on pCPUs with the host policy, event by event.
+ *     Its output per vCPU is the list of intervals it was runnable but not
+ *     running: its steal intervals.
+ *  2. Every vCPU's guest Scheduler then runs independently, in parallel, in
+ *     guest time, which stops during steal: an arrival at real time t
+ *     enters at t minus the steal before t, and guest times map back to
+ *     real time by adding the steal that precedes them.
+ *
+ * No guest is paused or called back per host event, so a host with
+ * thousands of vCPUs costs one host pass, O(events log vCPUs), plus the
+ * guest runs. The mapping is exact for work-conserving guest policies
+ * without context switch overhead; guest schedulers should schedule one
+ * CPU each.
+ */
+class HypervisorSimulator {
+private:
+    HostConfig config;              ///< Host parameters
+    SchedulerFactory guestFactory;  ///< Creates each vCPU's guest scheduler
+    std::vector<int64_t> vcpuSteal; ///< Steal per vCPU, after run()
+
+public:
+    /**
+     * @brief Construct a host
+     *
+     * @param config Host parameters
+     * @param guestFactory Creates the guest scheduler of each vCPU (called from several threads)
+     */
+    HypervisorSimulator(const HostConfig& config, SchedulerFactory guestFactory);
+
+    /**
+     * @brief Simulate the VMs on the host
+     *
+     * The tasks are copied, so the same VMs can be run under several host
+     * configurations.
+     *
+     * @param vms Guests
+     * @return HypervisorMetrics Results over every guest task
+     */
+    HypervisorMetrics run(const std::vector<VirtualMachine>& vms);
+
+    /**
+     * @brief Steal time of each vCPU of the last run, VM by VM
+     */
+    const std::vector<int64_t>& getVcpuSteal() const { return vcpuSteal; }
+
+    /**
+     * @brief Host policy name
+     */
+    static std::string policyName(HostPolicy policy);
+};
+
+#endif // HYPERVISOR_SIMULATOR_H
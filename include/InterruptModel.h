@@ -0,0 +1,216 @@
+#ifndef INTERRUPT_MODEL_H
+#define INTERRUPT_MODEL_H
+
+#include "Process.h"
+#include "Workload.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file InterruptModel.h
+ * @brief Interrupt (hardirq + softirq) sources that steal CPU time from processes
+ *
+ * Interrupt handlers preempt whatever runs on a core, so on network-heavy
+ * hosts part of every core is not available to processes. An
+ * InterruptModel describes the sources of a machine; a Scheduler given a
+ * core of the model (Scheduler::setInterrupts) runs its processes on what
+ * the handlers leave of that core's time.
+ */
+
+/**
+ * @struct InterruptSource
+ * @brief One interrupt line (a NIC queue, a disk, the local timer, ...)
+ *
+ * Times may be fractional: a source raising one interrupt per time unit
+ * with 0.2 units of handling takes 20% of a core, and is simulated per
+ * interrupt, not per time unit.
+ */
+struct InterruptSource {
+    std::string name;                       ///< Label in reports
+    double meanInterarrival;                ///< Mean time between interrupts, over all its cores
+    BurstDistribution arrivalDistribution;  ///< CONSTANT = periodic, EXPONENTIAL = Poisson
+    double hardirqCost;                     ///< Mean handler (top half) time
+    double softirqCost;                     ///< Mean deferred (softirq) time, run right after the handler
+    BurstDistribution costDistribution;     ///< Shape of both costs
+    uint64_t affinity;                      ///< Cores it may interrupt, bit i = core i (0 = every core)
+};
+
+/**
+ * @class InterruptTimeline
+ * @brief Handler activity on one core, generated lazily, and the time mapping it implies
+ *
+ * Interrupts on the core are handled one at a time in arrival order; a run
+ * of back-to-back handlers is one busy period. Periods are generated only
+ * as far as queries need, event by event, so the cost is per interrupt and
+ * independent of the length of a time unit. Busy periods are rounded to
+ * whole time units with the rounding error carried forward, so the stolen
+ * total stays within one unit of the sampled handling time.
+ *
+ * Process time is real time minus the handler time before it: the time
+ * processes can use.
+ */
+class InterruptTimeline {
+private:
+    /**
+     * @struct Stream
+     * @brief Interrupts of one source that reach this core
+     */
+    struct Stream {
+        InterruptSource source;     ///< Source, with meanInterarrival scaled to this core
+        std::mt19937_64 engine;     ///< Arrival and cost draws
+    };
+
+    typedef std::pair<double, size_t> Pending;     ///< (next arrival, stream index)
+
+    std::vector<Stream> streams;                    ///< Sources affine to the core
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> pending;  ///< Next arrival per stream
+    std::vector<int64_t> realStarts;                ///< Busy period starts, real time
+    std::vector<int64_t> realEnds;                  ///< Busy period ends, real time
+    std::vector<int64_t> processStarts;             ///< Busy period starts, process time
+    int64_t stolen;                                 ///< Handler time of every period so far
+    double handled;                                 ///< Unrounded handler time so far
+    size_t interrupts;                              ///< Interrupts generated so far
+
+    /**
+     * @brief Draw a time of the given shape and mean
+     */
+    static double sample(BurstDistribution shape, double mean, double u);
+
+    /**
+     * @brief Generate the next busy period
+     *
+     * @return false if the core has no interrupt sources
+     */
+    bool generateNext();
+
+    /**
+     * @brief Generate until a period starts after @p realTime, or after
+     *        @p processTime in process time
+     */
+    void generateUntil(int64_t realTime, int64_t processTime);
+
+public:
+    /**
+     * @brief Construct the timeline of one core
+     *
+     * @param sources Sources affine to the core, rates already per core
+     * @param seed Seed of the core's draws
+     */
+    InterruptTimeline(const std::vector<InterruptSource>& sources, uint64_t seed);
+
+    /**
+     * @brief Process time at real time @p t (inside a busy period: its start)
+     */
+    int64_t toProcessTime(int64_t t);
+
+    /**
+     * @brief Real time of process time @p t
+     *
+     * A busy period starting exactly at @p t counts as after it unless
+     * @p afterHandlers: something that ends at @p t ends before the
+     * handlers run, and something that starts at @p t is preempted by them
+     * at once.
+     */
+    int64_t toRealTime(int64_t t, bool afterHandlers = false);
+    
+    /**
+     * @brief Handler time during a slice of process time
+     *
+     * Handlers at the slice's start preempt it; those at its end follow it.
+     *
+     * @param start Start of the slice, process time
+     * @param duration Length of the slice
+     */
+    int64_t handlerTimeDuring(int64_t start, int64_t duration);
+    
+    /**
+     * @brief Set the start and completion times of a finished process in real time
+     *
+     * Handler time outside the process's own slices adds to its waiting
+     * time; handler time before its arrival is not its own.
+     *
+     * @param process Process with its start time still in process time
+     * @param completion Its completion, process time
+     */
+    void completeInRealTime(Process& process, int64_t completion);
+
+    /**
+     * @brief Interrupts generated so far
+     */
+    size_t getInterruptCount() const { return interrupts; }
+
+    /**
+     * @brief Handler time of the busy periods generated so far
+     */
+    int64_t getStolenTime() const { return stolen; }
+};
+
+/**
+ * @class InterruptModel
+ * @brief Interrupt sources of a machine and their affinity to its cores
+ *
+ * A source allowed on several cores is spread evenly over them, as
+ * receive-side scaling or irqbalance would: each of m allowed cores sees
+ * 1/m of its interrupts. Each core's interrupts come from their own
+ * seeded streams, so a core's timeline does not depend on the others.
+ */
+class InterruptModel {
+private:
+    int cores;                              ///< Cores of the machine
+    uint64_t seed;                          ///< Base seed
+    std::vector<InterruptSource> sources;   ///< Sources
+
+    /**
+     * @brief Sources affine to @p core, with interarrival times scaled to the core
+     */
+    std::vector<InterruptSource> sourcesOn(int core) const;
+
+public:
+    /**
+     * @brief Construct a machine without interrupt sources
+     *
+     * @param cores Cores (at least 1, at most 64)
+     * @param seed Seed of every interrupt stream
+     */
+    explicit InterruptModel(int cores = 1, uint64_t seed = 1);
+
+    /**
+     * @brief Add a source
+     *
+     * @return false if its interarrival time is not positive, a cost is
+     *         negative, or its affinity names none of the cores
+     */
+    bool addSource(const InterruptSource& source);
+
+    /**
+     * @brief Share of @p core's time the handlers take on average
+     */
+    double coreLoad(int core) const;
+
+    /**
+     * @brief Start the timeline of one core
+     *
+     * @return std::shared_ptr<InterruptTimeline> Timeline, or nullptr if
+     *         @p core does not exist or its handlers need the whole core
+     */
+    std::shared_ptr<InterruptTimeline> createTimeline(int core) const;
+
+    /**
+     * @brief Number of cores
+     */
+    int getCores() const { return cores; }
+
+    /**
+     * @brief Sources, in the order added
+     */
+    const std::vector<InterruptSource>& getSources() const { return sources; }
+};
+
+#endif // INTERRUPT_MODEL_H
@@ -0,0 +1,87 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include "QuantileSketch.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file LatencyHistogram.h
+ * @brief Scheduling latency (READY to RUNNING delay) per priority class
+ *
+ * Response time only covers a process's first dispatch. A process that is
+ * preempted, blocks on a lock or is requeued at the end of every quantum
+ * waits again each time it becomes ready, and it is the tail of those
+ * waits that users notice (runqlat, perf sched latency). Every scheduler
+ * records each READY -> RUNNING delay here, split by priority class.
+ */
+
+/**
+ * @class LatencyHistogram
+ * @brief One QuantileSketch per priority class, plus one over all classes
+ *
+ * Classes are the processes' priority values. Sketches are kept in a
+ * vector indexed from the lowest class seen, so recording a delay is O(1)
+ * apart from the occasional growth of that vector. Histograms with the
+ * same accuracy merge exactly, class by class, so per-run, per-CPU or
+ * per-replica histograms can be combined in any order.
+ */
+class LatencyHistogram {
+private:
+    double relativeAccuracy;                ///< Accuracy of every sketch
+    std::vector<QuantileSketch> classes;    ///< classes[i] = class lowest + i
+    int lowest;                             ///< Class of classes[0]
+    QuantileSketch all;                     ///< Every delay, whatever its class
+
+    /**
+     * @brief Sketch of @p priorityClass, created if missing
+     */
+    QuantileSketch& sketchFor(int priorityClass);
+
+public:
+    /**
+     * @brief Construct an empty histogram
+     *
+     * @param relativeAccuracy Maximum relative error of quantiles, in (0, 1)
+     */
+    explicit LatencyHistogram(double relativeAccuracy = QuantileSketch::DEFAULT_ACCURACY);
+
+    /**
+     * @brief Record one READY -> RUNNING delay
+     */
+    void record(int priorityClass, double latency);
+
+    /**
+     * @brief Add every delay of another histogram with the same accuracy
+     *
+     * @return bool false (and nothing merged) if the accuracies differ
+     */
+    bool merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Forget every delay
+     */
+    void clear();
+
+    /**
+     * @brief Classes with at least one delay, lowest (most urgent) first
+     */
+    std::vector<int> getClasses() const;
+
+    /**
+     * @brief Delays of one class (an empty sketch if it has none)
+     */
+    const QuantileSketch& forClass(int priorityClass) const;
+
+    /**
+     * @brief Delays of every class
+     */
+    const QuantileSketch& overall() const { return all; }
+
+    /**
+     * @brief Number of delays recorded
+     */
+    uint64_t count() const { return all.count(); }
+};
+
+#endif // LATENCY_HISTOGRAM_H
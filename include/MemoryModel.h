@@ -0,0 +1,215 @@
+#ifndef MEMORY_MODEL_H
+#define MEMORY_MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+/**
+ * @file MemoryModel.h
+ * @brief Host memory capacity, swap slowdown and memory-aware admission
+ *
+ * Processes declare a resident set size (Process::setResidentSetSize). A
+ * Scheduler given a MemoryConfig (Scheduler::setMemory) charges each
+ * admitted process's RSS to the host and releases it on completion. With
+ * admission control on, a process whose RSS would push the host past its
+ * limit is held back until enough memory is free; without it everything is
+ * admitted and, once the working sets of the admitted processes exceed
+ * physical memory, they page against each other and make less progress
+ * (thrashing). MemoryAdmission is the part of this a Scheduler owns.
+ */
+
+/**
+ * @struct MemoryConfig
+ * @brief Host memory and how the scheduler treats it
+ *
+ * Sizes are in whatever unit the processes' RSS uses (e.g. MiB).
+ */
+struct MemoryConfig {
+    int64_t capacity;           ///< Physical memory (> 0)
+    double admissionLimit;      ///< Admit while resident <= limit * capacity (0 = admit everything)
+    double workingSetFraction;  ///< Share of its RSS a process touches all the time (0..1]
+    double swapPenalty;         ///< Slowdown per unit of working set that does not fit, relative to the working set
+
+    MemoryConfig() : capacity(1024), admissionLimit(1.0), workingSetFraction(0.5), swapPenalty(20.0) {}
+};
+
+/**
+ * @class MemoryAccount
+ * @brief Running totals of charged memory, updated per admission and completion
+ *
+ * Every query is O(1): the totals are adjusted when a process is charged
+ * or released, never recomputed from the process set.
+ *
+ * Swap model: with a total working set W above the capacity C, the part
+ * W - C is paged in and out continuously and every access to it faults.
+ * Processes then run at 1 / (1 + swapPenalty * (W - C) / W) of full speed,
+ * so progress collapses quickly as the overflow grows, as it does on a
+ * thrashing host. At or below capacity processes run at full speed.
+ */
+class MemoryAccount {
+private:
+    MemoryConfig config;    ///< Host memory parameters
+    int64_t resident;       ///< RSS of the charged processes
+    int64_t workingSet;     ///< Working sets of the charged processes
+
+    /**
+     * @brief Working set of a process of RSS @p rss
+     */
+    int64_t workingSetOf(int64_t rss) const;
+
+public:
+    /**
+     * @brief Construct an empty host
+     */
+    explicit MemoryAccount(const MemoryConfig& config = MemoryConfig());
+
+    /**
+     * @brief Whether the parameters make sense
+     *
+     * @return false if the capacity is not positive, the admission limit is
+     *         negative, the working-set fraction is outside (0, 1] or the
+     *         penalty is negative
+     */
+    static bool isValid(const MemoryConfig& config);
+
+    /**
+     * @brief Whether admission control lets a process of RSS @p rss in now
+     *
+     * Always true without admission control, and when nothing is charged,
+     * so a process larger than the limit runs alone rather than never.
+     */
+    bool admits(int64_t rss) const;
+
+    /**
+     * @brief Add an admitted process's memory
+     */
+    void charge(int64_t rss);
+
+    /**
+     * @brief Remove a finished process's memory
+     */
+    void release(int64_t rss);
+
+    /**
+     * @brief Progress per time unit under the current working set, in thousandths
+     */
+    int speed() const;
+
+    /**
+     * @brief Forget every charge
+     */
+    void clear();
+
+    /**
+     * @brief RSS of the charged processes
+     */
+    int64_t getResident() const { return resident; }
+
+    /**
+     * @brief Working sets of the charged processes
+     */
+    int64_t getWorkingSet() const { return workingSet; }
+
+    /**
+     * @brief Host memory parameters
+     */
+    const MemoryConfig& getConfig() const { return config; }
+};
+
+/**
+ * @class MemoryAdmission
+ * @brief A MemoryAccount plus the processes admission control holds back
+ *
+ * Processes are named by their index in the scheduler. One that would push
+ * the charged RSS past the limit is held back, and so is every process
+ * arriving while others are held, so large processes are not starved by
+ * smaller ones; completions let them in, in the order they were held.
+ * Pressure-stall time is the time at least one process was held, plus the
+ * time the policy reports running processes slowed by swapping.
+ */
+class MemoryAdmission {
+private:
+    /**
+     * @struct Held
+     * @brief A process waiting for memory
+     */
+    struct Held {
+        size_t index;   ///< Process index
+        int64_t rss;    ///< Its RSS
+        int since;      ///< Time it was held back
+    };
+    
+    MemoryAccount account;      ///< Memory of the admitted processes
+    std::deque<Held> held;      ///< Processes held back, FIFO
+    std::vector<char> charged;  ///< Per process index: RSS charged to the host
+    int heldQueueSince;         ///< Time held last became non-empty (-1 = empty)
+    int64_t pressureTime;       ///< Time some process stalled on memory
+
+public:
+    /**
+     * @brief Construct an empty host
+     */
+    explicit MemoryAdmission(const MemoryConfig& config = MemoryConfig());
+    
+    /**
+     * @brief Forget every charge and hold before a run of @p processes processes
+     */
+    void reset(size_t processes);
+    
+    /**
+     * @brief Charge a process's memory, or hold it back if it does not fit
+     *
+     * A process already charged (let in by release()) is admitted at once.
+     *
+     * @param index Process index
+     * @param rss Its RSS
+     * @param now Current time
+     * @return true if the process may be admitted now
+     */
+    bool admit(size_t index, int64_t rss, int now);
+    
+    /**
+     * @brief Release a finished process's memory and let held processes in
+     *        while they fit, in the order they were held back
+     *
+     * The processes let in are charged already.
+     *
+     * @param rss RSS of the finished process
+     * @param now Current time
+     * @return (process index, time it was held) of each process let in
+     */
+    std::vector<std::pair<size_t, int>> release(int64_t rss, int now);
+    
+    /**
+     * @brief Whether a process is held back
+     */
+    bool holding() const { return !held.empty(); }
+    
+    /**
+     * @brief Progress per time unit under the current working set, in thousandths
+     */
+    int speed() const { return account.speed(); }
+    
+    /**
+     * @brief Count time during which running processes were slowed by swapping
+     *
+     * Call only for time when no process was held back, which is already
+     * counted.
+     */
+    void addPressureTime(int duration) { pressureTime += duration; }
+    
+    /**
+     * @brief Time since reset() at least one process stalled on memory
+     */
+    int64_t getPressureTime() const { return pressureTime; }
+    
+    /**
+     * @brief Memory of the admitted processes
+     */
+    const MemoryAccount& getAccount() const { return account; }
+};
+
+#endif // MEMORY_MODEL_H
@@ -0,0 +1,241 @@
+#ifndef MONTE_CARLO_COMPARISON_H
+#define MONTE_CARLO_COMPARISON_H
+
+#include "Scheduler.h"
+#include "Workload.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file MonteCarloComparison.h
+ * @brief Statistical comparison of scheduling policies over random workloads
+ *
+ * Runs every registered policy on K workload replicas drawn from the same
+ * distribution and reports the mean and confidence interval of each metric,
+ * together with paired-difference tests between policies. All policies see
+ * exactly the same replicas (common random numbers), which removes workload
+ * variance from the differences and makes them far tighter than the
+ * individual intervals.
+ */
+
+/**
+ * @brief Factory producing a freshly configured scheduler
+ *
+ * Called once per replica and policy, possibly from several threads at once,
+ * so it must not share mutable state between the schedulers it returns.
+ */
+using SchedulerFactory = std::function<std::unique_ptr<Scheduler>()>;
+
+/**
+ * @enum ComparisonMetric
+ * @brief Metrics from SchedulingMetrics that are estimated
+ */
+enum class ComparisonMetric {
+    WAITING_TIME,
+    TURNAROUND_TIME,
+    RESPONSE_TIME,
+    CPU_UTILIZATION,
+    THROUGHPUT,
+    CONTEXT_SWITCHES
+};
+
+/**
+ * @struct MonteCarloConfig
+ * @brief Replication and stopping parameters
+ *
+ * Replicas are run in batches of batchSize. Once minReplicas have been run,
+ * the experiment stops as soon as the confidence interval of every policy's
+ * waiting, turnaround and response time is within relativePrecision of its
+ * mean, or when stopOnSeparation is set and every policy is significantly
+ * different from the best one on primaryMetric. It never exceeds maxReplicas.
+ */
+struct MonteCarloConfig {
+    int minReplicas;                    ///< Replicas always run
+    int maxReplicas;                    ///< Hard upper bound on replicas
+    int batchSize;                      ///< Replicas between stopping checks
+    double confidenceLevel;             ///< Two-sided confidence level (e.g. 0.95)
+    double relativePrecision;           ///< Target half-width / |mean|
+    bool stopOnSeparation;              ///< Also stop once all policies are separated
+    ComparisonMetric primaryMetric;     ///< Metric used for separation and ranking
+    int numThreads;                     ///< Worker threads (0 = hardware concurrency)
+    uint64_t baseSeed;                  ///< Seed from which replica seeds are derived
+
+    MonteCarloConfig()
+        : minReplicas(10), maxReplicas(500), batchSize(10),
+          confidenceLevel(0.95), relativePrecision(0.05), stopOnSeparation(true),
+          primaryMetric(ComparisonMetric::TURNAROUND_TIME),
+          numThreads(0), baseSeed(1) {}
+};
+
+/**
+ * @struct IntervalEstimate
+ * @brief Sample mean with a Student-t confidence interval
+ */
+struct IntervalEstimate {
+    double mean;        ///< Sample mean
+    double stddev;      ///< Sample standard deviation
+    double halfWidth;   ///< Half-width of the confidence interval
+    int samples;        ///< Number of samples
+
+    IntervalEstimate() : mean(0), stddev(0), halfWidth(0), samples(0) {}
+
+    double lower() const { return mean - halfWidth; }
+    double upper() const { return mean + halfWidth; }
+};
+
+/**
+ * @struct PolicyStatistics
+ * @brief Interval estimates of every metric for one policy
+ */
+struct PolicyStatistics {
+    std::string name;                       ///< Policy label
+    std::vector<IntervalEstimate> metrics;  ///< Indexed by ComparisonMetric
+};
+
+/**
+ * @struct PairedComparison
+ * @brief Paired difference (policy - baseline) of one metric over all replicas
+ */
+struct PairedComparison {
+    std::string policy;             ///< Policy label
+    std::string baseline;           ///< Baseline policy label
+    ComparisonMetric metric;        ///< Compared metric
+    IntervalEstimate difference;    ///< Interval of the per-replica difference
+    double tStatistic;              ///< Paired t statistic
+    bool significant;               ///< Interval excludes zero
+};
+
+/**
+ * @class MonteCarloComparison
+ * @brief Replicated, parallel comparison of scheduling policies
+ *
+ * Replicas are distributed over worker threads; each replica's workload is
+ * generated once and copied into every policy. Results are stored by replica
+ * index, so the estimates do not depend on the number of threads.
+ */
+class MonteCarloComparison {
+private:
+    WorkloadGenerator generator;                        ///< Replica source
+    MonteCarloConfig config;                            ///< Replication parameters
+    std::vector<std::string> policyNames;               ///< Policy labels
+    std::vector<SchedulerFactory> factories;            ///< Policy factories
+    std::vector<std::vector<SchedulingMetrics>> samples; ///< [policy][replica] results
+    int replicasRun;                                    ///< Replicas completed so far
+    bool stoppedEarly;                                  ///< Stopping rule fired before maxReplicas
+
+    /**
+     * @brief Run replicas [first, last) for every policy in parallel
+     */
+    void runBatch(int first, int last);
+
+    /**
+     * @brief Evaluate the adaptive stopping rule on the samples so far
+     *
+     * @return true if the experiment may stop
+     */
+    bool shouldStop() const;
+
+public:
+    /**
+     * @brief Construct a comparison over the given workload distribution
+     *
+     * @param distribution Distribution replicas are drawn from
+     * @param config Replication and stopping parameters
+     */
+    MonteCarloComparison(const WorkloadDistribution& distribution,
+                         const MonteCarloConfig& config = MonteCarloConfig());
+
+    /**
+     * @brief Register a policy
+     *
+     * @param name Label used in reports
+     * @param factory Factory creating a configured scheduler
+     */
+    void addPolicy(const std::string& name, SchedulerFactory factory);
+
+    /**
+     * @brief Run replicas until the stopping rule fires or maxReplicas is reached
+     */
+    void run();
+
+    /**
+     * @brief Get the interval estimates of every policy
+     *
+     * @return std::vector<PolicyStatistics> One entry per policy, in registration order
+     */
+    std::vector<PolicyStatistics> getStatistics() const;
+
+    /**
+     * @brief Compare every policy against a baseline on every metric
+     *
+     * @param baselineIndex Registration index of the baseline policy
+     * @return std::vector<PairedComparison> One entry per (policy, metric)
+     */
+    std::vector<PairedComparison> getPairedComparisons(size_t baselineIndex = 0) const;
+
+    /**
+     * @brief Get the raw per-replica metrics of one policy
+     *
+     * @param policyIndex Registration index
+     * @return const std::vector<SchedulingMetrics>& Metrics by replica index
+     */
+    const std::vector<SchedulingMetrics>& getSamples(size_t policyIndex) const {
+        return samples[policyIndex];
+    }
+
+    /**
+     * @brief Number of replicas run
+     */
+    int getReplicasRun() const { return replicasRun; }
+
+    /**
+     * @brief Whether the adaptive stopping rule ended the run
+     */
+    bool stoppedAdaptively() const { return stoppedEarly; }
+
+    /**
+     * @brief Print interval estimates and paired comparisons against the best policy
+     */
+    void displayResults() const;
+
+    /**
+     * @brief Extract one metric from a SchedulingMetrics record
+     */
+    static double metricValue(const SchedulingMetrics& metrics, ComparisonMetric metric);
+
+    /**
+     * @brief Human-readable name of a metric
+     */
+    static std::string metricName(ComparisonMetric metric);
+
+    /**
+     * @brief Whether lower values of the metric are better
+     */
+    static bool lowerIsBetter(ComparisonMetric metric);
+};
+
+/**
+ * @brief Build a Student-t interval estimate from samples
+ *
+ * @param values Samples
+ * @param confidenceLevel Two-sided confidence level
+ * @return IntervalEstimate Mean, standard deviation and half-width
+ */
+IntervalEstimate estimateInterval(const std::vector<double>& values, double confidenceLevel);
+
+/**
+ * @brief Two-sided Student-t critical value
+ *
+ * Uses a normal quantile refined with the Cornish-Fisher expansion, which is
+ * accurate to about 1e-3 for three or more degrees of freedom.
+ *
+ * @param confidenceLevel Two-sided confidence level in (0, 1)
+ * @param degreesOfFreedom Degrees of freedom (at least 1)
+ * @return double Critical value t such that P(|T| <= t) = confidenceLevel
+ */
+double studentTCritical(double confidenceLevel, int degreesOfFreedom);
+
+#endif // MONTE_CARLO_COMPARISON_H
@@ -64,6 +64,13 @@ private:
      */
     void promoteProcess(std::shared_ptr<Process> process);
     
+    /**
+     * @brief Admit arrived processes and append them to their level's queue
+     * 
+     * Arrivals are appended in tie-break order (arrival, PID, seeded key).
+     */
+    void enqueueArrivals();
+    
     /**
      * @brief Apply aging mechanism to prevent starvation
      * 
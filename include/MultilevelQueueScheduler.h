@@ -61,6 +61,23 @@ private:
      */
     int getHighestPriorityQueue();
     
+    /**
+     * @brief Find the queue a process belongs to
+     * 
+     * @param process Process to place
+     * @return int Priority level of the first queue covering the process
+     *         priority, the lowest priority queue if none does, or -1 if
+     *         no queues are configured
+     */
+    int getTargetQueue(const std::shared_ptr<Process>& process) const;
+    
+    /**
+     * @brief Admit arrived processes and append them to their queues
+     * 
+     * Arrivals are appended in tie-break order (arrival, PID, seeded key).
+     */
+    void enqueueArrivals();
+    
     /**
      * @brief Schedule process from a specific queue using its algorithm
      * 
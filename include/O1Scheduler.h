@@ -0,0 +1,180 @@
+#ifndef O1_SCHEDULER_H
+#define O1_SCHEDULER_H
+
+#include "Scheduler.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file O1Scheduler.h
+ * @brief Linux 2.6-style O(1) scheduler with active and expired priority arrays
+ *
+ * Models the scheduler Linux used from 2.6.0 to 2.6.22: 140 priority lists
+ * in an active and an expired array, a bitmap per array to find the best
+ * list, an array swap when the active array runs empty, and an interactivity
+ * bonus from sleep time. It sits between MultilevelFeedbackQueueScheduler
+ * and a fair-share scheduler when studying legacy kernels.
+ */
+
+/**
+ * @class O1Scheduler
+ * @brief Implements the Linux 2.6 O(1) CPU scheduler
+ *
+ * Process::priority is read as a nice value (clamped to -20..19), giving a
+ * static priority of 120 + nice; lower numbers are better, as everywhere in
+ * this simulator. The timeslice follows the 2.6 formula scaled to
+ * baseTimeslice: nice 0 gets baseTimeslice, negative nice values get up to
+ * eight times as much, positive ones down to one unit.
+ *
+ * The dynamic priority is the static priority minus a bonus of -5..+5
+ * derived from the average sleep time (sleep_avg). Time on the CPU drains
+ * sleep_avg. Time spent sleeping fills it, and the simulator has no I/O
+ * waits, so sleep is the time a newly woken (arrived) task waits on the
+ * runqueue, credited at 30% as in 2.6. Tasks that arrive have no parent to
+ * inherit from and start with a neutral bonus.
+ *
+ * When a task's timeslice runs out it gets a new timeslice and moves to the
+ * expired array, unless it is interactive and the expired array is not
+ * starving, in which case it goes back into the active array. An arrival
+ * with a better dynamic priority preempts the running task, which keeps the
+ * rest of its timeslice.
+ *
+ * Every operation is O(1) in the number of tasks: lists are intrusive,
+ * the best list is found by scanning three bitmap words, and waiting time
+ * and sleep credit are charged from timestamps when a task is picked.
+ */
+class O1Scheduler : public Scheduler {
+private:
+    static constexpr int MAX_RT_PRIO = 100;         ///< First non-real-time priority
+    static constexpr int MAX_PRIO = 140;            ///< Number of priority lists
+    static constexpr int NICE_0_PRIO = 120;         ///< Static priority of nice 0
+    static constexpr int MAX_BONUS = 10;            ///< Width of the bonus range (-5..+5)
+    static constexpr int INTERACTIVE_DELTA = 2;     ///< Bonus needed to count as interactive at nice 0
+    static constexpr int ON_RUNQUEUE_WEIGHT = 30;   ///< Percent of runqueue wait credited as sleep
+    static constexpr int BITMAP_WORDS = (MAX_PRIO + 63) / 64;  ///< 64-bit words per bitmap
+
+    /**
+     * @struct PrioArray
+     * @brief One priority array: 140 FIFO lists plus an occupancy bitmap
+     */
+    struct PrioArray {
+        int nrActive;                   ///< Tasks in this array
+        uint64_t bitmap[BITMAP_WORDS];  ///< Bit p set if list p is non-empty
+        int head[MAX_PRIO];             ///< First task per list (-1 = empty)
+        int tail[MAX_PRIO];             ///< Last task per list (-1 = empty)
+    };
+
+    /**
+     * @struct Task
+     * @brief Per-process scheduling state
+     */
+    struct Task {
+        int staticPrio;     ///< 120 + nice
+        int prio;           ///< Dynamic priority
+        int timeSlice;      ///< Remaining timeslice
+        int sleepAvg;       ///< Average sleep time, 0..maxSleepAvg
+        int enqueuedAt;     ///< Time the task last entered a runqueue
+        bool activated;     ///< Woken up and not yet run (earns sleep credit)
+        int next;           ///< Next task in the same list (-1 = none)
+    };
+
+    int baseTimeslice;                              ///< Timeslice of a nice-0 task
+    int maxSleepAvg;                                ///< Cap of sleepAvg (10 base timeslices)
+    int starvationLimit;                            ///< Expired-array wait per runnable task
+    PrioArray arrays[2];                            ///< Storage for the two arrays
+    PrioArray* active;                              ///< Array tasks are picked from
+    PrioArray* expired;                             ///< Tasks whose timeslice ran out
+    std::vector<Task> tasks;                        ///< Indexed like 'processes'
+    std::unordered_map<const Process*, int> taskIndex;  ///< Process -> index in 'tasks'
+    int nrRunning;                                  ///< Runnable tasks, including the running one
+    int expiredTimestamp;                           ///< First expiry since the last swap (-1 = none)
+    int arraySwitches;                              ///< Number of active/expired swaps
+    std::vector<std::string> ganttChart;            ///< Execution timeline
+
+    /**
+     * @brief Clear a priority array
+     */
+    static void clearArray(PrioArray& array);
+
+    /**
+     * @brief Append (or prepend) a task to the list of its dynamic priority
+     */
+    void enqueueTask(PrioArray& array, int task, bool atHead);
+
+    /**
+     * @brief Remove and return the first task of the best non-empty list
+     *
+     * @return int Task index, or -1 if the array is empty
+     */
+    int dequeueBest(PrioArray& array);
+
+    /**
+     * @brief Dynamic priority: static priority minus the sleep bonus
+     */
+    int effectivePrio(const Task& task) const;
+
+    /**
+     * @brief Whether a task's bonus makes it interactive (TASK_INTERACTIVE)
+     */
+    bool isInteractive(const Task& task) const;
+
+    /**
+     * @brief Whether tasks in the expired array have waited too long
+     */
+    bool expiredStarving() const;
+
+public:
+    /**
+     * @brief Construct a new O(1) Scheduler
+     *
+     * @param baseTimeslice Timeslice of a nice-0 task (default: 4)
+     * @param contextSwitchOverhead Context switch time cost (default: 0)
+     */
+    explicit O1Scheduler(int baseTimeslice = 4, int contextSwitchOverhead = 0);
+
+    /**
+     * @brief Get the name of this scheduling algorithm
+     *
+     * @return std::string "O(1) Scheduler (Base Timeslice=N)"
+     */
+    std::string getName() const override;
+
+    /**
+     * @brief Execute O(1) scheduling simulation
+     *
+     * Event-driven: the running task runs until it completes, its timeslice
+     * expires or a process arrives.
+     */
+    void schedule() override;
+
+    /**
+     * @brief Get visual Gantt chart of execution
+     *
+     * @return std::string Formatted timeline showing process execution order
+     */
+    std::string getGanttChart() const override;
+
+    /**
+     * @brief Number of active/expired array swaps in the last run
+     */
+    int getArraySwitches() const { return arraySwitches; }
+
+    /**
+     * @brief Static priority (100..139) of a process priority
+     *
+     * @param priority Process::priority, read as a nice value
+     * @return int 120 + clamped nice
+     */
+    static int staticPriority(int priority);
+
+    /**
+     * @brief Timeslice of a static priority
+     *
+     * @param staticPrio Static priority (100..139)
+     * @return int Timeslice in time units (at least 1)
+     */
+    int timeslice(int staticPrio) const;
+};
+
+#endif // O1_SCHEDULER_H
@@ -0,0 +1,42 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * @file ParallelFor.h
+ * @brief Worker threads over independent items
+ *
+ * Replicas (and any other independent runs) are simulated each into its
+ * own result slot. These helpers size the pool and fan the items out; the
+ * calling thread is one of the workers, so a single thread runs everything
+ * inline. If an item throws, the remaining items are abandoned, every
+ * thread is joined and the first exception is rethrown to the caller.
+ */
+
+/**
+ * @brief Worker threads for @p items units of work
+ *
+ * @param requested Threads asked for (0 or less = hardware concurrency)
+ * @param items Units of work
+ * @return int Between 1 and max(1, items)
+ */
+int workerThreads(int requested, size_t items);
+
+/**
+ * @brief Call @p body(k) for every k in [0, items) on @p threads threads
+ *
+ * Items are claimed one at a time, so uneven items balance themselves.
+ * The order in which items run is unspecified.
+ */
+void parallelFor(size_t items, int threads, const std::function<void(size_t)>& body);
+
+/**
+ * @brief Call @p body(begin, end) on one contiguous block per thread
+ *
+ * For items too cheap to claim one by one.
+ */
+void parallelForBlocks(size_t items, int threads, const std::function<void(size_t, size_t)>& body);
+
+#endif // PARALLEL_FOR_H
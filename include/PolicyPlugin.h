@@ -0,0 +1,126 @@
+#ifndef POLICY_PLUGIN_H
+#define POLICY_PLUGIN_H
+
+#include "Scheduler.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @file PolicyPlugin.h
+ * @brief Versioned ABI for scheduling policies loaded at runtime with dlopen
+ *
+ * A plugin is a shared object built against these headers that exports one
+ * C function, scheduler_plugin_info(), returning a SchedulerPluginInfo. The
+ * factory in it returns an ordinary Scheduler subclass (possibly an
+ * ExtScheduler<Policy>), so the simulation loop runs as compiled code inside
+ * the plugin and every scheduling decision costs the same as in a built-in
+ * policy; only schedule() itself is reached through one indirect call, as
+ * for built-ins.
+ *
+ * Plugins resolve Scheduler's out-of-line members from the executable,
+ * which is therefore linked with -rdynamic.
+ */
+
+/// Bump whenever Scheduler, Process or SchedulerPluginInfo change incompatibly
+#define SCHEDULER_PLUGIN_ABI_VERSION 12
+
+/// Name of the function every plugin exports
+#define SCHEDULER_PLUGIN_ENTRY "scheduler_plugin_info"
+
+/**
+ * @struct SchedulerPluginInfo
+ * @brief What a plugin exports
+ */
+struct SchedulerPluginInfo {
+    uint32_t abiVersion;        ///< SCHEDULER_PLUGIN_ABI_VERSION the plugin was built with
+    size_t schedulerSize;       ///< sizeof(Scheduler) the plugin was built with
+    size_t processSize;         ///< sizeof(Process) the plugin was built with
+    const char* name;           ///< Policy name for menus and reports
+    const char* description;    ///< One-line description
+    Scheduler* (*create)(const char* args);  ///< New scheduler; args is plugin-defined ("" = defaults)
+};
+
+/// Signature of scheduler_plugin_info()
+typedef const SchedulerPluginInfo* (*SchedulerPluginEntry)();
+
+/**
+ * @brief Define scheduler_plugin_info() in a plugin source file
+ *
+ * @param NAME Policy name (string literal)
+ * @param DESCRIPTION One-line description (string literal)
+ * @param CREATE Function Scheduler* (const char* args)
+ */
+#define EXPORT_SCHEDULER_PLUGIN(NAME, DESCRIPTION, CREATE)                           \
+    extern "C" __attribute__((visibility("default")))                                \
+    const SchedulerPluginInfo* scheduler_plugin_info() {                             \
+        static const SchedulerPluginInfo info = {                                    \
+            SCHEDULER_PLUGIN_ABI_VERSION, sizeof(Scheduler), sizeof(Process),        \
+            NAME, DESCRIPTION, CREATE                                                \
+        };                                                                           \
+        return &info;                                                                \
+    }
+
+/**
+ * @class PolicyPlugin
+ * @brief A loaded policy plugin
+ *
+ * The library stays loaded as long as the PolicyPlugin exists; schedulers
+ * it created must be destroyed first. Sweeps keep it alive by capturing the
+ * shared pointer in their factory.
+ */
+class PolicyPlugin {
+private:
+    void* handle;                       ///< dlopen handle
+    const SchedulerPluginInfo* info;    ///< Exported plugin description
+    std::string path;                   ///< File the plugin was loaded from
+
+    /**
+     * @brief Wrap an opened and validated library
+     */
+    PolicyPlugin(void* handle, const SchedulerPluginInfo* info, const std::string& path);
+
+public:
+    /**
+     * @brief Open a plugin and check its ABI
+     *
+     * @param path Path of the shared object
+     * @param error Receives the reason if loading fails
+     * @return std::shared_ptr<PolicyPlugin> The plugin, or nullptr on failure
+     */
+    static std::shared_ptr<PolicyPlugin> load(const std::string& path, std::string& error);
+
+    /**
+     * @brief Close the library
+     */
+    ~PolicyPlugin();
+
+    PolicyPlugin(const PolicyPlugin&) = delete;
+    PolicyPlugin& operator=(const PolicyPlugin&) = delete;
+
+    /**
+     * @brief Create a scheduler from the plugin
+     *
+     * @param args Plugin-defined arguments ("" = defaults)
+     * @return std::unique_ptr<Scheduler> New scheduler, or nullptr if the plugin refused
+     */
+    std::unique_ptr<Scheduler> create(const std::string& args = "") const;
+
+    /**
+     * @brief Policy name exported by the plugin
+     */
+    std::string getName() const { return info->name; }
+
+    /**
+     * @brief Description exported by the plugin
+     */
+    std::string getDescription() const { return info->description != nullptr ? info->description : ""; }
+
+    /**
+     * @brief File the plugin was loaded from
+     */
+    const std::string& getPath() const { return path; }
+};
+
+#endif // POLICY_PLUGIN_H
@@ -4,6 +4,8 @@
 #include "Scheduler.h"
 #include <queue>
 #include <functional>
+#include <set>
+#include <unordered_map>
 
 /**
  * @file PriorityScheduler.h
@@ -13,6 +15,30 @@
  * Processes are selected based on priority values (lower number = higher priority).
  */
 
+/**
+ * @enum LockProtocol
+ * @brief How lock holders and waiters interact with priorities
+ */
+enum class LockProtocol {
+    NONE,           ///< Plain locks: a holder keeps its own priority (unbounded inversion)
+    INHERITANCE,    ///< Priority Inheritance: a holder runs at its best waiter's priority
+    CEILING         ///< Priority Ceiling: a lock is granted only above the system ceiling
+};
+
+/**
+ * @struct LockMetrics
+ * @brief Lock contention results of the last run
+ */
+struct LockMetrics {
+    size_t acquisitions;                ///< Locks granted
+    size_t contended;                   ///< Acquisitions that had to wait first
+    int64_t totalBlocking;              ///< Time processes spent blocked on locks
+    int maxWait;                        ///< Longest single wait for a lock
+    int64_t inversionTime;              ///< Time a process ran while a higher-priority one was blocked
+    size_t deadlocked;                  ///< Processes still blocked when the run ended
+    std::vector<size_t> waitHistogram;  ///< Bucket 0: waits of 0; bucket k: waits in [2^(k-1), 2^k)
+};
+
 /**
  * @class PriorityScheduler
  * @brief Implements priority-based CPU scheduling
@@ -22,6 +48,27 @@
  * and non-preemptive mode (running process completes its burst).
  * 
  * Includes aging mechanism to prevent starvation of low-priority processes.
+ * 
+ * The simulation is event-driven: a process runs until it completes, a
+ * process arrives or a timer fires, whichever comes first. Aging is a
+ * periodic timer at multiples of agingInterval that is cancelled while the
+ * CPU is idle and re-armed on wakeup, so idle gaps are skipped in one step.
+ *
+ * Processes may hold locks during parts of their burst (CriticalSection).
+ * A process that requests a held lock blocks (WAITING) in that lock's wait
+ * queue, ordered by effective priority; each lock keeps its own queue, so
+ * every queue operation is O(log waiters) however many locks exist. Lock
+ * requests and releases are events like arrivals: a process runs until
+ * its next one. Under INHERITANCE a released lock is handed to its best
+ * waiter, and a holder runs at the best priority waiting on any lock it
+ * holds, transitively along chains of blocked holders. Under CEILING
+ * (the original priority ceiling protocol) each lock's ceiling is the best
+ * priority of any process using it; a lock is granted only if the
+ * requester's priority is strictly better than every ceiling of a lock
+ * held by another process, otherwise the requester blocks on that lock and
+ * its holder inherits. Waiters are woken on release and retry, which rules
+ * out deadlock. Aging changes priorities at run time and is best disabled
+ * with CEILING, whose guarantees assume fixed priorities.
  */
 class PriorityScheduler : public Scheduler {
 private:
@@ -34,17 +81,23 @@ private:
      * @brief Custom comparator for priority queue
      * 
      * Compares processes based on priority (lower value = higher priority).
-     * Breaks ties using arrival time (earlier arrival = higher priority).
+     * Breaks ties with the scheduler-wide order: earlier arrival, then lower
+     * PID, then lower seeded key, so equal-priority selection never depends
+     * on std::priority_queue internals.
      */
     struct PriorityComparator {
+        uint64_t seed;  ///< Tie-break seed
+        
+        explicit PriorityComparator(uint64_t seed = 0) : seed(seed) {}
+        
         bool operator()(const std::shared_ptr<Process>& a, 
                        const std::shared_ptr<Process>& b) const {
-            // Lower priority number = higher priority
-            if (a->getPriority() != b->getPriority()) {
-                return a->getPriority() > b->getPriority();
+            // Lower priority number = higher priority; inherited priorities count
+            if (a->getEffectivePriority() != b->getEffectivePriority()) {
+                return a->getEffectivePriority() > b->getEffectivePriority();
             }
-            // Break ties with arrival time (earlier = higher priority)
-            return a->getArrivalTime() > b->getArrivalTime();
+            // Max-heap: a ranks lower when b goes first in tie-break order
+            return Scheduler::tieBreakBefore(seed, *b, *a);
         }
     };
     
@@ -52,6 +105,116 @@ private:
                        std::vector<std::shared_ptr<Process>>,
                        PriorityComparator> readyQueue;  ///< Priority-ordered ready queue
     
+    /**
+     * @struct WaitKey
+     * @brief Position of a blocked process in a lock's wait queue
+     */
+    struct WaitKey {
+        int priority;       ///< Effective priority when queued
+        int arrival;        ///< Arrival time (tie-break)
+        int pid;            ///< PID (tie-break)
+        size_t process;     ///< Process index
+        
+        bool operator<(const WaitKey& other) const {
+            if (priority != other.priority) return priority < other.priority;
+            if (arrival != other.arrival) return arrival < other.arrival;
+            if (pid != other.pid) return pid < other.pid;
+            return process < other.process;
+        }
+    };
+    
+    /**
+     * @struct LockState
+     * @brief One lock: holder, priority ceiling and wait queue
+     */
+    struct LockState {
+        int owner;                  ///< Holding process index (-1 = free)
+        int depth;                  ///< Nested acquisitions by the owner
+        int ceiling;                ///< Best priority of any process using the lock
+        std::set<WaitKey> waiters;  ///< Blocked processes, best first
+    };
+    
+    /**
+     * @struct HeldLock
+     * @brief A lock a process holds and when it lets go
+     */
+    struct HeldLock {
+        size_t lock;    ///< Lock slot
+        int releaseAt;  ///< Executed CPU time at which it is released
+    };
+    
+    /**
+     * @struct ProcessLocks
+     * @brief Per-process lock progress
+     */
+    struct ProcessLocks {
+        size_t nextSection;             ///< Next critical section to enter
+        std::vector<HeldLock> held;     ///< Locks held, innermost last
+        int waitingOn;                  ///< Lock slot blocked on (-1 = none)
+        WaitKey key;                    ///< Entry in that lock's wait queue
+        int waitStart;                  ///< When the current wait began (-1 = not waiting)
+        int blockedPriority;            ///< Own priority recorded in blockedPriorities
+    };
+    
+    LockProtocol lockProtocol;                                  ///< Lock protocol
+    std::vector<LockState> locks;                               ///< Lock table
+    std::unordered_map<int, size_t> lockSlots;                  ///< Lock identifier to slot
+    std::vector<ProcessLocks> processLocks;                     ///< Per process index
+    std::unordered_map<const Process*, size_t> processIndex;    ///< Process to index
+    std::set<std::pair<int, size_t>> heldCeilings;              ///< CEILING: (ceiling, slot) of held locks
+    std::multiset<int> blockedPriorities;                       ///< Own priorities of blocked processes
+    std::vector<int> blockingTimes;                             ///< Per process index: time blocked on locks
+    LockMetrics lockMetrics;                                    ///< Results of the last run
+    bool readyQueueDirty;                                       ///< A queued process changed priority
+    
+    /**
+     * @brief Build the lock table and reset lock progress for a run
+     */
+    void prepareLocks();
+    
+    /**
+     * @brief Release and request locks at the process's current progress
+     * 
+     * @return false if the process blocked on a lock
+     */
+    bool advanceLocks(size_t process);
+    
+    /**
+     * @brief Grant @p lock to @p process or block it
+     */
+    bool tryAcquire(size_t process, size_t lock);
+    
+    /**
+     * @brief Record a granted lock and end the current wait
+     */
+    void granted(size_t process, size_t lock);
+    
+    /**
+     * @brief Put the running process in @p lock's wait queue
+     */
+    void block(size_t process, size_t lock);
+    
+    /**
+     * @brief Move a blocked process back to the ready queue
+     */
+    void unblock(size_t process);
+    
+    /**
+     * @brief Release @p lock, handing it over or waking its waiters
+     */
+    void releaseLock(size_t process, size_t lock);
+    
+    /**
+     * @brief Recompute the inherited priority of @p process and pass a
+     *        change on along the chain of locks it waits for
+     */
+    void updateInheritance(size_t process);
+    
+    /**
+     * @brief CPU time @p process can run before its next lock event
+     */
+    int untilLockEvent(size_t process) const;
+    
     /**
      * @brief Apply priority aging to prevent starvation
      * 
@@ -59,6 +222,11 @@ private:
      * to ensure they eventually get CPU time.
      */
     void applyAging();
+    
+    /**
+     * @brief Re-heap the ready queue after priorities changed
+     */
+    void rebuildReadyQueue();
 
 public:
     /**
@@ -83,7 +251,8 @@ public:
      * @brief Execute priority scheduling simulation
      * 
      * Schedules processes based on priority values. In preemptive mode,
-     * checks for higher priority processes after each time unit.
+     * checks for higher priority processes whenever a process arrives or
+     * the aging timer fires.
      */
     void schedule() override;
     
@@ -93,6 +262,31 @@ public:
      * @return std::string Formatted timeline showing process execution order
      */
     std::string getGanttChart() const override;
+    
+    /**
+     * @brief Choose the lock protocol (default NONE)
+     */
+    void setLockProtocol(LockProtocol protocol) { lockProtocol = protocol; }
+    
+    /**
+     * @brief Get the lock protocol
+     */
+    LockProtocol getLockProtocol() const { return lockProtocol; }
+    
+    /**
+     * @brief Lock contention results of the last run
+     */
+    const LockMetrics& getLockMetrics() const { return lockMetrics; }
+    
+    /**
+     * @brief Time each process spent blocked on locks (same order as getProcesses())
+     */
+    const std::vector<int>& getBlockingTimes() const { return blockingTimes; }
+    
+    /**
+     * @brief Protocol name
+     */
+    static std::string lockProtocolName(LockProtocol protocol);
 };
 
 #endif // PRIORITY_SCHEDULER_H
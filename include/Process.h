@@ -1,7 +1,9 @@
 #ifndef PROCESS_H
 #define PROCESS_H
 
+#include <climits>
 #include <string>
+#include <vector>
 
 /**
  * @file Process.h
@@ -30,6 +32,20 @@ enum class ProcessState {
     TERMINATED
 };
 
+/**
+ * @struct CriticalSection
+ * @brief A span of a CPU burst during which the process holds a lock
+ *
+ * The lock is requested once the process has executed @c start units of
+ * its burst and released after @c length more units (or at the end of the
+ * burst). Sections may nest.
+ */
+struct CriticalSection {
+    int lock;       ///< Lock identifier
+    int start;      ///< CPU time executed when the lock is requested
+    int length;     ///< CPU time the lock is held
+};
+
 /**
  * @class Process
  * @brief Represents a single process in the CPU scheduling simulation
@@ -46,6 +62,7 @@ private:
     int burstTime;              ///< Total CPU time required by the process
     int remainingTime;          ///< Remaining CPU time (for preemptive scheduling)
     int priority;               ///< Process priority (lower number = higher priority)
+    int basePriority;           ///< Priority the process was created with, before any aging
     ProcessState state;         ///< Current state of the process
     
     // Timing metrics
@@ -54,10 +71,21 @@ private:
     int waitingTime;            ///< Total time spent waiting in ready queue
     int turnaroundTime;         ///< Total time from arrival to completion
     int responseTime;           ///< Time from arrival to first CPU allocation
+    int interruptTime;          ///< Time interrupt handlers preempted it while running
+    int memoryStallTime;        ///< Time held back or slowed by memory pressure
+    int residentSetSize;        ///< Memory it occupies while in the system (0 = none)
+    int wastedTime;             ///< CPU time of runs lost to crashes
+    bool failed;                ///< Terminated by crashing, not by completing
     
     // Additional tracking
     int lastScheduledTime;      ///< Last time process was scheduled (for calculating waiting)
+    int readySince;             ///< Time it last became READY (for scheduling latency)
     bool firstSchedule;         ///< Flag to track if process has been scheduled before
+    
+    // Shared resources
+    std::vector<CriticalSection> criticalSections;  ///< Lock usage, ordered by start
+    int inheritedPriority;      ///< Priority inherited through a lock protocol (INT_MAX = none)
+    int sequence;               ///< Position in the scheduler's process list (last-resort tie-break)
 
 public:
     /**
@@ -79,14 +107,32 @@ public:
     int getBurstTime() const { return burstTime; }
     int getRemainingTime() const { return remainingTime; }
     int getPriority() const { return priority; }
+    int getBasePriority() const { return basePriority; }
     ProcessState getState() const { return state; }
     int getStartTime() const { return startTime; }
     int getCompletionTime() const { return completionTime; }
     int getWaitingTime() const { return waitingTime; }
     int getTurnaroundTime() const { return turnaroundTime; }
     int getResponseTime() const { return responseTime; }
+    int getInterruptTime() const { return interruptTime; }
+    int getMemoryStallTime() const { return memoryStallTime; }
+    int getResidentSetSize() const { return residentSetSize; }
+    int getWastedTime() const { return wastedTime; }
+    bool isFailed() const { return failed; }
     int getLastScheduledTime() const { return lastScheduledTime; }
+    int getReadySince() const { return readySince; }
     bool isFirstSchedule() const { return firstSchedule; }
+    int getInheritedPriority() const { return inheritedPriority; }
+    int getSequence() const { return sequence; }
+    const std::vector<CriticalSection>& getCriticalSections() const { return criticalSections; }
+    
+    /**
+     * @brief Priority the scheduler should use: the better of the own and
+     *        the inherited priority
+     */
+    int getEffectivePriority() const {
+        return inheritedPriority < priority ? inheritedPriority : priority;
+    }
     
     // Setters
     void setState(ProcessState newState) { state = newState; }
@@ -94,7 +140,22 @@ public:
     void setStartTime(int time) { startTime = time; }
     void setCompletionTime(int time) { completionTime = time; }
     void setLastScheduledTime(int time) { lastScheduledTime = time; }
+    void setReadySince(int time) { readySince = time; }
     void setFirstSchedule(bool value) { firstSchedule = value; }
+    void setInheritedPriority(int value) { inheritedPriority = value; }
+    void setSequence(int value) { sequence = value; }
+    void setResidentSetSize(int size) { residentSetSize = size; }
+    void setFailed(bool value) { failed = value; }
+    
+    /**
+     * @brief Declare that part of the burst runs while holding a lock
+     * 
+     * @param lock Lock identifier
+     * @param start CPU time executed when the lock is requested (0 <= start < burst)
+     * @param length CPU time the lock is held (>= 1; cut at the end of the burst)
+     * @return false if the section does not lie within the burst
+     */
+    bool addCriticalSection(int lock, int start, int length);
     
     /**
      * @brief Execute the process for a given time quantum
@@ -107,6 +168,16 @@ public:
      */
     int execute(int quantum);
     
+    /**
+     * @brief Lose the progress of the current run, as when it crashes
+     * 
+     * The whole burst is remaining again, and the work lost counts as
+     * wasted time.
+     * 
+     * @return int Work lost
+     */
+    int restartBurst();
+    
     /**
      * @brief Add waiting time to the process
      * 
@@ -117,6 +188,23 @@ public:
      */
     void addWaitingTime(int time) { waitingTime += time; }
     
+    /**
+     * @brief Add time interrupt handlers took while the process was running
+     * 
+     * @param time Handler time
+     */
+    void addInterruptTime(int time) { interruptTime += time; }
+    
+    /**
+     * @brief Add time memory pressure cost the process
+     * 
+     * Time it was held back by memory admission, plus the progress it
+     * lost to swapping while running.
+     * 
+     * @param time Stall time
+     */
+    void addMemoryStallTime(int time) { memoryStallTime += time; }
+    
     /**
      * @brief Calculate and update all timing metrics
      * 
@@ -0,0 +1,101 @@
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file QuantileSketch.h
+ * @brief Mergeable quantile sketch with bounded relative error
+ *
+ * A cluster run produces millions of per-process times spread over
+ * thousands of nodes. Each node summarizes its own in a sketch and the
+ * cluster merges them, so percentiles cost memory proportional to the
+ * value range's logarithm, not to the number of processes.
+ */
+
+/**
+ * @class QuantileSketch
+ * @brief DDSketch-style logarithmic histogram
+ *
+ * A positive value x goes to bucket ceil(log_gamma(x)) with
+ * gamma = (1 + a) / (1 - a), and a quantile is answered with the bucket's
+ * midpoint, so every reported quantile is within relative error a of the
+ * true one. Zero has its own counter. Merging adds bucket counts, so it is
+ * exact, associative and commutative: the merged sketch does not depend on
+ * how values were split between sketches or merged.
+ */
+class QuantileSketch {
+private:
+    double relativeAccuracy;        ///< a: maximum relative error
+    double gamma;                   ///< Bucket growth factor
+    double logGamma;                ///< ln(gamma)
+    std::vector<uint64_t> buckets;  ///< Counts, buckets[i] is index offset + i
+    int offset;                     ///< Bucket index of buckets[0]
+    uint64_t zeroCount;             ///< Values <= 0
+    uint64_t total;                 ///< Values added
+    double sum;                     ///< Sum of values
+    double minValue;                ///< Smallest value
+    double maxValue;                ///< Largest value
+
+    /**
+     * @brief Add @p count to the bucket with the given index, growing storage
+     */
+    void addToBucket(int index, uint64_t count);
+
+public:
+    /// Default relative accuracy (1%)
+    static constexpr double DEFAULT_ACCURACY = 0.01;
+
+    /**
+     * @brief Construct an empty sketch
+     *
+     * @param relativeAccuracy Maximum relative error of quantiles, in (0, 1)
+     */
+    explicit QuantileSketch(double relativeAccuracy = DEFAULT_ACCURACY);
+
+    /**
+     * @brief Add one value (values <= 0 count as 0)
+     */
+    void add(double value);
+
+    /**
+     * @brief Add every value of another sketch with the same accuracy
+     *
+     * @return bool false (and nothing merged) if the accuracies differ
+     */
+    bool merge(const QuantileSketch& other);
+
+    /**
+     * @brief Value at quantile @p q in [0, 1] (0 if empty)
+     */
+    double quantile(double q) const;
+
+    /**
+     * @brief Number of values added
+     */
+    uint64_t count() const { return total; }
+
+    /**
+     * @brief Exact mean (0 if empty)
+     */
+    double mean() const { return total > 0 ? sum / static_cast<double>(total) : 0.0; }
+
+    /**
+     * @brief Exact minimum (0 if empty)
+     */
+    double min() const { return total > 0 ? minValue : 0.0; }
+
+    /**
+     * @brief Exact maximum (0 if empty)
+     */
+    double max() const { return total > 0 ? maxValue : 0.0; }
+
+    /**
+     * @brief Relative accuracy the sketch was built with
+     */
+    double getRelativeAccuracy() const { return relativeAccuracy; }
+};
+
+#endif // QUANTILE_SKETCH_H
@@ -0,0 +1,151 @@
+#ifndef RPC_SERVER_SIMULATOR_H
+#define RPC_SERVER_SIMULATOR_H
+
+#include "QuantileSketch.h"
+#include "Workload.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file RpcServerSimulator.h
+ * @brief Microsecond-scale RPC server: a dispatcher core in front of worker cores
+ *
+ * Latency-critical RPC servers (Shinjuku, Shenango, ZygOS) dedicate one core
+ * to steering requests to worker cores. At microsecond service times the
+ * dispatcher's per-request cost, preemption cost and queue layout decide the
+ * tail, so the architectures are compared by p99.9 slowdown (latency over
+ * service time) as offered load grows. Times are in nanoseconds.
+ */
+
+/**
+ * @enum RpcArchitecture
+ * @brief How requests reach worker cores
+ */
+enum class RpcArchitecture {
+    CENTRALIZED_FCFS,   ///< One central queue; the dispatcher hands each request to an idle worker
+    WORK_STEALING,      ///< The dispatcher steers to per-worker queues; idle workers steal
+    PROCESSOR_SHARING   ///< Central queue; a request runs at most one quantum, then is preempted
+};
+
+/**
+ * @struct RpcRequestType
+ * @brief One class of the request mix
+ */
+struct RpcRequestType {
+    std::string name;               ///< Label in reports
+    double share;                   ///< Fraction of requests (normalized over the mix)
+    double meanService;             ///< Mean service time, ns
+    BurstDistribution distribution; ///< Shape of service times (at least 1 ns)
+};
+
+/**
+ * @struct RpcServerConfig
+ * @brief Server shape, costs and request mix
+ *
+ * Arrivals are Poisson; at load rho the rate is rho * workers / E[service].
+ * The default mix is Shinjuku's bimodal workload: 99.5% of requests take
+ * 0.5 us and 0.5% take 500 us.
+ */
+struct RpcServerConfig {
+    int workers;                        ///< Worker cores
+    std::vector<RpcRequestType> mix;    ///< Request types
+    int64_t dispatchCost;               ///< Dispatcher time per request handed off or steered, ns
+    int64_t quantum;                    ///< PROCESSOR_SHARING time slice, ns
+    int64_t preemptionCost;             ///< Worker time lost per preemption, ns
+    int64_t stealCost;                  ///< Extra latency of taking a request from another worker's queue, ns
+    size_t requests;                    ///< Requests per simulation
+    double warmupFraction;              ///< Leading share of requests not measured
+    int numThreads;                     ///< Sweep worker threads (0 = hardware concurrency)
+    uint64_t seed;                      ///< Arrival, mix and steering seed
+
+    RpcServerConfig()
+        : workers(16),
+          mix({{"short", 0.995, 500.0, BurstDistribution::CONSTANT},
+               {"long", 0.005, 500000.0, BurstDistribution::CONSTANT}}),
+          dispatchCost(100), quantum(5000), preemptionCost(250), stealCost(200),
+          requests(200000), warmupFraction(0.1), numThreads(0), seed(1) {}
+};
+
+/**
+ * @struct RpcMetrics
+ * @brief Results of one architecture at one load
+ */
+struct RpcMetrics {
+    RpcArchitecture architecture;       ///< Architecture simulated
+    double load;                        ///< Offered load rho
+    size_t completed;                   ///< Requests measured
+    QuantileSketch slowdown;            ///< Latency / service time
+    QuantileSketch latency;             ///< Arrival to completion, ns
+    std::vector<QuantileSketch> typeLatency;  ///< Latency per request type
+    double workerUtilization;           ///< Service time / (workers * span), in %
+    double dispatcherUtilization;       ///< Dispatcher busy time / span, in %
+    size_t preemptions;                 ///< Quanta that ended before the request did
+    size_t steals;                      ///< Requests taken from another worker's queue
+};
+
+/**
+ * @class RpcServerSimulator
+ * @brief Event-driven simulation of a dispatcher core and worker cores
+ *
+ * Every architecture sees the same arrival and service sequence for a
+ * given load (common random numbers):
+ *
+ *  - CENTRALIZED_FCFS: arrivals join one FIFO DispatchQueue. Whenever the
+ *    dispatcher is free and a worker is idle, it spends dispatchCost
+ *    handing the head request to that worker, which runs it to completion.
+ *  - WORK_STEALING: the dispatcher spends dispatchCost steering each
+ *    arrival to a uniformly chosen worker's FIFO queue. A worker drains
+ *    its own queue first; an idle worker takes queued work from the next
+ *    non-empty queue after its own, paying stealCost.
+ *  - PROCESSOR_SHARING: as CENTRALIZED_FCFS, but a request runs at most
+ *    one quantum; if unfinished, the worker spends preemptionCost and the
+ *    request rejoins the tail of the central queue.
+ *
+ * Pending events live in a FutureEventSet. Only the next arrival is ever
+ * generated ahead of time and request slots are recycled, so memory is
+ * proportional to the requests in the system, not to the run length.
+ */
+class RpcServerSimulator {
+private:
+    RpcServerConfig config;     ///< Parameters
+
+public:
+    /**
+     * @brief Construct a simulator (an empty mix becomes one 1 us type)
+     *
+     * @param config Parameters
+     */
+    explicit RpcServerSimulator(const RpcServerConfig& config);
+
+    /**
+     * @brief Simulate one architecture at offered load @p load
+     */
+    RpcMetrics run(RpcArchitecture architecture, double load) const;
+
+    /**
+     * @brief Simulate one architecture at every load, in parallel
+     *
+     * Results are in the order of @p loads and do not depend on the thread
+     * count.
+     */
+    std::vector<RpcMetrics> sweep(RpcArchitecture architecture, const std::vector<double>& loads) const;
+
+    /**
+     * @brief Mean service time of the mix, ns
+     */
+    double meanService() const;
+
+    /**
+     * @brief Parameters after validation
+     */
+    const RpcServerConfig& getConfig() const { return config; }
+
+    /**
+     * @brief Architecture name
+     */
+    static std::string architectureName(RpcArchitecture architecture);
+};
+
+#endif // RPC_SERVER_SIMULATOR_H
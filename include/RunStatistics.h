@@ -0,0 +1,97 @@
+#ifndef RUN_STATISTICS_H
+#define RUN_STATISTICS_H
+
+#include "FairnessStats.h"
+#include "HeavyHitters.h"
+#include "LatencyHistogram.h"
+#include "StarvationTracker.h"
+#include <cstddef>
+#include <memory>
+
+/**
+ * @file RunStatistics.h
+ * @brief Streaming statistics a Scheduler keeps as its processes change state
+ *
+ * Scheduling latency, fairness, the top CPU consumers and the most-starved
+ * READY process are all fed by the same four events: a process becomes
+ * READY, is dispatched, runs for a while, completes. The Scheduler reports
+ * the events; what is computed from them lives here.
+ */
+
+class Process;
+
+/**
+ * @class RunStatistics
+ * @brief LatencyHistogram and FairnessStats, plus optional top consumers and starvation tracking
+ *
+ * Every update is O(1), or O(log) in the tracked counters or READY
+ * processes for the optional parts, which are off until enabled.
+ */
+class RunStatistics {
+private:
+    LatencyHistogram latencies;                     ///< READY -> RUNNING delays, by priority
+    FairnessStats fairness;                         ///< Slowdown, CPU shares and starvation
+    std::unique_ptr<SpaceSaving> consumers;         ///< Top CPU consumers (null = off)
+    std::unique_ptr<StarvationTracker> starving;    ///< READY processes by ready time (null = off)
+
+public:
+    /**
+     * @brief Forget the previous run, keeping what is tracked
+     */
+    void clear();
+    
+    /**
+     * @brief A process became READY at @p since
+     */
+    void ready(const Process& process, int since);
+    
+    /**
+     * @brief A READY process started running at @p time
+     *
+     * Its delay since Process::getReadySince() goes to the class of its
+     * base priority; aging does not move it between classes.
+     */
+    void dispatched(const Process& process, int time);
+    
+    /**
+     * @brief A process ran for @p duration
+     */
+    void executed(const Process& process, int duration);
+    
+    /**
+     * @brief A process completed; failed processes are left out
+     */
+    void completed(const Process& process);
+    
+    /**
+     * @brief Track the heaviest CPU consumers in @p capacity counters (0 = stop)
+     */
+    void setTopConsumers(size_t capacity);
+    
+    /**
+     * @brief Track the READY processes by the time they became ready
+     */
+    void setStarvationTracking(bool track);
+    
+    /**
+     * @brief READY -> RUNNING delays, by priority class
+     */
+    const LatencyHistogram& getLatencies() const { return latencies; }
+    
+    /**
+     * @brief Slowdown, CPU share and starvation, by priority class
+     */
+    const FairnessStats& getFairness() const { return fairness; }
+    
+    /**
+     * @brief Top CPU consumers (nullptr if not tracked)
+     */
+    const SpaceSaving* getTopConsumers() const { return consumers.get(); }
+    
+    /**
+     * @brief READY processes and the longest wait (nullptr if not tracked)
+     */
+    const StarvationTracker* getStarvation() const { return starving.get(); }
+};
+
+#endif // RUN_STATISTICS_H
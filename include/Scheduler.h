@@ -2,10 +2,16 @@
 #define SCHEDULER_H
 
 #include "Process.h"
+#include "FutureEventSet.h"
+#include "TimerWheel.h"
+#include "RunStatistics.h"
 #include <vector>
 #include <queue>
 #include <memory>
 #include <string>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
 
 /**
  * @file Scheduler.h
@@ -16,6 +22,11 @@
  * scheduling policies.
  */
 
+class InterruptModel;
+class InterruptTimeline;
+class MemoryAdmission;
+struct MemoryConfig;
+
 /**
  * @struct SchedulingMetrics
  * @brief Contains aggregate performance metrics for a scheduling simulation
@@ -31,6 +42,25 @@ struct SchedulingMetrics {
     double throughput;              ///< Number of processes completed per time unit
     int totalContextSwitches;       ///< Number of context switches performed
     int totalTime;                  ///< Total simulation time
+    int totalInterruptTime;         ///< Time interrupt handlers preempted running processes
+    int totalMemoryStallTime;       ///< Time processes were held back or slowed by memory pressure
+    int failedProcesses;            ///< Processes that crashed more often than their retries allowed
+    int totalWastedTime;            ///< CPU time of runs lost to crashes
+    double goodput;                 ///< Percentage of CPU time spent on runs that completed
+    double averageSlowdown;         ///< Average turnaround / burst
+    double jainFairnessIndex;       ///< Jain's index over the processes' CPU shares (1 = equal)
+    double classFairnessIndex;      ///< Jain's index over the priority classes' CPU shares
+    int maxStarvationTime;          ///< Longest time a process waited READY before a dispatch
+};
+
+/**
+ * @struct ExecutionSlice
+ * @brief A maximal interval during which one process ran
+ */
+struct ExecutionSlice {
+    int pid;        ///< Process that ran
+    int start;      ///< Start time
+    int end;        ///< End time (exclusive)
 };
 
 /**
@@ -40,14 +70,38 @@ struct SchedulingMetrics {
  * This class defines the interface that all scheduling algorithms must implement.
  * It provides common functionality for process management, metric tracking,
  * and simulation execution.
+ *
+ * Reproducibility contract: whenever a policy has to choose between processes
+ * it considers equivalent (same priority, same queue level, ...), it orders
+ * them by arrival time, then PID, then a key derived from the tie-break seed
+ * and the position each was added at. With unique PIDs, simulation results
+ * therefore depend only on the process set, never on the order processes
+ * were added or on container internals; processes sharing an arrival time
+ * and a PID are ordered by the seed. getRunFingerprint() is identical for
+ * identical runs.
  */
 class Scheduler {
 protected:
     std::vector<std::shared_ptr<Process>> processes;  ///< All processes to be scheduled
     int currentTime;                                   ///< Current simulation time
     int contextSwitchOverhead;                         ///< Time cost of context switch
+    int cpuCount;                                      ///< CPUs the policy schedules on
     int totalContextSwitches;                          ///< Count of context switches
     std::shared_ptr<Process> currentProcess;           ///< Currently running process
+    uint64_t tieBreakSeed;                             ///< Seed for the last-resort tie-break key
+    uint64_t fingerprint;                              ///< Hash over committed timeline slices
+    int pendingSlicePid;                               ///< PID of the slice not yet hashed (-1 = none)
+    int pendingSliceStart;                             ///< Start time of the pending slice
+    int pendingSliceEnd;                               ///< End time of the pending slice
+    TimerWheel timers;                                 ///< Virtual timers for event-driven policies
+    std::unique_ptr<FutureEventSet> arrivals;          ///< Pending arrivals, payload = process index
+    FutureEventSetType arrivalSetType;                 ///< Implementation used for arrivals
+    bool arrivalsPrepared;                             ///< arrivals holds the current run's processes
+    bool recordSlices;                                 ///< Keep the timeline in slices
+    std::vector<ExecutionSlice> slices;                ///< Merged timeline of the last run, if recorded
+    std::shared_ptr<InterruptTimeline> interrupts;     ///< Handler activity on the CPU (null = none)
+    std::shared_ptr<MemoryAdmission> memory;           ///< Host memory and the processes it holds back (null = unlimited)
+    RunStatistics stats;                               ///< Latency, fairness, consumers and starvation of the current run
     
     /**
      * @brief Perform a context switch
@@ -60,6 +114,27 @@ protected:
      */
     void contextSwitch(std::shared_ptr<Process> from, std::shared_ptr<Process> to);
     
+    /**
+     * @brief Make a process READY, remembering since when
+     * 
+     * Every transition to READY goes through here, so that the next
+     * transition to RUNNING can measure the delay.
+     * 
+     * @param process Process that became runnable
+     * @param since Time it became runnable
+     */
+    void markReady(Process& process, int since);
+    
+    /**
+     * @brief Make a READY process RUNNING and record its scheduling latency
+     * 
+     * The delay since markReady() goes into the run statistics, in O(1).
+     * 
+     * @param process Process being dispatched
+     * @param time Time it starts running (after any switch overhead)
+     */
+    void markRunning(Process& process, int time);
+    
     /**
      * @brief Update waiting time for all ready processes
      * 
@@ -74,11 +149,113 @@ protected:
      * @brief Check for and admit newly arrived processes
      * 
      * Moves processes from NEW state to READY state when their arrival
-     * time equals the current simulation time.
+     * time is at or before the current simulation time and every process
+     * they depend on has terminated. Arrivals are taken from the
+     * future-event set, so the cost does not grow with the number of
+     * processes that have not arrived yet; a process with dependencies
+     * enters that set only when completeProcess() releases its last one.
+     * 
+     * @return std::vector<std::shared_ptr<Process>> Newly admitted processes,
+     *         in tie-break order (arrival, PID, seeded key)
+     */
+    std::vector<std::shared_ptr<Process>> admitArrivingProcesses();
+    
+    /**
+     * @brief Mark a process as finished at the current time
+     * 
+     * Sets its completion time, computes its metrics and terminates it,
+     * then releases the successors for which it was the last unfinished
+     * dependency. Each dependency edge is visited once per run.
      * 
-     * @return int Number of processes that arrived
+     * @param process Process whose remaining time has reached zero
      */
-    int admitArrivingProcesses();
+    void completeProcess(const std::shared_ptr<Process>& process);
+    
+    /**
+     * @brief Get the arrival time of the next process not yet admitted
+     * 
+     * Event-driven policies use this, together with timers.nextExpiry(),
+     * to run a process until the next event instead of one unit at a time.
+     * 
+     * @return int Earliest arrival time of a NEW process, or INT_MAX if none
+     */
+    int nextArrivalTime();
+    
+    /**
+     * @brief Record that a process ran on the CPU
+     * 
+     * Feeds the run fingerprint. Adjacent slices of the same process are
+     * merged first, so the fingerprint does not depend on whether a policy
+     * executes in single time units or in whole quanta.
+     * 
+     * @param process Process that ran
+     * @param start Time the slice started
+     * @param duration Length of the slice
+     */
+    void recordExecution(const std::shared_ptr<Process>& process, int start, int duration);
+    
+    /**
+     * @brief Clear the recorded timeline and pending arrivals before a new run
+     */
+    void resetTimeline();
+    
+    /**
+     * @brief Convert a real time (e.g. an arrival) to the policy's clock
+     * 
+     * Without interrupts the two are the same.
+     */
+    int toProcessTime(int realTime) const;
+    
+    /**
+     * @brief Time an admitted process became ready, on the policy's clock
+     * 
+     * Its arrival, or its release if memory admission held it back. Policies
+     * that charge waiting time from the moment a process became ready use
+     * this; the hold itself is already counted as waiting.
+     */
+    int readyTime(const Process& process) const;
+    
+    /**
+     * @brief Progress per time unit the host's memory allows, in thousandths
+     * 
+     * 1000 unless the admitted working sets exceed physical memory. Only
+     * policies that track fractional progress can apply it.
+     */
+    int memorySpeed() const;
+    
+    /**
+     * @brief Whether memory admission is holding a process back
+     */
+    bool memoryHeld() const;
+    
+    /**
+     * @brief Count time during which running processes were slowed by swapping
+     * 
+     * Call only for time when no process was held back, which the base
+     * class already counts.
+     */
+    void addMemoryPressureTime(int duration);
+
+private:
+    std::vector<std::pair<int, int>> dependencies;     ///< (predecessor PID, successor PID) edges
+    std::unordered_map<int, size_t> pidIndex;          ///< PID to process index, when there are dependencies
+    std::vector<size_t> successorStart;                ///< Per process index: offset into successorList
+    std::vector<size_t> successorList;                 ///< Successor process indices, grouped by predecessor
+    std::vector<int> unmetDependencies;                ///< Per process index: predecessors not yet terminated
+    
+    /**
+     * @brief Load every NEW process without unmet dependencies into the
+     *        arrivals future-event set
+     */
+    void prepareArrivals();
+    
+    /**
+     * @brief Resolve the dependency edges into per-process successor lists
+     * 
+     * O(processes + edges). Edges naming an unknown PID, and self-edges,
+     * are ignored.
+     */
+    void buildDependencyGraph();
 
 public:
     /**
@@ -100,6 +277,30 @@ public:
      */
     void addProcess(std::shared_ptr<Process> process);
     
+    /**
+     * @brief Make one process wait for another to finish
+     * 
+     * The successor is admitted only once it has arrived and all of its
+     * predecessors have terminated, whatever the policy. Processes on a
+     * dependency cycle are never admitted and stay NEW. PIDs must be unique
+     * among the processes of a workload with dependencies.
+     * 
+     * @param predecessorPid Process that must finish first
+     * @param successorPid Process that waits for it
+     * @return false if the two PIDs are equal
+     */
+    bool addDependency(int predecessorPid, int successorPid);
+    
+    /**
+     * @brief Remove all dependencies
+     */
+    void clearDependencies();
+    
+    /**
+     * @brief Number of dependency edges
+     */
+    size_t getDependencyCount() const { return dependencies.size(); }
+    
     /**
      * @brief Get the name of the scheduling algorithm
      * 
@@ -122,6 +323,9 @@ public:
      * 
      * Computes average waiting time, turnaround time, response time,
      * CPU utilization, and throughput based on completed processes.
+     * Processes that terminated by failing are counted apart: they add
+     * their lost runs to the wasted time and utilization, but not to the
+     * averages, throughput or goodput.
      * 
      * @return SchedulingMetrics Structure containing all calculated metrics
      */
@@ -153,6 +357,200 @@ public:
      */
     void reset();
     
+    /**
+     * @brief Set the seed of the last-resort tie-break key
+     * 
+     * Processes with equal arrival time and equal PID are ordered by a
+     * seeded hash of the position they were added at, so different seeds
+     * give different (but reproducible) orders among them. Processes that
+     * differ in arrival time or PID are never reordered by the seed.
+     * 
+     * @param seed Tie-break seed
+     */
+    void setTieBreakSeed(uint64_t seed) { tieBreakSeed = seed; }
+    
+    /**
+     * @brief Get the tie-break seed
+     */
+    uint64_t getTieBreakSeed() const { return tieBreakSeed; }
+    
+    /**
+     * @brief Choose the future-event set used for pending arrivals
+     * 
+     * AUTO (the default) uses a binary heap for small workloads and the
+     * timing wheel from WHEEL_SELECTION_THRESHOLD processes on. Results are
+     * identical either way; only the running time differs.
+     * 
+     * @param type Future-event set implementation
+     */
+    void setArrivalSetType(FutureEventSetType type) {
+        arrivalSetType = type;
+        arrivalsPrepared = false;
+    }
+    
+    /**
+     * @brief Get a hash of the execution timeline of the last run
+     * 
+     * 64-bit FNV-1a over the merged (PID, start, end) slices in time order.
+     * Two runs produce the same fingerprint exactly when they executed the
+     * same processes over the same intervals.
+     * 
+     * @return uint64_t Run fingerprint
+     */
+    uint64_t getRunFingerprint() const;
+    
+    /**
+     * @brief Seeded well-mixed key of an integer id
+     * 
+     * A bijection of id for a given seed, so distinct ids get distinct keys.
+     * 
+     * @param seed Tie-break seed
+     * @param id Value to key (a process's sequence for tie-breaking)
+     * @return uint64_t Well-mixed key
+     */
+    static uint64_t tieBreakKey(uint64_t seed, int id);
+    
+    /**
+     * @brief Canonical tie-break order between two processes
+     * 
+     * @param seed Tie-break seed
+     * @param a First process
+     * @param b Second process
+     * @return true if @p a goes before @p b (earlier arrival, then lower PID,
+     *         then lower seeded key of Process::getSequence())
+     */
+    static bool tieBreakBefore(uint64_t seed, const Process& a, const Process& b);
+    
+    /**
+     * @brief Keep the execution timeline of each run
+     * 
+     * Off by default; the fingerprint is always computed.
+     * 
+     * @param record Whether to record slices
+     */
+    void setRecordSlices(bool record) { recordSlices = record; }
+    
+    /**
+     * @brief Execution timeline of the last run, if recorded
+     * 
+     * Adjacent slices of the same process are merged, as for the
+     * fingerprint; slices are in the order they were recorded.
+     */
+    const std::vector<ExecutionSlice>& getExecutionSlices() const { return slices; }
+    
+    /**
+     * @brief Let interrupt handlers on one core of @p model preempt the processes
+     * 
+     * The policy then runs on the time the handlers leave: currentTime,
+     * quanta and the recorded timeline are in process time, and arrivals
+     * are converted into it. On completion, start and completion times are
+     * converted back to real time; handler time while a process ran is its
+     * interrupt time, and handler time while it waited adds to its waiting
+     * time. Any policy gets this without change, since interrupts preempt
+     * whatever runs. Handler activity is generated per interrupt, only as
+     * far as the run reaches.
+     * 
+     * @param model Interrupt sources of the machine
+     * @param core Core this scheduler's CPU is
+     * @return false if the policy schedules more than one CPU, @p core does
+     *         not exist, or its handlers need the whole core
+     */
+    bool setInterrupts(const InterruptModel& model, int core);
+    
+    /**
+     * @brief Give the processes the whole CPU again
+     */
+    void clearInterrupts() { interrupts.reset(); }
+    
+    /**
+     * @brief Give the host finite memory
+     * 
+     * Each process's RSS is charged when it is admitted and released when
+     * it completes, in O(1). With an admission limit, a process that would
+     * push the charged RSS past it waits, in arrival order, until
+     * completions free enough memory; the hold counts as waiting time and
+     * as memory stall time. Policies that track fractional progress
+     * (ExtScheduler) also slow running processes while the admitted working
+     * sets exceed the capacity. Pressure-stall time (getMemoryPressureTime)
+     * is the time at least one process was held back or slowed, like the
+     * "some" line of /proc/pressure/memory.
+     * 
+     * @param config Host memory parameters
+     * @return false if MemoryAccount::isValid rejects them
+     */
+    bool setMemory(const MemoryConfig& config);
+    
+    /**
+     * @brief Give the host unlimited memory again
+     */
+    void clearMemory() { memory.reset(); }
+    
+    /**
+     * @brief Time in the last run at least one process stalled on memory
+     */
+    int64_t getMemoryPressureTime() const;
+    
+    /**
+     * @brief Every READY -> RUNNING delay of the last run, by priority class
+     * 
+     * Unlike response time, this covers every dispatch: after arrival,
+     * preemption, the end of a quantum or a wakeup from a lock.
+     */
+    const LatencyHistogram& getSchedulingLatency() const { return stats.getLatencies(); }
+    
+    /**
+     * @brief Slowdown, CPU share and starvation of the last run, by priority class
+     * 
+     * Updated as processes are dispatched and complete; failed processes
+     * are left out.
+     */
+    const FairnessStats& getFairness() const { return stats.getFairness(); }
+    
+    /**
+     * @brief Track the heaviest CPU consumers in @p capacity counters
+     * 
+     * Every executed slice is charged to its process in a Space-Saving
+     * summary, in O(log capacity): memory does not grow with the number of
+     * processes, and every process that used more than 1/capacity of the
+     * CPU time is guaranteed to be reported. Off by default.
+     * 
+     * @param capacity Counters kept (0 = stop tracking)
+     */
+    void setTopConsumers(size_t capacity) { stats.setTopConsumers(capacity); }
+    
+    /**
+     * @brief Top CPU consumers of the current or last run (nullptr if not tracked)
+     * 
+     * Valid during a run too, e.g. for a policy deciding what to throttle.
+     */
+    const SpaceSaving* getTopConsumers() const { return stats.getTopConsumers(); }
+    
+    /**
+     * @brief Track the READY processes by the time they became ready
+     * 
+     * Keeps an indexed heap updated by markReady() and markRunning(), in
+     * O(log r) for r READY processes, so the most-starved process is known
+     * in O(1) at any time. Off by default.
+     * 
+     * @param track Whether to track
+     */
+    void setStarvationTracking(bool track) { stats.setStarvationTracking(track); }
+    
+    /**
+     * @brief READY processes of the current run and its longest wait (nullptr if not tracked)
+     * 
+     * During a run oldest() is the process starving now; after it,
+     * getWorstId() and getWorstWait() give the worst wait of the run.
+     */
+    const StarvationTracker* getStarvation() const { return stats.getStarvation(); }
+    
+    /**
+     * @brief Get the number of CPUs the policy schedules on
+     * 
+     * CPU utilization is reported relative to all of them.
+     */
+    int getCpuCount() const { return cpuCount; }
+    
     /**
      * @brief Get all processes
      * 
@@ -0,0 +1,155 @@
+#ifndef SKIP_LIST_SCHEDULER_H
+#define SKIP_LIST_SCHEDULER_H
+
+#include "Scheduler.h"
+#include "DeadlineSkipList.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file SkipListScheduler.h
+ * @brief BFS/MuQSS-style virtual-deadline scheduling on one or more CPUs
+ *
+ * Every runnable task has a virtual deadline: the time it was queued plus
+ * rr_interval scaled by a ratio that grows 10% per nice level. The task with
+ * the earliest deadline runs next, for at most rr_interval; then it receives
+ * a new deadline and is requeued. Low-nice tasks thus run more often, but
+ * no task can be postponed indefinitely, which gives BFS its low desktop
+ * latency.
+ */
+
+/**
+ * @enum RunQueueLayout
+ * @brief How runnable tasks are distributed over skip lists
+ */
+enum class RunQueueLayout {
+    GLOBAL,     ///< BFS: one skip list shared by all CPUs
+    PER_CPU     ///< MuQSS: one skip list per CPU, with peeking at the others' heads
+};
+
+/**
+ * @class SkipListScheduler
+ * @brief Implements BFS (global) and MuQSS (per-CPU) virtual-deadline scheduling
+ *
+ * Process::priority is read as a nice value (clamped to -20..19). Arrivals
+ * go to an idle CPU if there is one; otherwise they preempt the CPU running
+ * the latest deadline when theirs is earlier. A preempted task keeps its
+ * deadline and the rest of its timeslice.
+ *
+ * With GLOBAL, an idle CPU pops the head of the shared list. With PER_CPU,
+ * a task is queued on one CPU's list and an idle CPU compares the head of
+ * its own list with the heads of all others (a lock-free read of one
+ * deadline each in MuQSS) and takes the earliest, so picking costs
+ * O(CPUs) and inserting O(log n).
+ *
+ * Each CPU pays the context switch overhead itself rather than stalling
+ * the whole machine. Waiting time is charged from enqueue timestamps.
+ */
+class SkipListScheduler : public Scheduler {
+private:
+    /**
+     * @struct Task
+     * @brief Per-process scheduling state
+     */
+    struct Task {
+        int64_t deadline;       ///< Virtual deadline (time units x 128)
+        int sliceLeft;          ///< Remaining timeslice
+        int enqueuedAt;         ///< Time the task last entered a run queue
+    };
+
+    /**
+     * @struct Cpu
+     * @brief State of one simulated CPU
+     */
+    struct Cpu {
+        int running;                    ///< Running task (-1 = idle)
+        int previous;                   ///< Task that ran last, for switch counting (-1 = none)
+        int readyAt;                    ///< Time the switch overhead ends
+        DeadlineSkipList queue;         ///< Run queue (PER_CPU only)
+        std::vector<std::string> gantt; ///< Timeline of this CPU
+    };
+
+    int rrInterval;                                     ///< Timeslice of every task
+    RunQueueLayout layout;                              ///< Global or per-CPU run queues
+    DeadlineSkipList globalQueue;                       ///< Run queue (GLOBAL only)
+    std::vector<Cpu> cpus;                              ///< Simulated CPUs
+    std::vector<Task> tasks;                            ///< Indexed like 'processes'
+    std::unordered_map<const Process*, int> taskIndex;  ///< Process -> index in 'tasks'
+    int ganttOrigin;                                    ///< Time of the first Gantt column
+
+    /**
+     * @brief Queue a runnable task, on @p cpu's list for PER_CPU
+     */
+    void enqueue(int task, int cpu);
+
+    /**
+     * @brief Place a newly arrived task: idle CPU, preemption, or queue
+     */
+    void wakeUp(int task);
+
+    /**
+     * @brief Take the earliest-deadline task visible to @p cpu
+     *
+     * @return int Task index, or -1 if nothing is runnable
+     */
+    int pickNext(int cpu);
+
+    /**
+     * @brief Put a task on a CPU, charging its wait and any switch overhead
+     */
+    void startTask(int cpu, int task);
+
+    /**
+     * @brief Record a CPU's timeline for columns [from, to) after ganttOrigin
+     */
+    void recordGantt(int cpu, int from, int to);
+
+public:
+    /**
+     * @brief Construct a new Skip List Scheduler
+     *
+     * @param rrInterval Timeslice of every task (default: 6, as in BFS)
+     * @param numCpus Number of CPUs (default: 1)
+     * @param layout GLOBAL for BFS, PER_CPU for MuQSS (default: GLOBAL)
+     * @param contextSwitchOverhead Context switch time cost (default: 0)
+     */
+    explicit SkipListScheduler(int rrInterval = 6, int numCpus = 1,
+                               RunQueueLayout layout = RunQueueLayout::GLOBAL,
+                               int contextSwitchOverhead = 0);
+
+    /**
+     * @brief Get the name of this scheduling algorithm
+     *
+     * @return std::string "BFS Skip List (...)" or "MuQSS Skip Lists (...)"
+     */
+    std::string getName() const override;
+
+    /**
+     * @brief Execute the virtual-deadline scheduling simulation
+     *
+     * Event-driven: time advances to the next arrival, completion or
+     * timeslice expiry on any CPU.
+     */
+    void schedule() override;
+
+    /**
+     * @brief Get visual Gantt chart of execution, one row per CPU
+     *
+     * @return std::string Formatted timeline showing process execution order
+     */
+    std::string getGanttChart() const override;
+
+    /**
+     * @brief Deadline offset of a nice value, in time units x 128
+     *
+     * rr_interval x prio_ratio, where prio_ratio is 128 at nice -20 and
+     * grows by 10% per nice level.
+     *
+     * @param priority Process::priority, read as a nice value
+     * @return int64_t Deadline offset
+     */
+    int64_t deadlineOffset(int priority) const;
+};
+
+#endif // SKIP_LIST_SCHEDULER_H
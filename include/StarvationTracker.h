@@ -0,0 +1,119 @@
+#ifndef STARVATION_TRACKER_H
+#define STARVATION_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file StarvationTracker.h
+ * @brief The task that has waited longest for a CPU, live and over a run
+ *
+ * FairnessStats knows the longest wait of each priority class once the
+ * wait has ended. A watchdog needs the task that is starving now, while
+ * it still waits, without scanning the run queues.
+ */
+
+/**
+ * @struct ReadyEntry
+ * @brief A READY task and the time it became ready
+ */
+struct ReadyEntry {
+    int64_t since;  ///< Time the task became ready
+    int id;         ///< Task id (a PID)
+};
+
+/**
+ * @class StarvationTracker
+ * @brief Indexed min-heap of READY tasks on the time they became ready
+ *
+ * The root is the most-starved task, read in O(1). Entering and leaving
+ * the READY set is O(log r) for r READY tasks; memory is proportional to
+ * r, not to the number of tasks in the run. Ties go to the lower id. The
+ * longest finished wait is kept with the task that suffered it.
+ */
+class StarvationTracker {
+private:
+    std::vector<ReadyEntry> heap;               ///< READY tasks, min-heap on (since, id)
+    std::unordered_map<int, size_t> position;   ///< id -> index in heap
+    int worstId;                                ///< Task of the longest finished wait (-1 = none)
+    int64_t worstWait;                          ///< Longest finished wait
+
+    /**
+     * @brief Heap order: true if a belongs below b
+     */
+    static bool after(const ReadyEntry& a, const ReadyEntry& b);
+
+    /**
+     * @brief Swap two heap slots and their positions
+     */
+    void swapEntries(size_t i, size_t j);
+
+    /**
+     * @brief Restore the heap around index @p i
+     */
+    void sift(size_t i);
+
+public:
+    /**
+     * @brief Construct an empty tracker
+     */
+    StarvationTracker();
+
+    /**
+     * @brief Record that @p id became ready at @p since
+     *
+     * A task already READY has its time replaced.
+     */
+    void enter(int id, int64_t since);
+
+    /**
+     * @brief Record that @p id stopped being ready at @p time
+     *
+     * @return int64_t How long it waited (0 if it was not READY)
+     */
+    int64_t leave(int id, int64_t time);
+
+    /**
+     * @brief Forget every task and the longest wait
+     */
+    void clear();
+
+    /**
+     * @brief Whether no task is READY
+     */
+    bool empty() const { return heap.empty(); }
+
+    /**
+     * @brief READY tasks
+     */
+    size_t size() const { return heap.size(); }
+
+    /**
+     * @brief The task that has been READY longest (-1 if none)
+     */
+    int oldest() const { return heap.empty() ? -1 : heap.front().id; }
+
+    /**
+     * @brief Time the oldest READY task became ready (INT64_MAX if none)
+     */
+    int64_t oldestSince() const { return heap.empty() ? INT64_MAX : heap.front().since; }
+
+    /**
+     * @brief How long the oldest READY task has waited at @p now (0 if none)
+     */
+    int64_t currentWait(int64_t now) const { return heap.empty() ? 0 : now - heap.front().since; }
+
+    /**
+     * @brief Task of the longest finished wait (-1 if none)
+     */
+    int getWorstId() const { return worstId; }
+
+    /**
+     * @brief Longest finished wait
+     */
+    int64_t getWorstWait() const { return worstWait; }
+};
+
+#endif // STARVATION_TRACKER_H
@@ -0,0 +1,98 @@
+#ifndef SWF_READER_H
+#define SWF_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+
+/**
+ * @file SwfReader.h
+ * @brief Streaming reader for the Standard Workload Format (SWF)
+ *
+ * SWF is the format of the Parallel Workloads Archive: one job per line,
+ * 18 whitespace-separated fields, -1 for unknown values, and header
+ * comments starting with ';'. Logs run to millions of lines, so jobs are
+ * read one at a time and never held in memory.
+ */
+
+/**
+ * @struct SwfJob
+ * @brief One job record; fields keep their SWF meaning, -1 = unknown
+ */
+struct SwfJob {
+    int64_t jobNumber;          ///< 1: job number
+    int64_t submitTime;         ///< 2: submit time (seconds from log start)
+    int64_t waitTime;           ///< 3: wait time in the original system
+    int64_t runTime;            ///< 4: run time
+    int allocatedProcessors;    ///< 5: processors allocated
+    double averageCpuTime;      ///< 6: average CPU time used per processor
+    int64_t usedMemory;         ///< 7: memory used per processor (KB)
+    int requestedProcessors;    ///< 8: processors requested
+    int64_t requestedTime;      ///< 9: requested time (the user's runtime estimate)
+    int64_t requestedMemory;    ///< 10: memory requested per processor (KB)
+    int status;                 ///< 11: 1 completed, 0 failed, 5 cancelled, ...
+    int userId;                 ///< 12: user ID
+    int groupId;                ///< 13: group ID
+    int executable;             ///< 14: executable (application) number
+    int queue;                  ///< 15: queue number
+    int partition;              ///< 16: partition number
+    int64_t precedingJob;       ///< 17: job this one depends on
+    int64_t thinkTime;          ///< 18: think time after the preceding job
+};
+
+/**
+ * @class SwfReader
+ * @brief Reads SwfJob records from a stream, one at a time
+ *
+ * Header comments are parsed as they are passed, so getMaxProcs() is known
+ * once the first job has been read. Lines that are neither comments nor 18
+ * numeric fields are counted and skipped.
+ */
+class SwfReader {
+private:
+    std::istream& in;           ///< Source stream
+    std::string line;           ///< Line buffer, reused
+    size_t lineNumber;          ///< Lines consumed so far
+    size_t malformedLines;      ///< Non-comment lines that were skipped
+    int maxProcs;               ///< MaxProcs (or MaxNodes) header, 0 = absent
+
+    /**
+     * @brief Pick MaxProcs / MaxNodes out of a header comment
+     */
+    void parseHeader(const std::string& comment);
+
+public:
+    /// Fields per SWF record
+    static constexpr int FIELDS = 18;
+
+    /**
+     * @brief Read from @p in; the stream must outlive the reader
+     */
+    explicit SwfReader(std::istream& in);
+
+    /**
+     * @brief Read the next job
+     *
+     * @param job Receives the record
+     * @return bool false at end of stream
+     */
+    bool next(SwfJob& job);
+
+    /**
+     * @brief Machine size from the header, 0 if the log does not say
+     */
+    int getMaxProcs() const { return maxProcs; }
+
+    /**
+     * @brief Lines consumed so far, comments included
+     */
+    size_t getLineNumber() const { return lineNumber; }
+
+    /**
+     * @brief Lines skipped because they were not valid records
+     */
+    size_t getMalformedLines() const { return malformedLines; }
+};
+
+#endif // SWF_READER_H
@@ -0,0 +1,177 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file TimerWheel.h
+ * @brief Hierarchical timing wheel for one-shot and periodic virtual timers
+ *
+ * Lets event-driven policies model a timer tick (aging, periodic accounting,
+ * load balancing) without stepping through every time unit. Time only moves
+ * to the next due timer, so ticks cost nothing while no timer is due, and a
+ * policy can cancel its periodic timer while the CPU is idle and re-arm it on
+ * wakeup, like a tickless (NO_HZ) kernel.
+ */
+
+/**
+ * @struct TimerEvent
+ * @brief A timer that has expired
+ */
+struct TimerEvent {
+    uint64_t id;        ///< Handle returned by TimerWheel::schedule()
+    int64_t expiry;     ///< Time the timer expired
+    uint64_t payload;   ///< Caller-defined value stored with the timer
+};
+
+/**
+ * @class TimerWheel
+ * @brief Four-level hierarchical timing wheel with 64 slots per level
+ *
+ * A timer sits at the lowest level whose window still contains it relative
+ * to the wheel's current time: level 0 covers the current 64-tick block,
+ * level 1 the current 4096-tick block, and so on up to 2^24 ticks. Timers
+ * further out wait in an overflow heap. Because every timer at level l
+ * expires after every timer at lower levels, the next expiry is found with
+ * one find-first-set on the lowest non-empty level's occupancy bitmap; slots
+ * above level 0 are cascaded down when reached, so each timer moves at most
+ * four times and insert/expire are O(1) amortized.
+ *
+ * Timers expiring at the same time fire in the order they were scheduled,
+ * which keeps simulations deterministic. Cancellation is lazy and O(1).
+ */
+class TimerWheel {
+private:
+    static const int LEVELS = 4;                ///< Number of wheel levels
+    static const int SLOT_BITS = 6;             ///< log2 of slots per level
+    static const int SLOTS = 1 << SLOT_BITS;    ///< Slots per level
+
+    /**
+     * @struct Entry
+     * @brief Storage for one scheduled timer
+     */
+    struct Entry {
+        int64_t expiry;         ///< Next expiry time
+        int64_t period;         ///< Re-arm interval (0 = one-shot)
+        uint64_t payload;       ///< Caller-defined value
+        uint64_t sequence;      ///< Scheduling order, for deterministic ties
+        uint32_t generation;    ///< Incremented when the entry is reused
+        bool active;            ///< False once cancelled or fired
+    };
+
+    int64_t now;                                        ///< Current wheel time
+    std::vector<Entry> entries;                         ///< Timer storage (slab)
+    std::vector<uint32_t> freeEntries;                  ///< Reusable entry indices
+    std::vector<uint32_t> slots[LEVELS][SLOTS];         ///< Entry indices per slot
+    uint64_t occupied[LEVELS];                          ///< Non-empty slot bitmap per level
+    std::vector<uint32_t> due;                          ///< Entries expiring at 'now', in order
+    size_t dueHead;                                     ///< Next entry of 'due' to fire
+    std::vector<uint32_t> overflow;                     ///< Far-future timers (min-heap)
+    uint64_t nextSequence;                              ///< Next scheduling sequence number
+    size_t activeCount;                                 ///< Scheduled, not cancelled timers
+    int64_t cachedNextExpiry;                           ///< Memoized nextExpiry() result
+    bool nextExpiryValid;                               ///< Whether cachedNextExpiry is current
+
+    /**
+     * @brief Heap order for overflow: true if entry a expires after entry b
+     */
+    bool expiresAfter(uint32_t a, uint32_t b) const;
+
+    /**
+     * @brief Place an entry at the wheel level matching its expiry
+     */
+    void place(uint32_t index);
+
+    /**
+     * @brief Move the earliest non-empty slot towards 'due'
+     *
+     * The wheel time only ever moves to the start of a slot at or before
+     * @p limit, so it never runs ahead of the caller's clock.
+     *
+     * @param limit Do not advance beyond this time
+     * @return true if progress was made, false if the next timer is after limit
+     */
+    bool cascade(int64_t limit);
+
+    /**
+     * @brief Release an entry for reuse
+     */
+    void release(uint32_t index);
+
+public:
+    static constexpr int64_t NO_TIMER = INT64_MAX;  ///< nextExpiry() when nothing is scheduled
+
+    /**
+     * @brief Construct an empty wheel
+     *
+     * @param startTime Initial wheel time
+     */
+    explicit TimerWheel(int64_t startTime = 0);
+
+    /**
+     * @brief Remove all timers and reset the wheel time
+     *
+     * @param startTime New wheel time
+     */
+    void clear(int64_t startTime = 0);
+
+    /**
+     * @brief Schedule a one-shot or periodic timer
+     *
+     * Expiry times in the past are treated as due now.
+     *
+     * @param expiry First expiry time
+     * @param payload Caller-defined value returned when the timer fires
+     * @param period Re-arm interval for periodic timers (0 = one-shot)
+     * @return uint64_t Handle for cancel()
+     */
+    uint64_t schedule(int64_t expiry, uint64_t payload, int64_t period = 0);
+
+    /**
+     * @brief Cancel a timer
+     *
+     * @param id Handle returned by schedule()
+     * @return true if the timer was still pending
+     */
+    bool cancel(uint64_t id);
+
+    /**
+     * @brief Time of the earliest pending timer
+     *
+     * Scans only the earliest non-empty slot, and the answer is memoized
+     * until the wheel changes, hence not const.
+     *
+     * @return int64_t Expiry time, or NO_TIMER if no timer is pending
+     */
+    int64_t nextExpiry();
+
+    /**
+     * @brief Fire the earliest timer expiring at or before @p time
+     *
+     * Periodic timers are re-armed at expiry + period before returning.
+     *
+     * @param time Current simulation time
+     * @param event Receives the expired timer
+     * @return true if a timer fired, false if none is due
+     */
+    bool popExpired(int64_t time, TimerEvent& event);
+
+    /**
+     * @brief Get the wheel's current time
+     */
+    int64_t getCurrentTime() const { return now; }
+
+    /**
+     * @brief Number of pending timers
+     */
+    size_t size() const { return activeCount; }
+
+    /**
+     * @brief Whether no timers are pending
+     */
+    bool empty() const { return activeCount == 0; }
+};
+
+#endif // TIMER_WHEEL_H
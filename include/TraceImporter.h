@@ -0,0 +1,227 @@
+#ifndef TRACE_IMPORTER_H
+#define TRACE_IMPORTER_H
+
+#include "Process.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @file TraceImporter.h
+ * @brief Streaming importers for public cluster traces (CSV)
+ *
+ * Reads the Google Borg 2019 instance_events table (as exported to CSV,
+ * with a header row) and the Alibaba 2018 batch_task / batch_instance
+ * files, and turns them into tasks with an arrival time, duration, CPU
+ * request, priority and scheduling class. Input is decoded in parallel
+ * blocks and filtered while parsing, so a slice of a multi-terabyte trace
+ * costs memory proportional to the slice, not to the trace.
+ */
+
+/**
+ * @enum TraceFormat
+ * @brief Supported trace schemas
+ */
+enum class TraceFormat {
+    GOOGLE_2019,    ///< Borg 2019 instance_events CSV (header row required; times in microseconds)
+    ALIBABA_2018    ///< Alibaba 2018 batch_task (9 columns) or batch_instance (14 columns); times in seconds
+};
+
+/**
+ * @struct TraceTask
+ * @brief One task execution from a trace; times in seconds
+ */
+struct TraceTask {
+    int64_t jobId;          ///< Google collection_id / Alibaba job number
+    int64_t taskIndex;      ///< Google instance_index / Alibaba task or instance number
+    int64_t arrival;        ///< Submission (Google) or start (Alibaba) time
+    int64_t duration;       ///< Time from start to termination (at least 1)
+    double cpuRequest;      ///< CPUs requested (Google: normalized to the largest machine)
+    int priority;           ///< Trace priority (Google 0-450; Alibaba 0)
+    int schedulingClass;    ///< Google scheduling_class / Alibaba task_type
+    int64_t machineId;      ///< Machine the task ran on (-1 = unknown)
+};
+
+/**
+ * @struct TraceFilter
+ * @brief Which tasks to keep
+ */
+struct TraceFilter {
+    int64_t windowStart;                    ///< Keep arrivals at or after this time (seconds)
+    int64_t windowEnd;                      ///< Keep arrivals before this time (-1 = no limit)
+    std::unordered_set<int64_t> machines;   ///< Keep tasks on these machines (empty = all)
+
+    TraceFilter() : windowStart(0), windowEnd(-1) {}
+};
+
+/**
+ * @class TraceImporter
+ * @brief Reads TraceTask records from a trace stream
+ *
+ * The stream is read in blocks of numThreads * BLOCK_BYTES. Each block is
+ * cut at line boundaries into one segment per thread, the segments are
+ * parsed and filtered in parallel, and their rows are consumed in file
+ * order. Google rows are events: a task is emitted when its terminal
+ * event (FINISH, KILL, FAIL, EVICT, LOST) follows a SCHEDULE, and only
+ * tasks whose SUBMIT lies in the window are tracked. Alibaba rows are
+ * complete tasks. The machine filter applies to rows that name a machine
+ * (Google SCHEDULE events, Alibaba batch_instance).
+ *
+ * Malformed input never throws: bad rows are counted and skipped, and a
+ * missing Google header is reported by getError().
+ */
+class TraceImporter {
+public:
+    /// Bytes decoded per thread per block
+    static constexpr size_t BLOCK_BYTES = 1 << 20;
+
+private:
+    /**
+     * @struct Row
+     * @brief One parsed line, common to both formats
+     */
+    struct Row {
+        int64_t time;           ///< Event time (Google) or start time (Alibaba), seconds
+        int64_t end;            ///< Alibaba end time, seconds
+        int type;               ///< Google event type (-1 for Alibaba)
+        int64_t jobId;          ///< Collection / job
+        int64_t taskIndex;      ///< Instance / task
+        int64_t machineId;      ///< Machine (-1 = none)
+        double cpu;             ///< CPU request
+        int priority;           ///< Priority
+        int schedulingClass;    ///< Scheduling class
+    };
+
+    /**
+     * @struct OpenTask
+     * @brief A Google task between SUBMIT and its terminal event
+     */
+    struct OpenTask {
+        int64_t submit;         ///< SUBMIT time
+        int64_t scheduled;      ///< SCHEDULE time (-1 = pending)
+        int64_t machineId;      ///< Machine from SCHEDULE
+        double cpu;             ///< CPU request
+        int priority;           ///< Priority
+        int schedulingClass;    ///< Scheduling class
+    };
+
+    /**
+     * @struct GoogleColumns
+     * @brief Column positions from the Google header (-1 = absent)
+     */
+    struct GoogleColumns {
+        int time, type, collection, instance, machine, priority, schedulingClass, cpus;
+    };
+
+    std::istream& in;                   ///< Source
+    TraceFormat format;                 ///< Schema
+    TraceFilter filter;                 ///< Kept tasks
+    int numThreads;                     ///< Decoding threads
+    GoogleColumns columns;              ///< Google column map
+    std::string carry;                  ///< Partial line left from the previous block
+    std::deque<TraceTask> ready;        ///< Decoded tasks not yet returned
+    std::unordered_map<uint64_t, OpenTask> open;    ///< Google tasks awaiting termination
+    std::string error;                  ///< Fatal input problem ("" = none)
+    bool headerRead;                    ///< Google header consumed
+    bool exhausted;                     ///< Stream fully read
+    size_t rows;                        ///< Data lines decoded
+    size_t malformed;                   ///< Data lines that could not be parsed
+    size_t filtered;                    ///< Rows or tasks dropped by the filter
+
+    /**
+     * @brief Read the Google header and locate the columns
+     */
+    bool readGoogleHeader();
+
+    /**
+     * @brief Parse one line into a Row
+     *
+     * @return int 1 = row, 0 = filtered, 2 = event type not used, -1 = malformed
+     */
+    int parseLine(const char* begin, const char* end, Row& row) const;
+
+    /**
+     * @brief Parse a segment of whole lines
+     */
+    void parseSegment(const char* begin, const char* end, std::vector<Row>& out,
+                      size_t& lines, size_t& badLines, size_t& droppedLines) const;
+
+    /**
+     * @brief Turn rows into tasks, in file order
+     */
+    void consume(const std::vector<Row>& rowsIn);
+
+    /**
+     * @brief Decode the next block of the stream into ready
+     */
+    void fill();
+
+    /**
+     * @brief Key of a Google task
+     */
+    static uint64_t taskKey(int64_t jobId, int64_t taskIndex);
+
+public:
+    /**
+     * @brief Import from @p in, which must outlive the importer
+     *
+     * @param in Trace stream
+     * @param format Schema
+     * @param filter Tasks to keep
+     * @param numThreads Decoding threads (0 = hardware concurrency)
+     */
+    TraceImporter(std::istream& in, TraceFormat format, const TraceFilter& filter = TraceFilter(),
+                  int numThreads = 0);
+
+    /**
+     * @brief Next task that passes the filter
+     *
+     * @return bool false at end of input or on a fatal error
+     */
+    bool next(TraceTask& task);
+
+    /**
+     * @brief Fatal input problem, "" if none
+     */
+    const std::string& getError() const { return error; }
+
+    /**
+     * @brief Data lines decoded so far
+     */
+    size_t getRows() const { return rows; }
+
+    /**
+     * @brief Data lines skipped as malformed
+     */
+    size_t getMalformedRows() const { return malformed; }
+
+    /**
+     * @brief Rows or tasks dropped by the window or machine filter
+     */
+    size_t getFiltered() const { return filtered; }
+
+    /**
+     * @brief Parse "google" or "alibaba"
+     *
+     * @return bool false if the name is unknown
+     */
+    static bool parseFormat(const std::string& name, TraceFormat& format);
+
+    /**
+     * @brief Make a simulator process from a task
+     *
+     * @param task Imported task
+     * @param pid Process ID to assign
+     * @param origin Trace time mapped to simulation time 0
+     * @return std::shared_ptr<Process> Process "J<job>.<task>" with burst = duration
+     */
+    static std::shared_ptr<Process> toProcess(const TraceTask& task, int pid, int64_t origin);
+};
+
+#endif // TRACE_IMPORTER_H
@@ -0,0 +1,155 @@
+#ifndef WORKFLOW_H
+#define WORKFLOW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Scheduler;
+
+/**
+ * @file Workflow.h
+ * @brief Directed acyclic graphs of tasks (pipelines, fork-join workflows)
+ *
+ * A task may start only when every task it depends on has finished. The
+ * graph is kept in compressed sparse row form so that graphs of tens of
+ * millions of tasks fit in memory: one cost per task, one offset per task
+ * and one entry per edge.
+ */
+
+/**
+ * @class Workflow
+ * @brief A task DAG with per-task costs
+ *
+ * Tasks and edges are added first; finalize() then builds the successor
+ * lists, the predecessor counts and a topological order in O(tasks +
+ * edges). The accessors below require a finalized workflow.
+ */
+class Workflow {
+private:
+    std::vector<int64_t> costs;             ///< Work of each task (>= 0)
+    std::vector<int> edgeFrom;              ///< Edge sources, until finalize()
+    std::vector<int> edgeTo;                ///< Edge targets, until finalize()
+    std::vector<size_t> successorStart;     ///< Per task: offset into successors
+    std::vector<int> successors;            ///< Successor tasks, grouped by predecessor
+    std::vector<int> predecessorCounts;     ///< Per task: number of incoming edges
+    std::vector<int> order;                 ///< Topological order
+    bool finalized;                         ///< Successor lists are current
+    bool acyclic;                           ///< order covers every task
+
+    /**
+     * @brief Return a finalized workflow to the edge-list form
+     */
+    void reopen();
+
+public:
+    /**
+     * @brief Construct an empty workflow
+     */
+    Workflow();
+
+    /**
+     * @brief Add a task
+     *
+     * @param cost Work of the task (negative values are treated as 0)
+     * @return int Index of the new task
+     */
+    int addTask(int64_t cost);
+
+    /**
+     * @brief Make task @p to depend on task @p from
+     *
+     * @return false if either index is out of range or they are equal
+     */
+    bool addEdge(int from, int to);
+
+    /**
+     * @brief Build successor lists and a topological order
+     *
+     * @return false if the graph has a cycle (the order then holds only
+     *         the tasks not on or behind a cycle)
+     */
+    bool finalize();
+
+    /**
+     * @brief Whether finalize() has run since the last change
+     */
+    bool isFinalized() const { return finalized; }
+
+    /**
+     * @brief Whether the last finalize() found no cycle
+     */
+    bool isAcyclic() const { return finalized && acyclic; }
+
+    /**
+     * @brief Number of tasks
+     */
+    size_t size() const { return costs.size(); }
+
+    /**
+     * @brief Number of edges
+     */
+    size_t edgeCount() const { return finalized ? successors.size() : edgeFrom.size(); }
+
+    /**
+     * @brief Work of a task
+     */
+    int64_t getCost(int task) const { return costs[static_cast<size_t>(task)]; }
+
+    /**
+     * @brief Per-task offsets into getSuccessors(); task i owns
+     *        [start[i], start[i + 1])
+     */
+    const std::vector<size_t>& getSuccessorStart() const { return successorStart; }
+
+    /**
+     * @brief Successor tasks, grouped by predecessor
+     */
+    const std::vector<int>& getSuccessors() const { return successors; }
+
+    /**
+     * @brief Number of predecessors of each task
+     */
+    const std::vector<int>& getPredecessorCounts() const { return predecessorCounts; }
+
+    /**
+     * @brief Tasks in an order where every edge points forward
+     */
+    const std::vector<int>& getTopologicalOrder() const { return order; }
+
+    /**
+     * @brief Add the workflow to a scheduler as processes with dependencies
+     *
+     * Task i becomes process "T<i>" with PID firstPid + i, arrival 0 and
+     * burst equal to its cost; each edge becomes a dependency.
+     *
+     * @param scheduler Scheduler to fill
+     * @param firstPid PID of task 0
+     */
+    void addToScheduler(Scheduler& scheduler, int firstPid = 1) const;
+
+    /**
+     * @brief Build a chain of fork-join stages
+     *
+     * Each stage is a fork task, @p width parallel tasks and a join task;
+     * the join of one stage is the fork of the next. Costs are drawn
+     * uniformly from [minCost, maxCost].
+     *
+     * @return Workflow Finalized workflow of stages * (width + 1) + 1 tasks
+     */
+    static Workflow forkJoin(int stages, int width, int64_t minCost, int64_t maxCost,
+                             uint64_t seed);
+
+    /**
+     * @brief Build a random layered DAG
+     *
+     * Tasks are split into layers of @p width; every task after the first
+     * layer depends on 1 to @p maxFanIn distinct tasks of the layer before.
+     *
+     * @return Workflow Finalized workflow of @p tasks tasks
+     */
+    static Workflow layered(int tasks, int width, int maxFanIn, int64_t minCost,
+                            int64_t maxCost, uint64_t seed);
+};
+
+#endif // WORKFLOW_H
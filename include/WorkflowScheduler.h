@@ -0,0 +1,132 @@
+#ifndef WORKFLOW_SCHEDULER_H
+#define WORKFLOW_SCHEDULER_H
+
+#include "Workflow.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file WorkflowScheduler.h
+ * @brief Critical-path-aware list scheduling of task DAGs on several CPUs
+ *
+ * The CPU schedulers admit a process once it has arrived and its
+ * dependencies have finished, but they choose among ready processes
+ * without looking at the graph behind them. The policies here rank tasks
+ * by the longest path still ahead of them, which is what bounds the
+ * makespan of a workflow.
+ */
+
+/**
+ * @enum WorkflowPolicy
+ * @brief How ready tasks are ordered and placed
+ */
+enum class WorkflowPolicy {
+    FIFO,           ///< Ready order; the fastest idle CPU takes the oldest ready task
+    LONGEST_PATH,   ///< Ready task with the longest remaining path first, on the fastest idle CPU
+    HEFT            ///< Static list in upward-rank order, each task on the CPU that finishes it earliest
+};
+
+/**
+ * @struct WorkflowMetrics
+ * @brief Results of scheduling one workflow
+ */
+struct WorkflowMetrics {
+    size_t tasks;               ///< Tasks scheduled (0 if the workflow has a cycle)
+    int64_t makespan;           ///< Completion time of the last task
+    int64_t criticalPath;       ///< Longest path at the fastest CPU's speed (a lower bound)
+    int64_t slack;              ///< makespan - criticalPath
+    size_t criticalTasks;       ///< Tasks on a critical path (zero static slack)
+    double averageTaskSlack;    ///< Mean of criticalPath - longest path through each task
+    double averageWait;         ///< Mean time from all predecessors finished to start
+    double utilization;         ///< Busy CPU time / (CPUs * makespan), in %
+};
+
+/**
+ * @class WorkflowScheduler
+ * @brief Non-preemptive list scheduler for a Workflow
+ *
+ * Task i takes ceil(cost / speed) on a CPU of the given speed. A task's
+ * rank is its bottom level: its own duration plus the longest chain of
+ * successors after it, at the fastest speed. HEFT's upward rank uses mean
+ * execution times, a positive rescaling of the same quantity when there
+ * are no communication costs, so both list policies use the bottom level.
+ *
+ * FIFO and LONGEST_PATH are dynamic: time advances from completion to
+ * completion, each completion releases the successors whose last
+ * predecessor it was, and idle CPUs take ready tasks in policy order.
+ * HEFT places tasks in decreasing rank (a topological order) on the CPU
+ * with the earliest finish time. CPUs of equal speed share a heap, so a
+ * placement costs O(log CPUs) per speed class. Levels, release and
+ * placement together are O((tasks + edges) + tasks log tasks).
+ */
+class WorkflowScheduler {
+private:
+    std::vector<double> speeds;         ///< Relative speed of each CPU
+    WorkflowPolicy policy;              ///< Ordering and placement
+    std::vector<int64_t> startTimes;    ///< Start of each task, after run()
+    std::vector<int64_t> finishTimes;   ///< Finish of each task, after run()
+    std::vector<int> cpus;              ///< CPU of each task, after run()
+
+    /**
+     * @brief Duration of a task of @p cost on a CPU of @p speed
+     */
+    static int64_t duration(int64_t cost, double speed);
+
+    /**
+     * @brief Event-driven simulation for FIFO and LONGEST_PATH
+     */
+    void runDynamic(const Workflow& workflow, const std::vector<int64_t>& bottom,
+                    double& waitSum);
+
+    /**
+     * @brief Static earliest-finish-time placement in rank order
+     */
+    void runHeft(const Workflow& workflow, const std::vector<int64_t>& bottom,
+                 double& waitSum);
+
+public:
+    /**
+     * @brief Schedule on @p cpuCount identical CPUs
+     */
+    WorkflowScheduler(int cpuCount, WorkflowPolicy policy);
+
+    /**
+     * @brief Schedule on CPUs of the given relative speeds
+     *
+     * @param speeds One entry per CPU; non-positive entries count as 1
+     * @param policy Ordering and placement
+     */
+    WorkflowScheduler(const std::vector<double>& speeds, WorkflowPolicy policy);
+
+    /**
+     * @brief Schedule a finalized workflow
+     *
+     * @return WorkflowMetrics Results; tasks is 0 if the workflow is not
+     *         finalized or has a cycle
+     */
+    WorkflowMetrics run(const Workflow& workflow);
+
+    /**
+     * @brief Start time of each task of the last run
+     */
+    const std::vector<int64_t>& getStartTimes() const { return startTimes; }
+
+    /**
+     * @brief Finish time of each task of the last run
+     */
+    const std::vector<int64_t>& getFinishTimes() const { return finishTimes; }
+
+    /**
+     * @brief CPU of each task of the last run
+     */
+    const std::vector<int>& getCpus() const { return cpus; }
+
+    /**
+     * @brief Policy name
+     */
+    static std::string policyName(WorkflowPolicy policy);
+};
+
+#endif // WORKFLOW_SCHEDULER_H
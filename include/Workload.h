@@ -0,0 +1,115 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "Process.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * @file Workload.h
+ * @brief Seeded random workload generation for repeated simulation runs
+ *
+ * Describes a workload as a distribution of interarrival times, burst times
+ * and priorities, and draws concrete process sets (replicas) from it. The
+ * same seed always produces the same replica, on every platform, so several
+ * scheduling policies can be compared on identical inputs.
+ */
+
+/**
+ * @enum BurstDistribution
+ * @brief Shape of the CPU burst time distribution
+ */
+enum class BurstDistribution {
+    CONSTANT,       ///< Every burst equals the mean
+    UNIFORM,        ///< Uniform on [1, 2 * mean - 1]
+    EXPONENTIAL     ///< Exponential with the given mean (rounded, at least 1)
+};
+
+/**
+ * @struct WorkloadDistribution
+ * @brief Parameters from which workload replicas are drawn
+ *
+ * Interarrival times are exponential (Poisson arrivals). Priorities are
+ * drawn uniformly from [minPriority, maxPriority]. With numLocks > 0, a
+ * process has, with criticalSectionProbability, one critical section on a
+ * uniformly chosen lock, starting and ending at uniform points of its burst.
+ */
+struct WorkloadDistribution {
+    int numProcesses;                       ///< Processes per replica
+    double meanInterarrival;                ///< Mean time between arrivals
+    double meanBurst;                       ///< Mean CPU burst time
+    BurstDistribution burstDistribution;    ///< Shape of the burst distribution
+    int minPriority;                        ///< Lowest priority number drawn
+    int maxPriority;                        ///< Highest priority number drawn
+    int numLocks;                           ///< Shared locks (0 = processes use no locks)
+    double criticalSectionProbability;      ///< Chance that a process has a critical section
+
+    WorkloadDistribution()
+        : numProcesses(20), meanInterarrival(4.0), meanBurst(3.0),
+          burstDistribution(BurstDistribution::EXPONENTIAL),
+          minPriority(0), maxPriority(3), numLocks(0), criticalSectionProbability(0.5) {}
+};
+
+/**
+ * @class WorkloadGenerator
+ * @brief Draws process sets from a WorkloadDistribution
+ *
+ * Sampling is done by inverse transform on the raw output of std::mt19937_64,
+ * whose sequence is fixed by the standard. The standard library distribution
+ * classes are deliberately avoided because their output is
+ * implementation-defined.
+ */
+class WorkloadGenerator {
+private:
+    WorkloadDistribution distribution;      ///< Distribution to sample from
+
+public:
+    /**
+     * @brief Construct a generator for the given distribution
+     *
+     * @param distribution Workload parameters
+     */
+    explicit WorkloadGenerator(const WorkloadDistribution& distribution);
+
+    /**
+     * @brief Generate one workload replica
+     *
+     * Processes are numbered 1..numProcesses in arrival order and named
+     * "P<pid>". The first process arrives at time 0.
+     *
+     * @param seed Replica seed
+     * @return std::vector<std::shared_ptr<Process>> Fresh processes in NEW state
+     */
+    std::vector<std::shared_ptr<Process>> generate(uint64_t seed) const;
+
+    /**
+     * @brief Get the distribution this generator samples from
+     *
+     * @return const WorkloadDistribution& Workload parameters
+     */
+    const WorkloadDistribution& getDistribution() const { return distribution; }
+
+    /**
+     * @brief Derive a well-mixed seed for replica @p index
+     *
+     * Uses the SplitMix64 finalizer so that consecutive replica indices give
+     * unrelated random streams.
+     *
+     * @param baseSeed Experiment seed
+     * @param index Replica index
+     * @return uint64_t Seed for that replica
+     */
+    static uint64_t replicaSeed(uint64_t baseSeed, uint64_t index);
+
+    /**
+     * @brief Draw a uniform double in [0, 1) from a 64-bit engine
+     *
+     * @param engine Random engine
+     * @return double Uniform sample
+     */
+    static double uniform01(std::mt19937_64& engine);
+};
+
+#endif // WORKLOAD_H
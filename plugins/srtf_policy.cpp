@@ -0,0 +1,72 @@
+#include "PolicyPlugin.h"
+#include "ExtScheduler.h"
+#include <cstdlib>
+
+/**
+ * @file srtf_policy.cpp
+ * @brief Example plugin: preemptive Shortest Remaining Time First
+ *
+ * Written as an ExtScheduler policy, so the engine is instantiated and
+ * inlined inside the plugin. Build with `make plugins`; load with
+ * `scheduler_sim --plugin bin/srtf_policy.so` or menu option 12.
+ */
+
+/**
+ * @struct SrtfPolicy
+ * @brief Runs the task with the least remaining work; arrivals preempt longer tasks
+ */
+struct SrtfPolicy : ExtPolicy {
+    static constexpr uint64_t QUEUE = 0;    ///< VTIME DSQ keyed by remaining time
+
+    std::string name() const { return "Shortest Remaining Time First"; }
+
+    void init(ExtContext& ctx) {
+        ctx.createDsq(QUEUE, DsqOrder::VTIME);
+    }
+
+    int selectCpu(ExtContext& ctx, int task, int prevCpu) {
+        bool isIdle = false;
+        return ctx.selectCpuDefault(task, prevCpu, isIdle);
+    }
+
+    void enqueue(ExtContext& ctx, int task, uint64_t enqFlags) {
+        int remaining = ctx.process(task).getRemainingTime();
+        ctx.insertVtime(task, QUEUE, remaining, static_cast<uint64_t>(remaining));
+        if (!(enqFlags & ExtContext::ENQ_WAKEUP)) {
+            return;
+        }
+
+        // Preempt the CPU running the longest remaining task, unless one is idle
+        int victim = -1;
+        int longest = remaining;
+        for (int cpu = 0; cpu < ctx.nrCpus(); cpu++) {
+            int current = ctx.currentTask(cpu);
+            if (current == -1) {
+                return;
+            }
+            if (ctx.process(current).getRemainingTime() > longest) {
+                longest = ctx.process(current).getRemainingTime();
+                victim = cpu;
+            }
+        }
+        if (victim != -1) {
+            ctx.kickCpu(victim, true);
+        }
+    }
+
+    void dispatch(ExtContext& ctx, int cpu) {
+        ctx.moveToLocal(QUEUE, cpu);
+    }
+};
+
+/**
+ * @brief Plugin factory; args is the number of CPUs ("" = 1)
+ */
+static Scheduler* createSrtf(const char* args) {
+    int numCpus = args != nullptr && *args != '\0' ? std::atoi(args) : 1;
+    return new ExtScheduler<SrtfPolicy>(numCpus);
+}
+
+EXPORT_SCHEDULER_PLUGIN("SRTF (plugin)",
+                        "Preemptive shortest remaining time first on the sched_ext-style engine",
+                        createSrtf)
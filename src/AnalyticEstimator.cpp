@@ -0,0 +1,198 @@
+#include "AnalyticEstimator.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+/**
+ * @file AnalyticEstimator.cpp
+ * @brief Implementation of the queueing-theory estimator
+ */
+
+/**
+ * @brief First two moments of max(1, round(X)) for a continuous X with CDF @p cdf
+ */
+static void discretizedMoments(const std::function<double(double)>& cdf,
+                               double& mean, double& secondMoment) {
+    mean = 0;
+    secondMoment = 0;
+    double below = 0;  // Everything below 1.5 rounds to 1
+    for (int k = 1; k < 10000000; k++) {
+        double upper = cdf(k + 0.5);
+        double p = upper - below;
+        mean += p * k;
+        secondMoment += p * static_cast<double>(k) * k;
+        below = upper;
+        if (upper >= 1.0 - 1e-15) {
+            break;
+        }
+    }
+}
+
+QueueingParameters AnalyticEstimator::fromWorkload(const WorkloadDistribution& distribution,
+                                                   int servers) {
+    QueueingParameters parameters;
+    parameters.servers = servers;
+    parameters.arrivalRate = distribution.meanInterarrival > 0
+        ? 1.0 / distribution.meanInterarrival : 0.0;
+
+    double m = distribution.meanBurst;
+    switch (distribution.burstDistribution) {
+        case BurstDistribution::CONSTANT: {
+            double s = std::max(1.0, std::round(m));
+            parameters.meanService = s;
+            parameters.serviceSecondMoment = s * s;
+            break;
+        }
+        case BurstDistribution::UNIFORM: {
+            double low = 1.0;
+            double high = 2.0 * m - 1.0;
+            discretizedMoments([low, high](double x) {
+                if (high <= low) return x >= low ? 1.0 : 0.0;
+                return std::min(1.0, std::max(0.0, (x - low) / (high - low)));
+            }, parameters.meanService, parameters.serviceSecondMoment);
+            break;
+        }
+        case BurstDistribution::EXPONENTIAL:
+            discretizedMoments([m](double x) {
+                return x <= 0 ? 0.0 : 1.0 - std::exp(-x / m);
+            }, parameters.meanService, parameters.serviceSecondMoment);
+            break;
+    }
+
+    // Equally likely priority classes, highest priority (lowest number) first
+    int classes = std::max(0, distribution.maxPriority - distribution.minPriority) + 1;
+    parameters.classShares.assign(classes, 1.0 / classes);
+    return parameters;
+}
+
+double AnalyticEstimator::erlangC(int servers, double offeredLoad) {
+    if (offeredLoad >= servers) {
+        return 1.0;
+    }
+    // Iterate the Erlang B recursion, then convert to Erlang C
+    double erlangB = 1.0;
+    for (int k = 1; k <= servers; k++) {
+        erlangB = offeredLoad * erlangB / (k + offeredLoad * erlangB);
+    }
+    double rho = offeredLoad / servers;
+    return erlangB / (1.0 - rho + rho * erlangB);
+}
+
+AnalyticPrediction AnalyticEstimator::predict(const QueueingParameters& parameters,
+                                              QueueDiscipline discipline) {
+    AnalyticPrediction prediction;
+    prediction.discipline = discipline;
+    prediction.utilization = parameters.utilization();
+    prediction.stable = prediction.utilization < 1.0;
+    prediction.exact = true;
+    prediction.meanWaitingTime = std::numeric_limits<double>::infinity();
+    prediction.meanTurnaroundTime = std::numeric_limits<double>::infinity();
+
+    double lambda = parameters.arrivalRate;
+    double es = parameters.meanService;
+    double es2 = parameters.serviceSecondMoment;
+    double rho = prediction.utilization;
+
+    if (parameters.servers > 1 && discipline != QueueDiscipline::FCFS) {
+        prediction.model = "unsupported for c > 1";
+        prediction.stable = false;
+        return prediction;
+    }
+
+    switch (discipline) {
+        case QueueDiscipline::FCFS:
+            if (parameters.servers == 1) {
+                prediction.model = "M/G/1 Pollaczek-Khinchine";
+                if (prediction.stable) {
+                    prediction.meanWaitingTime = lambda * es2 / (2.0 * (1.0 - rho));
+                }
+            } else {
+                double scv = parameters.serviceSCV();
+                prediction.exact = std::fabs(scv - 1.0) < 1e-9;
+                prediction.model = prediction.exact ? "M/M/c Erlang C"
+                                                    : "M/G/c Allen-Cunneen";
+                if (prediction.stable) {
+                    double offered = lambda * es;
+                    double waitMMc = erlangC(parameters.servers, offered) * es /
+                                     (parameters.servers - offered);
+                    prediction.meanWaitingTime = waitMMc * (1.0 + scv) / 2.0;
+                }
+            }
+            if (prediction.stable) {
+                prediction.meanTurnaroundTime = prediction.meanWaitingTime + es;
+            }
+            break;
+
+        case QueueDiscipline::PROCESSOR_SHARING:
+            // Insensitive to the service distribution beyond its mean
+            prediction.model = "M/G/1 Processor Sharing";
+            if (prediction.stable) {
+                prediction.meanTurnaroundTime = es / (1.0 - rho);
+                prediction.meanWaitingTime = prediction.meanTurnaroundTime - es;
+            }
+            break;
+
+        case QueueDiscipline::NONPREEMPTIVE_PRIORITY:
+        case QueueDiscipline::PREEMPTIVE_PRIORITY: {
+            bool preemptive = discipline == QueueDiscipline::PREEMPTIVE_PRIORITY;
+            prediction.model = preemptive ? "M/G/1 preemptive-resume priority"
+                                          : "M/G/1 Cobham non-preemptive priority";
+            if (!prediction.stable) {
+                break;
+            }
+
+            double sigmaBefore = 0;     // Load of strictly higher classes
+            double residualUpTo = 0;    // Residual work of classes up to k
+            double total = 0;
+            for (double share : parameters.classShares) {
+                double lambdaK = lambda * share;
+                double sigmaK = sigmaBefore + lambdaK * es;
+                residualUpTo += lambdaK * es2 / 2.0;
+
+                double turnaround;
+                if (preemptive) {
+                    turnaround = es / (1.0 - sigmaBefore) +
+                                 residualUpTo / ((1.0 - sigmaBefore) * (1.0 - sigmaK));
+                } else {
+                    double residualAll = lambda * es2 / 2.0;
+                    turnaround = residualAll / ((1.0 - sigmaBefore) * (1.0 - sigmaK)) + es;
+                }
+                prediction.classTurnaroundTimes.push_back(turnaround);
+                total += share * turnaround;
+                sigmaBefore = sigmaK;
+            }
+            prediction.meanTurnaroundTime = total;
+            prediction.meanWaitingTime = total - es;
+            break;
+        }
+    }
+
+    return prediction;
+}
+
+AnalyticCheck AnalyticEstimator::check(double predicted, const IntervalEstimate& simulated,
+                                       double tolerance) {
+    AnalyticCheck result;
+    result.predicted = predicted;
+    result.simulated = simulated.mean;
+    result.relativeError = predicted != 0 ? (simulated.mean - predicted) / predicted : 0.0;
+    result.disagrees = !std::isfinite(predicted) ||
+                       std::fabs(simulated.mean - predicted) >
+                           tolerance * std::fabs(predicted) + simulated.halfWidth;
+    return result;
+}
+
+std::string AnalyticEstimator::disciplineName(QueueDiscipline discipline) {
+    switch (discipline) {
+        case QueueDiscipline::FCFS:
+            return "FCFS";
+        case QueueDiscipline::PROCESSOR_SHARING:
+            return "Processor Sharing";
+        case QueueDiscipline::NONPREEMPTIVE_PRIORITY:
+            return "Non-Preemptive Priority";
+        case QueueDiscipline::PREEMPTIVE_PRIORITY:
+            return "Preemptive Priority";
+    }
+    return "Unknown";
+}
@@ -0,0 +1,311 @@
+#include "AvailabilityProfile.h"
+#include <algorithm>
+
+/**
+ * @file AvailabilityProfile.cpp
+ * @brief Implementation of the treap-backed free-processor profile
+ */
+
+AvailabilityProfile::AvailabilityProfile(int capacity, int64_t origin) {
+    clear(capacity, origin);
+}
+
+void AvailabilityProfile::clear(int capacity, int64_t origin) {
+    nodes.clear();
+    freeNodes.clear();
+    this->capacity = capacity;
+    this->origin = origin;
+    count = 0;
+    randomState = 0x9E3779B97F4A7C15ULL;
+    root = newNode(origin, capacity);
+}
+
+int AvailabilityProfile::newNode(int64_t key, int value) {
+    // xorshift64: priorities only need to be unpredictable to the input
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+
+    Node node = {key, value, 0, value, value, static_cast<uint32_t>(randomState >> 32), -1, -1};
+    count++;
+    if (!freeNodes.empty()) {
+        int index = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[index] = node;
+        return index;
+    }
+    nodes.push_back(node);
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+void AvailabilityProfile::apply(int node, int delta) {
+    if (node == -1) {
+        return;
+    }
+    Node& n = nodes[node];
+    n.value += delta;
+    n.subMin += delta;
+    n.subMax += delta;
+    n.add += delta;
+}
+
+void AvailabilityProfile::push(int node) {
+    Node& n = nodes[node];
+    if (n.add != 0) {
+        apply(n.left, n.add);
+        apply(n.right, n.add);
+        n.add = 0;
+    }
+}
+
+void AvailabilityProfile::pull(int node) {
+    Node& n = nodes[node];
+    n.subMin = n.value;
+    n.subMax = n.value;
+    if (n.left != -1) {
+        n.subMin = std::min(n.subMin, nodes[n.left].subMin);
+        n.subMax = std::max(n.subMax, nodes[n.left].subMax);
+    }
+    if (n.right != -1) {
+        n.subMin = std::min(n.subMin, nodes[n.right].subMin);
+        n.subMax = std::max(n.subMax, nodes[n.right].subMax);
+    }
+}
+
+void AvailabilityProfile::split(int node, int64_t key, int& left, int& right) {
+    if (node == -1) {
+        left = -1;
+        right = -1;
+        return;
+    }
+    push(node);
+    if (nodes[node].key < key) {
+        split(nodes[node].right, key, nodes[node].right, right);
+        left = node;
+    } else {
+        split(nodes[node].left, key, left, nodes[node].left);
+        right = node;
+    }
+    pull(node);
+}
+
+int AvailabilityProfile::merge(int a, int b) {
+    if (a == -1) {
+        return b;
+    }
+    if (b == -1) {
+        return a;
+    }
+    if (nodes[a].priority > nodes[b].priority) {
+        push(a);
+        nodes[a].right = merge(nodes[a].right, b);
+        pull(a);
+        return a;
+    }
+    push(b);
+    nodes[b].left = merge(a, nodes[b].left);
+    pull(b);
+    return b;
+}
+
+int AvailabilityProfile::firstAtLeast(int node, int procs) {
+    while (node != -1 && nodes[node].subMax >= procs) {
+        push(node);
+        int left = nodes[node].left;
+        if (left != -1 && nodes[left].subMax >= procs) {
+            node = left;
+        } else if (nodes[node].value >= procs) {
+            return node;
+        } else {
+            node = nodes[node].right;
+        }
+    }
+    return -1;
+}
+
+int AvailabilityProfile::lastBelow(int node, int procs) {
+    while (node != -1 && nodes[node].subMin < procs) {
+        push(node);
+        int right = nodes[node].right;
+        if (right != -1 && nodes[right].subMin < procs) {
+            node = right;
+        } else if (nodes[node].value < procs) {
+            return node;
+        } else {
+            node = nodes[node].left;
+        }
+    }
+    return -1;
+}
+
+void AvailabilityProfile::ensureBreakpoint(int64_t time) {
+    int left, right;
+    split(root, time, left, right);
+
+    int first = right;
+    while (first != -1 && nodes[first].left != -1) {
+        first = nodes[first].left;
+    }
+    if (first == -1 || nodes[first].key != time) {
+        // The new step continues the value of its predecessor
+        int last = left;
+        while (nodes[last].right != -1) {
+            push(last);
+            last = nodes[last].right;
+        }
+        right = merge(newNode(time, nodes[last].value), right);
+    }
+    root = merge(left, right);
+}
+
+void AvailabilityProfile::addRange(int64_t start, int64_t end, int delta) {
+    start = std::max(start, origin);
+    if (end <= start || delta == 0) {
+        return;
+    }
+    ensureBreakpoint(start);
+    ensureBreakpoint(end);
+
+    int left, middle, right;
+    split(root, start, left, middle);
+    split(middle, end, middle, right);
+    apply(middle, delta);
+
+    // Only the steps at start and end changed relative to their
+    // predecessors; drop them if they no longer differ, so the profile
+    // holds at most two breakpoints per outstanding reservation
+    if (left != -1) {
+        int last = left;
+        while (nodes[last].right != -1) {
+            push(last);
+            last = nodes[last].right;
+        }
+        int first, rest;
+        split(middle, start + 1, first, rest);
+        if (nodes[first].value == nodes[last].value) {
+            release(first);
+            first = -1;
+        }
+        middle = merge(first, rest);
+    }
+    if (end != NEVER) {
+        int last = middle != -1 ? middle : left;
+        while (nodes[last].right != -1) {
+            push(last);
+            last = nodes[last].right;
+        }
+        int first, rest;
+        split(right, end + 1, first, rest);
+        if (nodes[first].value == nodes[last].value) {
+            release(first);
+            first = -1;
+        }
+        right = merge(first, rest);
+    }
+    root = merge(left, merge(middle, right));
+}
+
+void AvailabilityProfile::release(int node) {
+    if (node == -1) {
+        return;
+    }
+    std::vector<int> stack(1, node);
+    while (!stack.empty()) {
+        int n = stack.back();
+        stack.pop_back();
+        if (nodes[n].left != -1) {
+            stack.push_back(nodes[n].left);
+        }
+        if (nodes[n].right != -1) {
+            stack.push_back(nodes[n].right);
+        }
+        freeNodes.push_back(n);
+        count--;
+    }
+}
+
+int AvailabilityProfile::freeAt(int64_t time) {
+    int value = capacity;
+    int node = root;
+    while (node != -1) {
+        push(node);
+        if (nodes[node].key <= time) {
+            value = nodes[node].value;
+            node = nodes[node].right;
+        } else {
+            node = nodes[node].left;
+        }
+    }
+    return value;
+}
+
+int AvailabilityProfile::minFree(int64_t start, int64_t end) {
+    start = std::max(start, origin);
+    int value = freeAt(start);
+    if (end <= start + 1) {
+        return value;
+    }
+
+    int left, middle, right;
+    split(root, start + 1, left, middle);
+    split(middle, end, middle, right);
+    if (middle != -1) {
+        value = std::min(value, nodes[middle].subMin);
+    }
+    root = merge(left, merge(middle, right));
+    return value;
+}
+
+int64_t AvailabilityProfile::earliestStart(int64_t after, int64_t duration, int procs) {
+    int64_t start = std::max(after, origin);
+    if (procs > capacity) {
+        return NEVER;
+    }
+    if (procs <= 0) {
+        return start;
+    }
+
+    for (;;) {
+        int left, right;
+        if (freeAt(start) < procs) {
+            // Skip to the next step with room
+            split(root, start + 1, left, right);
+            int node = firstAtLeast(right, procs);
+            int64_t next = node != -1 ? nodes[node].key : NEVER;
+            root = merge(left, right);
+            if (next == NEVER) {
+                return NEVER;
+            }
+            start = next;
+        }
+        if (duration <= 1) {
+            return start;
+        }
+
+        // No start up to the last step in the window without room can work,
+        // so the next candidate is the first step with room after it
+        int64_t end = duration > NEVER - start ? NEVER : start + duration;
+        int middle;
+        split(root, start + 1, left, middle);
+        split(middle, end, middle, right);
+        int node = lastBelow(middle, procs);
+        int64_t blocker = node != -1 ? nodes[node].key : NEVER;
+        root = merge(left, merge(middle, right));
+        if (blocker == NEVER) {
+            return start;
+        }
+        start = blocker;
+    }
+}
+
+void AvailabilityProfile::advance(int64_t time) {
+    if (time <= origin) {
+        return;
+    }
+    ensureBreakpoint(time);
+    int left, right;
+    split(root, time, left, right);
+    release(left);
+    root = right;
+    origin = time;
+}
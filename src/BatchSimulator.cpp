@@ -0,0 +1,200 @@
+#include "BatchSimulator.h"
+#include <algorithm>
+
+/**
+ * @file BatchSimulator.cpp
+ * @brief Implementation of the FCFS / EASY / conservative backfilling simulator
+ */
+
+BatchSimulator::BatchSimulator(int cores, BackfillPolicy policy, int64_t slowdownThreshold)
+    : cores(cores), policy(policy), slowdownThreshold(std::max<int64_t>(1, slowdownThreshold)),
+      profile(cores, 0), nextSequence(0), now(0),
+      completed(0), backfilled(0), rejected(0), waitSum(0.0), slowdownSum(0.0),
+      slowdownMax(0.0), busy(0.0), firstSubmit(-1), lastEnd(0) {
+}
+
+std::string BatchSimulator::getName() const {
+    switch (policy) {
+        case BackfillPolicy::FCFS:
+            return "FCFS";
+        case BackfillPolicy::EASY:
+            return "EASY Backfilling";
+        case BackfillPolicy::CONSERVATIVE:
+            return "Conservative Backfilling";
+    }
+    return "";
+}
+
+bool BatchSimulator::fromSwf(const SwfJob& record, BatchJob& job) {
+    int procs = record.requestedProcessors > 0 ? record.requestedProcessors
+                                               : record.allocatedProcessors;
+    if (procs <= 0 || record.runTime < 0 || record.submitTime < 0) {
+        return false;
+    }
+    job.id = record.jobNumber;
+    job.submitTime = record.submitTime;
+    job.estimate = record.requestedTime > 0 ? record.requestedTime : record.runTime;
+    job.runTime = std::min(record.runTime, job.estimate);
+    job.procs = procs;
+    job.userId = record.userId;
+    job.groupId = record.groupId;
+    return true;
+}
+
+bool BatchSimulator::submit(const BatchJob& job) {
+    if (job.procs <= 0 || job.procs > cores || job.runTime < 0) {
+        rejected++;
+        return false;
+    }
+
+    int64_t time = std::max(job.submitTime, now);
+    completeUntil(time);
+    now = time;
+    profile.advance(now);
+    if (firstSubmit == -1) {
+        firstSubmit = now;
+    }
+
+    // A zero estimate would reserve nothing; every job holds its processors
+    // for at least one time unit in the profile
+    Waiting waiting = {job, -1, nextSequence++};
+    waiting.job.estimate = std::max<int64_t>(1, job.estimate);
+    waiting.job.runTime = std::min(job.runTime, waiting.job.estimate);
+    queue.push_back(waiting);
+
+    if (policy == BackfillPolicy::CONSERVATIVE) {
+        Waiting& queued = queue.back();
+        queued.reservedStart = profile.earliestStart(now, queued.job.estimate, queued.job.procs);
+        profile.reserve(queued.reservedStart, queued.reservedStart + queued.job.estimate,
+                        queued.job.procs);
+        reservations.emplace(queued.reservedStart, std::prev(queue.end()));
+    }
+    schedulePass();
+    return true;
+}
+
+std::list<BatchSimulator::Waiting>::iterator
+BatchSimulator::start(std::list<Waiting>::iterator it, bool outOfOrder) {
+    const BatchJob& job = it->job;
+    Running run = {now + job.runTime, now + job.estimate, now - job.submitTime, job.runTime, job.procs};
+    if (policy != BackfillPolicy::CONSERVATIVE) {
+        // Conservative jobs already hold exactly this range
+        profile.reserve(now, run.expectedEnd, job.procs);
+    }
+    running.push_back(run);
+    std::push_heap(running.begin(), running.end(), endsLater);
+    if (outOfOrder) {
+        backfilled++;
+    }
+    return queue.erase(it);
+}
+
+void BatchSimulator::completeUntil(int64_t time) {
+    for (;;) {
+        int64_t next = running.empty() ? AvailabilityProfile::NEVER : running.front().end;
+        if (!reservations.empty()) {
+            next = std::min(next, reservations.begin()->first);
+        }
+        if (next == AvailabilityProfile::NEVER || next > time) {
+            return;
+        }
+        now = std::max(now, next);
+
+        bool early = false;
+        while (!running.empty() && running.front().end <= now) {
+            std::pop_heap(running.begin(), running.end(), endsLater);
+            Running done = running.back();
+            running.pop_back();
+            if (done.expectedEnd > now) {
+                profile.release(now, done.expectedEnd, done.procs);
+                early = true;
+            }
+
+            double turnaround = static_cast<double>(done.wait + done.runTime);
+            double slowdown = std::max(1.0, turnaround / std::max(done.runTime, slowdownThreshold));
+            completed++;
+            waitSum += static_cast<double>(done.wait);
+            slowdownSum += slowdown;
+            slowdownMax = std::max(slowdownMax, slowdown);
+            busy += static_cast<double>(done.procs) * static_cast<double>(done.runTime);
+            lastEnd = std::max(lastEnd, now);
+        }
+
+        profile.advance(now);
+        if (early && policy == BackfillPolicy::CONSERVATIVE) {
+            compress();
+        }
+        schedulePass();
+    }
+}
+
+void BatchSimulator::compress() {
+    reservations.clear();
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+        const BatchJob& job = it->job;
+        profile.release(it->reservedStart, it->reservedStart + job.estimate, job.procs);
+        it->reservedStart = profile.earliestStart(now, job.estimate, job.procs);
+        profile.reserve(it->reservedStart, it->reservedStart + job.estimate, job.procs);
+        reservations.emplace(it->reservedStart, it);
+    }
+}
+
+void BatchSimulator::schedulePass() {
+    if (policy == BackfillPolicy::CONSERVATIVE) {
+        // Start every reservation that has come due, in queue order
+        std::vector<std::list<Waiting>::iterator> due;
+        while (!reservations.empty() && reservations.begin()->first <= now) {
+            due.push_back(reservations.begin()->second);
+            reservations.erase(reservations.begin());
+        }
+        std::sort(due.begin(), due.end(),
+                  [](std::list<Waiting>::iterator a, std::list<Waiting>::iterator b) {
+                      return a->sequence < b->sequence;
+                  });
+        for (auto it : due) {
+            start(it, it != queue.begin());
+        }
+        return;
+    }
+
+    while (!queue.empty() && profile.freeAt(now) >= queue.front().job.procs) {
+        start(queue.begin(), false);
+    }
+    if (policy == BackfillPolicy::FCFS || queue.size() < 2 || profile.freeAt(now) == 0) {
+        return;
+    }
+
+    // EASY: hold the head's earliest start, then let anything that fits
+    // around that reservation go now
+    const BatchJob& head = queue.front().job;
+    int64_t shadow = profile.earliestStart(now, head.estimate, head.procs);
+    profile.reserve(shadow, shadow + head.estimate, head.procs);
+    for (auto it = std::next(queue.begin()); it != queue.end();) {
+        if (profile.freeAt(now) == 0) {
+            break;
+        }
+        if (profile.minFree(now, now + it->job.estimate) >= it->job.procs) {
+            it = start(it, true);
+        } else {
+            ++it;
+        }
+    }
+    profile.release(shadow, shadow + head.estimate, head.procs);
+}
+
+BatchMetrics BatchSimulator::finish() {
+    completeUntil(AvailabilityProfile::NEVER - 1);
+
+    BatchMetrics metrics;
+    metrics.jobs = completed;
+    metrics.backfilled = backfilled;
+    metrics.rejected = rejected;
+    metrics.averageWait = completed > 0 ? waitSum / static_cast<double>(completed) : 0.0;
+    metrics.averageBoundedSlowdown = completed > 0 ? slowdownSum / static_cast<double>(completed) : 0.0;
+    metrics.maxBoundedSlowdown = slowdownMax;
+    metrics.makespan = firstSubmit == -1 ? 0 : lastEnd - firstSubmit;
+    metrics.utilization = metrics.makespan > 0
+        ? busy / (static_cast<double>(cores) * static_cast<double>(metrics.makespan))
+        : 0.0;
+    return metrics;
+}
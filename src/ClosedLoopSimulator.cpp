@@ -0,0 +1,238 @@
+#include "ClosedLoopSimulator.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+
+/**
+ * @file ClosedLoopSimulator.cpp
+ * @brief Implementation of the closed-loop interactive workload simulation
+ */
+
+namespace {
+
+/**
+ * @struct User
+ * @brief Per-user state; everything else about a user is recomputed on demand
+ */
+struct User {
+    int64_t submit;         ///< Submission time of the current request
+    int64_t remaining;      ///< Service still needed by the current request
+    uint32_t request;       ///< Index of the current request
+};
+
+/**
+ * @struct ReadyEntry
+ * @brief Queued request; smallest (key, sequence) runs first
+ */
+struct ReadyEntry {
+    int64_t key;            ///< 0, or the service time for SHORTEST_FIRST
+    uint64_t sequence;      ///< Enqueue order
+    int user;               ///< Owner
+
+    bool operator>(const ReadyEntry& other) const {
+        return key != other.key ? key > other.key : sequence > other.sequence;
+    }
+};
+
+/**
+ * @brief Uniform draw in [0, 1) for stream @p stream of request @p request of @p user
+ */
+double draw(uint64_t seed, int user, uint32_t request, uint64_t stream) {
+    uint64_t index = (static_cast<uint64_t>(user) << 33) | (static_cast<uint64_t>(request) << 1) | stream;
+    return static_cast<double>(WorkloadGenerator::replicaSeed(seed, index) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Time of the given shape and mean from a uniform draw, at least @p minimum
+ */
+int64_t sample(BurstDistribution shape, double mean, double u, int64_t minimum) {
+    double value = mean;
+    switch (shape) {
+        case BurstDistribution::CONSTANT:
+            break;
+        case BurstDistribution::UNIFORM:
+            value = minimum + u * (2.0 * mean - 2.0 * minimum);
+            break;
+        case BurstDistribution::EXPONENTIAL:
+            value = -mean * std::log(1.0 - u);
+            break;
+    }
+    return std::max(minimum, static_cast<int64_t>(std::llround(value)));
+}
+
+} // namespace
+
+ClosedLoopSimulator::ClosedLoopSimulator(const ClosedLoopConfig& config) : config(config) {
+    this->config.users = std::max(1, config.users);
+    this->config.cpus = std::max(1, config.cpus);
+    this->config.quantum = std::max(1, config.quantum);
+    this->config.meanThink = std::max(0.0, config.meanThink);
+    this->config.meanService = std::max(1.0, config.meanService);
+    this->config.warmup = std::max<int64_t>(0, config.warmup);
+    this->config.horizon = std::max(this->config.warmup + 1, config.horizon);
+}
+
+std::string ClosedLoopSimulator::disciplineName(ClosedLoopDiscipline discipline) {
+    switch (discipline) {
+        case ClosedLoopDiscipline::FCFS:
+            return "FCFS";
+        case ClosedLoopDiscipline::ROUND_ROBIN:
+            return "Round Robin";
+        case ClosedLoopDiscipline::SHORTEST_FIRST:
+            return "Shortest First";
+    }
+    return "Unknown";
+}
+
+double ClosedLoopSimulator::saturationUsers() const {
+    return config.cpus * (config.meanService + config.meanThink) / config.meanService;
+}
+
+void ClosedLoopSimulator::meanValueAnalysis(int users, double& response, double& throughput) const {
+    const double c = config.cpus;
+    const double queueDemand = config.meanService / c;
+    const double delay = config.meanService * (c - 1.0) / c;
+    double queueLength = 0.0;
+    response = config.meanService;
+    throughput = 0.0;
+    for (int n = 1; n <= users; n++) {
+        double queueResponse = queueDemand * (1.0 + queueLength);
+        response = queueResponse + delay;
+        throughput = n / (response + config.meanThink);
+        queueLength = throughput * queueResponse;
+    }
+}
+
+ClosedLoopMetrics ClosedLoopSimulator::run(int users) const {
+    users = std::max(1, users);
+    const size_t numCpus = static_cast<size_t>(config.cpus);
+    const bool roundRobin = config.discipline == ClosedLoopDiscipline::ROUND_ROBIN;
+    const bool shortestFirst = config.discipline == ClosedLoopDiscipline::SHORTEST_FIRST;
+    auto think = [this](int user, uint32_t request) {
+        return sample(config.thinkDistribution, config.meanThink, draw(config.seed, user, request, 0), 0);
+    };
+    auto service = [this](int user, uint32_t request) {
+        return sample(config.serviceDistribution, config.meanService, draw(config.seed, user, request, 1), 1);
+    };
+
+    // Every user starts by thinking; the heap holds each user's next submission
+    typedef std::pair<int64_t, int> Event;
+    std::vector<User> state(static_cast<size_t>(users), User{0, 0, 0});
+    std::vector<Event> initial;
+    initial.reserve(state.size());
+    for (int user = 0; user < users; user++) {
+        initial.emplace_back(think(user, 0), user);
+    }
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> thinking(
+        std::greater<Event>(), std::move(initial));
+
+    std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, std::greater<ReadyEntry>> ready;
+    uint64_t sequence = 0;
+    auto enqueue = [&](int user) {
+        ready.push(ReadyEntry{shortestFirst ? state[static_cast<size_t>(user)].remaining : 0, sequence++, user});
+    };
+
+    // Slice ends, (end, CPU); runningUser/slice describe what each CPU runs
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> running;
+    std::vector<int> runningUser(numCpus, -1);
+    std::vector<int64_t> slice(numCpus, 0);
+    std::vector<int> idle;
+    for (size_t cpu = numCpus; cpu-- > 0;) {
+        idle.push_back(static_cast<int>(cpu));
+    }
+
+    ClosedLoopMetrics metrics;
+    metrics.users = users;
+    metrics.completed = 0;
+    int64_t busy = 0;
+    std::vector<int> expired;
+    while (true) {
+        int64_t now = INT64_MAX;
+        if (!thinking.empty()) {
+            now = thinking.top().first;
+        }
+        if (!running.empty()) {
+            now = std::min(now, running.top().first);
+        }
+        if (now >= config.horizon) {
+            break;
+        }
+
+        // 1. Slices that end now
+        expired.clear();
+        while (!running.empty() && running.top().first == now) {
+            size_t cpu = static_cast<size_t>(running.top().second);
+            running.pop();
+            int user = runningUser[cpu];
+            User& current = state[static_cast<size_t>(user)];
+            current.remaining -= slice[cpu];
+            runningUser[cpu] = -1;
+            idle.push_back(static_cast<int>(cpu));
+            if (current.remaining > 0) {
+                expired.push_back(user);
+                continue;
+            }
+            if (now >= config.warmup) {
+                metrics.response.add(static_cast<double>(now - current.submit));
+                metrics.completed++;
+            }
+            current.request++;
+            thinking.emplace(now + think(user, current.request), user);
+        }
+
+        // 2. Users who finish thinking submit, ahead of expired quanta
+        while (!thinking.empty() && thinking.top().first == now) {
+            int user = thinking.top().second;
+            thinking.pop();
+            User& current = state[static_cast<size_t>(user)];
+            current.submit = now;
+            current.remaining = service(user, current.request);
+            enqueue(user);
+        }
+        for (int user : expired) {
+            enqueue(user);
+        }
+
+        // 3. Idle CPUs take queued requests
+        while (!idle.empty() && !ready.empty()) {
+            size_t cpu = static_cast<size_t>(idle.back());
+            idle.pop_back();
+            int user = ready.top().user;
+            ready.pop();
+            int64_t remaining = state[static_cast<size_t>(user)].remaining;
+            slice[cpu] = roundRobin ? std::min<int64_t>(config.quantum, remaining) : remaining;
+            runningUser[cpu] = user;
+            running.emplace(now + slice[cpu], static_cast<int>(cpu));
+            int64_t from = std::max(now, config.warmup);
+            int64_t to = std::min(now + slice[cpu], config.horizon);
+            busy += std::max<int64_t>(0, to - from);
+        }
+    }
+
+    double measured = static_cast<double>(config.horizon - config.warmup);
+    metrics.throughput = metrics.completed / measured;
+    metrics.utilization = 100.0 * static_cast<double>(busy) / (config.cpus * measured);
+    metrics.responseTimeLaw = metrics.throughput > 0 ? users / metrics.throughput - config.meanThink : 0.0;
+    meanValueAnalysis(users, metrics.predictedResponse, metrics.predictedThroughput);
+    return metrics;
+}
+
+std::vector<ClosedLoopMetrics> ClosedLoopSimulator::sweep(const std::vector<int>& userCounts) const {
+    // Largest points first, so a long one does not start last
+    std::vector<size_t> order(userCounts.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&userCounts](size_t a, size_t b) {
+        return userCounts[a] > userCounts[b];
+    });
+
+    std::vector<ClosedLoopMetrics> results(userCounts.size());
+    parallelFor(order.size(), workerThreads(config.numThreads, userCounts.size()), [&](size_t k) {
+        results[order[k]] = run(userCounts[order[k]]);
+    });
+    return results;
+}
@@ -0,0 +1,229 @@
+#include "ClusterSimulator.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <climits>
+#include <limits>
+
+/**
+ * @file ClusterSimulator.cpp
+ * @brief Implementation of the cluster-of-schedulers simulation
+ */
+
+namespace {
+
+/// Nodes per thread below which the epoch report is not worth a thread
+const size_t MIN_NODES_PER_THREAD = 4096;
+
+/**
+ * @class LoadTree
+ * @brief Min-tree over node loads for O(log n) least-loaded and first-fit
+ */
+class LoadTree {
+private:
+    std::vector<double> tree;   ///< Heap-ordered minima; leaves start at 'leaves'
+    size_t leaves;              ///< Leaf count (power of two)
+
+public:
+    void build(const std::vector<double>& loads) {
+        leaves = 1;
+        while (leaves < loads.size()) {
+            leaves <<= 1;
+        }
+        tree.assign(2 * leaves, std::numeric_limits<double>::infinity());
+        std::copy(loads.begin(), loads.end(), tree.begin() + static_cast<std::ptrdiff_t>(leaves));
+        for (size_t i = leaves - 1; i > 0; i--) {
+            tree[i] = std::min(tree[2 * i], tree[2 * i + 1]);
+        }
+    }
+
+    void update(size_t node, double load) {
+        size_t i = leaves + node;
+        tree[i] = load;
+        for (i /= 2; i > 0; i /= 2) {
+            tree[i] = std::min(tree[2 * i], tree[2 * i + 1]);
+        }
+    }
+
+    /**
+     * @brief Lowest-index node with load <= limit (-1 = none)
+     */
+    int firstAtMost(double limit) const {
+        if (tree[1] > limit) {
+            return -1;
+        }
+        size_t i = 1;
+        while (i < leaves) {
+            i = tree[2 * i] <= limit ? 2 * i : 2 * i + 1;
+        }
+        return static_cast<int>(i - leaves);
+    }
+
+    /**
+     * @brief Lowest-index node with the least load
+     */
+    int leastLoaded() const { return firstAtMost(tree[1]); }
+};
+
+/**
+ * @brief splitmix64, for reproducible placement draws
+ */
+uint64_t nextRandom(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+ClusterSimulator::ClusterSimulator(const ClusterConfig& config, SchedulerFactory nodeFactory,
+                                   PlacementPolicy placement)
+    : config(config), nodeFactory(nodeFactory), placement(placement) {
+    this->config.numNodes = std::max(1, config.numNodes);
+    this->config.epochLength = std::max(1, config.epochLength);
+}
+
+std::string ClusterSimulator::placementName(PlacementPolicy placement) {
+    switch (placement) {
+        case PlacementPolicy::LEAST_LOADED:
+            return "Least Loaded";
+        case PlacementPolicy::POWER_OF_TWO:
+            return "Power of Two Choices";
+        case PlacementPolicy::BIN_PACKING:
+            return "Bin Packing";
+    }
+    return "Unknown";
+}
+
+ClusterMetrics ClusterSimulator::run(const std::vector<std::shared_ptr<Process>>& jobs) {
+    const size_t numNodes = static_cast<size_t>(config.numNodes);
+    const int epoch = config.epochLength;
+    const double cpus = std::max(1, nodeFactory()->getCpuCount());
+
+    std::vector<size_t> order(jobs.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&jobs](size_t a, size_t b) {
+        if (jobs[a]->getArrivalTime() != jobs[b]->getArrivalTime()) {
+            return jobs[a]->getArrivalTime() < jobs[b]->getArrivalTime();
+        }
+        return jobs[a]->getPID() < jobs[b]->getPID();
+    });
+
+    // finish[k]: when node k's unfinished work would run out if nothing
+    // else arrived; load[k]: what the router believes that work is
+    std::vector<double> finish(numNodes, 0.0);
+    std::vector<double> load(numNodes, 0.0);
+    std::vector<std::vector<size_t>> nodeJobs(numNodes);
+    assignment.assign(jobs.size(), -1);
+    LoadTree tree;
+    uint64_t random = config.seed;
+    size_t epochs = 0;
+
+    size_t next = 0;
+    while (next < order.size()) {
+        int first = jobs[order[0]]->getArrivalTime();
+        int arrival = jobs[order[next]]->getArrivalTime();
+        int epochStart = first + (arrival - first) / epoch * epoch;
+        epochs++;
+
+        // 1. Every node reports its unfinished work at the boundary
+        int reporters = workerThreads(config.numThreads, numNodes / MIN_NODES_PER_THREAD);
+        parallelForBlocks(numNodes, reporters, [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; k++) {
+                load[k] = std::max(0.0, finish[k] - epochStart) * cpus;
+            }
+        });
+        if (placement != PlacementPolicy::POWER_OF_TWO) {
+            tree.build(load);
+        }
+
+        // 2. Place this epoch's arrivals on the reports plus own decisions
+        for (; next < order.size() && jobs[order[next]]->getArrivalTime() < epochStart + epoch; next++) {
+            const Process& job = *jobs[order[next]];
+            double work = job.getBurstTime();
+            int node = 0;
+            switch (placement) {
+                case PlacementPolicy::LEAST_LOADED:
+                    node = tree.leastLoaded();
+                    break;
+                case PlacementPolicy::POWER_OF_TWO:
+                    if (numNodes > 1) {
+                        size_t a = nextRandom(random) % numNodes;
+                        size_t b = nextRandom(random) % (numNodes - 1);
+                        b += b >= a ? 1 : 0;
+                        node = static_cast<int>(load[b] < load[a] || (load[b] == load[a] && b < a) ? b : a);
+                    }
+                    break;
+                case PlacementPolicy::BIN_PACKING:
+                    node = tree.firstAtMost(config.binCapacity * cpus - work);
+                    if (node == -1) {
+                        node = tree.leastLoaded();
+                    }
+                    break;
+            }
+
+            load[node] += work;
+            if (placement != PlacementPolicy::POWER_OF_TWO) {
+                tree.update(node, load[node]);
+            }
+            finish[node] = std::max(finish[node], static_cast<double>(job.getArrivalTime())) + work / cpus;
+            assignment[order[next]] = node;
+            nodeJobs[node].push_back(order[next]);
+        }
+    }
+
+    // 3. Simulate every node; results land in per-node slots, so the merge
+    // below sees the same sketches whatever the thread count
+    std::vector<NodeResult> results(numNodes);
+    parallelFor(numNodes, workerThreads(config.numThreads, numNodes), [&](size_t k) {
+        NodeResult& result = results[k];
+        result.firstArrival = INT_MAX;
+        result.lastCompletion = 0;
+        result.busy = 0;
+        if (nodeJobs[k].empty()) {
+            return;
+        }
+        std::unique_ptr<Scheduler> scheduler = nodeFactory();
+        for (size_t job : nodeJobs[k]) {
+            scheduler->addProcess(std::make_shared<Process>(*jobs[job]));
+        }
+        scheduler->schedule();
+        for (const auto& process : scheduler->getProcesses()) {
+            if (process->getState() != ProcessState::TERMINATED) {
+                continue;
+            }
+            result.waiting.add(process->getWaitingTime());
+            result.turnaround.add(process->getTurnaroundTime());
+            result.response.add(process->getResponseTime());
+            result.firstArrival = std::min(result.firstArrival, process->getArrivalTime());
+            result.lastCompletion = std::max(result.lastCompletion, process->getCompletionTime());
+            result.busy += process->getBurstTime();
+        }
+    });
+
+    ClusterMetrics metrics;
+    metrics.busiestNode = 0;
+    metrics.activeNodes = 0;
+    metrics.epochs = epochs;
+    int firstArrival = INT_MAX;
+    int lastCompletion = 0;
+    int64_t busy = 0;
+    for (size_t k = 0; k < numNodes; k++) {
+        metrics.waiting.merge(results[k].waiting);
+        metrics.turnaround.merge(results[k].turnaround);
+        metrics.response.merge(results[k].response);
+        metrics.busiestNode = std::max(metrics.busiestNode, nodeJobs[k].size());
+        metrics.activeNodes += nodeJobs[k].empty() ? 0 : 1;
+        firstArrival = std::min(firstArrival, results[k].firstArrival);
+        lastCompletion = std::max(lastCompletion, results[k].lastCompletion);
+        busy += results[k].busy;
+    }
+    metrics.processes = static_cast<size_t>(metrics.turnaround.count());
+    metrics.makespan = firstArrival == INT_MAX ? 0 : lastCompletion - firstArrival;
+    metrics.utilization = metrics.makespan > 0
+        ? 100.0 * static_cast<double>(busy) / (static_cast<double>(numNodes) * cpus * metrics.makespan)
+        : 0.0;
+    return metrics;
+}
@@ -0,0 +1,137 @@
+#include "CpuSet.h"
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+/**
+ * @file CpuSet.cpp
+ * @brief Implementation of the word-parallel CPU set
+ */
+
+CpuSet::CpuSet(int cpus, bool full)
+    : words((std::max(0, cpus) + 63) / 64, full ? ~0ULL : 0), cpus(std::max(0, cpus)) {
+    if (full && cpus % 64 != 0) {
+        words.back() = (1ULL << (cpus % 64)) - 1;
+    }
+}
+
+bool CpuSet::parse(const std::string& list, int cpus, CpuSet& set) {
+    CpuSet result(cpus);
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        char* end = nullptr;
+        long low = std::strtol(item.c_str(), &end, 10);
+        long high = low;
+        if (end == item.c_str()) {
+            return false;
+        }
+        if (*end == '-') {
+            const char* rest = end + 1;
+            high = std::strtol(rest, &end, 10);
+            if (end == rest) {
+                return false;
+            }
+        }
+        if (*end != '\0' || low < 0 || high < low || high >= cpus) {
+            return false;
+        }
+        for (long cpu = low; cpu <= high; cpu++) {
+            result.set(static_cast<int>(cpu));
+        }
+    }
+    if (result.empty()) {
+        return false;
+    }
+    set = result;
+    return true;
+}
+
+std::string CpuSet::toString() const {
+    std::string list;
+    for (int low = first(); low != -1;) {
+        int high = low;
+        while (test(high + 1)) {
+            high++;
+        }
+        list += (list.empty() ? "" : ",") + std::to_string(low);
+        if (high > low) {
+            list += "-" + std::to_string(high);
+        }
+        low = next(high + 1);
+    }
+    return list;
+}
+
+int CpuSet::count() const {
+    int total = 0;
+    for (uint64_t word : words) {
+        total += __builtin_popcountll(word);
+    }
+    return total;
+}
+
+bool CpuSet::empty() const {
+    for (uint64_t word : words) {
+        if (word != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int CpuSet::next(int cpu) const {
+    if (cpu < 0) {
+        cpu = 0;
+    }
+    if (cpu >= cpus) {
+        return -1;
+    }
+    size_t w = static_cast<size_t>(cpu >> 6);
+    uint64_t word = words[w] & (~0ULL << (cpu & 63));
+    while (word == 0) {
+        if (++w == words.size()) {
+            return -1;
+        }
+        word = words[w];
+    }
+    return static_cast<int>(w * 64) + __builtin_ctzll(word);
+}
+
+int CpuSet::firstAnd(const CpuSet& other) const {
+    size_t n = std::min(words.size(), other.words.size());
+    for (size_t w = 0; w < n; w++) {
+        uint64_t both = words[w] & other.words[w];
+        if (both != 0) {
+            return static_cast<int>(w * 64) + __builtin_ctzll(both);
+        }
+    }
+    return -1;
+}
+
+bool CpuSet::intersects(const CpuSet& other) const {
+    return firstAnd(other) != -1;
+}
+
+CpuSet& CpuSet::operator&=(const CpuSet& other) {
+    for (size_t w = 0; w < words.size(); w++) {
+        words[w] &= w < other.words.size() ? other.words[w] : 0;
+    }
+    return *this;
+}
+
+CpuSet& CpuSet::operator|=(const CpuSet& other) {
+    size_t n = std::min(words.size(), other.words.size());
+    for (size_t w = 0; w < n; w++) {
+        words[w] |= other.words[w];
+    }
+    return *this;
+}
+
+CpuSet& CpuSet::andNot(const CpuSet& other) {
+    size_t n = std::min(words.size(), other.words.size());
+    for (size_t w = 0; w < n; w++) {
+        words[w] &= ~other.words[w];
+    }
+    return *this;
+}
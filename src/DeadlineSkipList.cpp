@@ -0,0 +1,108 @@
+#include "DeadlineSkipList.h"
+
+/**
+ * @file DeadlineSkipList.cpp
+ * @brief Implementation of the virtual-deadline skip list
+ */
+
+DeadlineSkipList::DeadlineSkipList(uint64_t seed) {
+    clear(seed);
+}
+
+void DeadlineSkipList::clear(uint64_t seed) {
+    nodes.clear();
+    freeNodes.clear();
+    for (int i = 0; i < MAX_LEVEL; i++) {
+        head[i] = -1;
+    }
+    level = 1;
+    count = 0;
+    nextSequence = 0;
+    // xorshift must not start at zero
+    randomState = seed * 0x9E3779B97F4A7C15ULL + 0x2545F4914F6CDD1DULL;
+    if (randomState == 0) {
+        randomState = 1;
+    }
+}
+
+int DeadlineSkipList::randomLevel() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+
+    // Two bits per level: promote with probability 1/4
+    int nodeLevel = 1;
+    uint64_t bits = randomState;
+    while (nodeLevel < MAX_LEVEL && (bits & 3) == 0) {
+        nodeLevel++;
+        bits >>= 2;
+    }
+    return nodeLevel;
+}
+
+bool DeadlineSkipList::before(int a, int64_t deadline, uint64_t sequence) const {
+    if (nodes[a].deadline != deadline) {
+        return nodes[a].deadline < deadline;
+    }
+    return nodes[a].sequence < sequence;
+}
+
+void DeadlineSkipList::insert(int64_t deadline, int value) {
+    int index;
+    if (!freeNodes.empty()) {
+        index = freeNodes.back();
+        freeNodes.pop_back();
+    } else {
+        index = static_cast<int>(nodes.size());
+        nodes.push_back(Node());
+    }
+
+    Node& node = nodes[index];
+    node.deadline = deadline;
+    node.sequence = nextSequence++;
+    node.value = value;
+    node.level = randomLevel();
+    if (node.level > level) {
+        level = node.level;
+    }
+
+    // Walk down from the top, splicing the node in at each of its levels.
+    // 'previous' is -1 while still at the head sentinel.
+    int previous = -1;
+    for (int l = level - 1; l >= 0; l--) {
+        int current = previous == -1 ? head[l] : nodes[previous].next[l];
+        while (current != -1 && before(current, node.deadline, node.sequence)) {
+            previous = current;
+            current = nodes[current].next[l];
+        }
+        if (l < node.level) {
+            node.next[l] = current;
+            if (previous == -1) {
+                head[l] = index;
+            } else {
+                nodes[previous].next[l] = index;
+            }
+        }
+    }
+    count++;
+}
+
+int DeadlineSkipList::popFirst() {
+    int first = head[0];
+    if (first == -1) {
+        return -1;
+    }
+
+    // The first node is first at every level it occupies
+    const Node& node = nodes[first];
+    for (int l = 0; l < node.level; l++) {
+        head[l] = node.next[l];
+    }
+    while (level > 1 && head[level - 1] == -1) {
+        level--;
+    }
+
+    freeNodes.push_back(first);
+    count--;
+    return node.value;
+}
@@ -0,0 +1,73 @@
+#include "DispatchQueue.h"
+#include <algorithm>
+
+/**
+ * @file DispatchQueue.cpp
+ * @brief Implementation of the sched_ext-style dispatch queue
+ */
+
+DispatchQueue::DispatchQueue(uint64_t id, DsqOrder order)
+    : id(id), order(order), nextSequence(0), maxVtime(0) {
+}
+
+bool DispatchQueue::after(const VtimeEntry& a, const VtimeEntry& b) {
+    if (a.vtime != b.vtime) {
+        return a.vtime > b.vtime;
+    }
+    return a.sequence > b.sequence;
+}
+
+void DispatchQueue::insert(int task, bool atHead) {
+    if (order == DsqOrder::VTIME) {
+        // Behind every task inserted so far
+        insertVtime(task, maxVtime);
+        return;
+    }
+    if (atHead) {
+        fifo.push_front(task);
+    } else {
+        fifo.push_back(task);
+    }
+}
+
+void DispatchQueue::insertVtime(int task, uint64_t vtime) {
+    if (order == DsqOrder::FIFO) {
+        fifo.push_back(task);
+        return;
+    }
+    maxVtime = std::max(maxVtime, vtime);
+    heap.push_back(VtimeEntry{vtime, nextSequence++, task});
+    std::push_heap(heap.begin(), heap.end(), after);
+}
+
+int DispatchQueue::peek() const {
+    if (order == DsqOrder::FIFO) {
+        return fifo.empty() ? -1 : fifo.front();
+    }
+    return heap.empty() ? -1 : heap.front().task;
+}
+
+int DispatchQueue::pop() {
+    if (order == DsqOrder::FIFO) {
+        if (fifo.empty()) {
+            return -1;
+        }
+        int task = fifo.front();
+        fifo.pop_front();
+        return task;
+    }
+    if (heap.empty()) {
+        return -1;
+    }
+    std::pop_heap(heap.begin(), heap.end(), after);
+    int task = heap.back().task;
+    heap.pop_back();
+    return task;
+}
+
+void DispatchQueue::clear() {
+    fifo.clear();
+    heap.clear();
+    nextSequence = 0;
+    maxVtime = 0;
+}
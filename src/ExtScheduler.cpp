@@ -0,0 +1,606 @@
+#include "ExtScheduler.h"
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+/**
+ * @file ExtScheduler.cpp
+ * @brief Implementation of the policy-independent part of the sched_ext-style engine
+ */
+
+/// Linux sched_prio_to_weight: load weight of nice -20..19 (1024 at nice 0)
+static const int NICE_TO_WEIGHT[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+    9548, 7620, 6100, 4904, 3906,
+    3121, 2501, 1991, 1586, 1277,
+    1024, 820, 655, 526, 423,
+    335, 272, 215, 172, 137,
+    110, 87, 70, 56, 45,
+    36, 29, 23, 18, 15
+};
+
+ExtContext::ExtContext()
+    : processes(nullptr), globalDsq(DSQ_GLOBAL), brokenAffinities(0), threadsPerCore(1),
+      coreScheduling(false), now(0), dispatchCpu(-1), nextHotplug(0), migrations(0),
+      forcedIdleTime(0), pendingRetries(0), taskCrashes(0), cpuFailures(0), watchdogTimeout(0) {
+}
+
+void ExtContext::reset(const std::vector<std::shared_ptr<Process>>& processes, int numCpus) {
+    this->processes = &processes;
+    now = 0;
+    dispatchCpu = -1;
+    exitReason.clear();
+    globalDsq.clear();
+    userDsqs.clear();
+
+    cpus.assign(numCpus, Cpu());
+    for (int c = 0; c < numCpus; c++) {
+        cpus[c].running = -1;
+        cpus[c].previous = -1;
+        cpus[c].readyAt = 0;
+        cpus[c].preempt = false;
+        cpus[c].online = true;
+        cpus[c].forcedIdle = false;
+        cpus[c].local = DispatchQueue(localOn(c));
+    }
+    idleMask = CpuSet(numCpus, true);
+    onlineMask = CpuSet(numCpus, true);
+    backlog = CpuSet(numCpus);
+    brokenAffinities = 0;
+
+    tasks.assign(processes.size(), Task());
+    for (size_t i = 0; i < processes.size(); i++) {
+        Task& task = tasks[i];
+        int nice = std::min(19, std::max(-20, processes[i]->getPriority()));
+        task.cpu = -1;
+        task.slice = 0;
+        task.dsqVtime = 0;
+        task.weight = std::max(1, NICE_TO_WEIGHT[nice + 20] * 100 / 1024);
+        task.enqueuedAt = processes[i]->getArrivalTime();
+        task.queued = false;
+        task.allowed = onlineMask;
+        auto pinned = affinity.find(processes[i]->getPID());
+        if (pinned != affinity.end()) {
+            task.allowed = pinned->second;
+        }
+        auto smtClass = smtClasses.find(processes[i]->getPID());
+        task.smtClass = smtClass != smtClasses.end() ? smtClass->second : 0;
+        auto cookie = cookies.find(processes[i]->getPID());
+        task.cookie = cookie != cookies.end() ? cookie->second : 0;
+    }
+
+    taskIndex.clear();
+    for (size_t i = 0; i < processes.size(); i++) {
+        taskIndex[processes[i].get()] = static_cast<int>(i);
+    }
+    lastCpu.assign(processes.size(), -1);
+    workCarry.assign(processes.size(), 0);
+    stallCarry.assign(processes.size(), 0);
+    attempts.assign(processes.size(), 0);
+    crashAt.assign(processes.size(), INT_MAX);
+    cpuFailAt.assign(numCpus, NEVER);
+    cpuRepairAt.assign(numCpus, NEVER);
+    cpuLives.assign(numCpus, 0);
+    pendingRetries = 0;
+    taskCrashes = 0;
+    cpuFailures = 0;
+    forcedIdleTime = 0;
+    migrations = 0;
+    nextHotplug = 0;
+}
+
+bool ExtContext::setAffinity(int pid, const CpuSet& allowed, int numCpus) {
+    if (allowed.size() != numCpus || allowed.empty()) {
+        return false;
+    }
+    affinity[pid] = allowed;
+    return true;
+}
+
+bool ExtContext::addHotplugEvent(int time, int cpu, bool online, int numCpus) {
+    if (cpu < 0 || cpu >= numCpus || time < 0) {
+        return false;
+    }
+    HotplugEvent event{time, cpu, online};
+    auto at = std::upper_bound(hotplugEvents.begin(), hotplugEvents.end(), event,
+                               [](const HotplugEvent& a, const HotplugEvent& b) { return a.time < b.time; });
+    hotplugEvents.insert(at, event);
+    return true;
+}
+
+bool ExtContext::setSmt(const SmtConfig& config, int numCpus) {
+    if (config.threadsPerCore < 1 || numCpus % config.threadsPerCore != 0) {
+        return false;
+    }
+    for (const auto& row : config.slowdown) {
+        for (double factor : row) {
+            if (!(factor >= 1.0)) {
+                return false;
+            }
+        }
+    }
+    smt = config;
+    threadsPerCore = smt.threadsPerCore;
+    coreScheduling = smt.coreScheduling && smt.threadsPerCore > 1;
+    return true;
+}
+
+bool ExtContext::setFailures(const FailureConfig& config) {
+    if (!(config.crashProbability >= 0.0 && config.crashProbability < 1.0) || config.maxRetries < 0 ||
+        config.retryBackoff < 0 || config.maxBackoff < 0 || !(config.backoffMultiplier >= 1.0) ||
+        !(config.cpuMtbf >= 0.0) || config.cpuRepairTime < 1) {
+        return false;
+    }
+    failures = config;
+    return true;
+}
+
+bool ExtContext::setWatchdogTimeout(int timeout) {
+    watchdogTimeout = std::max(0, timeout);
+    return watchdogTimeout > 0;
+}
+
+bool ExtContext::place(int cpu, int task, int overhead) {
+    Cpu& state = cpus[cpu];
+    bool switched = state.previous != -1 && state.previous != task;
+    state.readyAt = now + (switched ? overhead : 0);
+    state.running = task;
+    state.previous = task;
+    if (lastCpu[task] != -1 && lastCpu[task] != cpu) {
+        migrations++;
+    }
+    lastCpu[task] = cpu;
+    tasks[task].cpu = cpu;
+    setIdle(cpu, false);
+    return switched;
+}
+
+int ExtContext::speedOf(int cpu, int memory) const {
+    if (smt.threadsPerCore == 1) {
+        return memory;
+    }
+    int own = tasks[cpus[cpu].running].smtClass;
+    double factor = 1.0;
+    int first = cpu - cpu % smt.threadsPerCore;
+    for (int s = first; s < first + smt.threadsPerCore; s++) {
+        int other = cpus[s].running;
+        if (s == cpu || other == -1) {
+            continue;
+        }
+        int sibling = tasks[other].smtClass;
+        if (own >= 0 && own < static_cast<int>(smt.slowdown.size()) &&
+            sibling >= 0 && sibling < static_cast<int>(smt.slowdown[own].size())) {
+            factor *= smt.slowdown[own][sibling];
+        }
+    }
+    return std::max(1, static_cast<int>(std::lround(memory / factor)));
+}
+
+void ExtContext::advance(int cpu, int to, int memory) {
+    const Cpu& state = cpus[cpu];
+    if (state.running == -1) {
+        if (coreScheduling && state.forcedIdle) {
+            forcedIdleTime += to - now;
+        }
+        return;
+    }
+    int ran = to - std::max(now, state.readyAt);
+    if (ran <= 0) {
+        return;
+    }
+    int task = state.running;
+    Process& process = *(*processes)[task];
+    int64_t work = static_cast<int64_t>(speedOf(cpu, memory)) * ran + workCarry[task];
+    process.execute(static_cast<int>(std::min<int64_t>(work / 1000, INT_MAX)));
+    workCarry[task] = process.isComplete() ? 0 : static_cast<int>(work % 1000);
+    tasks[task].slice -= ran;
+    if (memory < 1000) {
+        // Whole units as they accrue; the remainder rounds on completion
+        int64_t lost = static_cast<int64_t>(1000 - memory) * ran + stallCarry[task];
+        bool done = process.isComplete();
+        process.addMemoryStallTime(static_cast<int>((lost + (done ? 500 : 0)) / 1000));
+        stallCarry[task] = done ? 0 : static_cast<int>(lost % 1000);
+    }
+}
+
+void ExtContext::updateForcedIdle() {
+    for (int c = 0; c < nrCpus() && coreScheduling; c++) {
+        cpus[c].forcedIdle = cpus[c].running == -1 && cpus[c].online && hasWaiting(c);
+    }
+}
+
+double ExtContext::failureDraw(uint64_t stream, int id, int n) const {
+    uint64_t key = Scheduler::tieBreakKey(failures.seed ^ stream, id) + 0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(n);
+    return static_cast<double>(Scheduler::tieBreakKey(key, n) >> 11) * 0x1.0p-53;
+}
+
+void ExtContext::sampleCrash(int task) {
+    crashAt[task] = INT_MAX;
+    double p = failures.crashProbability;
+    double u = failureDraw(0, process(task).getPID(), attempts[task]);
+    if (u >= p) {
+        return;
+    }
+    // Exponential time to failure conditioned on falling inside the burst
+    double point = process(task).getBurstTime() * std::log1p(-u) / std::log1p(-p);
+    crashAt[task] = std::max(1, static_cast<int>(std::ceil(point)));
+}
+
+int64_t ExtContext::sampleCpuLifetime(int cpu) {
+    double u = failureDraw(0x5DEECE66DULL, cpu, cpuLives[cpu]++);
+    return std::max<int64_t>(1, std::llround(-failures.cpuMtbf * std::log1p(-u)));
+}
+
+void ExtContext::firstAttempt(int task) {
+    attempts[task] = 1;
+    if (failures.crashProbability > 0) {
+        sampleCrash(task);
+    }
+}
+
+void ExtContext::nextAttempt(int task) {
+    pendingRetries--;
+    attempts[task]++;
+    sampleCrash(task);
+}
+
+bool ExtContext::crashDue(int task) const {
+    const Process& run = process(task);
+    return run.getBurstTime() - run.getRemainingTime() >= crashAt[task];
+}
+
+int64_t ExtContext::crashRun(int task) {
+    (*processes)[task]->restartBurst();
+    workCarry[task] = 0;
+    taskCrashes++;
+    int retry = attempts[task];
+    if (retry > failures.maxRetries) {
+        return -1;
+    }
+    pendingRetries++;
+    double backoff = failures.retryBackoff * std::pow(failures.backoffMultiplier, retry - 1);
+    return static_cast<int64_t>(std::min<double>(backoff, failures.maxBackoff));
+}
+
+void ExtContext::startFailures(int start) {
+    for (int c = 0; c < nrCpus() && failures.cpuMtbf > 0; c++) {
+        cpuFailAt[c] = start + sampleCpuLifetime(c);
+    }
+}
+
+void ExtContext::applyCpuFailures(const std::function<void(const HotplugEvent&)>& hotplug) {
+    for (int c = 0; c < nrCpus(); c++) {
+        if (cpuRepairAt[c] <= now) {
+            cpuRepairAt[c] = NEVER;
+            hotplug(HotplugEvent{now, c, true});
+            cpuFailAt[c] = now + sampleCpuLifetime(c);
+        }
+        if (cpuFailAt[c] > now) {
+            continue;
+        }
+        if (!cpus[c].online || onlineMask.count() == 1) {
+            cpuFailAt[c] = now + sampleCpuLifetime(c);
+            continue;
+        }
+        int task = cpus[c].running;
+        if (task != -1) {
+            (*processes)[task]->restartBurst();
+            workCarry[task] = 0;
+        }
+        hotplug(HotplugEvent{now, c, false});
+        cpuFailures++;
+        cpuFailAt[c] = NEVER;
+        cpuRepairAt[c] = now + failures.cpuRepairTime;
+    }
+}
+
+int64_t ExtContext::nextCpuEvent(int memory) const {
+    int64_t next = NEVER;
+    if (nextHotplug < hotplugEvents.size()) {
+        next = hotplugEvents[nextHotplug].time;
+    }
+    for (int c = 0; c < nrCpus() && failures.cpuMtbf > 0; c++) {
+        next = std::min({next, cpuFailAt[c], cpuRepairAt[c]});
+    }
+    for (int c = 0; c < nrCpus(); c++) {
+        const Cpu& cpu = cpus[c];
+        if (cpu.running == -1) {
+            continue;
+        }
+        int start = std::max(now, cpu.readyAt);
+        int speed = speedOf(c, memory);
+        const Process& run = process(cpu.running);
+        int work = std::min(run.getRemainingTime(),
+                            crashAt[cpu.running] - (run.getBurstTime() - run.getRemainingTime()));
+        int64_t left = 1000LL * work - workCarry[cpu.running];
+        int64_t finish = (left + speed - 1) / speed;
+        int64_t runFor = std::min<int64_t>(tasks[cpu.running].slice, finish);
+        next = std::min<int64_t>(next, static_cast<int64_t>(start) + runFor);
+    }
+    return next;
+}
+
+DispatchQueue* ExtContext::resolve(uint64_t dsqId, int task) {
+    if (dsqId == DSQ_GLOBAL) {
+        return &globalDsq;
+    }
+    if (dsqId == DSQ_LOCAL) {
+        // Inside dispatch() the dispatching CPU, otherwise the task's CPU
+        int cpu = dispatchCpu != -1 ? dispatchCpu : (task >= 0 ? tasks[task].cpu : -1);
+        return cpu >= 0 ? &cpus[cpu].local : nullptr;
+    }
+    if ((dsqId & DSQ_LOCAL_ON) == DSQ_LOCAL_ON) {
+        uint64_t cpu = dsqId & ~DSQ_LOCAL_ON;
+        return cpu < cpus.size() ? &cpus[cpu].local : nullptr;
+    }
+    auto it = userDsqs.find(dsqId);
+    return it != userDsqs.end() ? &it->second : nullptr;
+}
+
+void ExtContext::setIdle(int cpu, bool idle) {
+    if (idle && cpus[cpu].online) {
+        idleMask.set(cpu);
+    } else {
+        idleMask.clear(cpu);
+    }
+}
+
+void ExtContext::setOnline(int cpu, bool online) {
+    cpus[cpu].online = online;
+    if (online) {
+        onlineMask.set(cpu);
+        idleMask.set(cpu);
+        return;
+    }
+    onlineMask.clear(cpu);
+    idleMask.clear(cpu);
+    for (size_t i = 0; i < tasks.size(); i++) {
+        if (!tasks[i].allowed.intersects(onlineMask) && !(*processes)[i]->isComplete()) {
+            tasks[i].allowed = onlineMask;
+            brokenAffinities++;
+        }
+    }
+}
+
+int ExtContext::pullTask(int cpu) {
+    int busiest = -1;
+    for (int c = backlog.first(); c != -1; c = backlog.next(c + 1)) {
+        if (c != cpu && cpus[c].running != -1 &&
+            (busiest == -1 || cpus[c].local.size() > cpus[busiest].local.size())) {
+            busiest = c;
+        }
+    }
+    if (busiest == -1) {
+        return -1;
+    }
+    int task = consume(cpus[busiest].local, cpu);
+    for (int c = backlog.first(); task == -1 && c != -1; c = backlog.next(c + 1)) {
+        if (c != cpu && c != busiest && cpus[c].running != -1) {
+            task = consume(cpus[c].local, cpu);
+        }
+    }
+    return task;
+}
+
+int ExtContext::consume(DispatchQueue& dsq, int cpu) {
+    int task = dsq.findFirst([this, cpu](int candidate) {
+        return tasks[candidate].allowed.test(cpu) && onlineMask.test(cpu);
+    });
+    if (task == -1 || !coreCompatible(task, cpu)) {
+        return -1;
+    }
+    dsq.popFirst([task](int candidate) { return candidate == task; });
+    uint64_t id = dsq.getId();
+    if ((id & DSQ_LOCAL_ON) == DSQ_LOCAL_ON && dsq.empty()) {
+        backlog.clear(static_cast<int>(id & ~DSQ_LOCAL_ON));
+    }
+    return task;
+}
+
+size_t ExtContext::userQueued() const {
+    size_t queued = 0;
+    for (const auto& entry : userDsqs) {
+        queued += entry.second.size();
+    }
+    return queued;
+}
+
+void ExtContext::drainUserDsqs() {
+    for (auto& entry : userDsqs) {
+        int task;
+        while ((task = entry.second.pop()) != -1) {
+            globalDsq.insert(task);
+        }
+    }
+}
+
+bool ExtContext::hasWaiting(int cpu) const {
+    auto allowed = [this, cpu](int task) { return tasks[task].allowed.test(cpu); };
+    if (cpus[cpu].local.findFirst(allowed) != -1 || globalDsq.findFirst(allowed) != -1) {
+        return true;
+    }
+    for (const auto& entry : userDsqs) {
+        if (entry.second.findFirst(allowed) != -1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ExtContext::createDsq(uint64_t id, DsqOrder order) {
+    if ((id & DSQ_FLAG_BUILTIN) != 0 || userDsqs.count(id) != 0) {
+        return false;
+    }
+    userDsqs.emplace(id, DispatchQueue(id, order));
+    return true;
+}
+
+void ExtContext::insert(int task, uint64_t dsqId, int slice, uint64_t enqFlags) {
+    DispatchQueue* dsq = resolve(dsqId, task);
+    if (dsq == nullptr) {
+        error("insert into unknown DSQ " + std::to_string(dsqId));
+        return;
+    }
+    if (tasks[task].queued) {
+        error(process(task).getName() + " inserted twice");
+        return;
+    }
+    if (dsq->getOrder() == DsqOrder::VTIME) {
+        error("FIFO insert into VTIME DSQ " + std::to_string(dsqId));
+        return;
+    }
+    bool local = (dsq->getId() & DSQ_LOCAL_ON) == DSQ_LOCAL_ON;
+    int cpu = local ? static_cast<int>(dsq->getId() & ~DSQ_LOCAL_ON) : -1;
+    if (local && !canRun(task, cpu)) {
+        // Not allowed there, or offline: any CPU the task may use takes it
+        dsq = &globalDsq;
+        local = false;
+    }
+
+    tasks[task].slice = std::max(1, slice);
+    tasks[task].enqueuedAt = now;
+    tasks[task].queued = true;
+    dsq->insert(task, (enqFlags & ENQ_HEAD) != 0);
+
+    // ENQ_PREEMPT only means something for a local DSQ
+    if (local) {
+        backlog.set(cpu);
+        if ((enqFlags & ENQ_PREEMPT) != 0) {
+            cpus[cpu].preempt = true;
+        }
+    }
+}
+
+void ExtContext::insertVtime(int task, uint64_t dsqId, int slice, uint64_t vtime,
+                             uint64_t enqFlags) {
+    DispatchQueue* dsq = resolve(dsqId, task);
+    if (dsq == nullptr || (dsqId & DSQ_FLAG_BUILTIN) != 0 || dsq->getOrder() != DsqOrder::VTIME) {
+        error("vtime insert into non-VTIME DSQ " + std::to_string(dsqId));
+        return;
+    }
+    if (tasks[task].queued) {
+        error(process(task).getName() + " inserted twice");
+        return;
+    }
+    (void)enqFlags;  // ENQ_HEAD and ENQ_PREEMPT do not apply to VTIME DSQs
+
+    tasks[task].slice = std::max(1, slice);
+    tasks[task].enqueuedAt = now;
+    tasks[task].queued = true;
+    dsq->insertVtime(task, vtime);
+}
+
+bool ExtContext::moveToLocal(uint64_t dsqId, int cpu) {
+    DispatchQueue* dsq = resolve(dsqId, -1);
+    if (dsq == nullptr || cpu < 0 || cpu >= nrCpus()) {
+        error("move from unknown DSQ " + std::to_string(dsqId));
+        return false;
+    }
+    int task = consume(*dsq, cpu);
+    if (task == -1) {
+        return false;
+    }
+    cpus[cpu].local.insert(task);
+    backlog.set(cpu);
+    return true;
+}
+
+size_t ExtContext::dsqSize(uint64_t dsqId) {
+    DispatchQueue* dsq = resolve(dsqId, -1);
+    return dsq != nullptr ? dsq->size() : 0;
+}
+
+void ExtContext::kickCpu(int cpu, bool preempt) {
+    if (cpu >= 0 && cpu < nrCpus() && preempt) {
+        cpus[cpu].preempt = true;
+    }
+}
+
+bool ExtContext::testAndClearCpuIdle(int cpu) {
+    if (!idleMask.test(cpu)) {
+        return false;
+    }
+    idleMask.clear(cpu);
+    return true;
+}
+
+int ExtContext::pickIdleCpu() {
+    int cpu = idleMask.first();
+    if (cpu != -1) {
+        idleMask.clear(cpu);
+    }
+    return cpu;
+}
+
+int ExtContext::pickIdleCpu(const CpuSet& allowed) {
+    int cpu = idleMask.firstAnd(allowed);
+    if (cpu != -1) {
+        idleMask.clear(cpu);
+    }
+    return cpu;
+}
+
+int ExtContext::selectCpuDefault(int task, int prevCpu, bool& isIdle) {
+    const CpuSet& allowed = tasks[task].allowed;
+    isIdle = true;
+    if (allowed.test(prevCpu) && testAndClearCpuIdle(prevCpu)) {
+        return prevCpu;
+    }
+    int cpu = pickIdleCpu(allowed);
+    if (cpu != -1) {
+        return cpu;
+    }
+    isIdle = false;
+    return canRun(task, prevCpu) ? prevCpu : allowed.firstAnd(onlineMask);
+}
+
+void ExtContext::error(const std::string& reason) {
+    if (exitReason.empty()) {
+        exitReason = reason;
+    }
+}
+
+void ExtContext::recordGantt(int cpu, int from, int to, int origin) {
+    Cpu& state = cpus[cpu];
+    for (int t = from; t < to && state.gantt.size() < GANTT_WIDTH; t++) {
+        if (!state.online) {
+            state.gantt.push_back("OFFLINE");
+        } else if (state.running != -1 && t >= state.readyAt - origin) {
+            state.gantt.push_back((*processes)[state.running]->getName());
+        } else {
+            state.gantt.push_back("IDLE");
+        }
+    }
+}
+
+std::string ExtContext::ganttChart() const {
+    std::stringstream ss;
+    ss << "\nGantt Chart:\n";
+    ss << std::string(80, '-') << "\n";
+
+    if (cpus.empty() || cpus[0].gantt.empty()) {
+        ss << "No execution recorded\n";
+        return ss.str();
+    }
+
+    for (size_t c = 0; c < cpus.size(); c++) {
+        std::string label = cpus.size() > 1 ? "CPU" + std::to_string(c) : "";
+        ss << std::left << std::setw(5) << label << "|";
+        for (const auto& name : cpus[c].gantt) {
+            ss << (name == "IDLE" ? '-' : name == "OFFLINE" ? 'x' : name[0]);
+        }
+        ss << "\n";
+    }
+
+    ss << "  0  ";
+    for (size_t i = 0; i < cpus[0].gantt.size(); i += 5) {
+        ss << std::right << std::setw(5) << (i + 5);
+    }
+    ss << "\n";
+
+    ss << std::string(80, '-') << "\n";
+    return ss.str();
+}
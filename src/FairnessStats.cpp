@@ -0,0 +1,129 @@
+#include "FairnessStats.h"
+#include <algorithm>
+
+/**
+ * @file FairnessStats.cpp
+ * @brief Implementation of the streaming fairness statistics
+ */
+
+namespace {
+
+/**
+ * @brief Jain's index from n, sum x and sum x^2 (1 if there is nothing to compare)
+ */
+double jain(double n, double sum, double squares) {
+    if (n <= 0 || squares <= 0) {
+        return 1.0;
+    }
+    return sum * sum / (n * squares);
+}
+
+}  // namespace
+
+double ClassFairness::jainIndex() const {
+    return jain(static_cast<double>(completed), shareSum, shareSquares);
+}
+
+double ClassFairness::share() const {
+    return turnaroundSum > 0 ? static_cast<double>(burstSum) / static_cast<double>(turnaroundSum) : 0.0;
+}
+
+void ClassFairness::merge(const ClassFairness& other) {
+    completed += other.completed;
+    shareSum += other.shareSum;
+    shareSquares += other.shareSquares;
+    burstSum += other.burstSum;
+    turnaroundSum += other.turnaroundSum;
+    maxStarvation = std::max(maxStarvation, other.maxStarvation);
+    slowdown.merge(other.slowdown);
+}
+
+FairnessStats::FairnessStats(double relativeAccuracy)
+    : relativeAccuracy(relativeAccuracy), lowest(0), all(relativeAccuracy) {
+}
+
+ClassFairness& FairnessStats::totalsFor(int priorityClass) {
+    if (classes.empty()) {
+        lowest = priorityClass;
+        classes.emplace_back(relativeAccuracy);
+    } else if (priorityClass < lowest) {
+        classes.insert(classes.begin(), static_cast<size_t>(lowest - priorityClass),
+                       ClassFairness(relativeAccuracy));
+        lowest = priorityClass;
+    } else if (priorityClass - lowest >= static_cast<int>(classes.size())) {
+        classes.resize(static_cast<size_t>(priorityClass - lowest) + 1, ClassFairness(relativeAccuracy));
+    }
+    return classes[static_cast<size_t>(priorityClass - lowest)];
+}
+
+void FairnessStats::recordCompletion(int priorityClass, int burst, int turnaround) {
+    if (burst <= 0 || turnaround <= 0) {
+        return;
+    }
+    double share = static_cast<double>(burst) / turnaround;
+    for (ClassFairness* totals : {&totalsFor(priorityClass), &all}) {
+        totals->completed++;
+        totals->shareSum += share;
+        totals->shareSquares += share * share;
+        totals->burstSum += burst;
+        totals->turnaroundSum += turnaround;
+        totals->slowdown.add(1.0 / share);
+    }
+}
+
+void FairnessStats::recordWait(int priorityClass, int wait) {
+    ClassFairness& totals = totalsFor(priorityClass);
+    totals.maxStarvation = std::max(totals.maxStarvation, wait);
+    all.maxStarvation = std::max(all.maxStarvation, wait);
+}
+
+bool FairnessStats::merge(const FairnessStats& other) {
+    if (other.relativeAccuracy != relativeAccuracy) {
+        return false;
+    }
+    for (size_t i = 0; i < other.classes.size(); i++) {
+        totalsFor(other.lowest + static_cast<int>(i)).merge(other.classes[i]);
+    }
+    all.merge(other.all);
+    return true;
+}
+
+void FairnessStats::clear() {
+    classes.clear();
+    lowest = 0;
+    all = ClassFairness(relativeAccuracy);
+}
+
+std::vector<int> FairnessStats::getClasses() const {
+    std::vector<int> result;
+    for (size_t i = 0; i < classes.size(); i++) {
+        if (classes[i].completed > 0 || classes[i].maxStarvation > 0) {
+            result.push_back(lowest + static_cast<int>(i));
+        }
+    }
+    return result;
+}
+
+const ClassFairness& FairnessStats::forClass(int priorityClass) const {
+    static const ClassFairness EMPTY;
+    int index = priorityClass - lowest;
+    if (index < 0 || index >= static_cast<int>(classes.size())) {
+        return EMPTY;
+    }
+    return classes[static_cast<size_t>(index)];
+}
+
+double FairnessStats::classJainIndex() const {
+    double n = 0;
+    double sum = 0;
+    double squares = 0;
+    for (const ClassFairness& totals : classes) {
+        if (totals.completed > 0) {
+            double share = totals.share();
+            n++;
+            sum += share;
+            squares += share * share;
+        }
+    }
+    return jain(n, sum, squares);
+}
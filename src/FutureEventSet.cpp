@@ -0,0 +1,71 @@
+#include "FutureEventSet.h"
+#include <algorithm>
+
+/**
+ * @file FutureEventSet.cpp
+ * @brief Implementation of the heap and timing-wheel future-event sets
+ */
+
+bool HeapEventSet::after(const Node& a, const Node& b) {
+    if (a.time != b.time) {
+        return a.time > b.time;
+    }
+    return a.sequence > b.sequence;
+}
+
+void HeapEventSet::push(int64_t time, uint64_t payload) {
+    heap.push_back(Node{time, nextSequence++, payload});
+    std::push_heap(heap.begin(), heap.end(), after);
+}
+
+int64_t HeapEventSet::nextTime() {
+    return heap.empty() ? NO_EVENT : heap.front().time;
+}
+
+bool HeapEventSet::pop(FutureEvent& event) {
+    if (heap.empty()) {
+        return false;
+    }
+    std::pop_heap(heap.begin(), heap.end(), after);
+    event.time = heap.back().time;
+    event.payload = heap.back().payload;
+    heap.pop_back();
+    return true;
+}
+
+void HeapEventSet::clear() {
+    heap.clear();
+    nextSequence = 0;
+}
+
+void WheelEventSet::push(int64_t time, uint64_t payload) {
+    wheel.schedule(time, payload);
+}
+
+int64_t WheelEventSet::nextTime() {
+    int64_t next = wheel.nextExpiry();
+    return next == TimerWheel::NO_TIMER ? NO_EVENT : next;
+}
+
+bool WheelEventSet::pop(FutureEvent& event) {
+    int64_t next = wheel.nextExpiry();
+    TimerEvent timer;
+    if (next == TimerWheel::NO_TIMER || !wheel.popExpired(next, timer)) {
+        return false;
+    }
+    event.time = timer.expiry;
+    event.payload = timer.payload;
+    return true;
+}
+
+std::unique_ptr<FutureEventSet> createFutureEventSet(FutureEventSetType type,
+                                                     size_t expectedPending) {
+    if (type == FutureEventSetType::AUTO) {
+        type = expectedPending >= WHEEL_SELECTION_THRESHOLD
+            ? FutureEventSetType::TIMING_WHEEL : FutureEventSetType::BINARY_HEAP;
+    }
+    if (type == FutureEventSetType::TIMING_WHEEL) {
+        return std::unique_ptr<FutureEventSet>(new WheelEventSet());
+    }
+    return std::unique_ptr<FutureEventSet>(new HeapEventSet());
+}
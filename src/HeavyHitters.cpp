@@ -0,0 +1,93 @@
+#include "HeavyHitters.h"
+#include <algorithm>
+
+/**
+ * @file HeavyHitters.cpp
+ * @brief Implementation of the weighted Space-Saving summary
+ */
+
+SpaceSaving::SpaceSaving(size_t capacity)
+    : capacity(std::max<size_t>(1, capacity)), total(0) {
+}
+
+bool SpaceSaving::after(const HeavyHitter& a, const HeavyHitter& b) {
+    if (a.count != b.count) {
+        return a.count > b.count;
+    }
+    return a.id > b.id;
+}
+
+void SpaceSaving::siftDown(size_t i) {
+    while (true) {
+        size_t smallest = i;
+        for (size_t child = 2 * i + 1; child <= 2 * i + 2 && child < heap.size(); child++) {
+            if (after(heap[smallest], heap[child])) {
+                smallest = child;
+            }
+        }
+        if (smallest == i) {
+            return;
+        }
+        std::swap(heap[i], heap[smallest]);
+        position[heap[i].id] = i;
+        position[heap[smallest].id] = smallest;
+        i = smallest;
+    }
+}
+
+void SpaceSaving::add(int id, int64_t weight) {
+    if (weight <= 0) {
+        return;
+    }
+    total += weight;
+    auto monitored = position.find(id);
+    if (monitored != position.end()) {
+        heap[monitored->second].count += weight;
+        siftDown(monitored->second);
+        return;
+    }
+    if (heap.size() < capacity) {
+        // A new counter can be smaller than its parents: sift it up
+        size_t i = heap.size();
+        heap.push_back(HeavyHitter{id, weight, 0});
+        while (i > 0 && after(heap[(i - 1) / 2], heap[i])) {
+            std::swap(heap[i], heap[(i - 1) / 2]);
+            position[heap[i].id] = i;
+            i = (i - 1) / 2;
+        }
+        position[id] = i;
+        return;
+    }
+
+    // Take over the smallest counter
+    HeavyHitter& smallest = heap.front();
+    position.erase(smallest.id);
+    smallest.id = id;
+    smallest.error = smallest.count;
+    smallest.count += weight;
+    position[id] = 0;
+    siftDown(0);
+}
+
+std::vector<HeavyHitter> SpaceSaving::top(size_t n) const {
+    std::vector<HeavyHitter> result(heap);
+    n = std::min(n, result.size());
+    std::partial_sort(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(n), result.end(),
+                      [](const HeavyHitter& a, const HeavyHitter& b) { return after(a, b); });
+    result.resize(n);
+    return result;
+}
+
+int64_t SpaceSaving::estimate(int id) const {
+    auto monitored = position.find(id);
+    if (monitored != position.end()) {
+        return heap[monitored->second].count;
+    }
+    return heap.size() < capacity ? 0 : heap.front().count;
+}
+
+void SpaceSaving::clear() {
+    heap.clear();
+    position.clear();
+    total = 0;
+}
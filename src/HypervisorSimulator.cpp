@@ -0,0 +1,357 @@
+#include "HypervisorSimulator.h"
+#include "DispatchQueue.h"
+#include "FutureEventSet.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <climits>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @file HypervisorSimulator.cpp
+ * @brief Implementation of the two-level (vCPU on pCPU) simulation
+ */
+
+namespace {
+
+/// vruntime units per unit of pCPU time at weight 1
+const uint64_t VRUNTIME_SCALE = 1024;
+
+/**
+ * @enum VcpuState
+ * @brief Host view of a vCPU
+ */
+enum class VcpuState {
+    IDLE,       ///< No work
+    RUNNABLE,   ///< Work, waiting for a pCPU (stealing)
+    RUNNING     ///< On a pCPU
+};
+
+/**
+ * @struct Vcpu
+ * @brief Host-side state of one vCPU
+ */
+struct Vcpu {
+    std::vector<std::pair<int, int>> arrivals;  ///< (real arrival, burst), in order
+    size_t nextArrival;         ///< First arrival not yet delivered
+    int64_t work;               ///< Unfinished work (as of runStart while RUNNING)
+    VcpuState state;            ///< Host state
+    int64_t runStart;           ///< Start of the current run
+    int64_t sliceEnd;           ///< End of the current timeslice
+    int64_t stopAt;             ///< Time of the valid STOP event
+    int64_t stealStart;         ///< Became RUNNABLE at
+    uint64_t vruntime;          ///< FAIR_SHARE key
+    int weight;                 ///< VM weight
+    std::vector<std::pair<int64_t, int64_t>> steal;   ///< Steal intervals [start, end)
+};
+
+/**
+ * @class GuestClock
+ * @brief Maps between real time and a vCPU's guest time, which stops during steal
+ */
+class GuestClock {
+private:
+    std::vector<int64_t> realStarts;    ///< Steal interval starts, real time
+    std::vector<int64_t> guestStarts;   ///< Same starts in guest time
+    std::vector<int64_t> stolenBefore;  ///< Steal before interval j, plus one entry for all
+
+public:
+    explicit GuestClock(const std::vector<std::pair<int64_t, int64_t>>& steal) {
+        stolenBefore.push_back(0);
+        for (const auto& interval : steal) {
+            realStarts.push_back(interval.first);
+            guestStarts.push_back(interval.first - stolenBefore.back());
+            stolenBefore.push_back(stolenBefore.back() + interval.second - interval.first);
+        }
+    }
+
+    /**
+     * @brief Guest time at real time @p t (an arrival during steal enters when it ends)
+     */
+    int64_t toGuest(int64_t t) const {
+        size_t j = static_cast<size_t>(std::lower_bound(realStarts.begin(), realStarts.end(), t) - realStarts.begin());
+        if (j == 0) {
+            return t;
+        }
+        int64_t inLast = std::min(t, realStarts[j - 1] + stolenBefore[j] - stolenBefore[j - 1]) - realStarts[j - 1];
+        return t - stolenBefore[j - 1] - inLast;
+    }
+
+    /**
+     * @brief Real time at which something that ends at guest time @p g ends
+     */
+    int64_t endToReal(int64_t g) const {
+        size_t j = static_cast<size_t>(std::lower_bound(guestStarts.begin(), guestStarts.end(), g) - guestStarts.begin());
+        return g + stolenBefore[j];
+    }
+
+    /**
+     * @brief Real time at which something that starts at guest time @p g starts
+     */
+    int64_t startToReal(int64_t g) const {
+        size_t j = static_cast<size_t>(std::upper_bound(guestStarts.begin(), guestStarts.end(), g) - guestStarts.begin());
+        return g + stolenBefore[j];
+    }
+};
+
+/**
+ * @struct GuestResult
+ * @brief What one vCPU's guest reports
+ */
+struct GuestResult {
+    QuantileSketch waiting;         ///< Real waiting times
+    QuantileSketch turnaround;      ///< Real turnaround times
+    QuantileSketch response;        ///< Real response times
+    QuantileSketch steal;           ///< Steal per task
+    size_t sections;                ///< Critical sections executed
+    size_t preemptedSections;       ///< Sections stretched by steal
+    int64_t lockHolderDelay;        ///< Total stretch
+    int maxLockHolderDelay;         ///< Largest stretch
+    int firstArrival;               ///< Earliest real arrival (INT_MAX if idle)
+    int lastCompletion;             ///< Latest real completion
+};
+
+} // namespace
+
+HypervisorSimulator::HypervisorSimulator(const HostConfig& config, SchedulerFactory guestFactory)
+    : config(config), guestFactory(guestFactory) {
+    this->config.pcpus = std::max(1, config.pcpus);
+    this->config.timeslice = std::max(1, config.timeslice);
+}
+
+std::string HypervisorSimulator::policyName(HostPolicy policy) {
+    switch (policy) {
+        case HostPolicy::ROUND_ROBIN:
+            return "Round Robin";
+        case HostPolicy::FAIR_SHARE:
+            return "Fair Share";
+    }
+    return "Unknown";
+}
+
+HypervisorMetrics HypervisorSimulator::run(const std::vector<VirtualMachine>& vms) {
+    // Place each VM's tasks on its vCPUs round-robin in arrival order
+    std::vector<Vcpu> vcpus;
+    std::vector<std::vector<const Process*>> placed;
+    for (const VirtualMachine& vm : vms) {
+        size_t first = vcpus.size();
+        int count = std::max(1, vm.vcpus);
+        for (int k = 0; k < count; k++) {
+            Vcpu vcpu = Vcpu();
+            vcpu.state = VcpuState::IDLE;
+            vcpu.stopAt = -1;
+            vcpu.weight = std::max(1, vm.weight);
+            vcpus.push_back(vcpu);
+            placed.emplace_back();
+        }
+        std::vector<const Process*> order;
+        for (const auto& task : vm.tasks) {
+            order.push_back(task.get());
+        }
+        std::sort(order.begin(), order.end(), [](const Process* a, const Process* b) {
+            return Scheduler::tieBreakBefore(0, *a, *b);
+        });
+        for (size_t i = 0; i < order.size(); i++) {
+            size_t v = first + i % static_cast<size_t>(count);
+            vcpus[v].arrivals.emplace_back(order[i]->getArrivalTime(), order[i]->getBurstTime());
+            placed[v].push_back(order[i]);
+        }
+    }
+
+    // 1. Host pass: vCPUs on pCPUs; STOP events are invalidated by stopAt
+    enum : uint64_t { ARRIVAL = 0, STOP = 1 };
+    std::unique_ptr<FutureEventSet> events = createFutureEventSet(FutureEventSetType::AUTO, vcpus.size());
+    for (size_t v = 0; v < vcpus.size(); v++) {
+        if (!vcpus[v].arrivals.empty()) {
+            events->push(vcpus[v].arrivals[0].first, v << 1 | ARRIVAL);
+        }
+    }
+    const bool fair = config.policy == HostPolicy::FAIR_SHARE;
+    DispatchQueue runQueue(0, fair ? DsqOrder::VTIME : DsqOrder::FIFO);
+    uint64_t minVruntime = 0;
+    int freePcpus = config.pcpus;
+    int64_t busy = 0;
+    auto enqueue = [&](size_t v, int64_t now) {
+        Vcpu& vcpu = vcpus[v];
+        vcpu.state = VcpuState::RUNNABLE;
+        vcpu.stealStart = now;
+        if (fair) {
+            vcpu.vruntime = std::max(vcpu.vruntime, minVruntime);
+            runQueue.insertVtime(static_cast<int>(v), vcpu.vruntime);
+        } else {
+            runQueue.insert(static_cast<int>(v));
+        }
+    };
+
+    FutureEvent event;
+    while (!events->empty()) {
+        const int64_t now = events->nextTime();
+        while (events->nextTime() == now && events->pop(event)) {
+            size_t v = static_cast<size_t>(event.payload >> 1);
+            Vcpu& vcpu = vcpus[v];
+            if ((event.payload & 1) == ARRIVAL) {
+                while (vcpu.nextArrival < vcpu.arrivals.size() && vcpu.arrivals[vcpu.nextArrival].first == now) {
+                    vcpu.work += vcpu.arrivals[vcpu.nextArrival++].second;
+                }
+                if (vcpu.nextArrival < vcpu.arrivals.size()) {
+                    events->push(vcpu.arrivals[vcpu.nextArrival].first, v << 1 | ARRIVAL);
+                }
+                if (vcpu.state == VcpuState::IDLE) {
+                    enqueue(v, now);
+                } else if (vcpu.state == VcpuState::RUNNING) {
+                    vcpu.stopAt = std::min(vcpu.sliceEnd, vcpu.runStart + vcpu.work);
+                    events->push(vcpu.stopAt, v << 1 | STOP);
+                }
+                continue;
+            }
+            if (vcpu.state != VcpuState::RUNNING || vcpu.stopAt != now) {
+                continue;
+            }
+            int64_t ran = now - vcpu.runStart;
+            vcpu.work -= ran;
+            vcpu.vruntime += static_cast<uint64_t>(ran) * VRUNTIME_SCALE / static_cast<uint64_t>(vcpu.weight);
+            busy += ran;
+            freePcpus++;
+            if (vcpu.work > 0) {
+                enqueue(v, now);
+            } else {
+                vcpu.state = VcpuState::IDLE;
+            }
+        }
+
+        // Free pCPUs take runnable vCPUs
+        while (freePcpus > 0 && !runQueue.empty()) {
+            size_t v = static_cast<size_t>(runQueue.pop());
+            Vcpu& vcpu = vcpus[v];
+            if (now > vcpu.stealStart) {
+                vcpu.steal.emplace_back(vcpu.stealStart, now);
+            }
+            minVruntime = std::max(minVruntime, vcpu.vruntime);
+            vcpu.state = VcpuState::RUNNING;
+            vcpu.runStart = now;
+            vcpu.sliceEnd = now + config.timeslice;
+            vcpu.stopAt = std::min(vcpu.sliceEnd, now + vcpu.work);
+            events->push(vcpu.stopAt, v << 1 | STOP);
+            freePcpus--;
+        }
+    }
+
+    // 2. Guest pass: every vCPU's scheduler in its own guest time, in parallel
+    std::vector<GuestResult> results(vcpus.size());
+    parallelFor(vcpus.size(), workerThreads(config.numThreads, vcpus.size()), [&](size_t v) {
+        GuestResult& result = results[v];
+        result.sections = 0;
+        result.preemptedSections = 0;
+        result.lockHolderDelay = 0;
+        result.maxLockHolderDelay = 0;
+        result.firstArrival = INT_MAX;
+        result.lastCompletion = 0;
+        if (placed[v].empty()) {
+            return;
+        }
+        GuestClock clock(vcpus[v].steal);
+        std::unique_ptr<Scheduler> guest = guestFactory();
+        std::unordered_map<int, const Process*> original;
+        bool sections = false;
+        for (const Process* task : placed[v]) {
+            auto copy = std::make_shared<Process>(task->getPID(), task->getName(),
+                                                  static_cast<int>(clock.toGuest(task->getArrivalTime())),
+                                                  task->getBurstTime(), task->getPriority());
+            for (const CriticalSection& section : task->getCriticalSections()) {
+                copy->addCriticalSection(section.lock, section.start, section.length);
+                sections = true;
+            }
+            original[task->getPID()] = task;
+            guest->addProcess(copy);
+        }
+        guest->setRecordSlices(sections);
+        guest->schedule();
+
+        // Slices per task, for locating critical sections in guest time
+        std::unordered_map<int, std::vector<ExecutionSlice>> slicesOf;
+        for (const ExecutionSlice& slice : guest->getExecutionSlices()) {
+            slicesOf[slice.pid].push_back(slice);
+        }
+        // Guest time at which a task has executed @p offset units
+        auto executedAt = [](const std::vector<ExecutionSlice>& slices, int offset, bool start) {
+            int before = 0;
+            for (const ExecutionSlice& slice : slices) {
+                int length = slice.end - slice.start;
+                if (start ? offset < before + length : offset <= before + length) {
+                    return static_cast<int64_t>(slice.start + offset - before);
+                }
+                before += length;
+            }
+            return static_cast<int64_t>(-1);
+        };
+
+        for (const auto& process : guest->getProcesses()) {
+            if (process->getState() != ProcessState::TERMINATED) {
+                continue;
+            }
+            int arrival = original[process->getPID()]->getArrivalTime();
+            int64_t completion = clock.endToReal(process->getCompletionTime());
+            int64_t start = clock.startToReal(process->getStartTime());
+            int64_t turnaround = completion - arrival;
+            int64_t stolen = turnaround - process->getTurnaroundTime();
+            result.turnaround.add(static_cast<double>(turnaround));
+            result.waiting.add(static_cast<double>(process->getWaitingTime() + stolen));
+            result.response.add(static_cast<double>(start - arrival));
+            result.steal.add(static_cast<double>(stolen));
+            result.firstArrival = std::min(result.firstArrival, arrival);
+            result.lastCompletion = std::max(result.lastCompletion, static_cast<int>(completion));
+
+            const std::vector<ExecutionSlice>& slices = slicesOf[process->getPID()];
+            for (const CriticalSection& section : process->getCriticalSections()) {
+                int end = std::min(section.start + section.length, process->getBurstTime());
+                int64_t from = executedAt(slices, section.start, true);
+                int64_t to = executedAt(slices, end, false);
+                if (from < 0 || to < 0) {
+                    continue;
+                }
+                int64_t delay = (clock.endToReal(to) - clock.startToReal(from)) - (to - from);
+                result.sections++;
+                result.preemptedSections += delay > 0 ? 1 : 0;
+                result.lockHolderDelay += delay;
+                result.maxLockHolderDelay = std::max(result.maxLockHolderDelay, static_cast<int>(delay));
+            }
+        }
+    });
+
+    HypervisorMetrics metrics;
+    metrics.vcpus = vcpus.size();
+    metrics.stolenTime = 0;
+    metrics.criticalSections = 0;
+    metrics.preemptedSections = 0;
+    metrics.lockHolderDelay = 0;
+    metrics.maxLockHolderDelay = 0;
+    vcpuSteal.assign(vcpus.size(), 0);
+    int firstArrival = INT_MAX;
+    int lastCompletion = 0;
+    for (size_t v = 0; v < vcpus.size(); v++) {
+        for (const auto& interval : vcpus[v].steal) {
+            vcpuSteal[v] += interval.second - interval.first;
+        }
+        metrics.stolenTime += vcpuSteal[v];
+        const GuestResult& result = results[v];
+        metrics.waiting.merge(result.waiting);
+        metrics.turnaround.merge(result.turnaround);
+        metrics.response.merge(result.response);
+        metrics.steal.merge(result.steal);
+        metrics.criticalSections += result.sections;
+        metrics.preemptedSections += result.preemptedSections;
+        metrics.lockHolderDelay += result.lockHolderDelay;
+        metrics.maxLockHolderDelay = std::max(metrics.maxLockHolderDelay, result.maxLockHolderDelay);
+        firstArrival = std::min(firstArrival, result.firstArrival);
+        lastCompletion = std::max(lastCompletion, result.lastCompletion);
+    }
+    metrics.processes = static_cast<size_t>(metrics.turnaround.count());
+    metrics.stealPercent = metrics.stolenTime + busy > 0
+        ? 100.0 * static_cast<double>(metrics.stolenTime) / static_cast<double>(metrics.stolenTime + busy)
+        : 0.0;
+    metrics.makespan = firstArrival == INT_MAX ? 0 : lastCompletion - firstArrival;
+    metrics.utilization = metrics.makespan > 0
+        ? 100.0 * static_cast<double>(busy) / (static_cast<double>(config.pcpus) * metrics.makespan)
+        : 0.0;
+    return metrics;
+}
@@ -0,0 +1,175 @@
+#include "InterruptModel.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+/**
+ * @file InterruptModel.cpp
+ * @brief Implementation of interrupt sources and per-core handler timelines
+ */
+
+InterruptTimeline::InterruptTimeline(const std::vector<InterruptSource>& sources, uint64_t seed)
+    : stolen(0), handled(0.0), interrupts(0) {
+    for (size_t i = 0; i < sources.size(); i++) {
+        streams.push_back(Stream{sources[i], std::mt19937_64(WorkloadGenerator::replicaSeed(seed, i))});
+        Stream& stream = streams.back();
+        double u = WorkloadGenerator::uniform01(stream.engine);
+        // A periodic source starts at a random phase
+        double first = stream.source.arrivalDistribution == BurstDistribution::CONSTANT
+                           ? u * stream.source.meanInterarrival
+                           : sample(stream.source.arrivalDistribution, stream.source.meanInterarrival, u);
+        pending.emplace(first, i);
+    }
+}
+
+double InterruptTimeline::sample(BurstDistribution shape, double mean, double u) {
+    switch (shape) {
+        case BurstDistribution::CONSTANT:
+            return mean;
+        case BurstDistribution::UNIFORM:
+            return 2.0 * mean * u;
+        case BurstDistribution::EXPONENTIAL:
+            return -mean * std::log(1.0 - u);
+    }
+    return mean;
+}
+
+bool InterruptTimeline::generateNext() {
+    if (pending.empty()) {
+        return false;
+    }
+
+    // Handlers run back to back while interrupts arrive before the last one ends
+    const double start = pending.top().first;
+    double end = start;
+    double cost = 0.0;
+    while (!pending.empty() && pending.top().first <= end) {
+        Pending irq = pending.top();
+        pending.pop();
+        Stream& stream = streams[irq.second];
+        const InterruptSource& source = stream.source;
+        double handler = sample(source.costDistribution, source.hardirqCost,
+                                WorkloadGenerator::uniform01(stream.engine)) +
+                         sample(source.costDistribution, source.softirqCost,
+                                WorkloadGenerator::uniform01(stream.engine));
+        end += handler;
+        cost += handler;
+        interrupts++;
+        pending.emplace(irq.first + sample(source.arrivalDistribution, source.meanInterarrival,
+                                           WorkloadGenerator::uniform01(stream.engine)),
+                        irq.second);
+    }
+
+    // Whole time units, carrying the rounding error into the next period
+    int64_t before = std::llround(handled);
+    handled += cost;
+    int64_t length = std::llround(handled) - before;
+    if (length <= 0) {
+        return true;
+    }
+    int64_t realStart = std::llround(start);
+    if (!realEnds.empty() && realStart <= realEnds.back()) {
+        realEnds.back() += length;
+    } else {
+        realStarts.push_back(realStart);
+        realEnds.push_back(realStart + length);
+        processStarts.push_back(realStart - stolen);
+    }
+    stolen += length;
+    return true;
+}
+
+void InterruptTimeline::generateUntil(int64_t realTime, int64_t processTime) {
+    while ((realStarts.empty() || realStarts.back() <= realTime || processStarts.back() <= processTime) &&
+           generateNext()) {
+    }
+}
+
+int64_t InterruptTimeline::toProcessTime(int64_t t) {
+    generateUntil(t, INT64_MIN);
+    size_t j = static_cast<size_t>(std::lower_bound(realStarts.begin(), realStarts.end(), t) - realStarts.begin());
+    if (j == 0) {
+        return t;
+    }
+    int64_t stolenBefore = realStarts[j - 1] - processStarts[j - 1];
+    return t - stolenBefore - (std::min(t, realEnds[j - 1]) - realStarts[j - 1]);
+}
+
+int64_t InterruptTimeline::toRealTime(int64_t t, bool afterHandlers) {
+    generateUntil(INT64_MIN, t);
+    auto found = afterHandlers ? std::upper_bound(processStarts.begin(), processStarts.end(), t)
+                               : std::lower_bound(processStarts.begin(), processStarts.end(), t);
+    size_t j = static_cast<size_t>(found - processStarts.begin());
+    return j == 0 ? t : t + realEnds[j - 1] - processStarts[j - 1];
+}
+
+int64_t InterruptTimeline::handlerTimeDuring(int64_t start, int64_t duration) {
+    return toRealTime(start + duration) - toRealTime(start) - duration;
+}
+
+void InterruptTimeline::completeInRealTime(Process& process, int64_t completion) {
+    int arrival = process.getArrivalTime();
+    int real = static_cast<int>(toRealTime(completion));
+    int stolen = (real - arrival) - static_cast<int>(completion - toProcessTime(arrival));
+    int start = static_cast<int>(toRealTime(process.getStartTime()));
+    if (start < arrival) {
+        // Arrived while handlers ran, so their time before it was not its own
+        int after = static_cast<int>(toRealTime(process.getStartTime(), true));
+        process.addInterruptTime(start - after);
+        start = after;
+    }
+    process.setStartTime(start);
+    process.setCompletionTime(real);
+    process.addWaitingTime(std::max(0, stolen - process.getInterruptTime()));
+}
+
+InterruptModel::InterruptModel(int cores, uint64_t seed)
+    : cores(std::min(64, std::max(1, cores))), seed(seed) {
+}
+
+bool InterruptModel::addSource(const InterruptSource& source) {
+    uint64_t machine = cores == 64 ? ~0ULL : (1ULL << cores) - 1;
+    if (!(source.meanInterarrival > 0) || source.hardirqCost < 0 || source.softirqCost < 0 ||
+        (source.affinity != 0 && (source.affinity & machine) == 0)) {
+        return false;
+    }
+    sources.push_back(source);
+    return true;
+}
+
+std::vector<InterruptSource> InterruptModel::sourcesOn(int core) const {
+    uint64_t machine = cores == 64 ? ~0ULL : (1ULL << cores) - 1;
+    std::vector<InterruptSource> result;
+    for (const InterruptSource& source : sources) {
+        uint64_t allowed = (source.affinity == 0 ? machine : source.affinity) & machine;
+        if ((allowed >> core & 1) == 0) {
+            continue;
+        }
+        int spread = 0;
+        for (uint64_t bits = allowed; bits != 0; bits &= bits - 1) {
+            spread++;
+        }
+        result.push_back(source);
+        result.back().meanInterarrival *= spread;
+    }
+    return result;
+}
+
+double InterruptModel::coreLoad(int core) const {
+    if (core < 0 || core >= cores) {
+        return 0.0;
+    }
+    double load = 0.0;
+    for (const InterruptSource& source : sourcesOn(core)) {
+        load += (source.hardirqCost + source.softirqCost) / source.meanInterarrival;
+    }
+    return load;
+}
+
+std::shared_ptr<InterruptTimeline> InterruptModel::createTimeline(int core) const {
+    if (core < 0 || core >= cores || coreLoad(core) >= 1.0) {
+        return nullptr;
+    }
+    return std::make_shared<InterruptTimeline>(sourcesOn(core),
+                                               WorkloadGenerator::replicaSeed(seed, static_cast<uint64_t>(core)));
+}
@@ -0,0 +1,67 @@
+#include "LatencyHistogram.h"
+
+/**
+ * @file LatencyHistogram.cpp
+ * @brief Implementation of the per-class scheduling latency histogram
+ */
+
+LatencyHistogram::LatencyHistogram(double relativeAccuracy)
+    : relativeAccuracy(relativeAccuracy), lowest(0), all(relativeAccuracy) {
+}
+
+QuantileSketch& LatencyHistogram::sketchFor(int priorityClass) {
+    if (classes.empty()) {
+        lowest = priorityClass;
+        classes.emplace_back(relativeAccuracy);
+    } else if (priorityClass < lowest) {
+        classes.insert(classes.begin(), static_cast<size_t>(lowest - priorityClass),
+                       QuantileSketch(relativeAccuracy));
+        lowest = priorityClass;
+    } else if (priorityClass - lowest >= static_cast<int>(classes.size())) {
+        classes.resize(static_cast<size_t>(priorityClass - lowest) + 1, QuantileSketch(relativeAccuracy));
+    }
+    return classes[static_cast<size_t>(priorityClass - lowest)];
+}
+
+void LatencyHistogram::record(int priorityClass, double latency) {
+    sketchFor(priorityClass).add(latency);
+    all.add(latency);
+}
+
+bool LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.relativeAccuracy != relativeAccuracy) {
+        return false;
+    }
+    for (size_t i = 0; i < other.classes.size(); i++) {
+        if (other.classes[i].count() > 0) {
+            sketchFor(other.lowest + static_cast<int>(i)).merge(other.classes[i]);
+        }
+    }
+    all.merge(other.all);
+    return true;
+}
+
+void LatencyHistogram::clear() {
+    classes.clear();
+    lowest = 0;
+    all = QuantileSketch(relativeAccuracy);
+}
+
+std::vector<int> LatencyHistogram::getClasses() const {
+    std::vector<int> result;
+    for (size_t i = 0; i < classes.size(); i++) {
+        if (classes[i].count() > 0) {
+            result.push_back(lowest + static_cast<int>(i));
+        }
+    }
+    return result;
+}
+
+const QuantileSketch& LatencyHistogram::forClass(int priorityClass) const {
+    static const QuantileSketch EMPTY;
+    int index = priorityClass - lowest;
+    if (index < 0 || index >= static_cast<int>(classes.size())) {
+        return EMPTY;
+    }
+    return classes[static_cast<size_t>(index)];
+}
@@ -0,0 +1,97 @@
+#include "MemoryModel.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file MemoryModel.cpp
+ * @brief Implementation of the incremental memory account, swap model and admission queue
+ */
+
+MemoryAccount::MemoryAccount(const MemoryConfig& config)
+    : config(config), resident(0), workingSet(0) {
+}
+
+bool MemoryAccount::isValid(const MemoryConfig& config) {
+    return config.capacity > 0 && config.admissionLimit >= 0 &&
+           config.workingSetFraction > 0 && config.workingSetFraction <= 1 &&
+           config.swapPenalty >= 0;
+}
+
+int64_t MemoryAccount::workingSetOf(int64_t rss) const {
+    return std::llround(static_cast<double>(rss) * config.workingSetFraction);
+}
+
+bool MemoryAccount::admits(int64_t rss) const {
+    if (config.admissionLimit <= 0 || resident == 0) {
+        return true;
+    }
+    return static_cast<double>(resident + rss) <= config.admissionLimit * static_cast<double>(config.capacity);
+}
+
+void MemoryAccount::charge(int64_t rss) {
+    resident += rss;
+    workingSet += workingSetOf(rss);
+}
+
+void MemoryAccount::release(int64_t rss) {
+    resident -= rss;
+    workingSet -= workingSetOf(rss);
+}
+
+int MemoryAccount::speed() const {
+    if (workingSet <= config.capacity) {
+        return 1000;
+    }
+    double overflow = static_cast<double>(workingSet - config.capacity) / static_cast<double>(workingSet);
+    return std::max(1, static_cast<int>(std::lround(1000.0 / (1.0 + config.swapPenalty * overflow))));
+}
+
+void MemoryAccount::clear() {
+    resident = 0;
+    workingSet = 0;
+}
+
+MemoryAdmission::MemoryAdmission(const MemoryConfig& config)
+    : account(config), heldQueueSince(-1), pressureTime(0) {
+}
+
+void MemoryAdmission::reset(size_t processes) {
+    account.clear();
+    held.clear();
+    charged.assign(processes, 0);
+    heldQueueSince = -1;
+    pressureTime = 0;
+}
+
+bool MemoryAdmission::admit(size_t index, int64_t rss, int now) {
+    if (charged[index]) {
+        return true;
+    }
+    if (held.empty() && account.admits(rss)) {
+        account.charge(rss);
+        charged[index] = 1;
+        return true;
+    }
+    if (held.empty()) {
+        heldQueueSince = now;
+    }
+    held.push_back(Held{index, rss, now});
+    return false;
+}
+
+std::vector<std::pair<size_t, int>> MemoryAdmission::release(int64_t rss, int now) {
+    std::vector<std::pair<size_t, int>> released;
+    account.release(rss);
+    while (!held.empty() && account.admits(held.front().rss)) {
+        const Held& next = held.front();
+        account.charge(next.rss);
+        charged[next.index] = 1;
+        released.emplace_back(next.index, now - next.since);
+        held.pop_front();
+    }
+    if (held.empty() && heldQueueSince >= 0) {
+        pressureTime += now - heldQueueSince;
+        heldQueueSince = -1;
+    }
+    return released;
+}
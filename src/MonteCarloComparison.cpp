@@ -0,0 +1,366 @@
+#include "MonteCarloComparison.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+/**
+ * @file MonteCarloComparison.cpp
+ * @brief Implementation of the replicated policy comparison
+ */
+
+static const ComparisonMetric ALL_METRICS[] = {
+    ComparisonMetric::WAITING_TIME,
+    ComparisonMetric::TURNAROUND_TIME,
+    ComparisonMetric::RESPONSE_TIME,
+    ComparisonMetric::CPU_UTILIZATION,
+    ComparisonMetric::THROUGHPUT,
+    ComparisonMetric::CONTEXT_SWITCHES
+};
+
+/**
+ * @brief Inverse of the standard normal CDF (Acklam's rational approximation)
+ */
+static double normalQuantile(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02,
+                               -2.759285104469687e+02, 1.383577518672690e+02,
+                               -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02,
+                               -1.556989798598866e+02, 6.680131188771972e+01,
+                               -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01,
+                               -2.400758277161838e+00, -2.549732539343734e+00,
+                               4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01,
+                               2.445134137142996e+00, 3.754408661907416e+00};
+    const double low = 0.02425;
+
+    if (p < low) {
+        double q = std::sqrt(-2 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+    if (p > 1 - low) {
+        double q = std::sqrt(-2 * std::log(1 - p));
+        return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
+
+double studentTCritical(double confidenceLevel, int degreesOfFreedom) {
+    double p = 0.5 + confidenceLevel / 2.0;  // Upper-tail quantile
+    const double pi = 3.14159265358979323846;
+
+    // Closed forms where the expansion is inaccurate
+    if (degreesOfFreedom <= 1) {
+        return std::tan(pi * (p - 0.5));
+    }
+    if (degreesOfFreedom == 2) {
+        return (2 * p - 1) * std::sqrt(2.0 / (4 * p * (1 - p)));
+    }
+
+    double z = normalQuantile(p);
+    double v = degreesOfFreedom;
+    double z2 = z * z;
+    double g1 = (z2 + 1) * z / 4;
+    double g2 = ((5 * z2 + 16) * z2 + 3) * z / 96;
+    double g3 = (((3 * z2 + 19) * z2 + 17) * z2 - 15) * z / 384;
+    double g4 = ((((79 * z2 + 776) * z2 + 1482) * z2 - 1920) * z2 - 945) * z / 92160;
+    return z + g1 / v + g2 / (v * v) + g3 / (v * v * v) + g4 / (v * v * v * v);
+}
+
+IntervalEstimate estimateInterval(const std::vector<double>& values, double confidenceLevel) {
+    IntervalEstimate estimate;
+    estimate.samples = static_cast<int>(values.size());
+    if (values.empty()) {
+        return estimate;
+    }
+
+    // Welford's algorithm for a numerically stable variance
+    double mean = 0;
+    double m2 = 0;
+    int n = 0;
+    for (double x : values) {
+        n++;
+        double delta = x - mean;
+        mean += delta / n;
+        m2 += delta * (x - mean);
+    }
+
+    estimate.mean = mean;
+    if (n > 1) {
+        estimate.stddev = std::sqrt(m2 / (n - 1));
+        estimate.halfWidth = studentTCritical(confidenceLevel, n - 1) *
+                             estimate.stddev / std::sqrt(static_cast<double>(n));
+    }
+    return estimate;
+}
+
+MonteCarloComparison::MonteCarloComparison(const WorkloadDistribution& distribution,
+                                           const MonteCarloConfig& config)
+    : generator(distribution), config(config), replicasRun(0), stoppedEarly(false) {
+}
+
+void MonteCarloComparison::addPolicy(const std::string& name, SchedulerFactory factory) {
+    policyNames.push_back(name);
+    factories.push_back(factory);
+    samples.emplace_back();
+}
+
+double MonteCarloComparison::metricValue(const SchedulingMetrics& metrics,
+                                         ComparisonMetric metric) {
+    switch (metric) {
+        case ComparisonMetric::WAITING_TIME:
+            return metrics.averageWaitingTime;
+        case ComparisonMetric::TURNAROUND_TIME:
+            return metrics.averageTurnaroundTime;
+        case ComparisonMetric::RESPONSE_TIME:
+            return metrics.averageResponseTime;
+        case ComparisonMetric::CPU_UTILIZATION:
+            return metrics.cpuUtilization;
+        case ComparisonMetric::THROUGHPUT:
+            return metrics.throughput;
+        case ComparisonMetric::CONTEXT_SWITCHES:
+            return metrics.totalContextSwitches;
+    }
+    return 0;
+}
+
+std::string MonteCarloComparison::metricName(ComparisonMetric metric) {
+    switch (metric) {
+        case ComparisonMetric::WAITING_TIME:
+            return "Avg Wait";
+        case ComparisonMetric::TURNAROUND_TIME:
+            return "Avg TAT";
+        case ComparisonMetric::RESPONSE_TIME:
+            return "Avg Resp";
+        case ComparisonMetric::CPU_UTILIZATION:
+            return "CPU %";
+        case ComparisonMetric::THROUGHPUT:
+            return "Throughput";
+        case ComparisonMetric::CONTEXT_SWITCHES:
+            return "Switches";
+    }
+    return "Unknown";
+}
+
+bool MonteCarloComparison::lowerIsBetter(ComparisonMetric metric) {
+    return metric != ComparisonMetric::CPU_UTILIZATION &&
+           metric != ComparisonMetric::THROUGHPUT;
+}
+
+void MonteCarloComparison::runBatch(int first, int last) {
+    for (auto& policySamples : samples) {
+        policySamples.resize(last);
+    }
+
+    // Workers claim replica indices; each result lands in its own slot, so
+    // no locking is needed and the outcome is independent of thread count.
+    size_t replicas = static_cast<size_t>(last - first);
+    parallelFor(replicas, workerThreads(config.numThreads, replicas), [&](size_t k) {
+        int replica = first + static_cast<int>(k);
+        auto workload = generator.generate(
+            WorkloadGenerator::replicaSeed(config.baseSeed, replica));
+
+        for (size_t policy = 0; policy < factories.size(); policy++) {
+            std::unique_ptr<Scheduler> scheduler = factories[policy]();
+            for (const auto& process : workload) {
+                scheduler->addProcess(std::make_shared<Process>(*process));
+            }
+            scheduler->schedule();
+            samples[policy][replica] = scheduler->calculateMetrics();
+        }
+    });
+}
+
+bool MonteCarloComparison::shouldStop() const {
+    if (replicasRun < config.minReplicas) {
+        return false;
+    }
+
+    // Precision rule: all time-based intervals are tight relative to their means
+    static const ComparisonMetric precisionMetrics[] = {
+        ComparisonMetric::WAITING_TIME,
+        ComparisonMetric::TURNAROUND_TIME,
+        ComparisonMetric::RESPONSE_TIME
+    };
+
+    bool allTight = true;
+    for (const auto& stats : getStatistics()) {
+        for (ComparisonMetric metric : precisionMetrics) {
+            const IntervalEstimate& estimate = stats.metrics[static_cast<int>(metric)];
+            if (estimate.halfWidth > config.relativePrecision * std::fabs(estimate.mean)) {
+                allTight = false;
+            }
+        }
+    }
+    if (allTight) {
+        return true;
+    }
+
+    // Separation rule: every policy differs significantly from the current best
+    if (config.stopOnSeparation && factories.size() > 1) {
+        std::vector<PolicyStatistics> stats = getStatistics();
+        int primary = static_cast<int>(config.primaryMetric);
+        size_t best = 0;
+        for (size_t i = 1; i < stats.size(); i++) {
+            double candidate = stats[i].metrics[primary].mean;
+            double current = stats[best].metrics[primary].mean;
+            if (lowerIsBetter(config.primaryMetric) ? candidate < current : candidate > current) {
+                best = i;
+            }
+        }
+
+        for (const auto& comparison : getPairedComparisons(best)) {
+            if (comparison.metric == config.primaryMetric &&
+                comparison.policy != comparison.baseline && !comparison.significant) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+void MonteCarloComparison::run() {
+    replicasRun = 0;
+    stoppedEarly = false;
+    for (auto& policySamples : samples) {
+        policySamples.clear();
+    }
+    if (factories.empty()) {
+        return;
+    }
+
+    int batch = std::max(1, config.batchSize);
+    while (replicasRun < config.maxReplicas) {
+        int target = std::max(replicasRun + batch, std::min(config.minReplicas, config.maxReplicas));
+        target = std::min(target, config.maxReplicas);
+        runBatch(replicasRun, target);
+        replicasRun = target;
+
+        if (replicasRun < config.maxReplicas && shouldStop()) {
+            stoppedEarly = true;
+            break;
+        }
+    }
+}
+
+std::vector<PolicyStatistics> MonteCarloComparison::getStatistics() const {
+    std::vector<PolicyStatistics> result;
+    std::vector<double> values(replicasRun);
+
+    for (size_t policy = 0; policy < factories.size(); policy++) {
+        PolicyStatistics stats;
+        stats.name = policyNames[policy];
+        for (ComparisonMetric metric : ALL_METRICS) {
+            for (int r = 0; r < replicasRun; r++) {
+                values[r] = metricValue(samples[policy][r], metric);
+            }
+            stats.metrics.push_back(estimateInterval(values, config.confidenceLevel));
+        }
+        result.push_back(stats);
+    }
+    return result;
+}
+
+std::vector<PairedComparison> MonteCarloComparison::getPairedComparisons(
+    size_t baselineIndex) const {
+    std::vector<PairedComparison> result;
+    if (baselineIndex >= factories.size()) {
+        return result;
+    }
+
+    std::vector<double> differences(replicasRun);
+    for (size_t policy = 0; policy < factories.size(); policy++) {
+        for (ComparisonMetric metric : ALL_METRICS) {
+            // Common random numbers: replica r of both policies saw the same workload
+            for (int r = 0; r < replicasRun; r++) {
+                differences[r] = metricValue(samples[policy][r], metric) -
+                                 metricValue(samples[baselineIndex][r], metric);
+            }
+
+            PairedComparison comparison;
+            comparison.policy = policyNames[policy];
+            comparison.baseline = policyNames[baselineIndex];
+            comparison.metric = metric;
+            comparison.difference = estimateInterval(differences, config.confidenceLevel);
+
+            double standardError = comparison.difference.samples > 0
+                ? comparison.difference.stddev / std::sqrt(static_cast<double>(comparison.difference.samples))
+                : 0;
+            comparison.tStatistic = standardError > 0 ? comparison.difference.mean / standardError : 0;
+            comparison.significant = comparison.difference.lower() > 0 ||
+                                     comparison.difference.upper() < 0;
+            result.push_back(comparison);
+        }
+    }
+    return result;
+}
+
+void MonteCarloComparison::displayResults() const {
+    std::vector<PolicyStatistics> stats = getStatistics();
+
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "STATISTICAL COMPARISON (" << replicasRun << " replicas, "
+              << static_cast<int>(config.confidenceLevel * 100) << "% confidence"
+              << (stoppedEarly ? ", stopped adaptively" : "") << ")\n";
+    std::cout << std::string(80, '=') << "\n\n";
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(35) << "Algorithm"
+              << std::setw(15) << "Avg Wait"
+              << std::setw(15) << "Avg TAT"
+              << std::setw(15) << "Avg Resp"
+              << "\n";
+    std::cout << std::string(80, '-') << "\n";
+    for (const auto& policy : stats) {
+        std::cout << std::left << std::setw(35) << policy.name;
+        for (int m = 0; m < 3; m++) {
+            const IntervalEstimate& e = policy.metrics[m];
+            std::ostringstream cell;
+            cell << std::fixed << std::setprecision(2) << e.mean << " +/-" << e.halfWidth;
+            std::cout << std::setw(15) << cell.str();
+        }
+        std::cout << "\n";
+    }
+
+    if (stats.size() < 2) {
+        std::cout << std::string(80, '=') << "\n";
+        return;
+    }
+
+    // Paired differences against the best policy on the primary metric
+    int primary = static_cast<int>(config.primaryMetric);
+    size_t best = 0;
+    for (size_t i = 1; i < stats.size(); i++) {
+        double candidate = stats[i].metrics[primary].mean;
+        double current = stats[best].metrics[primary].mean;
+        if (lowerIsBetter(config.primaryMetric) ? candidate < current : candidate > current) {
+            best = i;
+        }
+    }
+
+    std::cout << "\nPaired differences vs. best on " << metricName(config.primaryMetric)
+              << " (" << stats[best].name << "):\n";
+    std::cout << std::string(80, '-') << "\n";
+    for (const auto& comparison : getPairedComparisons(best)) {
+        if (comparison.metric != config.primaryMetric || comparison.policy == comparison.baseline) {
+            continue;
+        }
+        std::cout << std::left << std::setw(35) << comparison.policy
+                  << std::right << std::setw(10) << comparison.difference.mean
+                  << " +/- " << std::left << std::setw(10) << comparison.difference.halfWidth
+                  << " t=" << std::setw(9) << comparison.tStatistic
+                  << (comparison.significant ? "significant" : "not significant")
+                  << "\n";
+    }
+    std::cout << std::string(80, '=') << "\n";
+}
@@ -64,23 +64,51 @@ void MultilevelFeedbackQueueScheduler::promoteProcess(std::shared_ptr<Process> p
 void MultilevelFeedbackQueueScheduler::applyAging() {
     if (!agingEnabled) return;
     
+    bool promoted = false;
     for (auto& process : processes) {
         if (process->getState() == ProcessState::READY) {
             int pid = process->getPID();
             timeInQueue[pid]++;
             
-            if (timeInQueue[pid] >= agingThreshold) {
+            if (timeInQueue[pid] >= agingThreshold && processQueueLevel[pid] > 0) {
                 promoteProcess(process);
+                promoted = true;
             }
         }
     }
+    if (!promoted) {
+        return;
+    }
+    
+    // Move promoted processes to the back of their new level's queue,
+    // scanning from the top level so each keeps its order among its peers
+    std::vector<std::queue<std::shared_ptr<Process>>> old(numQueues);
+    old.swap(queues);
+    for (auto& queue : old) {
+        while (!queue.empty()) {
+            std::shared_ptr<Process> process = queue.front();
+            queue.pop();
+            queues[processQueueLevel[process->getPID()]].push(process);
+        }
+    }
+}
+
+void MultilevelFeedbackQueueScheduler::enqueueArrivals() {
+    for (auto& process : admitArrivingProcesses()) {
+        queues[processQueueLevel[process->getPID()]].push(process);
+        process->setLastScheduledTime(currentTime);
+    }
 }
 
 void MultilevelFeedbackQueueScheduler::schedule() {
     currentTime = 0;
     ganttChart.clear();
+    resetTimeline();
     processQueueLevel.clear();
     timeInQueue.clear();
+    for (auto& queue : queues) {
+        queue = std::queue<std::shared_ptr<Process>>();
+    }
     
     // Initialize all processes to highest priority queue (level 0)
     for (const auto& process : processes) {
@@ -93,147 +121,78 @@ void MultilevelFeedbackQueueScheduler::schedule() {
     for (const auto& process : processes) {
         earliestArrival = std::min(earliestArrival, process->getArrivalTime());
     }
-    currentTime = earliestArrival;
-    
-    bool allComplete = false;
+    currentTime = toProcessTime(earliestArrival);
+    int lastAgingCheck = currentTime;
     
-    while (!allComplete) {
-        // Admit any processes that have arrived
-        admitArrivingProcesses();
+    while (true) {
+        // Add newly arrived processes to their queues
+        enqueueArrivals();
         
-        // Apply aging periodically
-        if (currentTime % agingThreshold == 0) {
+        // Apply aging whenever time has crossed a multiple of the threshold;
+        // quanta and switch overhead rarely land exactly on one
+        if (currentTime / agingThreshold != lastAgingCheck / agingThreshold) {
             applyAging();
         }
-        
-        // Add ready processes to their appropriate queues
-        for (auto& process : processes) {
-            if (process->getState() == ProcessState::READY && 
-                process->getLastScheduledTime() < currentTime) {
-                
-                int queueLevel = processQueueLevel[process->getPID()];
-                
-                // Check if process is not already in queue
-                bool inQueue = false;
-                std::queue<std::shared_ptr<Process>> tempQueue = queues[queueLevel];
-                while (!tempQueue.empty()) {
-                    if (tempQueue.front() == process) {
-                        inQueue = true;
-                        break;
-                    }
-                    tempQueue.pop();
-                }
-                
-                if (!inQueue) {
-                    queues[queueLevel].push(process);
-                    process->setLastScheduledTime(currentTime);
-                }
-            }
-        }
+        lastAgingCheck = currentTime;
         
         // Get highest priority non-empty queue
         int queueToSchedule = getHighestPriorityQueue();
         
         // If no queue has processes, advance time to next arrival
         if (queueToSchedule == -1) {
-            int nextArrival = INT_MAX;
-            for (const auto& process : processes) {
-                if (process->getState() == ProcessState::NEW) {
-                    nextArrival = std::min(nextArrival, process->getArrivalTime());
-                }
-            }
+            int nextArrival = nextArrivalTime();
             
-            if (nextArrival != INT_MAX) {
-                ganttChart.push_back("IDLE");
-                currentTime = nextArrival;
-                continue;
-            } else {
-                allComplete = true;
+            if (nextArrival == INT_MAX) {
                 break;
             }
+            
+            ganttChart.push_back("IDLE");
+            currentTime = nextArrival;
+            continue;
         }
         
         // Get next process from the selected queue
         std::shared_ptr<Process> process = queues[queueToSchedule].front();
         queues[queueToSchedule].pop();
         
-        // Context switch
+        // Context switch; it waited from becoming READY until now
+        int readySince = process->getReadySince();
         contextSwitch(currentProcess, process);
+        process->addWaitingTime(currentTime - readySince);
         
         // Get time quantum for this queue
         int quantum = timeQuantums[queueToSchedule];
         
         // Execute for time quantum or until completion
         int executionTime = process->execute(quantum);
+        recordExecution(process, currentTime, executionTime);
         
         for (int i = 0; i < executionTime; i++) {
             ganttChart.push_back(process->getName());
         }
         
-        // Update waiting times
-        for (auto& p : processes) {
-            if (p != process && p->getState() == ProcessState::READY) {
-                p->addWaitingTime(executionTime);
-            }
-        }
-        
         currentTime += executionTime;
         
         // Check if process is complete
         if (process->isComplete()) {
-            process->setCompletionTime(currentTime);
-            process->calculateMetrics();
-            process->setState(ProcessState::TERMINATED);
+            completeProcess(process);
+            currentProcess = nullptr;
         } else {
-            process->setState(ProcessState::READY);
+            markReady(*process, currentTime);
             
             // If process used full quantum, demote it
             if (executionTime == quantum) {
                 demoteProcess(process);
             }
             
-            // Admit new arrivals before re-queueing
-            admitArrivingProcesses();
-            for (auto& p : processes) {
-                if (p->getState() == ProcessState::READY && 
-                    p != process &&
-                    p->getLastScheduledTime() < currentTime) {
-                    
-                    int queueLevel = processQueueLevel[p->getPID()];
-                    
-                    bool inQueue = false;
-                    std::queue<std::shared_ptr<Process>> tempQueue = queues[queueLevel];
-                    while (!tempQueue.empty()) {
-                        if (tempQueue.front() == p) {
-                            inQueue = true;
-                            break;
-                        }
-                        tempQueue.pop();
-                    }
-                    
-                    if (!inQueue) {
-                        queues[queueLevel].push(p);
-                        p->setLastScheduledTime(currentTime);
-                    }
-                }
-            }
+            // Processes that arrived during the quantum are queued first
+            enqueueArrivals();
             
             // Re-queue the process at its (possibly new) level
             int newLevel = processQueueLevel[process->getPID()];
             queues[newLevel].push(process);
             process->setLastScheduledTime(currentTime);
         }
-        
-        currentProcess = nullptr;
-        
-        // Check if all processes are complete
-        allComplete = true;
-        for (const auto& p : processes) {
-            if (p->getState() != ProcessState::TERMINATED) {
-                allComplete = false;
-                break;
-            }
-        }
     }
 }
 
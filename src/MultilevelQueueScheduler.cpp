@@ -41,190 +41,110 @@ void MultilevelQueueScheduler::scheduleFromQueue(int queuePriority,
         // Run to completion
         int burstTime = process->getRemainingTime();
         process->execute(burstTime);
+        recordExecution(process, currentTime, burstTime);
         
         for (int i = 0; i < burstTime; i++) {
             ganttChart.push_back(process->getName());
         }
         
-        // Update waiting times for other ready processes
-        for (auto& p : processes) {
-            if (p != process && p->getState() == ProcessState::READY) {
-                p->addWaitingTime(burstTime);
-            }
-        }
-        
         currentTime += burstTime;
         
     } else if (config.algorithm == QueueSchedulingAlgorithm::ROUND_ROBIN) {
         // Execute for time quantum
         int executionTime = process->execute(config.timeQuantum);
+        recordExecution(process, currentTime, executionTime);
         
         for (int i = 0; i < executionTime; i++) {
             ganttChart.push_back(process->getName());
         }
         
-        // Update waiting times
-        for (auto& p : processes) {
-            if (p != process && p->getState() == ProcessState::READY) {
-                p->addWaitingTime(executionTime);
-            }
-        }
-        
         currentTime += executionTime;
     }
 }
 
+int MultilevelQueueScheduler::getTargetQueue(const std::shared_ptr<Process>& process) const {
+    // First queue whose priority level covers the process priority
+    for (const auto& pair : queueConfigs) {
+        if (process->getPriority() <= pair.first) {
+            return pair.first;
+        }
+    }
+    
+    // If no matching queue, use lowest priority queue
+    if (!queueConfigs.empty()) {
+        return queueConfigs.rbegin()->first;
+    }
+    return -1;
+}
+
+void MultilevelQueueScheduler::enqueueArrivals() {
+    for (auto& process : admitArrivingProcesses()) {
+        int targetQueue = getTargetQueue(process);
+        if (targetQueue != -1) {
+            queues[targetQueue].push(process);
+            process->setLastScheduledTime(currentTime);
+        }
+    }
+}
+
 void MultilevelQueueScheduler::schedule() {
     currentTime = 0;
     ganttChart.clear();
+    resetTimeline();
+    for (auto& pair : queues) {
+        pair.second = std::queue<std::shared_ptr<Process>>();
+    }
     
     // Find the earliest arrival time
     int earliestArrival = INT_MAX;
     for (const auto& process : processes) {
         earliestArrival = std::min(earliestArrival, process->getArrivalTime());
     }
-    currentTime = earliestArrival;
-    
-    bool allComplete = false;
+    currentTime = toProcessTime(earliestArrival);
     
-    while (!allComplete) {
-        // Admit any processes that have arrived
-        admitArrivingProcesses();
-        
-        // Add ready processes to their respective queues based on priority
-        for (auto& process : processes) {
-            if (process->getState() == ProcessState::READY && 
-                process->getLastScheduledTime() < currentTime) {
-                
-                // Find which queue this process belongs to
-                int targetQueue = -1;
-                for (const auto& pair : queueConfigs) {
-                    if (process->getPriority() <= pair.first) {
-                        targetQueue = pair.first;
-                        break;
-                    }
-                }
-                
-                // If no matching queue, use lowest priority queue
-                if (targetQueue == -1 && !queueConfigs.empty()) {
-                    targetQueue = queueConfigs.rbegin()->first;
-                }
-                
-                if (targetQueue != -1) {
-                    // Check if process is not already in queue
-                    bool inQueue = false;
-                    std::queue<std::shared_ptr<Process>> tempQueue = queues[targetQueue];
-                    while (!tempQueue.empty()) {
-                        if (tempQueue.front() == process) {
-                            inQueue = true;
-                            break;
-                        }
-                        tempQueue.pop();
-                    }
-                    
-                    if (!inQueue) {
-                        queues[targetQueue].push(process);
-                        process->setLastScheduledTime(currentTime);
-                    }
-                }
-            }
-        }
+    while (true) {
+        // Add newly arrived processes to their respective queues based on priority
+        enqueueArrivals();
         
         // Get highest priority non-empty queue
         int queueToSchedule = getHighestPriorityQueue();
         
         // If no queue has processes, advance time to next arrival
         if (queueToSchedule == -1) {
-            int nextArrival = INT_MAX;
-            for (const auto& process : processes) {
-                if (process->getState() == ProcessState::NEW) {
-                    nextArrival = std::min(nextArrival, process->getArrivalTime());
-                }
-            }
+            int nextArrival = nextArrivalTime();
             
-            if (nextArrival != INT_MAX) {
-                ganttChart.push_back("IDLE");
-                currentTime = nextArrival;
-                continue;
-            } else {
-                allComplete = true;
+            if (nextArrival == INT_MAX) {
                 break;
             }
+            
+            ganttChart.push_back("IDLE");
+            currentTime = nextArrival;
+            continue;
         }
         
         // Get next process from the selected queue
         std::shared_ptr<Process> process = queues[queueToSchedule].front();
         queues[queueToSchedule].pop();
         
-        // Context switch
+        // Context switch; it waited from becoming READY until now
+        int readySince = process->getReadySince();
         contextSwitch(currentProcess, process);
+        process->addWaitingTime(currentTime - readySince);
         
         // Schedule using the queue's algorithm
         scheduleFromQueue(queueToSchedule, process);
         
         // Check if process is complete
         if (process->isComplete()) {
-            process->setCompletionTime(currentTime);
-            process->calculateMetrics();
-            process->setState(ProcessState::TERMINATED);
+            completeProcess(process);
+            currentProcess = nullptr;
         } else {
-            // If using Round Robin and process not complete, re-add to queue
-            const QueueConfig& config = queueConfigs[queueToSchedule];
-            if (config.algorithm == QueueSchedulingAlgorithm::ROUND_ROBIN) {
-                process->setState(ProcessState::READY);
-                
-                // Admit new arrivals before re-queueing
-                admitArrivingProcesses();
-                for (auto& p : processes) {
-                    if (p->getState() == ProcessState::READY && 
-                        p != process &&
-                        p->getLastScheduledTime() < currentTime) {
-                        
-                        int targetQueue = -1;
-                        for (const auto& pair : queueConfigs) {
-                            if (p->getPriority() <= pair.first) {
-                                targetQueue = pair.first;
-                                break;
-                            }
-                        }
-                        
-                        if (targetQueue == -1 && !queueConfigs.empty()) {
-                            targetQueue = queueConfigs.rbegin()->first;
-                        }
-                        
-                        if (targetQueue != -1) {
-                            bool inQueue = false;
-                            std::queue<std::shared_ptr<Process>> tempQueue = queues[targetQueue];
-                            while (!tempQueue.empty()) {
-                                if (tempQueue.front() == p) {
-                                    inQueue = true;
-                                    break;
-                                }
-                                tempQueue.pop();
-                            }
-                            
-                            if (!inQueue) {
-                                queues[targetQueue].push(p);
-                                p->setLastScheduledTime(currentTime);
-                            }
-                        }
-                    }
-                }
-                
-                queues[queueToSchedule].push(process);
-                process->setLastScheduledTime(currentTime);
-            }
-        }
-        
-        currentProcess = nullptr;
-        
-        // Check if all processes are complete
-        allComplete = true;
-        for (const auto& p : processes) {
-            if (p->getState() != ProcessState::TERMINATED) {
-                allComplete = false;
-                break;
-            }
+            // Round Robin queue and process not complete: re-add to its queue
+            // behind any processes that arrived during the quantum
+            markReady(*process, currentTime);
+            enqueueArrivals();
+            queues[queueToSchedule].push(process);
+            process->setLastScheduledTime(currentTime);
         }
     }
 }
@@ -0,0 +1,275 @@
+#include "O1Scheduler.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <climits>
+#include <iomanip>
+
+/**
+ * @file O1Scheduler.cpp
+ * @brief Implementation of the Linux 2.6-style O(1) scheduler
+ */
+
+O1Scheduler::O1Scheduler(int baseTimeslice, int contextSwitchOverhead)
+    : Scheduler(contextSwitchOverhead), baseTimeslice(std::max(1, baseTimeslice)),
+      active(&arrays[0]), expired(&arrays[1]), nrRunning(0),
+      expiredTimestamp(-1), arraySwitches(0) {
+    // 2.6 used MAX_SLEEP_AVG = 10 default timeslices and the same as the
+    // starvation limit per runnable task
+    maxSleepAvg = 10 * this->baseTimeslice;
+    starvationLimit = maxSleepAvg;
+    clearArray(arrays[0]);
+    clearArray(arrays[1]);
+}
+
+std::string O1Scheduler::getName() const {
+    return "O(1) Scheduler (Base Timeslice=" + std::to_string(baseTimeslice) + ")";
+}
+
+int O1Scheduler::staticPriority(int priority) {
+    return NICE_0_PRIO + std::min(19, std::max(-20, priority));
+}
+
+int O1Scheduler::timeslice(int staticPrio) const {
+    // SCALE_PRIO: higher-priority (negative nice) tasks scale from 4x the base
+    int scale = staticPrio < NICE_0_PRIO ? 4 * baseTimeslice : baseTimeslice;
+    int slice = scale * (MAX_PRIO - staticPrio) / ((MAX_PRIO - MAX_RT_PRIO) / 2);
+    return std::max(1, slice);
+}
+
+void O1Scheduler::clearArray(PrioArray& array) {
+    array.nrActive = 0;
+    for (int i = 0; i < BITMAP_WORDS; i++) {
+        array.bitmap[i] = 0;
+    }
+    for (int prio = 0; prio < MAX_PRIO; prio++) {
+        array.head[prio] = -1;
+        array.tail[prio] = -1;
+    }
+}
+
+void O1Scheduler::enqueueTask(PrioArray& array, int task, bool atHead) {
+    int prio = tasks[task].prio;
+    if (array.head[prio] == -1) {
+        tasks[task].next = -1;
+        array.head[prio] = task;
+        array.tail[prio] = task;
+        array.bitmap[prio / 64] |= 1ULL << (prio % 64);
+    } else if (atHead) {
+        tasks[task].next = array.head[prio];
+        array.head[prio] = task;
+    } else {
+        tasks[task].next = -1;
+        tasks[array.tail[prio]].next = task;
+        array.tail[prio] = task;
+    }
+    array.nrActive++;
+}
+
+int O1Scheduler::dequeueBest(PrioArray& array) {
+    for (int word = 0; word < BITMAP_WORDS; word++) {
+        if (array.bitmap[word] == 0) {
+            continue;
+        }
+        int prio = word * 64 + __builtin_ctzll(array.bitmap[word]);
+        int task = array.head[prio];
+        array.head[prio] = tasks[task].next;
+        if (array.head[prio] == -1) {
+            array.tail[prio] = -1;
+            array.bitmap[word] &= ~(1ULL << (prio % 64));
+        }
+        tasks[task].next = -1;
+        array.nrActive--;
+        return task;
+    }
+    return -1;
+}
+
+int O1Scheduler::effectivePrio(const Task& task) const {
+    int bonus = task.sleepAvg * MAX_BONUS / maxSleepAvg - MAX_BONUS / 2;
+    return std::min(MAX_PRIO - 1, std::max(MAX_RT_PRIO, task.staticPrio - bonus));
+}
+
+bool O1Scheduler::isInteractive(const Task& task) const {
+    // TASK_INTERACTIVE: nice -20 tasks qualify easily, nice 19 never
+    int nice = task.staticPrio - NICE_0_PRIO;
+    int delta = nice * MAX_BONUS / (MAX_PRIO - MAX_RT_PRIO) + INTERACTIVE_DELTA;
+    return task.prio <= task.staticPrio - delta;
+}
+
+bool O1Scheduler::expiredStarving() const {
+    return expiredTimestamp >= 0 &&
+           currentTime - expiredTimestamp >= starvationLimit * nrRunning;
+}
+
+void O1Scheduler::schedule() {
+    currentTime = 0;
+    ganttChart.clear();
+    resetTimeline();
+    clearArray(arrays[0]);
+    clearArray(arrays[1]);
+    active = &arrays[0];
+    expired = &arrays[1];
+    nrRunning = 0;
+    expiredTimestamp = -1;
+    arraySwitches = 0;
+
+    tasks.assign(processes.size(), Task());
+    taskIndex.clear();
+    for (size_t i = 0; i < processes.size(); i++) {
+        Task& task = tasks[i];
+        task.staticPrio = staticPriority(processes[i]->getPriority());
+        task.timeSlice = timeslice(task.staticPrio);
+        task.sleepAvg = maxSleepAvg / 2;  // Neutral bonus: no parent to inherit from
+        task.prio = effectivePrio(task);
+        task.enqueuedAt = toProcessTime(processes[i]->getArrivalTime());
+        task.activated = false;
+        task.next = -1;
+        taskIndex[processes[i].get()] = static_cast<int>(i);
+    }
+
+    currentTime = nextArrivalTime();
+    if (currentTime == INT_MAX) {
+        currentTime = 0;
+        return;
+    }
+
+    int running = -1;
+    while (true) {
+        // Wake up arrivals; a better dynamic priority preempts the running task
+        bool needResched = false;
+        for (auto& process : admitArrivingProcesses()) {
+            int index = taskIndex[process.get()];
+            Task& task = tasks[index];
+            task.enqueuedAt = readyTime(*process);
+            task.activated = true;
+            task.prio = effectivePrio(task);
+            enqueueTask(*active, index, false);
+            nrRunning++;
+            if (running != -1 && task.prio < tasks[running].prio) {
+                needResched = true;
+            }
+        }
+
+        if (running != -1 && needResched) {
+            // The preempted task keeps its place and the rest of its timeslice
+            markReady(*processes[running], currentTime);
+            tasks[running].enqueuedAt = currentTime;
+            enqueueTask(*active, running, true);
+            running = -1;
+        }
+
+        if (running == -1) {
+            if (active->nrActive == 0 && expired->nrActive > 0) {
+                // Epoch end: every task in 'expired' already has a new timeslice
+                std::swap(active, expired);
+                expiredTimestamp = -1;
+                arraySwitches++;
+            }
+
+            int next = dequeueBest(*active);
+            if (next == -1) {
+                int nextArrival = nextArrivalTime();
+                if (nextArrival == INT_MAX) {
+                    break;
+                }
+                ganttChart.push_back("IDLE");
+                currentTime = nextArrival;
+                continue;
+            }
+
+            // Charge the runqueue wait; freshly woken tasks earn sleep credit
+            Task& task = tasks[next];
+            int waited = currentTime - task.enqueuedAt;
+            processes[next]->addWaitingTime(waited);
+            if (task.activated) {
+                task.sleepAvg = std::min(maxSleepAvg,
+                                         task.sleepAvg + waited * ON_RUNQUEUE_WEIGHT / 100);
+                task.activated = false;
+            }
+
+            int switchStart = currentTime;
+            contextSwitch(currentProcess, processes[next]);
+            running = next;
+
+            // Arrivals during the switch overhead are handled first
+            if (currentTime != switchStart) {
+                continue;
+            }
+        }
+
+        // Run until completion, timeslice expiry or the next arrival
+        Task& task = tasks[running];
+        std::shared_ptr<Process> process = processes[running];
+        int segment = std::min(task.timeSlice, process->getRemainingTime());
+        segment = static_cast<int>(std::min<int64_t>(segment,
+                                   static_cast<int64_t>(nextArrivalTime()) - currentTime));
+
+        process->execute(segment);
+        recordExecution(process, currentTime, segment);
+        for (int i = 0; i < segment; i++) {
+            ganttChart.push_back(process->getName());
+        }
+        currentTime += segment;
+        task.timeSlice -= segment;
+        task.sleepAvg = std::max(0, task.sleepAvg - segment);
+
+        if (process->isComplete()) {
+            completeProcess(process);
+            currentProcess = nullptr;
+            nrRunning--;
+            running = -1;
+        } else if (task.timeSlice == 0) {
+            // Timeslice used up: recalculate priority and refill
+            task.prio = effectivePrio(task);
+            task.timeSlice = timeslice(task.staticPrio);
+            task.enqueuedAt = currentTime;
+            markReady(*process, currentTime);
+
+            if (isInteractive(task) && !expiredStarving()) {
+                enqueueTask(*active, running, false);
+            } else {
+                enqueueTask(*expired, running, false);
+                if (expiredTimestamp < 0) {
+                    expiredTimestamp = currentTime;
+                }
+            }
+            running = -1;
+        }
+    }
+}
+
+std::string O1Scheduler::getGanttChart() const {
+    std::stringstream ss;
+    ss << "\nGantt Chart:\n";
+    ss << std::string(80, '-') << "\n";
+
+    if (ganttChart.empty()) {
+        ss << "No execution recorded\n";
+        return ss.str();
+    }
+
+    ss << "Time |";
+    for (size_t i = 0; i < ganttChart.size() && i < 60; i++) {
+        ss << " ";
+    }
+    ss << "\n     |";
+
+    for (size_t i = 0; i < ganttChart.size() && i < 60; i++) {
+        if (ganttChart[i] == "IDLE") {
+            ss << "-";
+        } else {
+            ss << ganttChart[i][0];
+        }
+    }
+    ss << "\n";
+
+    ss << "  0  ";
+    for (size_t i = 0; i < ganttChart.size() && i < 60; i += 5) {
+        ss << std::setw(5) << (i + 5);
+    }
+    ss << "\n";
+
+    ss << std::string(80, '-') << "\n";
+    return ss.str();
+}
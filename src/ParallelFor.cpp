@@ -0,0 +1,88 @@
+#include "ParallelFor.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file ParallelFor.cpp
+ * @brief Implementation of the shared worker loops
+ */
+
+namespace {
+
+/**
+ * @brief Run worker(t) for every t in [0, threads), t = 0 on the calling thread
+ *
+ * Every thread is joined before returning; the first exception thrown by a
+ * worker is then rethrown. A thread that cannot be started runs its share
+ * on the calling thread instead.
+ */
+void runWorkers(int threads, const std::function<void(int)>& worker) {
+    std::exception_ptr failure;
+    std::mutex failureLock;
+    auto guarded = [&](int t) {
+        try {
+            worker(t);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(failureLock);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) {
+        try {
+            workers.emplace_back(guarded, t);
+        } catch (...) {
+            guarded(t);
+        }
+    }
+    guarded(0);
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+}  // namespace
+
+int workerThreads(int requested, size_t items) {
+    size_t threads = requested > 0
+                         ? static_cast<size_t>(requested)
+                         : std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<int>(std::max<size_t>(1, std::min(threads, items)));
+}
+
+void parallelFor(size_t items, int threads, const std::function<void(size_t)>& body) {
+    std::atomic<size_t> next(0);
+    runWorkers(threads, [&](int) {
+        size_t k;
+        while ((k = next.fetch_add(1)) < items) {
+            try {
+                body(k);
+            } catch (...) {
+                next.store(items);  // Nobody claims another item
+                throw;
+            }
+        }
+    });
+}
+
+void parallelForBlocks(size_t items, int threads, const std::function<void(size_t, size_t)>& body) {
+    threads = std::max(1, threads);
+    size_t block = (items + threads - 1) / threads;
+    runWorkers(threads, [&](int t) {
+        size_t begin = std::min(items, static_cast<size_t>(t) * block);
+        size_t end = std::min(items, static_cast<size_t>(t + 1) * block);
+        if (begin < end) {
+            body(begin, end);
+        }
+    });
+}
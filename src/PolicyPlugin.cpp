@@ -0,0 +1,55 @@
+#include "PolicyPlugin.h"
+#include <cstring>
+#include <dlfcn.h>
+
+/**
+ * @file PolicyPlugin.cpp
+ * @brief Implementation of the runtime policy plugin loader
+ */
+
+PolicyPlugin::PolicyPlugin(void* handle, const SchedulerPluginInfo* info, const std::string& path)
+    : handle(handle), info(info), path(path) {
+}
+
+PolicyPlugin::~PolicyPlugin() {
+    dlclose(handle);
+}
+
+std::shared_ptr<PolicyPlugin> PolicyPlugin::load(const std::string& path, std::string& error) {
+    // RTLD_LOCAL keeps plugins from resolving each other's symbols
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+        const char* reason = dlerror();
+        error = reason != nullptr ? reason : "cannot open " + path;
+        return nullptr;
+    }
+
+    // Function pointers cannot be cast from void* directly in ISO C++
+    SchedulerPluginEntry entry;
+    void* symbol = dlsym(handle, SCHEDULER_PLUGIN_ENTRY);
+    static_assert(sizeof(entry) == sizeof(symbol), "function and object pointers differ in size");
+    std::memcpy(&entry, &symbol, sizeof(entry));
+    const SchedulerPluginInfo* info = entry != nullptr ? entry() : nullptr;
+
+    if (info == nullptr) {
+        error = path + ": no " SCHEDULER_PLUGIN_ENTRY "() exported";
+    } else if (info->abiVersion != SCHEDULER_PLUGIN_ABI_VERSION) {
+        error = path + ": plugin ABI version " + std::to_string(info->abiVersion) +
+                ", expected " + std::to_string(SCHEDULER_PLUGIN_ABI_VERSION);
+    } else if (info->schedulerSize != sizeof(Scheduler)) {
+        error = path + ": built against a different Scheduler layout";
+    } else if (info->processSize != sizeof(Process)) {
+        error = path + ": built against a different Process layout";
+    } else if (info->create == nullptr || info->name == nullptr) {
+        error = path + ": incomplete plugin description";
+    } else {
+        return std::shared_ptr<PolicyPlugin>(new PolicyPlugin(handle, info, path));
+    }
+
+    dlclose(handle);
+    return nullptr;
+}
+
+std::unique_ptr<Scheduler> PolicyPlugin::create(const std::string& args) const {
+    return std::unique_ptr<Scheduler>(info->create(args.c_str()));
+}
@@ -13,13 +13,254 @@
 PriorityScheduler::PriorityScheduler(bool preemptive, bool enableAging,
                                      int agingInterval, int contextSwitchOverhead)
     : Scheduler(contextSwitchOverhead), preemptive(preemptive),
-      agingEnabled(enableAging), agingInterval(agingInterval) {
+      agingEnabled(enableAging), agingInterval(agingInterval),
+      lockProtocol(LockProtocol::NONE), lockMetrics(), readyQueueDirty(false) {
 }
 
 std::string PriorityScheduler::getName() const {
     std::string mode = preemptive ? "Preemptive" : "Non-Preemptive";
     std::string aging = agingEnabled ? " with Aging" : "";
-    return mode + " Priority" + aging;
+    std::string locking = lockProtocol == LockProtocol::NONE ? "" : " (" + lockProtocolName(lockProtocol) + ")";
+    return mode + " Priority" + aging + locking;
+}
+
+std::string PriorityScheduler::lockProtocolName(LockProtocol protocol) {
+    switch (protocol) {
+        case LockProtocol::NONE:
+            return "No Protocol";
+        case LockProtocol::INHERITANCE:
+            return "Priority Inheritance";
+        case LockProtocol::CEILING:
+            return "Priority Ceiling";
+    }
+    return "Unknown";
+}
+
+void PriorityScheduler::prepareLocks() {
+    locks.clear();
+    lockSlots.clear();
+    heldCeilings.clear();
+    blockedPriorities.clear();
+    processIndex.clear();
+    processLocks.assign(processes.size(), ProcessLocks());
+    blockingTimes.assign(processes.size(), 0);
+    lockMetrics = LockMetrics();
+    readyQueueDirty = false;
+    
+    for (size_t i = 0; i < processes.size(); i++) {
+        processIndex[processes[i].get()] = i;
+        processLocks[i].nextSection = 0;
+        processLocks[i].waitingOn = -1;
+        processLocks[i].waitStart = -1;
+        processes[i]->setInheritedPriority(INT_MAX);
+        for (const CriticalSection& section : processes[i]->getCriticalSections()) {
+            auto slot = lockSlots.emplace(section.lock, locks.size());
+            if (slot.second) {
+                locks.push_back(LockState());
+                locks.back().owner = -1;
+                locks.back().depth = 0;
+                locks.back().ceiling = INT_MAX;
+            }
+            LockState& lock = locks[slot.first->second];
+            lock.ceiling = std::min(lock.ceiling, processes[i]->getPriority());
+        }
+    }
+}
+
+int PriorityScheduler::untilLockEvent(size_t process) const {
+    const Process& p = *processes[process];
+    const ProcessLocks& state = processLocks[process];
+    int executed = p.getBurstTime() - p.getRemainingTime();
+    int next = INT_MAX;
+    if (state.nextSection < p.getCriticalSections().size()) {
+        next = p.getCriticalSections()[state.nextSection].start;
+    }
+    for (const HeldLock& held : state.held) {
+        next = std::min(next, held.releaseAt);
+    }
+    return next == INT_MAX ? INT_MAX : next - executed;
+}
+
+bool PriorityScheduler::advanceLocks(size_t process) {
+    Process& p = *processes[process];
+    ProcessLocks& state = processLocks[process];
+    int executed = p.getBurstTime() - p.getRemainingTime();
+    
+    // Releases first, innermost first
+    for (size_t k = state.held.size(); k-- > 0;) {
+        if (state.held[k].releaseAt <= executed) {
+            size_t lock = state.held[k].lock;
+            state.held.erase(state.held.begin() + static_cast<std::ptrdiff_t>(k));
+            releaseLock(process, lock);
+        }
+    }
+    
+    const std::vector<CriticalSection>& sections = p.getCriticalSections();
+    while (state.nextSection < sections.size() && sections[state.nextSection].start <= executed) {
+        if (!tryAcquire(process, lockSlots[sections[state.nextSection].lock])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PriorityScheduler::tryAcquire(size_t process, size_t lock) {
+    LockState& state = locks[lock];
+    const Process& p = *processes[process];
+    if (state.owner == static_cast<int>(process)) {
+        state.depth++;
+        granted(process, lock);
+        return true;
+    }
+    
+    size_t blocker = lock;
+    bool available = state.owner == -1;
+    if (lockProtocol == LockProtocol::CEILING) {
+        // System ceiling: the best ceiling of a lock held by someone else
+        for (const auto& held : heldCeilings) {
+            if (locks[held.second].owner != static_cast<int>(process)) {
+                if (held.first <= p.getEffectivePriority()) {
+                    available = false;
+                    blocker = state.owner == -1 ? held.second : lock;
+                }
+                break;
+            }
+        }
+    }
+    
+    if (!available) {
+        block(process, blocker);
+        return false;
+    }
+    state.owner = static_cast<int>(process);
+    state.depth = 1;
+    if (lockProtocol == LockProtocol::CEILING) {
+        heldCeilings.emplace(state.ceiling, lock);
+    }
+    granted(process, lock);
+    return true;
+}
+
+void PriorityScheduler::granted(size_t process, size_t lock) {
+    Process& p = *processes[process];
+    ProcessLocks& state = processLocks[process];
+    const CriticalSection& section = p.getCriticalSections()[state.nextSection];
+    state.held.push_back({lock, std::min(section.start + section.length, p.getBurstTime())});
+    state.nextSection++;
+    lockMetrics.acquisitions++;
+    
+    if (state.waitStart >= 0) {
+        int wait = currentTime - state.waitStart;
+        size_t bucket = 0;
+        while (bucket < 31 && (1 << bucket) <= wait) {
+            bucket++;
+        }
+        if (lockMetrics.waitHistogram.size() <= bucket) {
+            lockMetrics.waitHistogram.resize(bucket + 1, 0);
+        }
+        lockMetrics.waitHistogram[bucket]++;
+        lockMetrics.maxWait = std::max(lockMetrics.maxWait, wait);
+        lockMetrics.totalBlocking += wait;
+        blockingTimes[process] += wait;
+        state.waitStart = -1;
+    }
+}
+
+void PriorityScheduler::block(size_t process, size_t lock) {
+    Process& p = *processes[process];
+    ProcessLocks& state = processLocks[process];
+    if (state.waitStart < 0) {
+        state.waitStart = currentTime;
+        lockMetrics.contended++;
+    }
+    state.waitingOn = static_cast<int>(lock);
+    state.key = {p.getEffectivePriority(), p.getArrivalTime(), p.getPID(), process};
+    state.blockedPriority = p.getPriority();
+    locks[lock].waiters.insert(state.key);
+    blockedPriorities.insert(state.blockedPriority);
+    p.setState(ProcessState::WAITING);
+    
+    if (lockProtocol != LockProtocol::NONE && locks[lock].owner != -1) {
+        updateInheritance(static_cast<size_t>(locks[lock].owner));
+    }
+}
+
+void PriorityScheduler::unblock(size_t process) {
+    Process& p = *processes[process];
+    ProcessLocks& state = processLocks[process];
+    blockedPriorities.erase(blockedPriorities.find(state.blockedPriority));
+    state.waitingOn = -1;
+    markReady(p, currentTime);
+    p.setLastScheduledTime(currentTime);
+    readyQueue.push(processes[process]);
+}
+
+void PriorityScheduler::releaseLock(size_t process, size_t lock) {
+    LockState& state = locks[lock];
+    if (--state.depth > 0) {
+        return;
+    }
+    state.owner = -1;
+    if (lockProtocol == LockProtocol::CEILING) {
+        heldCeilings.erase(std::make_pair(state.ceiling, lock));
+    }
+    
+    if (lockProtocol == LockProtocol::CEILING) {
+        // The system ceiling dropped: every waiter retries when it next runs
+        std::vector<size_t> woken;
+        for (const WaitKey& waiter : state.waiters) {
+            woken.push_back(waiter.process);
+        }
+        state.waiters.clear();
+        for (size_t waiter : woken) {
+            unblock(waiter);
+        }
+    } else if (!state.waiters.empty()) {
+        // Hand the lock straight to the best waiter
+        size_t next = state.waiters.begin()->process;
+        state.waiters.erase(state.waiters.begin());
+        state.owner = static_cast<int>(next);
+        state.depth = 1;
+        granted(next, lock);
+        unblock(next);
+        if (lockProtocol == LockProtocol::INHERITANCE) {
+            updateInheritance(next);
+        }
+    }
+    updateInheritance(process);
+}
+
+void PriorityScheduler::updateInheritance(size_t process) {
+    if (lockProtocol == LockProtocol::NONE) {
+        return;
+    }
+    Process& p = *processes[process];
+    ProcessLocks& state = processLocks[process];
+    int inherited = INT_MAX;
+    for (const HeldLock& held : state.held) {
+        const std::set<WaitKey>& waiters = locks[held.lock].waiters;
+        if (!waiters.empty()) {
+            inherited = std::min(inherited, waiters.begin()->priority);
+        }
+    }
+    if (inherited == p.getInheritedPriority()) {
+        return;
+    }
+    p.setInheritedPriority(inherited);
+    if (p.getState() == ProcessState::READY) {
+        readyQueueDirty = true;
+    }
+    
+    // A blocked holder moves in its own wait queue and passes the change on
+    if (state.waitingOn != -1) {
+        LockState& waitedFor = locks[static_cast<size_t>(state.waitingOn)];
+        waitedFor.waiters.erase(state.key);
+        state.key.priority = p.getEffectivePriority();
+        waitedFor.waiters.insert(state.key);
+        if (waitedFor.owner != -1) {
+            updateInheritance(static_cast<size_t>(waitedFor.owner));
+        }
+    }
 }
 
 void PriorityScheduler::applyAging() {
@@ -36,159 +277,163 @@ void PriorityScheduler::applyAging() {
     }
 }
 
+void PriorityScheduler::rebuildReadyQueue() {
+    std::vector<std::shared_ptr<Process>> ready;
+    while (!readyQueue.empty()) {
+        ready.push_back(readyQueue.top());
+        readyQueue.pop();
+    }
+    for (auto& process : ready) {
+        readyQueue.push(process);
+    }
+}
+
+/// Timer payload of the periodic aging tick
+static const uint64_t AGING_TIMER = 1;
+
 void PriorityScheduler::schedule() {
     currentTime = 0;
     ganttChart.clear();
+    resetTimeline();
+    readyQueue = std::priority_queue<std::shared_ptr<Process>,
+                                     std::vector<std::shared_ptr<Process>>,
+                                     PriorityComparator>(PriorityComparator(tieBreakSeed));
     
-    // Find the earliest arrival time
-    int earliestArrival = INT_MAX;
-    for (const auto& process : processes) {
-        earliestArrival = std::min(earliestArrival, process->getArrivalTime());
+    // Start at the earliest arrival time
+    currentTime = nextArrivalTime();
+    if (currentTime == INT_MAX) {
+        currentTime = 0;
+        return;
     }
-    currentTime = earliestArrival;
+    timers.clear(currentTime);
+    prepareLocks();
     
-    bool allComplete = false;
+    bool useAgingTimer = agingEnabled && agingInterval > 0;
+    bool agingTimerArmed = false;
+    uint64_t agingTimer = 0;
     std::shared_ptr<Process> runningProcess = nullptr;
+    std::shared_ptr<Process> blockedProcess = nullptr;
     
-    while (!allComplete) {
+    while (true) {
         // Admit any processes that have arrived
-        admitArrivingProcesses();
-        
-        // Apply aging if enabled
-        if (currentTime % agingInterval == 0) {
-            applyAging();
+        for (auto& process : admitArrivingProcesses()) {
+            readyQueue.push(process);
         }
         
-        // Build priority queue with all ready processes
-        // Clear the queue first
-        while (!readyQueue.empty()) {
-            readyQueue.pop();
+        // Fire due timers; aging changes priorities, so re-heap afterwards
+        TimerEvent event;
+        bool aged = false;
+        while (timers.popExpired(currentTime, event)) {
+            if (event.payload == AGING_TIMER) {
+                applyAging();
+                aged = true;
+            }
+        }
+        if (aged || readyQueueDirty) {
+            rebuildReadyQueue();
+            readyQueueDirty = false;
         }
         
-        for (auto& process : processes) {
-            if (process->getState() == ProcessState::READY) {
-                readyQueue.push(process);
-            }
+        // In preemptive mode, preempt only for a strictly higher priority
+        std::shared_ptr<Process> preempted = nullptr;
+        if (preemptive && runningProcess != nullptr && !readyQueue.empty() &&
+            readyQueue.top()->getEffectivePriority() < runningProcess->getEffectivePriority()) {
+            markReady(*runningProcess, currentTime);
+            runningProcess->setLastScheduledTime(currentTime);
+            readyQueue.push(runningProcess);
+            preempted = runningProcess;
+            runningProcess = nullptr;
         }
         
-        // If ready queue is empty, advance time to next arrival
-        if (readyQueue.empty()) {
-            if (runningProcess != nullptr && !runningProcess->isComplete()) {
-                // Continue running current process in non-preemptive mode
-                if (!preemptive) {
-                    // Execute one time unit
-                    runningProcess->execute(1);
-                    ganttChart.push_back(runningProcess->getName());
-                    currentTime++;
-                    
-                    if (runningProcess->isComplete()) {
-                        runningProcess->setCompletionTime(currentTime);
-                        runningProcess->calculateMetrics();
-                        runningProcess->setState(ProcessState::TERMINATED);
-                        runningProcess = nullptr;
-                    }
-                    continue;
+        if (runningProcess == nullptr) {
+            if (readyQueue.empty()) {
+                int nextArrival = nextArrivalTime();
+                if (nextArrival == INT_MAX) {
+                    break;
                 }
-            }
-            
-            // Find next arrival
-            int nextArrival = INT_MAX;
-            for (const auto& process : processes) {
-                if (process->getState() == ProcessState::NEW) {
-                    nextArrival = std::min(nextArrival, process->getArrivalTime());
+                
+                // Idle: stop the tick and jump straight to the next arrival
+                if (agingTimerArmed) {
+                    timers.cancel(agingTimer);
+                    agingTimerArmed = false;
                 }
-            }
-            
-            if (nextArrival != INT_MAX) {
                 ganttChart.push_back("IDLE");
                 currentTime = nextArrival;
                 continue;
-            } else {
-                allComplete = true;
-                break;
-            }
-        }
-        
-        // Get highest priority process
-        std::shared_ptr<Process> nextProcess = readyQueue.top();
-        
-        // In preemptive mode, check if we need to preempt current process
-        if (preemptive) {
-            if (runningProcess != nullptr && runningProcess != nextProcess) {
-                // Preempt if next process has higher priority
-                if (nextProcess->getPriority() < runningProcess->getPriority()) {
-                    runningProcess->setState(ProcessState::READY);
-                    contextSwitch(runningProcess, nextProcess);
-                    runningProcess = nextProcess;
-                }
-            } else if (runningProcess == nullptr) {
-                contextSwitch(nullptr, nextProcess);
-                runningProcess = nextProcess;
             }
             
+            std::shared_ptr<Process> nextProcess = readyQueue.top();
             readyQueue.pop();
             
-            // Execute one time unit
-            runningProcess->execute(1);
-            ganttChart.push_back(runningProcess->getName());
+            int switchStart = currentTime;
+            contextSwitch(preempted != nullptr ? preempted : blockedProcess, nextProcess);
+            blockedProcess = nullptr;
+
+            // The switch overhead is waiting for it and for everyone still READY
+            updateWaitingTimes(currentTime - switchStart);
+            nextProcess->addWaitingTime(currentTime - switchStart);
+            runningProcess = nextProcess;
             
-            // Update waiting times
-            for (auto& p : processes) {
-                if (p != runningProcess && p->getState() == ProcessState::READY) {
-                    p->addWaitingTime(1);
-                }
+            // (Re-)arm the aging tick at the next multiple of agingInterval
+            if (useAgingTimer && !agingTimerArmed) {
+                int firstTick = ((currentTime + agingInterval - 1) / agingInterval) * agingInterval;
+                agingTimer = timers.schedule(firstTick, AGING_TIMER, agingInterval);
+                agingTimerArmed = true;
             }
             
-            currentTime++;
-            
-            // Check if process is complete
-            if (runningProcess->isComplete()) {
-                runningProcess->setCompletionTime(currentTime);
-                runningProcess->calculateMetrics();
-                runningProcess->setState(ProcessState::TERMINATED);
+            // A lock requested at this point may block the process at once
+            if (!advanceLocks(processIndex[runningProcess.get()])) {
+                blockedProcess = runningProcess;
                 runningProcess = nullptr;
+                continue;
             }
             
-        } else {
-            // Non-preemptive mode: run process to completion
-            readyQueue.pop();
-            
-            contextSwitch(runningProcess, nextProcess);
-            runningProcess = nextProcess;
-            
-            // Execute entire burst
-            int burstTime = runningProcess->getRemainingTime();
-            runningProcess->execute(burstTime);
-            
-            for (int i = 0; i < burstTime; i++) {
-                ganttChart.push_back(runningProcess->getName());
-            }
-            
-            // Update waiting times
-            for (auto& p : processes) {
-                if (p != runningProcess && p->getState() == ProcessState::READY) {
-                    p->addWaitingTime(burstTime);
-                }
+            // Arrivals and ticks during the switch overhead are handled first
+            if (currentTime != switchStart) {
+                continue;
             }
-            
-            currentTime += burstTime;
-            
-            // Process is complete
-            runningProcess->setCompletionTime(currentTime);
-            runningProcess->calculateMetrics();
-            runningProcess->setState(ProcessState::TERMINATED);
-            runningProcess = nullptr;
         }
         
-        // Check if all processes are complete
-        allComplete = true;
-        for (const auto& p : processes) {
-            if (p->getState() != ProcessState::TERMINATED) {
-                allComplete = false;
-                break;
-            }
+        // Run until completion, the next arrival, timer or lock event
+        size_t running = processIndex[runningProcess.get()];
+        int64_t segmentEnd = static_cast<int64_t>(currentTime) + runningProcess->getRemainingTime();
+        segmentEnd = std::min(segmentEnd, static_cast<int64_t>(nextArrivalTime()));
+        segmentEnd = std::min(segmentEnd, timers.nextExpiry());
+        int untilLock = untilLockEvent(running);
+        if (untilLock != INT_MAX) {
+            segmentEnd = std::min(segmentEnd, static_cast<int64_t>(currentTime) + untilLock);
+        }
+        int duration = static_cast<int>(segmentEnd - currentTime);
+        
+        // Inversion: a better-priority process is blocked while this one runs
+        if (!blockedPriorities.empty() && *blockedPriorities.begin() < runningProcess->getPriority()) {
+            lockMetrics.inversionTime += duration;
+        }
+        
+        runningProcess->execute(duration);
+        recordExecution(runningProcess, currentTime, duration);
+        for (int i = 0; i < duration; i++) {
+            ganttChart.push_back(runningProcess->getName());
+        }
+        updateWaitingTimes(duration);
+        currentTime += duration;
+        
+        if (!advanceLocks(running)) {
+            blockedProcess = runningProcess;
+            runningProcess = nullptr;
+        } else if (runningProcess->isComplete()) {
+            completeProcess(runningProcess);
+            runningProcess = nullptr;
+        }
+    }
+    
+    // Whoever is still blocked can never run: a lock cycle
+    for (const auto& process : processes) {
+        if (process->getState() == ProcessState::WAITING) {
+            lockMetrics.deadlocked++;
         }
     }
+    timers.clear(currentTime);
 }
 
 std::string PriorityScheduler::getGanttChart() const {
@@ -1,6 +1,7 @@
 #include "Process.h"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 /**
  * @file Process.cpp
@@ -10,9 +11,29 @@
 Process::Process(int pid, const std::string& name, int arrivalTime, 
                  int burstTime, int priority)
     : pid(pid), name(name), arrivalTime(arrivalTime), burstTime(burstTime),
-      remainingTime(burstTime), priority(priority), state(ProcessState::NEW),
+      remainingTime(burstTime), priority(priority), basePriority(priority), state(ProcessState::NEW),
       startTime(-1), completionTime(-1), waitingTime(0), turnaroundTime(0),
-      responseTime(0), lastScheduledTime(arrivalTime), firstSchedule(true) {
+      responseTime(0), interruptTime(0), memoryStallTime(0), residentSetSize(0),
+      wastedTime(0), failed(false), lastScheduledTime(arrivalTime), readySince(arrivalTime), firstSchedule(true),
+      inheritedPriority(INT_MAX), sequence(0) {
+}
+
+bool Process::addCriticalSection(int lock, int start, int length) {
+    if (start < 0 || start >= burstTime || length < 1) {
+        return false;
+    }
+    CriticalSection section = {lock, start, length};
+    
+    // By start; an enclosing section goes before the sections it contains
+    auto position = std::upper_bound(criticalSections.begin(), criticalSections.end(), section,
+                                     [](const CriticalSection& a, const CriticalSection& b) {
+                                         if (a.start != b.start) {
+                                             return a.start < b.start;
+                                         }
+                                         return a.length > b.length;
+                                     });
+    criticalSections.insert(position, section);
+    return true;
 }
 
 int Process::execute(int quantum) {
@@ -25,6 +46,13 @@ int Process::execute(int quantum) {
     return executionTime;
 }
 
+int Process::restartBurst() {
+    int lost = burstTime - remainingTime;
+    remainingTime = burstTime;
+    wastedTime += lost;
+    return lost;
+}
+
 void Process::calculateMetrics() {
     // Turnaround Time = Completion Time - Arrival Time
     turnaroundTime = completionTime - arrivalTime;
@@ -45,8 +73,14 @@ void Process::reset() {
     waitingTime = 0;
     turnaroundTime = 0;
     responseTime = 0;
+    interruptTime = 0;
+    memoryStallTime = 0;
+    wastedTime = 0;
+    failed = false;
     lastScheduledTime = arrivalTime;
+    readySince = arrivalTime;
     firstSchedule = true;
+    inheritedPriority = INT_MAX;
 }
 
 std::string Process::getStateString() const {
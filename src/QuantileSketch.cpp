@@ -0,0 +1,87 @@
+#include "QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file QuantileSketch.cpp
+ * @brief Implementation of the mergeable quantile sketch
+ */
+
+QuantileSketch::QuantileSketch(double relativeAccuracy)
+    : relativeAccuracy(relativeAccuracy),
+      gamma((1.0 + relativeAccuracy) / (1.0 - relativeAccuracy)),
+      logGamma(std::log(gamma)), offset(0), zeroCount(0), total(0), sum(0.0),
+      minValue(0.0), maxValue(0.0) {
+}
+
+void QuantileSketch::addToBucket(int index, uint64_t count) {
+    if (buckets.empty()) {
+        offset = index;
+        buckets.assign(1, 0);
+    } else if (index < offset) {
+        buckets.insert(buckets.begin(), static_cast<size_t>(offset - index), 0);
+        offset = index;
+    } else if (index - offset >= static_cast<int>(buckets.size())) {
+        buckets.resize(static_cast<size_t>(index - offset) + 1, 0);
+    }
+    buckets[static_cast<size_t>(index - offset)] += count;
+}
+
+void QuantileSketch::add(double value) {
+    if (value <= 0.0) {
+        value = 0.0;
+        zeroCount++;
+    } else {
+        addToBucket(static_cast<int>(std::ceil(std::log(value) / logGamma)), 1);
+    }
+    if (total == 0 || value < minValue) {
+        minValue = value;
+    }
+    if (total == 0 || value > maxValue) {
+        maxValue = value;
+    }
+    total++;
+    sum += value;
+}
+
+bool QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.relativeAccuracy != relativeAccuracy) {
+        return false;
+    }
+    if (other.total == 0) {
+        return true;
+    }
+    for (size_t i = 0; i < other.buckets.size(); i++) {
+        if (other.buckets[i] > 0) {
+            addToBucket(other.offset + static_cast<int>(i), other.buckets[i]);
+        }
+    }
+    minValue = total == 0 ? other.minValue : std::min(minValue, other.minValue);
+    maxValue = total == 0 ? other.maxValue : std::max(maxValue, other.maxValue);
+    zeroCount += other.zeroCount;
+    total += other.total;
+    sum += other.sum;
+    return true;
+}
+
+double QuantileSketch::quantile(double q) const {
+    if (total == 0) {
+        return 0.0;
+    }
+    q = std::min(1.0, std::max(0.0, q));
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1));
+    if (rank < zeroCount) {
+        return 0.0;
+    }
+
+    uint64_t seen = zeroCount;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        seen += buckets[i];
+        if (seen > rank) {
+            // Midpoint of (gamma^(k-1), gamma^k] in the relative sense
+            double value = 2.0 * std::pow(gamma, offset + static_cast<int>(i)) / (gamma + 1.0);
+            return std::min(maxValue, std::max(minValue, value));
+        }
+    }
+    return maxValue;
+}
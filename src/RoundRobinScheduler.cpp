@@ -20,75 +20,49 @@ std::string RoundRobinScheduler::getName() const {
 void RoundRobinScheduler::schedule() {
     currentTime = 0;
     ganttChart.clear();
+    resetTimeline();
+    readyQueue = std::queue<std::shared_ptr<Process>>();
     
     // Find the earliest arrival time
     int earliestArrival = INT_MAX;
     for (const auto& process : processes) {
         earliestArrival = std::min(earliestArrival, process->getArrivalTime());
     }
-    currentTime = earliestArrival;
+    currentTime = toProcessTime(earliestArrival);
     
-    // Continue until all processes are complete
-    bool allComplete = false;
-    
-    while (!allComplete) {
-        // Admit any processes that have arrived
-        admitArrivingProcesses();
-        
-        // Add newly ready processes to the queue
-        for (auto& process : processes) {
-            if (process->getState() == ProcessState::READY && 
-                process->getLastScheduledTime() < currentTime) {
-                
-                // Check if process is not already in queue
-                bool inQueue = false;
-                std::queue<std::shared_ptr<Process>> tempQueue = readyQueue;
-                while (!tempQueue.empty()) {
-                    if (tempQueue.front() == process) {
-                        inQueue = true;
-                        break;
-                    }
-                    tempQueue.pop();
-                }
-                
-                if (!inQueue) {
-                    readyQueue.push(process);
-                    process->setLastScheduledTime(currentTime);
-                }
-            }
+    while (true) {
+        // Admit any processes that have arrived, in tie-break order
+        for (auto& process : admitArrivingProcesses()) {
+            readyQueue.push(process);
+            process->setLastScheduledTime(currentTime);
         }
         
         // If ready queue is empty, advance time to next arrival
         if (readyQueue.empty()) {
-            int nextArrival = INT_MAX;
-            for (const auto& process : processes) {
-                if (process->getState() == ProcessState::NEW) {
-                    nextArrival = std::min(nextArrival, process->getArrivalTime());
-                }
-            }
+            int nextArrival = nextArrivalTime();
             
-            if (nextArrival != INT_MAX) {
-                // Update waiting times for time skipped
-                updateWaitingTimes(nextArrival - currentTime);
-                currentTime = nextArrival;
-                ganttChart.push_back("IDLE");
-                continue;
-            } else {
+            if (nextArrival == INT_MAX) {
                 // All processes complete
-                allComplete = true;
                 break;
             }
+            
+            currentTime = nextArrival;
+            ganttChart.push_back("IDLE");
+            continue;
         }
         
         // Get next process from ready queue
         std::shared_ptr<Process> process = readyQueue.front();
         readyQueue.pop();
         
-        // Context switch to this process
+        // Context switch to this process; it waited from becoming READY until now
+        int readySince = process->getReadySince();
         contextSwitch(currentProcess, process);
+        process->addWaitingTime(currentTime - readySince);
         
         // Execute for time quantum or until completion
         int executionTime = process->execute(timeQuantum);
+        recordExecution(process, currentTime, executionTime);
         
         // Record in Gantt chart
         for (int i = 0; i < executionTime; i++) {
@@ -98,61 +72,24 @@ void RoundRobinScheduler::schedule() {
         // Update current time
         currentTime += executionTime;
         
-        // Update waiting times for other processes
-        for (auto& p : processes) {
-            if (p != process && p->getState() == ProcessState::READY) {
-                p->addWaitingTime(executionTime);
-            }
-        }
-        
         // Check if process is complete
         if (process->isComplete()) {
-            process->setCompletionTime(currentTime);
-            process->calculateMetrics();
-            process->setState(ProcessState::TERMINATED);
+            completeProcess(process);
+            currentProcess = nullptr;
         } else {
             // Process not complete, add back to ready queue
-            process->setState(ProcessState::READY);
+            markReady(*process, currentTime);
             
-            // Admit any new arrivals before re-queueing
-            admitArrivingProcesses();
-            for (auto& p : processes) {
-                if (p->getState() == ProcessState::READY && 
-                    p != process &&
-                    p->getLastScheduledTime() < currentTime) {
-                    
-                    bool inQueue = false;
-                    std::queue<std::shared_ptr<Process>> tempQueue = readyQueue;
-                    while (!tempQueue.empty()) {
-                        if (tempQueue.front() == p) {
-                            inQueue = true;
-                            break;
-                        }
-                        tempQueue.pop();
-                    }
-                    
-                    if (!inQueue) {
-                        readyQueue.push(p);
-                        p->setLastScheduledTime(currentTime);
-                    }
-                }
+            // Processes that arrived during the quantum go ahead of it
+            for (auto& p : admitArrivingProcesses()) {
+                readyQueue.push(p);
+                p->setLastScheduledTime(currentTime);
             }
             
             // Add current process back to queue
             readyQueue.push(process);
             process->setLastScheduledTime(currentTime);
         }
-        
-        currentProcess = nullptr;
-        
-        // Check if all processes are complete
-        allComplete = true;
-        for (const auto& p : processes) {
-            if (p->getState() != ProcessState::TERMINATED) {
-                allComplete = false;
-                break;
-            }
-        }
     }
 }
 
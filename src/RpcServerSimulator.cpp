@@ -0,0 +1,292 @@
+#include "RpcServerSimulator.h"
+#include "DispatchQueue.h"
+#include "FutureEventSet.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+/**
+ * @file RpcServerSimulator.cpp
+ * @brief Implementation of the dispatcher / worker RPC server simulation
+ */
+
+namespace {
+
+/**
+ * @enum EventKind
+ * @brief Low two bits of an event payload; the rest is a request or worker index
+ */
+enum EventKind : uint64_t {
+    ARRIVAL = 0,            ///< Next request arrives (index unused)
+    DISPATCHER_FREE = 1,    ///< Dispatcher finished a handoff (index unused)
+    SLICE_END = 2,          ///< Worker finished a slice and any preemption (index = worker)
+    STEERED = 3             ///< Steered request reaches its worker (index = request slot)
+};
+
+/**
+ * @struct Request
+ * @brief A request in the system; slots are recycled on completion
+ */
+struct Request {
+    int64_t arrival;        ///< Arrival time, ns
+    int64_t service;        ///< Total service time, ns
+    int64_t remaining;      ///< Service still needed, ns
+    int type;               ///< Index into the mix
+    int worker;             ///< WORK_STEALING: worker it was steered to
+    bool measured;          ///< Past the warmup
+};
+
+uint64_t payload(EventKind kind, size_t index) {
+    return static_cast<uint64_t>(index) << 2 | kind;
+}
+
+} // namespace
+
+RpcServerSimulator::RpcServerSimulator(const RpcServerConfig& config) : config(config) {
+    this->config.workers = std::max(1, config.workers);
+    this->config.dispatchCost = std::max<int64_t>(0, config.dispatchCost);
+    this->config.quantum = std::max<int64_t>(1, config.quantum);
+    this->config.preemptionCost = std::max<int64_t>(0, config.preemptionCost);
+    this->config.stealCost = std::max<int64_t>(0, config.stealCost);
+    this->config.requests = std::max<size_t>(1, config.requests);
+    this->config.warmupFraction = std::min(0.9, std::max(0.0, config.warmupFraction));
+    this->config.mix.clear();
+    for (const RpcRequestType& type : config.mix) {
+        if (type.share > 0) {
+            this->config.mix.push_back(type);
+            this->config.mix.back().meanService = std::max(1.0, type.meanService);
+        }
+    }
+    if (this->config.mix.empty()) {
+        this->config.mix.push_back(RpcRequestType{"request", 1.0, 1000.0, BurstDistribution::EXPONENTIAL});
+    }
+}
+
+std::string RpcServerSimulator::architectureName(RpcArchitecture architecture) {
+    switch (architecture) {
+        case RpcArchitecture::CENTRALIZED_FCFS:
+            return "Centralized FCFS";
+        case RpcArchitecture::WORK_STEALING:
+            return "Work Stealing";
+        case RpcArchitecture::PROCESSOR_SHARING:
+            return "Processor Sharing";
+    }
+    return "Unknown";
+}
+
+double RpcServerSimulator::meanService() const {
+    double shares = 0.0;
+    double mean = 0.0;
+    for (const RpcRequestType& type : config.mix) {
+        shares += type.share;
+        mean += type.share * type.meanService;
+    }
+    return mean / shares;
+}
+
+RpcMetrics RpcServerSimulator::run(RpcArchitecture architecture, double load) const {
+    const size_t workers = static_cast<size_t>(config.workers);
+    const bool stealing = architecture == RpcArchitecture::WORK_STEALING;
+    const bool sharing = architecture == RpcArchitecture::PROCESSOR_SHARING;
+    const double meanGap = meanService() / (std::max(1e-9, load) * config.workers);
+    const size_t warmup = static_cast<size_t>(config.warmupFraction * config.requests);
+
+    std::vector<double> cumulative;
+    double shares = 0.0;
+    for (const RpcRequestType& type : config.mix) {
+        shares += type.share;
+        cumulative.push_back(shares);
+    }
+
+    RpcMetrics metrics;
+    metrics.architecture = architecture;
+    metrics.load = load;
+    metrics.completed = 0;
+    metrics.typeLatency.assign(config.mix.size(), QuantileSketch());
+    metrics.preemptions = 0;
+    metrics.steals = 0;
+
+    // Arrivals and the mix use one stream, steering another, so every
+    // architecture sees the same requests
+    std::mt19937_64 engine(config.seed);
+    std::mt19937_64 steering(WorkloadGenerator::replicaSeed(config.seed, 1));
+    std::vector<Request> slots;
+    std::vector<size_t> freeSlots;
+    size_t generated = 0;
+    auto arrive = [&](int64_t now) {
+        double u = WorkloadGenerator::uniform01(engine) * shares;
+        int type = static_cast<int>(std::upper_bound(cumulative.begin(), cumulative.end(), u) - cumulative.begin());
+        type = std::min(type, static_cast<int>(cumulative.size()) - 1);
+        const RpcRequestType& kind = config.mix[static_cast<size_t>(type)];
+        double service = kind.meanService;
+        double v = WorkloadGenerator::uniform01(engine);
+        switch (kind.distribution) {
+            case BurstDistribution::CONSTANT:
+                break;
+            case BurstDistribution::UNIFORM:
+                service = 1.0 + v * (2.0 * kind.meanService - 2.0);
+                break;
+            case BurstDistribution::EXPONENTIAL:
+                service = -kind.meanService * std::log(1.0 - v);
+                break;
+        }
+        Request request;
+        request.arrival = now;
+        request.service = std::max<int64_t>(1, std::llround(service));
+        request.remaining = request.service;
+        request.type = type;
+        request.worker = static_cast<int>(steering() % workers);
+        request.measured = generated >= warmup;
+        generated++;
+        if (freeSlots.empty()) {
+            slots.push_back(request);
+            return slots.size() - 1;
+        }
+        size_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        slots[slot] = request;
+        return slot;
+    };
+    auto nextGap = [&]() {
+        return std::llround(-meanGap * std::log(1.0 - WorkloadGenerator::uniform01(engine)));
+    };
+
+    std::unique_ptr<FutureEventSet> events = createFutureEventSet(FutureEventSetType::BINARY_HEAP);
+    DispatchQueue central;
+    std::vector<DispatchQueue> local(stealing ? workers : 0);
+    std::vector<int> idle;
+    for (size_t w = workers; w-- > 0;) {
+        idle.push_back(static_cast<int>(w));
+    }
+    std::vector<int64_t> running(workers, -1);
+    std::vector<int64_t> slice(workers, 0);
+    int64_t dispatcherFree = 0;
+    int64_t dispatcherBusy = 0;
+    int64_t serviceBusy = 0;
+    int64_t lastTime = 0;
+
+    auto start = [&](size_t worker, size_t slot, int64_t at) {
+        const Request& request = slots[slot];
+        running[worker] = static_cast<int64_t>(slot);
+        slice[worker] = sharing ? std::min(config.quantum, request.remaining) : request.remaining;
+        bool preempted = slice[worker] < request.remaining;
+        serviceBusy += slice[worker];
+        events->push(at + slice[worker] + (preempted ? config.preemptionCost : 0), payload(SLICE_END, worker));
+    };
+    // Central queue: one handoff per dispatchCost while a worker is idle
+    auto dispatch = [&](int64_t now) {
+        while (now >= dispatcherFree && !central.empty() && !idle.empty()) {
+            size_t worker = static_cast<size_t>(idle.back());
+            idle.pop_back();
+            start(worker, static_cast<size_t>(central.pop()), now + config.dispatchCost);
+            dispatcherFree = now + config.dispatchCost;
+            dispatcherBusy += config.dispatchCost;
+            if (config.dispatchCost > 0) {
+                events->push(dispatcherFree, payload(DISPATCHER_FREE, 0));
+            }
+        }
+    };
+    // Next non-empty queue after @p worker's own, or -1
+    auto victim = [&](size_t worker) {
+        for (size_t k = 1; k < workers; k++) {
+            size_t other = (worker + k) % workers;
+            if (!local[other].empty()) {
+                return static_cast<int>(other);
+            }
+        }
+        return -1;
+    };
+
+    events->push(nextGap(), payload(ARRIVAL, 0));
+    FutureEvent event;
+    while (events->pop(event)) {
+        const int64_t now = event.time;
+        const size_t index = static_cast<size_t>(event.payload >> 2);
+        lastTime = now;
+        switch (static_cast<EventKind>(event.payload & 3)) {
+            case ARRIVAL: {
+                size_t slot = arrive(now);
+                if (generated < config.requests) {
+                    events->push(now + nextGap(), payload(ARRIVAL, 0));
+                }
+                if (stealing) {
+                    dispatcherFree = std::max(now, dispatcherFree) + config.dispatchCost;
+                    dispatcherBusy += config.dispatchCost;
+                    events->push(dispatcherFree, payload(STEERED, slot));
+                } else {
+                    central.insert(static_cast<int>(slot));
+                    dispatch(now);
+                }
+                break;
+            }
+            case DISPATCHER_FREE:
+                dispatch(now);
+                break;
+            case STEERED: {
+                size_t worker = static_cast<size_t>(slots[index].worker);
+                if (running[worker] < 0) {
+                    start(worker, index, now);
+                    break;
+                }
+                // A polling idle worker takes it before it is queued
+                auto found = std::find_if(running.begin(), running.end(), [](int64_t slot) { return slot < 0; });
+                if (found != running.end()) {
+                    metrics.steals++;
+                    start(static_cast<size_t>(found - running.begin()), index, now + config.stealCost);
+                } else {
+                    local[worker].insert(static_cast<int>(index));
+                }
+                break;
+            }
+            case SLICE_END: {
+                size_t worker = index;
+                size_t slot = static_cast<size_t>(running[worker]);
+                Request& request = slots[slot];
+                request.remaining -= slice[worker];
+                running[worker] = -1;
+                if (request.remaining > 0) {
+                    metrics.preemptions++;
+                    central.insert(static_cast<int>(slot));
+                } else {
+                    if (request.measured) {
+                        double latency = static_cast<double>(now - request.arrival);
+                        metrics.latency.add(latency);
+                        metrics.slowdown.add(latency / static_cast<double>(request.service));
+                        metrics.typeLatency[static_cast<size_t>(request.type)].add(latency);
+                        metrics.completed++;
+                    }
+                    freeSlots.push_back(slot);
+                }
+                if (!stealing) {
+                    idle.push_back(static_cast<int>(worker));
+                    dispatch(now);
+                } else if (!local[worker].empty()) {
+                    start(worker, static_cast<size_t>(local[worker].pop()), now);
+                } else {
+                    int other = victim(worker);
+                    if (other >= 0) {
+                        metrics.steals++;
+                        start(worker, static_cast<size_t>(local[static_cast<size_t>(other)].pop()),
+                              now + config.stealCost);
+                    }
+                }
+                break;
+            }
+        }
+    }
+
+    double span = static_cast<double>(std::max<int64_t>(1, lastTime));
+    metrics.workerUtilization = 100.0 * static_cast<double>(serviceBusy) / (config.workers * span);
+    metrics.dispatcherUtilization = 100.0 * static_cast<double>(dispatcherBusy) / span;
+    return metrics;
+}
+
+std::vector<RpcMetrics> RpcServerSimulator::sweep(RpcArchitecture architecture,
+                                                  const std::vector<double>& loads) const {
+    std::vector<RpcMetrics> results(loads.size());
+    parallelFor(loads.size(), workerThreads(config.numThreads, loads.size()), [&](size_t k) {
+        results[k] = run(architecture, loads[k]);
+    });
+    return results;
+}
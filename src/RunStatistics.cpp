@@ -0,0 +1,61 @@
+#include "RunStatistics.h"
+#include "Process.h"
+
+/**
+ * @file RunStatistics.cpp
+ * @brief Implementation of the per-run scheduling statistics
+ */
+
+void RunStatistics::clear() {
+    latencies.clear();
+    fairness.clear();
+    if (consumers) {
+        consumers->clear();
+    }
+    if (starving) {
+        starving->clear();
+    }
+}
+
+void RunStatistics::ready(const Process& process, int since) {
+    if (starving) {
+        starving->enter(process.getPID(), since);
+    }
+}
+
+void RunStatistics::dispatched(const Process& process, int time) {
+    latencies.record(process.getBasePriority(), time - process.getReadySince());
+    fairness.recordWait(process.getBasePriority(), time - process.getReadySince());
+    if (starving) {
+        starving->leave(process.getPID(), time);
+    }
+}
+
+void RunStatistics::executed(const Process& process, int duration) {
+    if (consumers) {
+        consumers->add(process.getPID(), duration);
+    }
+}
+
+void RunStatistics::completed(const Process& process) {
+    if (!process.isFailed()) {
+        fairness.recordCompletion(process.getBasePriority(), process.getBurstTime(),
+                                  process.getTurnaroundTime());
+    }
+}
+
+void RunStatistics::setTopConsumers(size_t capacity) {
+    if (capacity == 0) {
+        consumers.reset();
+    } else {
+        consumers.reset(new SpaceSaving(capacity));
+    }
+}
+
+void RunStatistics::setStarvationTracking(bool track) {
+    if (!track) {
+        starving.reset();
+    } else if (!starving) {
+        starving.reset(new StarvationTracker());
+    }
+}
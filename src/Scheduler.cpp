@@ -1,4 +1,6 @@
 #include "Scheduler.h"
+#include "InterruptModel.h"
+#include "MemoryModel.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -9,30 +11,162 @@
  * @brief Implementation of the base Scheduler class
  */
 
+static const uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+static const uint64_t FNV_PRIME = 0x100000001B3ULL;
+
+/**
+ * @brief Fold a 32-bit value into an FNV-1a hash, byte by byte
+ */
+static uint64_t fnvMix(uint64_t hash, int value) {
+    uint32_t bits = static_cast<uint32_t>(value);
+    for (int i = 0; i < 4; i++) {
+        hash ^= (bits >> (8 * i)) & 0xFF;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
 Scheduler::Scheduler(int contextSwitchOverhead)
-    : currentTime(0), contextSwitchOverhead(contextSwitchOverhead),
-      totalContextSwitches(0), currentProcess(nullptr) {
+    : currentTime(0), contextSwitchOverhead(contextSwitchOverhead), cpuCount(1),
+      totalContextSwitches(0), currentProcess(nullptr), tieBreakSeed(0),
+      fingerprint(FNV_OFFSET_BASIS), pendingSlicePid(-1), pendingSliceStart(0),
+      pendingSliceEnd(0), arrivalSetType(FutureEventSetType::AUTO),
+      arrivalsPrepared(false), recordSlices(false) {
+}
+
+uint64_t Scheduler::tieBreakKey(uint64_t seed, int id) {
+    // SplitMix64 finalizer
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (static_cast<uint64_t>(id) + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+bool Scheduler::tieBreakBefore(uint64_t seed, const Process& a, const Process& b) {
+    if (a.getArrivalTime() != b.getArrivalTime()) {
+        return a.getArrivalTime() < b.getArrivalTime();
+    }
+    if (a.getPID() != b.getPID()) {
+        return a.getPID() < b.getPID();
+    }
+    // Same arrival and PID: the seed decides, keyed on what differs between them
+    return tieBreakKey(seed, a.getSequence()) < tieBreakKey(seed, b.getSequence());
+}
+
+void Scheduler::recordExecution(const std::shared_ptr<Process>& process,
+                                int start, int duration) {
+    if (duration <= 0) {
+        return;
+    }
+    if (interrupts) {
+        process->addInterruptTime(static_cast<int>(interrupts->handlerTimeDuring(start, duration)));
+    }
+    stats.executed(*process, duration);
+    if (recordSlices) {
+        if (!slices.empty() && slices.back().pid == process->getPID() && slices.back().end == start) {
+            slices.back().end = start + duration;
+        } else {
+            slices.push_back(ExecutionSlice{process->getPID(), start, start + duration});
+        }
+    }
+    if (pendingSlicePid == process->getPID() && pendingSliceEnd == start) {
+        pendingSliceEnd = start + duration;
+        return;
+    }
+    if (pendingSlicePid != -1) {
+        fingerprint = fnvMix(fnvMix(fnvMix(fingerprint, pendingSlicePid),
+                                    pendingSliceStart), pendingSliceEnd);
+    }
+    pendingSlicePid = process->getPID();
+    pendingSliceStart = start;
+    pendingSliceEnd = start + duration;
+}
+
+void Scheduler::resetTimeline() {
+    fingerprint = FNV_OFFSET_BASIS;
+    pendingSlicePid = -1;
+    pendingSliceStart = 0;
+    pendingSliceEnd = 0;
+    arrivalsPrepared = false;
+    slices.clear();
+    stats.clear();
+}
+
+int Scheduler::toProcessTime(int realTime) const {
+    return interrupts ? static_cast<int>(interrupts->toProcessTime(realTime)) : realTime;
+}
+
+bool Scheduler::setInterrupts(const InterruptModel& model, int core) {
+    if (cpuCount > 1) {
+        return false;
+    }
+    interrupts = model.createTimeline(core);
+    arrivalsPrepared = false;
+    return interrupts != nullptr;
+}
+
+bool Scheduler::setMemory(const MemoryConfig& config) {
+    if (!MemoryAccount::isValid(config)) {
+        return false;
+    }
+    memory = std::make_shared<MemoryAdmission>(config);
+    arrivalsPrepared = false;
+    return true;
+}
+
+int Scheduler::memorySpeed() const {
+    return memory ? memory->speed() : 1000;
+}
+
+int Scheduler::readyTime(const Process& process) const {
+    // At admission, a process's only memory stall is its hold
+    return toProcessTime(process.getArrivalTime()) + process.getMemoryStallTime();
+}
+
+bool Scheduler::memoryHeld() const {
+    return memory && memory->holding();
+}
+
+void Scheduler::addMemoryPressureTime(int duration) {
+    if (memory) {
+        memory->addPressureTime(duration);
+    }
+}
+
+int64_t Scheduler::getMemoryPressureTime() const {
+    return memory ? memory->getPressureTime() : 0;
+}
+
+uint64_t Scheduler::getRunFingerprint() const {
+    if (pendingSlicePid == -1) {
+        return fingerprint;
+    }
+    return fnvMix(fnvMix(fnvMix(fingerprint, pendingSlicePid),
+                         pendingSliceStart), pendingSliceEnd);
 }
 
 void Scheduler::addProcess(std::shared_ptr<Process> process) {
+    process->setSequence(static_cast<int>(processes.size()));
     processes.push_back(process);
+    arrivalsPrepared = false;
 }
 
 void Scheduler::contextSwitch(std::shared_ptr<Process> from, 
                               std::shared_ptr<Process> to) {
     // Only count as context switch if actually switching between different processes
+    int switchStart = currentTime;
     if (from != to && from != nullptr && to != nullptr) {
         totalContextSwitches++;
         currentTime += contextSwitchOverhead;
     }
     
-    // Update states
-    if (from != nullptr && from->getState() == ProcessState::RUNNING) {
-        from->setState(ProcessState::READY);
+    // Update states; a process that keeps the CPU stays RUNNING
+    if (from != nullptr && from != to && from->getState() == ProcessState::RUNNING) {
+        markReady(*from, switchStart);
     }
     
     if (to != nullptr) {
-        to->setState(ProcessState::RUNNING);
+        markRunning(*to, currentTime);
         
         // Record start time if first time being scheduled
         if (to->isFirstSchedule()) {
@@ -44,6 +178,19 @@ void Scheduler::contextSwitch(std::shared_ptr<Process> from,
     currentProcess = to;
 }
 
+void Scheduler::markReady(Process& process, int since) {
+    process.setState(ProcessState::READY);
+    process.setReadySince(since);
+    stats.ready(process, since);
+}
+
+void Scheduler::markRunning(Process& process, int time) {
+    if (process.getState() == ProcessState::READY) {
+        stats.dispatched(process, time);
+    }
+    process.setState(ProcessState::RUNNING);
+}
+
 void Scheduler::updateWaitingTimes(int elapsedTime) {
     for (auto& process : processes) {
         // Only update waiting time for processes in READY state
@@ -53,18 +200,152 @@ void Scheduler::updateWaitingTimes(int elapsedTime) {
     }
 }
 
-int Scheduler::admitArrivingProcesses() {
-    int admitted = 0;
-    for (auto& process : processes) {
-        if (process->getState() == ProcessState::NEW && 
-            process->getArrivalTime() <= currentTime) {
-            process->setState(ProcessState::READY);
-            admitted++;
+bool Scheduler::addDependency(int predecessorPid, int successorPid) {
+    if (predecessorPid == successorPid) {
+        return false;
+    }
+    dependencies.emplace_back(predecessorPid, successorPid);
+    arrivalsPrepared = false;
+    return true;
+}
+
+void Scheduler::clearDependencies() {
+    dependencies.clear();
+    pidIndex.clear();
+    successorStart.clear();
+    successorList.clear();
+    unmetDependencies.clear();
+    arrivalsPrepared = false;
+}
+
+void Scheduler::buildDependencyGraph() {
+    pidIndex.clear();
+    pidIndex.reserve(processes.size());
+    for (size_t i = 0; i < processes.size(); i++) {
+        pidIndex.emplace(processes[i]->getPID(), i);
+    }
+    
+    // Counting pass, then fill: successorList is grouped by predecessor
+    successorStart.assign(processes.size() + 1, 0);
+    unmetDependencies.assign(processes.size(), 0);
+    auto resolve = [this](const std::pair<int, int>& edge, size_t& from, size_t& to) {
+        auto a = pidIndex.find(edge.first);
+        auto b = pidIndex.find(edge.second);
+        if (a == pidIndex.end() || b == pidIndex.end()) {
+            return false;
+        }
+        from = a->second;
+        to = b->second;
+        return true;
+    };
+    size_t from = 0;
+    size_t to = 0;
+    for (const auto& edge : dependencies) {
+        if (resolve(edge, from, to)) {
+            successorStart[from + 1]++;
+            if (processes[from]->getState() != ProcessState::TERMINATED) {
+                unmetDependencies[to]++;
+            }
+        }
+    }
+    for (size_t i = 0; i < processes.size(); i++) {
+        successorStart[i + 1] += successorStart[i];
+    }
+    successorList.resize(successorStart.back());
+    std::vector<size_t> cursor(successorStart.begin(), successorStart.end() - 1);
+    for (const auto& edge : dependencies) {
+        if (resolve(edge, from, to)) {
+            successorList[cursor[from]++] = to;
+        }
+    }
+}
+
+void Scheduler::prepareArrivals() {
+    arrivals = createFutureEventSet(arrivalSetType, processes.size());
+    if (dependencies.empty()) {
+        unmetDependencies.clear();
+    } else {
+        buildDependencyGraph();
+    }
+    for (size_t i = 0; i < processes.size(); i++) {
+        if (processes[i]->getState() == ProcessState::NEW &&
+            (unmetDependencies.empty() || unmetDependencies[i] == 0)) {
+            arrivals->push(toProcessTime(processes[i]->getArrivalTime()), i);
+        }
+    }
+    if (memory) {
+        memory->reset(processes.size());
+    }
+    arrivalsPrepared = true;
+}
+
+void Scheduler::completeProcess(const std::shared_ptr<Process>& process) {
+    if (interrupts) {
+        interrupts->completeInRealTime(*process, currentTime);
+    } else {
+        process->setCompletionTime(currentTime);
+    }
+    process->calculateMetrics();
+    process->setState(ProcessState::TERMINATED);
+    stats.completed(*process);
+    if (memory) {
+        for (const auto& released : memory->release(process->getResidentSetSize(), currentTime)) {
+            // The hold counts as memory stall and as waiting
+            processes[released.first]->addMemoryStallTime(released.second);
+            processes[released.first]->addWaitingTime(released.second);
+            arrivals->push(currentTime, released.first);
+        }
+    }
+    if (unmetDependencies.empty()) {
+        return;
+    }
+    
+    auto found = pidIndex.find(process->getPID());
+    if (found == pidIndex.end() || processes[found->second] != process) {
+        return;
+    }
+    for (size_t k = successorStart[found->second]; k < successorStart[found->second + 1]; k++) {
+        size_t successor = successorList[k];
+        if (--unmetDependencies[successor] == 0 &&
+            processes[successor]->getState() == ProcessState::NEW) {
+            arrivals->push(std::max(toProcessTime(processes[successor]->getArrivalTime()), currentTime),
+                           successor);
         }
     }
+}
+
+std::vector<std::shared_ptr<Process>> Scheduler::admitArrivingProcesses() {
+    if (!arrivalsPrepared) {
+        prepareArrivals();
+    }
+    
+    std::vector<std::shared_ptr<Process>> admitted;
+    FutureEvent event;
+    while (arrivals->nextTime() <= currentTime && arrivals->pop(event)) {
+        auto& process = processes[event.payload];
+        if (process->getState() == ProcessState::NEW && (!memory || memory->admit(event.payload, process->getResidentSetSize(), currentTime))) {
+            markReady(*process, readyTime(*process));
+            admitted.push_back(process);
+        }
+    }
+    
+    // Canonical order, independent of the order processes were added
+    uint64_t seed = tieBreakSeed;
+    std::sort(admitted.begin(), admitted.end(),
+              [seed](const std::shared_ptr<Process>& a, const std::shared_ptr<Process>& b) {
+                  return tieBreakBefore(seed, *a, *b);
+              });
     return admitted;
 }
 
+int Scheduler::nextArrivalTime() {
+    if (!arrivalsPrepared) {
+        prepareArrivals();
+    }
+    int64_t next = arrivals->nextTime();
+    return next == FutureEventSet::NO_EVENT ? INT_MAX : static_cast<int>(next);
+}
+
 SchedulingMetrics Scheduler::calculateMetrics() const {
     SchedulingMetrics metrics;
     
@@ -75,9 +356,18 @@ SchedulingMetrics Scheduler::calculateMetrics() const {
     int maxCompletionTime = 0;
     int minArrivalTime = INT_MAX;
     int totalBurstTime = 0;
+    int totalInterrupt = 0;
+    int totalMemoryStall = 0;
+    int failedProcesses = 0;
+    int totalWasted = 0;
     
     for (const auto& process : processes) {
-        if (process->getState() == ProcessState::TERMINATED) {
+        totalWasted += process->getWastedTime();
+        if (process->getState() == ProcessState::TERMINATED && process->isFailed()) {
+            failedProcesses++;
+            maxCompletionTime = std::max(maxCompletionTime, process->getCompletionTime());
+            minArrivalTime = std::min(minArrivalTime, process->getArrivalTime());
+        } else if (process->getState() == ProcessState::TERMINATED) {
             totalWaiting += process->getWaitingTime();
             totalTurnaround += process->getTurnaroundTime();
             totalResponse += process->getResponseTime();
@@ -86,6 +376,8 @@ SchedulingMetrics Scheduler::calculateMetrics() const {
             maxCompletionTime = std::max(maxCompletionTime, process->getCompletionTime());
             minArrivalTime = std::min(minArrivalTime, process->getArrivalTime());
             totalBurstTime += process->getBurstTime();
+            totalInterrupt += process->getInterruptTime();
+            totalMemoryStall += process->getMemoryStallTime();
         }
     }
     
@@ -99,12 +391,15 @@ SchedulingMetrics Scheduler::calculateMetrics() const {
         metrics.averageResponseTime = 0;
     }
     
-    // CPU Utilization = (Total Burst Time) / (Total Time) * 100
+    // CPU Utilization = (Total Burst Time + Wasted Time) / (Total Time * CPUs) * 100
     int totalTime = maxCompletionTime - minArrivalTime;
     if (totalTime > 0) {
-        metrics.cpuUtilization = (static_cast<double>(totalBurstTime) / totalTime) * 100.0;
+        double capacity = static_cast<double>(totalTime) * cpuCount;
+        metrics.cpuUtilization = (static_cast<double>(totalBurstTime + totalWasted) / capacity) * 100.0;
+        metrics.goodput = (static_cast<double>(totalBurstTime) / capacity) * 100.0;
     } else {
         metrics.cpuUtilization = 0;
+        metrics.goodput = 0;
     }
     
     // Throughput = Completed Processes / Total Time
@@ -116,6 +411,15 @@ SchedulingMetrics Scheduler::calculateMetrics() const {
     
     metrics.totalContextSwitches = totalContextSwitches;
     metrics.totalTime = totalTime;
+    metrics.totalInterruptTime = totalInterrupt;
+    metrics.totalMemoryStallTime = totalMemoryStall;
+    metrics.failedProcesses = failedProcesses;
+    metrics.totalWastedTime = totalWasted;
+    const FairnessStats& fairness = stats.getFairness();
+    metrics.averageSlowdown = fairness.overall().slowdown.mean();
+    metrics.jainFairnessIndex = fairness.overall().jainIndex();
+    metrics.classFairnessIndex = fairness.classJainIndex();
+    metrics.maxStarvationTime = fairness.overall().maxStarvation;
     
     return metrics;
 }
@@ -167,6 +471,92 @@ void Scheduler::displayResults() const {
     std::cout << "Throughput:                " << std::setw(10) << metrics.throughput << " processes/time unit\n";
     std::cout << "Total Context Switches:    " << std::setw(10) << metrics.totalContextSwitches << "\n";
     std::cout << "Total Simulation Time:     " << std::setw(10) << metrics.totalTime << " time units\n";
+    std::cout << "Average Slowdown:          " << std::setw(10) << metrics.averageSlowdown << "\n";
+    std::cout << "Jain Fairness (processes): " << std::setw(10) << metrics.jainFairnessIndex << "\n";
+    std::cout << "Jain Fairness (classes):   " << std::setw(10) << metrics.classFairnessIndex << "\n";
+    std::cout << "Max Starvation Time:       " << std::setw(10) << metrics.maxStarvationTime << " time units\n";
+    if (interrupts) {
+        std::cout << "Interrupt Time (running):  " << std::setw(10) << metrics.totalInterruptTime << " time units\n";
+    }
+    if (metrics.totalWastedTime > 0 || metrics.failedProcesses > 0) {
+        std::cout << "Wasted CPU Time (crashes): " << std::setw(10) << metrics.totalWastedTime << " time units\n";
+        std::cout << "Goodput:                   " << std::setw(10) << metrics.goodput << " %\n";
+        std::cout << "Failed Processes:          " << std::setw(10) << metrics.failedProcesses << "\n";
+    }
+    if (memory) {
+        std::cout << "Memory Stall Time (total): " << std::setw(10) << metrics.totalMemoryStallTime << " time units\n";
+        std::cout << "Memory Pressure Time:      " << std::setw(10) << memory->getPressureTime() << " time units\n";
+    }
+    
+    const LatencyHistogram& latencies = stats.getLatencies();
+    if (latencies.count() > 0) {
+        std::cout << "\n" << std::string(80, '-') << "\n";
+        std::cout << "Scheduling Latency (ready -> running), by priority:\n";
+        std::cout << std::string(80, '-') << "\n";
+        std::cout << std::left << std::setw(10) << "Priority"
+                  << std::right << std::setw(10) << "Count"
+                  << std::setw(10) << "Mean"
+                  << std::setw(10) << "p50"
+                  << std::setw(10) << "p99"
+                  << std::setw(10) << "Max" << "\n";
+        auto row = [](const std::string& label, const QuantileSketch& sketch) {
+            std::cout << std::left << std::setw(10) << label
+                      << std::right << std::setw(10) << sketch.count()
+                      << std::setw(10) << sketch.mean()
+                      << std::setw(10) << sketch.quantile(0.5)
+                      << std::setw(10) << sketch.quantile(0.99)
+                      << std::setw(10) << sketch.max() << "\n";
+        };
+        for (int priority : latencies.getClasses()) {
+            row(std::to_string(priority), latencies.forClass(priority));
+        }
+        row("All", latencies.overall());
+    }
+    
+    const FairnessStats& fairness = stats.getFairness();
+    if (fairness.overall().completed > 0) {
+        std::cout << "\n" << std::string(80, '-') << "\n";
+        std::cout << "Fairness and Slowdown (turnaround / burst), by priority:\n";
+        std::cout << std::string(80, '-') << "\n";
+        std::cout << std::left << std::setw(10) << "Priority"
+                  << std::right << std::setw(10) << "Done"
+                  << std::setw(10) << "Share"
+                  << std::setw(10) << "Jain"
+                  << std::setw(10) << "Mean SD"
+                  << std::setw(10) << "p99 SD"
+                  << std::setw(10) << "Starved" << "\n";
+        auto row = [](const std::string& label, const ClassFairness& totals) {
+            std::cout << std::left << std::setw(10) << label
+                      << std::right << std::setw(10) << totals.completed
+                      << std::setw(10) << totals.share()
+                      << std::setw(10) << totals.jainIndex()
+                      << std::setw(10) << totals.slowdown.mean()
+                      << std::setw(10) << totals.slowdown.quantile(0.99)
+                      << std::setw(10) << totals.maxStarvation << "\n";
+        };
+        for (int priority : fairness.getClasses()) {
+            row(std::to_string(priority), fairness.forClass(priority));
+        }
+        row("All", fairness.overall());
+    }
+    
+    const StarvationTracker* starving = stats.getStarvation();
+    const SpaceSaving* consumers = stats.getTopConsumers();
+    if (starving && starving->getWorstId() != -1) {
+        std::cout << "\nMost Starved Process:      PID " << starving->getWorstId()
+                  << ", ready for " << starving->getWorstWait() << " time units\n";
+    }
+    if (consumers && consumers->size() > 0) {
+        std::cout << "Top CPU Consumers:        ";
+        for (const HeavyHitter& hitter : consumers->top(5)) {
+            std::cout << " PID " << hitter.id << " (" << hitter.count;
+            if (hitter.error > 0) {
+                std::cout << ", -" << hitter.error;
+            }
+            std::cout << ")";
+        }
+        std::cout << "\n";
+    }
     std::cout << std::string(80, '=') << "\n\n";
 }
 
@@ -179,6 +569,8 @@ void Scheduler::reset() {
     currentTime = 0;
     totalContextSwitches = 0;
     currentProcess = nullptr;
+    resetTimeline();
+    timers.clear();
     
     for (auto& process : processes) {
         process->reset();
@@ -0,0 +1,285 @@
+#include "SkipListScheduler.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <climits>
+#include <iomanip>
+
+/**
+ * @file SkipListScheduler.cpp
+ * @brief Implementation of BFS/MuQSS-style virtual-deadline scheduling
+ */
+
+/// Columns of the Gantt chart that are recorded and shown
+static const size_t GANTT_WIDTH = 60;
+
+/// Fixed-point scale of deadlines and priority ratios
+static const int64_t RATIO_SCALE = 128;
+
+/**
+ * @brief Build the BFS prio_ratios table: 128 at nice -20, +10% per nice level
+ */
+static std::vector<int> buildPrioRatios() {
+    std::vector<int> ratios(40);
+    int ratio = static_cast<int>(RATIO_SCALE);
+    for (int i = 0; i < 40; i++) {
+        ratios[i] = ratio;
+        ratio = ratio * 11 / 10;
+    }
+    return ratios;
+}
+
+/**
+ * @brief prio_ratio of a nice value (clamped to -20..19)
+ */
+static int prioRatio(int nice) {
+    static const std::vector<int> ratios = buildPrioRatios();
+    return ratios[std::min(19, std::max(-20, nice)) + 20];
+}
+
+SkipListScheduler::SkipListScheduler(int rrInterval, int numCpus, RunQueueLayout layout,
+                                     int contextSwitchOverhead)
+    : Scheduler(contextSwitchOverhead), rrInterval(std::max(1, rrInterval)),
+      layout(layout), ganttOrigin(0) {
+    cpuCount = std::max(1, numCpus);
+}
+
+std::string SkipListScheduler::getName() const {
+    std::string variant = layout == RunQueueLayout::GLOBAL ? "BFS Skip List" : "MuQSS Skip Lists";
+    std::string cpusLabel = cpuCount > 1 ? ", " + std::to_string(cpuCount) + " CPUs" : "";
+    return variant + " (rr_interval=" + std::to_string(rrInterval) + cpusLabel + ")";
+}
+
+int64_t SkipListScheduler::deadlineOffset(int priority) const {
+    return static_cast<int64_t>(rrInterval) * prioRatio(priority);
+}
+
+void SkipListScheduler::enqueue(int task, int cpu) {
+    tasks[task].enqueuedAt = currentTime;
+    if (layout == RunQueueLayout::GLOBAL) {
+        globalQueue.insert(tasks[task].deadline, task);
+    } else {
+        cpus[cpu].queue.insert(tasks[task].deadline, task);
+    }
+}
+
+void SkipListScheduler::wakeUp(int task) {
+    // An idle CPU will pick it up this round
+    for (size_t c = 0; c < cpus.size(); c++) {
+        if (cpus[c].running == -1) {
+            enqueue(task, static_cast<int>(c));
+            return;
+        }
+    }
+
+    // Otherwise preempt the CPU running the latest deadline, if ours is earlier
+    int victim = 0;
+    for (size_t c = 1; c < cpus.size(); c++) {
+        if (tasks[cpus[c].running].deadline > tasks[cpus[victim].running].deadline) {
+            victim = static_cast<int>(c);
+        }
+    }
+    int preempted = cpus[victim].running;
+    if (tasks[task].deadline < tasks[preempted].deadline) {
+        markReady(*processes[preempted], currentTime);
+        cpus[victim].running = -1;
+        enqueue(preempted, victim);
+        enqueue(task, victim);
+        return;
+    }
+
+    // No preemption: queue on the CPU with the shortest list (MuQSS)
+    int target = 0;
+    for (size_t c = 1; c < cpus.size(); c++) {
+        if (cpus[c].queue.size() < cpus[target].queue.size()) {
+            target = static_cast<int>(c);
+        }
+    }
+    enqueue(task, target);
+}
+
+int SkipListScheduler::pickNext(int cpu) {
+    if (layout == RunQueueLayout::GLOBAL) {
+        return globalQueue.popFirst();
+    }
+
+    // Own list first; steal only a strictly earlier head from another CPU
+    int source = cpu;
+    int64_t best = cpus[cpu].queue.firstDeadline();
+    for (size_t c = 0; c < cpus.size(); c++) {
+        int64_t head = cpus[c].queue.firstDeadline();
+        if (head < best) {
+            best = head;
+            source = static_cast<int>(c);
+        }
+    }
+    return cpus[source].queue.popFirst();
+}
+
+void SkipListScheduler::startTask(int cpu, int task) {
+    Cpu& state = cpus[cpu];
+    std::shared_ptr<Process> process = processes[task];
+
+    process->addWaitingTime(currentTime - tasks[task].enqueuedAt);
+
+    state.readyAt = currentTime;
+    if (state.previous != -1 && state.previous != task) {
+        totalContextSwitches++;
+        state.readyAt += contextSwitchOverhead;
+    }
+    state.running = task;
+    state.previous = task;
+
+    markRunning(*process, state.readyAt);
+    if (process->isFirstSchedule()) {
+        process->setStartTime(state.readyAt);
+        process->setFirstSchedule(false);
+    }
+}
+
+void SkipListScheduler::recordGantt(int cpu, int from, int to) {
+    Cpu& state = cpus[cpu];
+    for (int t = from; t < to && state.gantt.size() < GANTT_WIDTH; t++) {
+        if (state.running != -1 && t >= state.readyAt - ganttOrigin) {
+            state.gantt.push_back(processes[state.running]->getName());
+        } else {
+            state.gantt.push_back("IDLE");
+        }
+    }
+}
+
+void SkipListScheduler::schedule() {
+    currentTime = 0;
+    resetTimeline();
+    globalQueue.clear(tieBreakSeed);
+    cpus.assign(cpuCount, Cpu());
+    for (int c = 0; c < cpuCount; c++) {
+        cpus[c].running = -1;
+        cpus[c].previous = -1;
+        cpus[c].readyAt = 0;
+        cpus[c].queue.clear(tieBreakSeed + c + 1);
+    }
+
+    tasks.assign(processes.size(), Task());
+    taskIndex.clear();
+    for (size_t i = 0; i < processes.size(); i++) {
+        taskIndex[processes[i].get()] = static_cast<int>(i);
+    }
+
+    currentTime = nextArrivalTime();
+    if (currentTime == INT_MAX) {
+        currentTime = 0;
+        return;
+    }
+    ganttOrigin = currentTime;
+
+    while (true) {
+        // Wake up arrivals with a fresh deadline and timeslice
+        for (auto& process : admitArrivingProcesses()) {
+            int task = taskIndex[process.get()];
+            tasks[task].deadline = static_cast<int64_t>(currentTime) * RATIO_SCALE +
+                                   deadlineOffset(process->getPriority());
+            tasks[task].sliceLeft = rrInterval;
+            wakeUp(task);
+            tasks[task].enqueuedAt = readyTime(*process);
+        }
+
+        // Idle CPUs pick the earliest deadline they can see
+        bool anyRunning = false;
+        for (int c = 0; c < cpuCount; c++) {
+            if (cpus[c].running == -1) {
+                int task = pickNext(c);
+                if (task != -1) {
+                    startTask(c, task);
+                }
+            }
+            anyRunning = anyRunning || cpus[c].running != -1;
+        }
+
+        // Next event: arrival, completion or timeslice expiry
+        int64_t nextEvent = nextArrivalTime();
+        for (const Cpu& cpu : cpus) {
+            if (cpu.running != -1) {
+                int runFor = std::min(tasks[cpu.running].sliceLeft,
+                                      processes[cpu.running]->getRemainingTime());
+                int start = std::max(currentTime, cpu.readyAt);
+                nextEvent = std::min<int64_t>(nextEvent, static_cast<int64_t>(start) + runFor);
+            }
+        }
+        if (!anyRunning && nextEvent == INT_MAX) {
+            break;
+        }
+        int eventTime = static_cast<int>(nextEvent);
+
+        // Advance every CPU to the event
+        for (int c = 0; c < cpuCount; c++) {
+            if (currentTime - ganttOrigin < static_cast<int>(GANTT_WIDTH)) {
+                recordGantt(c, currentTime - ganttOrigin, eventTime - ganttOrigin);
+            }
+            Cpu& cpu = cpus[c];
+            if (cpu.running == -1) {
+                continue;
+            }
+            int start = std::max(currentTime, cpu.readyAt);
+            int ran = eventTime - start;
+            if (ran > 0) {
+                processes[cpu.running]->execute(ran);
+                recordExecution(processes[cpu.running], start, ran);
+                tasks[cpu.running].sliceLeft -= ran;
+            }
+        }
+        currentTime = eventTime;
+
+        // Completions and timeslice expiries, in CPU order
+        for (int c = 0; c < cpuCount; c++) {
+            Cpu& cpu = cpus[c];
+            if (cpu.running == -1 || currentTime < cpu.readyAt) {
+                continue;
+            }
+            int task = cpu.running;
+            std::shared_ptr<Process> process = processes[task];
+            if (process->isComplete()) {
+                completeProcess(process);
+                cpu.running = -1;
+                cpu.previous = -1;
+            } else if (tasks[task].sliceLeft == 0) {
+                // New deadline from now; requeue on the same CPU
+                tasks[task].deadline = static_cast<int64_t>(currentTime) * RATIO_SCALE +
+                                       deadlineOffset(process->getPriority());
+                tasks[task].sliceLeft = rrInterval;
+                markReady(*process, currentTime);
+                cpu.running = -1;
+                enqueue(task, c);
+            }
+        }
+    }
+}
+
+std::string SkipListScheduler::getGanttChart() const {
+    std::stringstream ss;
+    ss << "\nGantt Chart:\n";
+    ss << std::string(80, '-') << "\n";
+
+    if (cpus.empty() || cpus[0].gantt.empty()) {
+        ss << "No execution recorded\n";
+        return ss.str();
+    }
+
+    for (size_t c = 0; c < cpus.size(); c++) {
+        std::string label = cpus.size() > 1 ? "CPU" + std::to_string(c) : "";
+        ss << std::left << std::setw(5) << label << "|";
+        for (const auto& name : cpus[c].gantt) {
+            ss << (name == "IDLE" ? '-' : name[0]);
+        }
+        ss << "\n";
+    }
+
+    ss << "  0  ";
+    for (size_t i = 0; i < cpus[0].gantt.size(); i += 5) {
+        ss << std::right << std::setw(5) << (i + 5);
+    }
+    ss << "\n";
+
+    ss << std::string(80, '-') << "\n";
+    return ss.str();
+}
@@ -0,0 +1,85 @@
+#include "StarvationTracker.h"
+#include <utility>
+
+/**
+ * @file StarvationTracker.cpp
+ * @brief Implementation of the indexed heap of READY tasks
+ */
+
+StarvationTracker::StarvationTracker() : worstId(-1), worstWait(0) {
+}
+
+bool StarvationTracker::after(const ReadyEntry& a, const ReadyEntry& b) {
+    if (a.since != b.since) {
+        return a.since > b.since;
+    }
+    return a.id > b.id;
+}
+
+void StarvationTracker::swapEntries(size_t i, size_t j) {
+    std::swap(heap[i], heap[j]);
+    position[heap[i].id] = i;
+    position[heap[j].id] = j;
+}
+
+void StarvationTracker::sift(size_t i) {
+    while (i > 0 && after(heap[(i - 1) / 2], heap[i])) {
+        swapEntries(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+    while (true) {
+        size_t smallest = i;
+        for (size_t child = 2 * i + 1; child <= 2 * i + 2 && child < heap.size(); child++) {
+            if (after(heap[smallest], heap[child])) {
+                smallest = child;
+            }
+        }
+        if (smallest == i) {
+            return;
+        }
+        swapEntries(i, smallest);
+        i = smallest;
+    }
+}
+
+void StarvationTracker::enter(int id, int64_t since) {
+    auto ready = position.find(id);
+    if (ready != position.end()) {
+        heap[ready->second].since = since;
+        sift(ready->second);
+        return;
+    }
+    heap.push_back(ReadyEntry{since, id});
+    position[id] = heap.size() - 1;
+    sift(heap.size() - 1);
+}
+
+int64_t StarvationTracker::leave(int id, int64_t time) {
+    auto ready = position.find(id);
+    if (ready == position.end()) {
+        return 0;
+    }
+    size_t i = ready->second;
+    int64_t wait = time - heap[i].since;
+    if (wait > worstWait || worstId == -1) {
+        worstWait = wait;
+        worstId = id;
+    }
+    position.erase(ready);
+    if (i != heap.size() - 1) {
+        heap[i] = heap.back();
+        position[heap[i].id] = i;
+        heap.pop_back();
+        sift(i);
+    } else {
+        heap.pop_back();
+    }
+    return wait;
+}
+
+void StarvationTracker::clear() {
+    heap.clear();
+    position.clear();
+    worstId = -1;
+    worstWait = 0;
+}
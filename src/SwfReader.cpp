@@ -0,0 +1,83 @@
+#include "SwfReader.h"
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * @file SwfReader.cpp
+ * @brief Implementation of the streaming SWF reader
+ */
+
+SwfReader::SwfReader(std::istream& in)
+    : in(in), lineNumber(0), malformedLines(0), maxProcs(0) {
+}
+
+void SwfReader::parseHeader(const std::string& comment) {
+    // "; MaxProcs: 128" wins over "; MaxNodes: 64"
+    const char* keys[] = {"MaxProcs:", "MaxNodes:"};
+    for (const char* key : keys) {
+        size_t at = comment.find(key);
+        if (at == std::string::npos) {
+            continue;
+        }
+        int value = std::atoi(comment.c_str() + at + std::strlen(key));
+        if (value > 0 && (maxProcs == 0 || key == keys[0])) {
+            maxProcs = value;
+        }
+        return;
+    }
+}
+
+bool SwfReader::next(SwfJob& job) {
+    while (std::getline(in, line)) {
+        lineNumber++;
+        const char* p = line.c_str();
+        while (*p == ' ' || *p == '\t') {
+            p++;
+        }
+        if (*p == ';') {
+            parseHeader(line);
+            continue;
+        }
+        if (*p == '\0' || *p == '\r') {
+            continue;
+        }
+
+        // strtod accepts every field; the integral ones are truncated below
+        double fields[FIELDS];
+        int parsed = 0;
+        while (parsed < FIELDS) {
+            char* end;
+            fields[parsed] = std::strtod(p, &end);
+            if (end == p) {
+                break;
+            }
+            p = end;
+            parsed++;
+        }
+        if (parsed < FIELDS) {
+            malformedLines++;
+            continue;
+        }
+
+        job.jobNumber = static_cast<int64_t>(fields[0]);
+        job.submitTime = static_cast<int64_t>(fields[1]);
+        job.waitTime = static_cast<int64_t>(fields[2]);
+        job.runTime = static_cast<int64_t>(fields[3]);
+        job.allocatedProcessors = static_cast<int>(fields[4]);
+        job.averageCpuTime = fields[5];
+        job.usedMemory = static_cast<int64_t>(fields[6]);
+        job.requestedProcessors = static_cast<int>(fields[7]);
+        job.requestedTime = static_cast<int64_t>(fields[8]);
+        job.requestedMemory = static_cast<int64_t>(fields[9]);
+        job.status = static_cast<int>(fields[10]);
+        job.userId = static_cast<int>(fields[11]);
+        job.groupId = static_cast<int>(fields[12]);
+        job.executable = static_cast<int>(fields[13]);
+        job.queue = static_cast<int>(fields[14]);
+        job.partition = static_cast<int>(fields[15]);
+        job.precedingJob = static_cast<int64_t>(fields[16]);
+        job.thinkTime = static_cast<int64_t>(fields[17]);
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,271 @@
+#include "TimerWheel.h"
+#include <algorithm>
+
+/**
+ * @file TimerWheel.cpp
+ * @brief Implementation of the hierarchical timing wheel
+ */
+
+/**
+ * @brief Index of the lowest set bit (word must be non-zero)
+ */
+static int lowestSetBit(uint64_t word) {
+    return __builtin_ctzll(word);
+}
+
+TimerWheel::TimerWheel(int64_t startTime) {
+    clear(startTime);
+}
+
+void TimerWheel::clear(int64_t startTime) {
+    now = startTime;
+    entries.clear();
+    freeEntries.clear();
+    for (int level = 0; level < LEVELS; level++) {
+        for (int slot = 0; slot < SLOTS; slot++) {
+            slots[level][slot].clear();
+        }
+        occupied[level] = 0;
+    }
+    due.clear();
+    dueHead = 0;
+    overflow.clear();
+    nextSequence = 0;
+    activeCount = 0;
+    nextExpiryValid = false;
+}
+
+bool TimerWheel::expiresAfter(uint32_t a, uint32_t b) const {
+    const Entry& x = entries[a];
+    const Entry& y = entries[b];
+    if (x.expiry != y.expiry) {
+        return x.expiry > y.expiry;
+    }
+    return x.sequence > y.sequence;
+}
+
+void TimerWheel::place(uint32_t index) {
+    Entry& entry = entries[index];
+
+    if (entry.expiry <= now) {
+        entry.expiry = now;
+        due.push_back(index);
+        return;
+    }
+
+    // Lowest level whose window (all higher bits equal) contains the expiry
+    uint64_t differing = static_cast<uint64_t>(entry.expiry ^ now);
+    for (int level = 0; level < LEVELS; level++) {
+        if ((differing >> (SLOT_BITS * (level + 1))) == 0) {
+            int slot = static_cast<int>((entry.expiry >> (SLOT_BITS * level)) & (SLOTS - 1));
+            slots[level][slot].push_back(index);
+            occupied[level] |= 1ULL << slot;
+            return;
+        }
+    }
+
+    overflow.push_back(index);
+    std::push_heap(overflow.begin(), overflow.end(),
+                   [this](uint32_t a, uint32_t b) { return expiresAfter(a, b); });
+}
+
+void TimerWheel::release(uint32_t index) {
+    entries[index].active = false;
+    entries[index].generation++;
+    freeEntries.push_back(index);
+}
+
+bool TimerWheel::cascade(int64_t limit) {
+    for (int level = 0; level < LEVELS; level++) {
+        if (occupied[level] == 0) {
+            continue;
+        }
+
+        int slot = lowestSetBit(occupied[level]);
+        int64_t blockMask = ~((int64_t(1) << (SLOT_BITS * (level + 1))) - 1);
+        int64_t slotStart = (now & blockMask) | (int64_t(slot) << (SLOT_BITS * level));
+        if (slotStart > limit) {
+            return false;
+        }
+
+        std::vector<uint32_t> taken;
+        taken.swap(slots[level][slot]);
+        occupied[level] &= ~(1ULL << slot);
+        now = std::max(now, slotStart);
+
+        if (level == 0) {
+            // Every entry here expires exactly at slotStart; fire in scheduling order
+            due.clear();
+            dueHead = 0;
+            for (uint32_t index : taken) {
+                if (entries[index].active) {
+                    due.push_back(index);
+                } else {
+                    freeEntries.push_back(index);
+                }
+            }
+            std::sort(due.begin(), due.end(), [this](uint32_t a, uint32_t b) {
+                return entries[a].sequence < entries[b].sequence;
+            });
+        } else {
+            // Redistribute into the lower levels now that 'now' is inside this slot
+            for (uint32_t index : taken) {
+                if (entries[index].active) {
+                    place(index);
+                } else {
+                    freeEntries.push_back(index);
+                }
+            }
+        }
+        return true;
+    }
+
+    // Wheel empty: pull the next top-level block out of the overflow heap
+    auto order = [this](uint32_t a, uint32_t b) { return expiresAfter(a, b); };
+    while (!overflow.empty() && !entries[overflow.front()].active) {
+        freeEntries.push_back(overflow.front());
+        std::pop_heap(overflow.begin(), overflow.end(), order);
+        overflow.pop_back();
+    }
+    if (overflow.empty() || entries[overflow.front()].expiry > limit) {
+        return false;
+    }
+
+    int64_t topMask = ~((int64_t(1) << (SLOT_BITS * LEVELS)) - 1);
+    now = std::max(now, entries[overflow.front()].expiry & topMask);
+    while (!overflow.empty() &&
+           (entries[overflow.front()].expiry & topMask) == (now & topMask)) {
+        uint32_t index = overflow.front();
+        std::pop_heap(overflow.begin(), overflow.end(), order);
+        overflow.pop_back();
+        if (entries[index].active) {
+            place(index);
+        } else {
+            freeEntries.push_back(index);
+        }
+    }
+    return true;
+}
+
+uint64_t TimerWheel::schedule(int64_t expiry, uint64_t payload, int64_t period) {
+    uint32_t index;
+    if (!freeEntries.empty()) {
+        index = freeEntries.back();
+        freeEntries.pop_back();
+    } else {
+        index = static_cast<uint32_t>(entries.size());
+        entries.push_back(Entry());
+        entries[index].generation = 0;
+    }
+
+    Entry& entry = entries[index];
+    entry.expiry = expiry;
+    entry.period = period;
+    entry.payload = payload;
+    entry.sequence = nextSequence++;
+    entry.active = true;
+    activeCount++;
+    place(index);
+
+    if (nextExpiryValid) {
+        cachedNextExpiry = std::min(cachedNextExpiry, entry.expiry);
+    }
+    return (static_cast<uint64_t>(entry.generation) << 32) | index;
+}
+
+bool TimerWheel::cancel(uint64_t id) {
+    uint32_t index = static_cast<uint32_t>(id & 0xFFFFFFFFULL);
+    uint32_t generation = static_cast<uint32_t>(id >> 32);
+    if (index >= entries.size() || entries[index].generation != generation ||
+        !entries[index].active) {
+        return false;
+    }
+
+    // Lazy: the slot still references the entry until it is reached, and
+    // only then is it recycled; the new generation invalidates the handle
+    entries[index].active = false;
+    entries[index].generation++;
+    activeCount--;
+    nextExpiryValid = false;
+    return true;
+}
+
+int64_t TimerWheel::nextExpiry() {
+    if (nextExpiryValid) {
+        return cachedNextExpiry;
+    }
+
+    int64_t result = NO_TIMER;
+    for (size_t i = dueHead; i < due.size(); i++) {
+        if (entries[due[i]].active) {
+            result = now;
+            break;
+        }
+    }
+
+    for (int level = 0; level < LEVELS && result == NO_TIMER; level++) {
+        uint64_t pending = occupied[level];
+        while (pending != 0 && result == NO_TIMER) {
+            int slot = lowestSetBit(pending);
+            pending &= pending - 1;
+            for (uint32_t index : slots[level][slot]) {
+                if (entries[index].active) {
+                    result = std::min(result, entries[index].expiry);
+                    if (level == 0) {
+                        break;  // A level-0 slot holds a single expiry time
+                    }
+                }
+            }
+        }
+    }
+
+    if (result == NO_TIMER) {
+        auto order = [this](uint32_t a, uint32_t b) { return expiresAfter(a, b); };
+        while (!overflow.empty() && !entries[overflow.front()].active) {
+            freeEntries.push_back(overflow.front());
+            std::pop_heap(overflow.begin(), overflow.end(), order);
+            overflow.pop_back();
+        }
+        if (!overflow.empty()) {
+            result = entries[overflow.front()].expiry;
+        }
+    }
+
+    cachedNextExpiry = result;
+    nextExpiryValid = true;
+    return result;
+}
+
+bool TimerWheel::popExpired(int64_t time, TimerEvent& event) {
+    while (true) {
+        while (dueHead < due.size()) {
+            uint32_t index = due[dueHead++];
+            Entry& entry = entries[index];
+            if (!entry.active) {
+                freeEntries.push_back(index);
+                continue;
+            }
+
+            event.id = (static_cast<uint64_t>(entry.generation) << 32) | index;
+            event.expiry = entry.expiry;
+            event.payload = entry.payload;
+            nextExpiryValid = false;
+
+            if (entry.period > 0) {
+                entry.expiry += entry.period;
+                entry.sequence = nextSequence++;
+                place(index);
+            } else {
+                activeCount--;
+                release(index);
+            }
+            return true;
+        }
+        due.clear();
+        dueHead = 0;
+
+        if (!cascade(time)) {
+            return false;
+        }
+    }
+}
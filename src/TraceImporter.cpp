@@ -0,0 +1,364 @@
+#include "TraceImporter.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * @file TraceImporter.cpp
+ * @brief Implementation of the Google / Alibaba trace importers
+ */
+
+namespace {
+
+/// Google instance_events event types
+enum GoogleEvent {
+    SUBMIT = 0,
+    SCHEDULE = 3,
+    EVICT = 4,
+    LOST = 8
+};
+
+/// Upper bound on fields per line; longer lines are malformed
+const int MAX_FIELDS = 32;
+
+/**
+ * @struct Field
+ * @brief One CSV field, quotes stripped
+ */
+struct Field {
+    const char* begin;
+    const char* end;
+};
+
+/**
+ * @brief Split a line at commas outside double quotes
+ *
+ * @return int Number of fields, or -1 if there are more than MAX_FIELDS
+ */
+int splitFields(const char* begin, const char* end, Field* fields) {
+    int count = 0;
+    const char* start = begin;
+    bool quoted = false;
+    for (const char* p = begin; p <= end; p++) {
+        if (p < end && *p == '"') {
+            quoted = !quoted;
+        } else if (p == end || (*p == ',' && !quoted)) {
+            if (count == MAX_FIELDS) {
+                return -1;
+            }
+            const char* b = start;
+            const char* e = p;
+            if (e > b && e[-1] == '\r') {
+                e--;
+            }
+            if (e - b >= 2 && *b == '"' && e[-1] == '"') {
+                b++;
+                e--;
+            }
+            fields[count++] = Field{b, e};
+            start = p + 1;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Parse an integer field; empty or non-numeric fields give @p missing
+ */
+int64_t toInt(const Field& field, int64_t missing) {
+    if (field.begin == field.end) {
+        return missing;
+    }
+    char* stop;
+    long long value = std::strtoll(field.begin, &stop, 10);
+    return stop == field.begin ? missing : static_cast<int64_t>(value);
+}
+
+/**
+ * @brief Parse a floating-point field; empty or non-numeric fields give @p missing
+ */
+double toDouble(const Field& field, double missing) {
+    if (field.begin == field.end) {
+        return missing;
+    }
+    char* stop;
+    double value = std::strtod(field.begin, &stop);
+    return stop == field.begin ? missing : value;
+}
+
+/**
+ * @brief First run of digits in an identifier ("j_1234" -> 1234, "M1" -> 1)
+ */
+int64_t idNumber(const Field& field) {
+    const char* p = field.begin;
+    while (p < field.end && (*p < '0' || *p > '9')) {
+        p++;
+    }
+    if (p == field.end) {
+        return -1;
+    }
+    int64_t value = 0;
+    for (; p < field.end && *p >= '0' && *p <= '9'; p++) {
+        value = value * 10 + (*p - '0');
+    }
+    return value;
+}
+
+} // namespace
+
+TraceImporter::TraceImporter(std::istream& in, TraceFormat format, const TraceFilter& filter,
+                             int numThreads)
+    : in(in), format(format), filter(filter),
+      numThreads(workerThreads(numThreads, SIZE_MAX)),
+      columns{-1, -1, -1, -1, -1, -1, -1, -1}, headerRead(false), exhausted(false),
+      rows(0), malformed(0), filtered(0) {
+}
+
+bool TraceImporter::parseFormat(const std::string& name, TraceFormat& format) {
+    if (name == "google") {
+        format = TraceFormat::GOOGLE_2019;
+    } else if (name == "alibaba") {
+        format = TraceFormat::ALIBABA_2018;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+uint64_t TraceImporter::taskKey(int64_t jobId, int64_t taskIndex) {
+    return static_cast<uint64_t>(jobId) * 0x9E3779B97F4A7C15ULL ^ static_cast<uint64_t>(taskIndex);
+}
+
+std::shared_ptr<Process> TraceImporter::toProcess(const TraceTask& task, int pid, int64_t origin) {
+    int64_t arrival = std::min<int64_t>(INT_MAX, std::max<int64_t>(0, task.arrival - origin));
+    int64_t burst = std::min<int64_t>(INT_MAX, std::max<int64_t>(1, task.duration));
+    std::string name = "J" + std::to_string(task.jobId) + "." + std::to_string(task.taskIndex);
+    return std::make_shared<Process>(pid, name, static_cast<int>(arrival), static_cast<int>(burst),
+                                     task.priority);
+}
+
+bool TraceImporter::readGoogleHeader() {
+    std::string line;
+    if (!std::getline(in, line)) {
+        exhausted = true;
+        return true;
+    }
+    Field fields[MAX_FIELDS];
+    int count = splitFields(line.data(), line.data() + line.size(), fields);
+    for (int i = 0; i < count; i++) {
+        std::string name(fields[i].begin, fields[i].end);
+        if (name == "time") {
+            columns.time = i;
+        } else if (name == "type") {
+            columns.type = i;
+        } else if (name == "collection_id") {
+            columns.collection = i;
+        } else if (name == "instance_index") {
+            columns.instance = i;
+        } else if (name == "machine_id") {
+            columns.machine = i;
+        } else if (name == "priority") {
+            columns.priority = i;
+        } else if (name == "scheduling_class") {
+            columns.schedulingClass = i;
+        } else if (name == "resource_request.cpus" || name == "resource_request_cpus" ||
+                   name == "cpus") {
+            columns.cpus = i;
+        }
+    }
+    if (columns.time < 0 || columns.type < 0 || columns.collection < 0 || columns.instance < 0) {
+        error = "Google trace needs a header with time, type, collection_id and instance_index";
+        return false;
+    }
+    return true;
+}
+
+int TraceImporter::parseLine(const char* begin, const char* end, Row& row) const {
+    Field fields[MAX_FIELDS];
+    int count = splitFields(begin, end, fields);
+    bool hasMachineFilter = !filter.machines.empty();
+
+    if (format == TraceFormat::GOOGLE_2019) {
+        int needed = std::max({columns.time, columns.type, columns.collection, columns.instance,
+                               columns.machine, columns.priority, columns.schedulingClass,
+                               columns.cpus});
+        if (count <= needed) {
+            return -1;
+        }
+        int64_t time = toInt(fields[columns.time], -1);
+        int64_t type = toInt(fields[columns.type], -1);
+        if (time < 0 || type < 0) {
+            return -1;
+        }
+        if (type != SUBMIT && type != SCHEDULE && (type < EVICT || type > LOST)) {
+            return 2;   // QUEUE, ENABLE and UPDATE events carry nothing we use
+        }
+        row.time = time / 1000000;
+        row.end = -1;
+        row.type = static_cast<int>(type);
+        if (type == SUBMIT &&
+            (row.time < filter.windowStart || (filter.windowEnd >= 0 && row.time >= filter.windowEnd))) {
+            return 0;
+        }
+        row.jobId = toInt(fields[columns.collection], -1);
+        row.taskIndex = toInt(fields[columns.instance], -1);
+        row.machineId = columns.machine >= 0 ? toInt(fields[columns.machine], -1) : -1;
+        row.cpu = columns.cpus >= 0 ? toDouble(fields[columns.cpus], 0.0) : 0.0;
+        row.priority = columns.priority >= 0 ? static_cast<int>(toInt(fields[columns.priority], 0)) : 0;
+        row.schedulingClass = columns.schedulingClass >= 0
+                                  ? static_cast<int>(toInt(fields[columns.schedulingClass], 0)) : 0;
+        return 1;
+    }
+
+    // Alibaba batch_task (9 columns) or batch_instance (14 columns)
+    if (count != 9 && count != 14) {
+        return -1;
+    }
+    bool instance = count == 14;
+    row.time = toInt(fields[5], -1);
+    row.end = toInt(fields[6], -1);
+    if (row.time <= 0 || row.end < row.time) {
+        return -1;      // never started, or still running at trace end
+    }
+    if (row.time < filter.windowStart || (filter.windowEnd >= 0 && row.time >= filter.windowEnd)) {
+        return 0;
+    }
+    row.type = -1;
+    row.jobId = idNumber(fields[2]);
+    row.taskIndex = idNumber(fields[0]);
+    row.machineId = instance ? idNumber(fields[7]) : -1;
+    if (hasMachineFilter && instance && filter.machines.count(row.machineId) == 0) {
+        return 0;
+    }
+    row.cpu = toDouble(fields[instance ? 10 : 7], 0.0) / 100.0;
+    row.priority = 0;
+    row.schedulingClass = static_cast<int>(idNumber(fields[3]));
+    return 1;
+}
+
+void TraceImporter::parseSegment(const char* begin, const char* end, std::vector<Row>& out,
+                                 size_t& lines, size_t& badLines, size_t& droppedLines) const {
+    const char* line = begin;
+    while (line < end) {
+        const char* stop = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (stop == nullptr) {
+            stop = end;
+        }
+        if (stop > line && !(stop - line == 1 && *line == '\r')) {
+            Row row;
+            lines++;
+            int result = parseLine(line, stop, row);
+            if (result == 1) {
+                out.push_back(row);
+            } else if (result == 0) {
+                droppedLines++;
+            } else if (result < 0) {
+                badLines++;
+            }
+        }
+        line = stop + 1;
+    }
+}
+
+void TraceImporter::consume(const std::vector<Row>& rowsIn) {
+    for (const Row& row : rowsIn) {
+        if (format == TraceFormat::ALIBABA_2018) {
+            ready.push_back(TraceTask{row.jobId, row.taskIndex, row.time,
+                                      std::max<int64_t>(1, row.end - row.time), row.cpu,
+                                      row.priority, row.schedulingClass, row.machineId});
+            continue;
+        }
+
+        uint64_t key = taskKey(row.jobId, row.taskIndex);
+        if (row.type == SUBMIT) {
+            open[key] = OpenTask{row.time, -1, -1, row.cpu, row.priority, row.schedulingClass};
+            continue;
+        }
+        auto it = open.find(key);
+        if (it == open.end()) {
+            continue;   // submitted outside the window, or already dropped
+        }
+        OpenTask& task = it->second;
+        if (row.type == SCHEDULE) {
+            if (!filter.machines.empty() && filter.machines.count(row.machineId) == 0) {
+                filtered++;
+                open.erase(it);
+            } else {
+                task.scheduled = row.time;
+                task.machineId = row.machineId;
+            }
+            continue;
+        }
+        // Terminal event: only tasks that actually ran become TraceTasks
+        if (task.scheduled >= 0) {
+            ready.push_back(TraceTask{row.jobId, row.taskIndex, task.submit,
+                                      std::max<int64_t>(1, row.time - task.scheduled), task.cpu,
+                                      task.priority, task.schedulingClass, task.machineId});
+        }
+        open.erase(it);
+    }
+}
+
+void TraceImporter::fill() {
+    if (format == TraceFormat::GOOGLE_2019 && !headerRead) {
+        headerRead = true;
+        if (!readGoogleHeader() || exhausted) {
+            return;
+        }
+    }
+
+    std::string buffer;
+    buffer.swap(carry);
+    size_t kept = buffer.size();
+    buffer.resize(kept + static_cast<size_t>(numThreads) * BLOCK_BYTES);
+    in.read(&buffer[kept], static_cast<std::streamsize>(buffer.size() - kept));
+    buffer.resize(kept + static_cast<size_t>(in.gcount()));
+    if (!in) {
+        exhausted = true;
+    } else {
+        // Hold back the partial last line for the next block
+        size_t last = buffer.rfind('\n');
+        size_t cut = last == std::string::npos ? 0 : last + 1;
+        carry.assign(buffer, cut, std::string::npos);
+        buffer.resize(cut);
+    }
+
+    // One segment of whole lines per thread
+    std::vector<const char*> bounds(1, buffer.data());
+    const char* end = buffer.data() + buffer.size();
+    size_t target = buffer.size() / static_cast<size_t>(numThreads) + 1;
+    while (bounds.back() < end) {
+        const char* cut = std::min(end, bounds.back() + target);
+        const char* newline = static_cast<const char*>(std::memchr(cut, '\n', end - cut));
+        bounds.push_back(newline == nullptr ? end : newline + 1);
+    }
+    size_t segments = bounds.size() - 1;
+
+    std::vector<std::vector<Row>> parsed(segments);
+    std::vector<size_t> lines(segments, 0), bad(segments, 0), dropped(segments, 0);
+    parallelFor(segments, static_cast<int>(segments), [&](size_t s) {
+        parseSegment(bounds[s], bounds[s + 1], parsed[s], lines[s], bad[s], dropped[s]);
+    });
+
+    for (size_t s = 0; s < segments; s++) {
+        rows += lines[s];
+        malformed += bad[s];
+        filtered += dropped[s];
+        consume(parsed[s]);
+    }
+}
+
+bool TraceImporter::next(TraceTask& task) {
+    while (ready.empty() && !exhausted && error.empty()) {
+        fill();
+    }
+    if (ready.empty()) {
+        return false;
+    }
+    task = ready.front();
+    ready.pop_front();
+    return true;
+}
@@ -0,0 +1,193 @@
+#include "Workflow.h"
+#include "Scheduler.h"
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <string>
+
+/**
+ * @file Workflow.cpp
+ * @brief Implementation of the task DAG
+ */
+
+namespace {
+
+/**
+ * @brief splitmix64, for reproducible generated workflows
+ */
+uint64_t nextRandom(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Uniform cost in [minCost, maxCost]
+ */
+int64_t drawCost(uint64_t& state, int64_t minCost, int64_t maxCost) {
+    if (maxCost <= minCost) {
+        return minCost;
+    }
+    uint64_t span = static_cast<uint64_t>(maxCost - minCost) + 1;
+    return minCost + static_cast<int64_t>(nextRandom(state) % span);
+}
+
+} // namespace
+
+Workflow::Workflow() : finalized(false), acyclic(false) {
+}
+
+void Workflow::reopen() {
+    if (!finalized) {
+        return;
+    }
+    // Fold the built lists back into the edge list so edges accumulate
+    for (size_t task = 0; task + 1 < successorStart.size(); task++) {
+        for (size_t k = successorStart[task]; k < successorStart[task + 1]; k++) {
+            edgeFrom.push_back(static_cast<int>(task));
+            edgeTo.push_back(successors[k]);
+        }
+    }
+    successors.clear();
+    successorStart.clear();
+    finalized = false;
+}
+
+int Workflow::addTask(int64_t cost) {
+    reopen();
+    costs.push_back(std::max<int64_t>(0, cost));
+    return static_cast<int>(costs.size() - 1);
+}
+
+bool Workflow::addEdge(int from, int to) {
+    int tasks = static_cast<int>(costs.size());
+    if (from < 0 || to < 0 || from >= tasks || to >= tasks || from == to) {
+        return false;
+    }
+    reopen();
+    edgeFrom.push_back(from);
+    edgeTo.push_back(to);
+    return true;
+}
+
+bool Workflow::finalize() {
+    if (finalized) {
+        return acyclic;
+    }
+    const size_t tasks = costs.size();
+
+    // Counting pass, then fill
+    successorStart.assign(tasks + 1, 0);
+    predecessorCounts.assign(tasks, 0);
+    for (size_t e = 0; e < edgeFrom.size(); e++) {
+        successorStart[static_cast<size_t>(edgeFrom[e]) + 1]++;
+        predecessorCounts[static_cast<size_t>(edgeTo[e])]++;
+    }
+    for (size_t task = 0; task < tasks; task++) {
+        successorStart[task + 1] += successorStart[task];
+    }
+    successors.resize(edgeFrom.size());
+    std::vector<size_t> cursor(successorStart.begin(), successorStart.end() - 1);
+    for (size_t e = 0; e < edgeFrom.size(); e++) {
+        successors[cursor[static_cast<size_t>(edgeFrom[e])]++] = edgeTo[e];
+    }
+    std::vector<int>().swap(edgeFrom);
+    std::vector<int>().swap(edgeTo);
+    std::vector<size_t>().swap(cursor);
+
+    // Kahn's algorithm, with the order vector as the queue
+    std::vector<int> unmet(predecessorCounts);
+    order.clear();
+    order.reserve(tasks);
+    for (size_t task = 0; task < tasks; task++) {
+        if (unmet[task] == 0) {
+            order.push_back(static_cast<int>(task));
+        }
+    }
+    for (size_t head = 0; head < order.size(); head++) {
+        size_t task = static_cast<size_t>(order[head]);
+        for (size_t k = successorStart[task]; k < successorStart[task + 1]; k++) {
+            if (--unmet[static_cast<size_t>(successors[k])] == 0) {
+                order.push_back(successors[k]);
+            }
+        }
+    }
+
+    finalized = true;
+    acyclic = order.size() == tasks;
+    return acyclic;
+}
+
+void Workflow::addToScheduler(Scheduler& scheduler, int firstPid) const {
+    for (size_t task = 0; task < costs.size(); task++) {
+        int burst = static_cast<int>(std::min<int64_t>(costs[task], INT_MAX));
+        scheduler.addProcess(std::make_shared<Process>(firstPid + static_cast<int>(task),
+                                                       "T" + std::to_string(task), 0, burst));
+    }
+    for (size_t task = 0; task < costs.size() && finalized; task++) {
+        for (size_t k = successorStart[task]; k < successorStart[task + 1]; k++) {
+            scheduler.addDependency(firstPid + static_cast<int>(task), firstPid + successors[k]);
+        }
+    }
+    for (size_t e = 0; e < edgeFrom.size(); e++) {
+        scheduler.addDependency(firstPid + edgeFrom[e], firstPid + edgeTo[e]);
+    }
+}
+
+Workflow Workflow::forkJoin(int stages, int width, int64_t minCost, int64_t maxCost,
+                            uint64_t seed) {
+    Workflow workflow;
+    stages = std::max(1, stages);
+    width = std::max(1, width);
+    uint64_t random = seed;
+    int fork = workflow.addTask(drawCost(random, minCost, maxCost));
+    for (int stage = 0; stage < stages; stage++) {
+        int firstBranch = static_cast<int>(workflow.size());
+        for (int b = 0; b < width; b++) {
+            workflow.addEdge(fork, workflow.addTask(drawCost(random, minCost, maxCost)));
+        }
+        int join = workflow.addTask(drawCost(random, minCost, maxCost));
+        for (int b = 0; b < width; b++) {
+            workflow.addEdge(firstBranch + b, join);
+        }
+        fork = join;
+    }
+    workflow.finalize();
+    return workflow;
+}
+
+Workflow Workflow::layered(int tasks, int width, int maxFanIn, int64_t minCost,
+                           int64_t maxCost, uint64_t seed) {
+    Workflow workflow;
+    tasks = std::max(1, tasks);
+    width = std::max(1, width);
+    maxFanIn = std::max(1, maxFanIn);
+    uint64_t random = seed;
+    workflow.costs.reserve(static_cast<size_t>(tasks));
+    for (int task = 0; task < tasks; task++) {
+        workflow.addTask(drawCost(random, minCost, maxCost));
+    }
+    workflow.edgeFrom.reserve(static_cast<size_t>(tasks) * static_cast<size_t>(maxFanIn + 1) / 2);
+    workflow.edgeTo.reserve(workflow.edgeFrom.capacity());
+
+    std::vector<int> picked;
+    for (int task = width; task < tasks; task++) {
+        int layerStart = task / width * width;
+        int previous = layerStart - width;
+        int fanIn = 1 + static_cast<int>(nextRandom(random) % static_cast<uint64_t>(maxFanIn));
+        fanIn = std::min(fanIn, width);
+
+        // Distinct predecessors; fan-in is small, so a linear check is enough
+        picked.clear();
+        while (static_cast<int>(picked.size()) < fanIn) {
+            int from = previous + static_cast<int>(nextRandom(random) % static_cast<uint64_t>(width));
+            if (std::find(picked.begin(), picked.end(), from) == picked.end()) {
+                picked.push_back(from);
+                workflow.addEdge(from, task);
+            }
+        }
+    }
+    workflow.finalize();
+    return workflow;
+}
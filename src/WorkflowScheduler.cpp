@@ -0,0 +1,258 @@
+#include "WorkflowScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+
+/**
+ * @file WorkflowScheduler.cpp
+ * @brief Implementation of the workflow list scheduler
+ */
+
+namespace {
+
+/**
+ * @struct SpeedClass
+ * @brief CPUs of one speed; 'cpus' is a min-heap of (free at, CPU)
+ */
+struct SpeedClass {
+    double speed;
+    std::priority_queue<std::pair<int64_t, int>, std::vector<std::pair<int64_t, int>>,
+                        std::greater<std::pair<int64_t, int>>> cpus;
+};
+
+/**
+ * @brief Group CPUs by speed, fastest class first
+ */
+std::vector<SpeedClass> speedClasses(const std::vector<double>& speeds, std::vector<int>& classOf) {
+    std::vector<double> distinct(speeds);
+    std::sort(distinct.begin(), distinct.end(), std::greater<double>());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+
+    std::vector<SpeedClass> classes(distinct.size());
+    classOf.assign(speeds.size(), 0);
+    for (size_t k = 0; k < distinct.size(); k++) {
+        classes[k].speed = distinct[k];
+    }
+    for (size_t c = 0; c < speeds.size(); c++) {
+        size_t k = static_cast<size_t>(std::find(distinct.begin(), distinct.end(), speeds[c]) - distinct.begin());
+        classOf[c] = static_cast<int>(k);
+        classes[k].cpus.emplace(0, static_cast<int>(c));
+    }
+    return classes;
+}
+
+} // namespace
+
+WorkflowScheduler::WorkflowScheduler(int cpuCount, WorkflowPolicy policy)
+    : speeds(static_cast<size_t>(std::max(1, cpuCount)), 1.0), policy(policy) {
+}
+
+WorkflowScheduler::WorkflowScheduler(const std::vector<double>& speeds, WorkflowPolicy policy)
+    : speeds(speeds), policy(policy) {
+    if (this->speeds.empty()) {
+        this->speeds.push_back(1.0);
+    }
+    for (double& speed : this->speeds) {
+        speed = speed > 0.0 ? speed : 1.0;
+    }
+}
+
+std::string WorkflowScheduler::policyName(WorkflowPolicy policy) {
+    switch (policy) {
+        case WorkflowPolicy::FIFO:
+            return "FIFO";
+        case WorkflowPolicy::LONGEST_PATH:
+            return "Longest Path First";
+        case WorkflowPolicy::HEFT:
+            return "HEFT";
+    }
+    return "Unknown";
+}
+
+int64_t WorkflowScheduler::duration(int64_t cost, double speed) {
+    return speed == 1.0 ? cost : static_cast<int64_t>(std::ceil(static_cast<double>(cost) / speed));
+}
+
+WorkflowMetrics WorkflowScheduler::run(const Workflow& workflow) {
+    WorkflowMetrics metrics = WorkflowMetrics();
+    startTimes.clear();
+    finishTimes.clear();
+    cpus.clear();
+    if (!workflow.isAcyclic()) {
+        return metrics;
+    }
+
+    const size_t tasks = workflow.size();
+    const std::vector<int>& order = workflow.getTopologicalOrder();
+    const std::vector<size_t>& start = workflow.getSuccessorStart();
+    const std::vector<int>& successors = workflow.getSuccessors();
+    const double fastest = *std::max_element(speeds.begin(), speeds.end());
+
+    // Bottom levels (reverse topological order), then top levels for slack
+    std::vector<int64_t> bottom(tasks, 0);
+    for (size_t i = tasks; i-- > 0;) {
+        size_t task = static_cast<size_t>(order[i]);
+        int64_t longest = 0;
+        for (size_t k = start[task]; k < start[task + 1]; k++) {
+            longest = std::max(longest, bottom[static_cast<size_t>(successors[k])]);
+        }
+        bottom[task] = duration(workflow.getCost(static_cast<int>(task)), fastest) + longest;
+    }
+    {
+        std::vector<int64_t> top(tasks, 0);
+        for (size_t i = 0; i < tasks; i++) {
+            size_t task = static_cast<size_t>(order[i]);
+            metrics.criticalPath = std::max(metrics.criticalPath, top[task] + bottom[task]);
+            int64_t end = top[task] + duration(workflow.getCost(static_cast<int>(task)), fastest);
+            for (size_t k = start[task]; k < start[task + 1]; k++) {
+                int64_t& next = top[static_cast<size_t>(successors[k])];
+                next = std::max(next, end);
+            }
+        }
+        double slackSum = 0.0;
+        for (size_t task = 0; task < tasks; task++) {
+            int64_t taskSlack = metrics.criticalPath - top[task] - bottom[task];
+            metrics.criticalTasks += taskSlack == 0 ? 1 : 0;
+            slackSum += static_cast<double>(taskSlack);
+        }
+        metrics.averageTaskSlack = tasks > 0 ? slackSum / static_cast<double>(tasks) : 0.0;
+    }
+
+    // startTimes holds each task's ready time until it starts
+    startTimes.assign(tasks, 0);
+    finishTimes.assign(tasks, 0);
+    cpus.assign(tasks, -1);
+    double waitSum = 0.0;
+    if (policy == WorkflowPolicy::HEFT) {
+        runHeft(workflow, bottom, waitSum);
+    } else {
+        runDynamic(workflow, bottom, waitSum);
+    }
+
+    double busy = 0.0;
+    for (size_t task = 0; task < tasks; task++) {
+        metrics.makespan = std::max(metrics.makespan, finishTimes[task]);
+        busy += static_cast<double>(finishTimes[task] - startTimes[task]);
+    }
+    metrics.tasks = tasks;
+    metrics.slack = metrics.makespan - metrics.criticalPath;
+    metrics.averageWait = tasks > 0 ? waitSum / static_cast<double>(tasks) : 0.0;
+    metrics.utilization = metrics.makespan > 0
+        ? 100.0 * busy / (static_cast<double>(speeds.size()) * static_cast<double>(metrics.makespan))
+        : 0.0;
+    return metrics;
+}
+
+void WorkflowScheduler::runDynamic(const Workflow& workflow, const std::vector<int64_t>& bottom,
+                                   double& waitSum) {
+    const std::vector<size_t>& start = workflow.getSuccessorStart();
+    const std::vector<int>& successors = workflow.getSuccessors();
+    std::vector<int> unmet(workflow.getPredecessorCounts());
+    std::vector<int> classOf;
+    std::vector<SpeedClass> classes = speedClasses(speeds, classOf);
+
+    // Ready heap: smallest (key, task) first; the key is the ready time
+    // (FIFO) or the negated bottom level (LONGEST_PATH)
+    typedef std::pair<int64_t, int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> ready;
+    auto release = [&](int task, int64_t now) {
+        startTimes[static_cast<size_t>(task)] = now;
+        ready.emplace(policy == WorkflowPolicy::FIFO ? now : -bottom[static_cast<size_t>(task)], task);
+    };
+    for (size_t task = 0; task < unmet.size(); task++) {
+        if (unmet[task] == 0) {
+            release(static_cast<int>(task), 0);
+        }
+    }
+
+    // Completions: smallest (finish, CPU) first
+    typedef std::pair<int64_t, int> Completion;
+    std::priority_queue<Completion, std::vector<Completion>, std::greater<Completion>> running;
+    std::vector<int> runningTask(speeds.size(), -1);
+    int64_t now = 0;
+    while (true) {
+        // Idle CPUs take ready tasks, fastest class first
+        size_t k = 0;
+        while (!ready.empty() && k < classes.size()) {
+            if (classes[k].cpus.empty()) {
+                k++;
+                continue;
+            }
+            int cpu = classes[k].cpus.top().second;
+            classes[k].cpus.pop();
+            size_t task = static_cast<size_t>(ready.top().second);
+            ready.pop();
+            waitSum += static_cast<double>(now - startTimes[task]);
+            startTimes[task] = now;
+            finishTimes[task] = now + duration(workflow.getCost(static_cast<int>(task)), classes[k].speed);
+            cpus[task] = cpu;
+            runningTask[static_cast<size_t>(cpu)] = static_cast<int>(task);
+            running.emplace(finishTimes[task], cpu);
+        }
+        if (running.empty()) {
+            break;
+        }
+
+        // Every completion at the next event time, before anyone is dispatched
+        now = running.top().first;
+        while (!running.empty() && running.top().first == now) {
+            int cpu = running.top().second;
+            running.pop();
+            size_t task = static_cast<size_t>(runningTask[static_cast<size_t>(cpu)]);
+            classes[static_cast<size_t>(classOf[static_cast<size_t>(cpu)])].cpus.emplace(0, cpu);
+            for (size_t e = start[task]; e < start[task + 1]; e++) {
+                if (--unmet[static_cast<size_t>(successors[e])] == 0) {
+                    release(successors[e], now);
+                }
+            }
+        }
+    }
+}
+
+void WorkflowScheduler::runHeft(const Workflow& workflow, const std::vector<int64_t>& bottom,
+                                double& waitSum) {
+    const std::vector<size_t>& start = workflow.getSuccessorStart();
+    const std::vector<int>& successors = workflow.getSuccessors();
+    std::vector<int> classOf;
+    std::vector<SpeedClass> classes = speedClasses(speeds, classOf);
+
+    // Decreasing rank; the stable sort keeps topological order among equal
+    // ranks, so every predecessor is placed before its successors
+    std::vector<int> list(workflow.getTopologicalOrder());
+    std::stable_sort(list.begin(), list.end(), [&bottom](int a, int b) {
+        return bottom[static_cast<size_t>(a)] > bottom[static_cast<size_t>(b)];
+    });
+
+    for (int id : list) {
+        size_t task = static_cast<size_t>(id);
+        int64_t readyAt = startTimes[task];
+        int64_t cost = workflow.getCost(id);
+
+        // Earliest finish: within a class, the CPU free first; ties go to
+        // the faster class
+        size_t best = 0;
+        int64_t bestFinish = INT64_MAX;
+        for (size_t k = 0; k < classes.size(); k++) {
+            int64_t finish = std::max(classes[k].cpus.top().first, readyAt) + duration(cost, classes[k].speed);
+            if (finish < bestFinish) {
+                bestFinish = finish;
+                best = k;
+            }
+        }
+        std::pair<int64_t, int> cpu = classes[best].cpus.top();
+        classes[best].cpus.pop();
+        startTimes[task] = std::max(cpu.first, readyAt);
+        finishTimes[task] = bestFinish;
+        cpus[task] = cpu.second;
+        waitSum += static_cast<double>(startTimes[task] - readyAt);
+        classes[best].cpus.emplace(bestFinish, cpu.second);
+
+        for (size_t e = start[task]; e < start[task + 1]; e++) {
+            int64_t& next = startTimes[static_cast<size_t>(successors[e])];
+            next = std::max(next, bestFinish);
+        }
+    }
+}
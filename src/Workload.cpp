@@ -0,0 +1,75 @@
+#include "Workload.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+/**
+ * @file Workload.cpp
+ * @brief Implementation of seeded workload generation
+ */
+
+WorkloadGenerator::WorkloadGenerator(const WorkloadDistribution& distribution)
+    : distribution(distribution) {
+}
+
+uint64_t WorkloadGenerator::replicaSeed(uint64_t baseSeed, uint64_t index) {
+    // SplitMix64 finalizer over (base + golden-ratio increment * index)
+    uint64_t z = baseSeed + 0x9E3779B97F4A7C15ULL * (index + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+double WorkloadGenerator::uniform01(std::mt19937_64& engine) {
+    // Top 53 bits give every representable double in [0, 1) with equal spacing
+    return static_cast<double>(engine() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+std::vector<std::shared_ptr<Process>> WorkloadGenerator::generate(uint64_t seed) const {
+    std::vector<std::shared_ptr<Process>> processes;
+    processes.reserve(distribution.numProcesses);
+
+    std::mt19937_64 engine(seed);
+    double arrivalClock = 0.0;
+    int priorityRange = std::max(0, distribution.maxPriority - distribution.minPriority) + 1;
+
+    for (int i = 0; i < distribution.numProcesses; i++) {
+        // Exponential interarrival times; the first process starts the clock
+        if (i > 0) {
+            arrivalClock += -distribution.meanInterarrival * std::log(1.0 - uniform01(engine));
+        }
+
+        double burst = distribution.meanBurst;
+        switch (distribution.burstDistribution) {
+            case BurstDistribution::CONSTANT:
+                break;
+            case BurstDistribution::UNIFORM:
+                burst = 1.0 + uniform01(engine) * (2.0 * distribution.meanBurst - 2.0);
+                break;
+            case BurstDistribution::EXPONENTIAL:
+                burst = -distribution.meanBurst * std::log(1.0 - uniform01(engine));
+                break;
+        }
+
+        int priority = distribution.minPriority +
+                       static_cast<int>(uniform01(engine) * priorityRange);
+
+        int pid = i + 1;
+        int burstTime = std::max(1, static_cast<int>(std::lround(burst)));
+        processes.push_back(std::make_shared<Process>(
+            pid, "P" + std::to_string(pid),
+            static_cast<int>(std::lround(arrivalClock)),
+            burstTime, priority));
+
+        // Drawn only when locks are in use, so lock-free replicas are unchanged
+        if (distribution.numLocks > 0 &&
+            uniform01(engine) < distribution.criticalSectionProbability) {
+            int lock = static_cast<int>(uniform01(engine) * distribution.numLocks);
+            int start = static_cast<int>(uniform01(engine) * burstTime);
+            int length = 1 + static_cast<int>(uniform01(engine) * (burstTime - start));
+            processes.back()->addCriticalSection(lock, start, length);
+        }
+    }
+
+    return processes;
+}
@@ -3,9 +3,32 @@
 #include "PriorityScheduler.h"
 #include "MultilevelQueueScheduler.h"
 #include "MultilevelFeedbackQueueScheduler.h"
+#include "O1Scheduler.h"
+#include "SkipListScheduler.h"
+#include "ExtPolicies.h"
+#include "PolicyPlugin.h"
+#include "MonteCarloComparison.h"
+#include "AnalyticEstimator.h"
+#include "BatchSimulator.h"
+#include "ClusterSimulator.h"
+#include "TraceImporter.h"
+#include "WorkflowScheduler.h"
+#include "ClosedLoopSimulator.h"
+#include "RpcServerSimulator.h"
+#include "HypervisorSimulator.h"
+#include "InterruptModel.h"
+#include "MemoryModel.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <cstdlib>
 #include <memory>
+#include <random>
+#include <string>
+#include <utility>
 #include <vector>
 
 /**
@@ -54,6 +77,28 @@ int displayMenu() {
     std::cout << "4. Multilevel Queue\n";
     std::cout << "5. Multilevel Feedback Queue\n";
     std::cout << "6. Compare All Algorithms\n";
+    std::cout << "7. Statistical Comparison (Monte Carlo)\n";
+    std::cout << "8. Analytic Estimate (Queueing Theory)\n";
+    std::cout << "9. O(1) Scheduler (Linux 2.6)\n";
+    std::cout << "10. BFS/MuQSS Virtual Deadline Scheduler\n";
+    std::cout << "11. sched_ext-Style Policy Engine\n";
+    std::cout << "12. Load Policy Plugin\n";
+    std::cout << "13. Batch Backfilling (SWF Log)\n";
+    std::cout << "14. Cluster Simulation (Job Placement)\n";
+    std::cout << "15. Import Cluster Trace (Google/Alibaba)\n";
+    std::cout << "16. Workflow DAG Scheduling (Critical Path)\n";
+    std::cout << "17. Priority Inversion (Lock Protocols)\n";
+    std::cout << "18. Closed-Loop Interactive Users (Response vs Users)\n";
+    std::cout << "19. RPC Server Architectures (Microsecond Tail Latency)\n";
+    std::cout << "20. Virtualized Host (Steal Time, Lock-Holder Preemption)\n";
+    std::cout << "21. Interrupt Load (IRQ/Softirq CPU Stealing)\n";
+    std::cout << "22. CPU Affinity and Hotplug (SMP)\n";
+    std::cout << "23. SMT Interference and Core Scheduling\n";
+    std::cout << "24. Memory Pressure (Swap, Admission Control)\n";
+    std::cout << "25. Fault Injection (Crashes, Retries, CPU Failures)\n";
+    std::cout << "26. Scheduling Latency by Priority (Wakeup to Run)\n";
+    std::cout << "27. Fairness and Aging (Slowdown, Jain's Index, Starvation)\n";
+    std::cout << "28. Top CPU Consumers and Starvation Watchdog (Bounded Memory)\n";
     std::cout << "0. Exit\n";
     std::cout << "\nEnter your choice: ";
     
@@ -155,6 +200,94 @@ void runMLFQ() {
     std::cout << scheduler.getGanttChart();
 }
 
+/**
+ * @brief Run O(1) scheduler
+ */
+void runO1() {
+    auto processes = createTestProcesses();
+    
+    int baseTimeslice;
+    std::cout << "\nEnter base timeslice for nice 0 (recommended: 4): ";
+    std::cin >> baseTimeslice;
+    
+    O1Scheduler scheduler(baseTimeslice, 0);
+    for (const auto& process : processes) {
+        scheduler.addProcess(process);
+    }
+    
+    std::cout << "\nRunning O(1) Scheduler...\n";
+    scheduler.schedule();
+    scheduler.displayResults();
+    std::cout << "Active/expired array switches: " << scheduler.getArraySwitches() << "\n";
+    std::cout << scheduler.getGanttChart();
+}
+
+/**
+ * @brief Run BFS/MuQSS virtual-deadline scheduler
+ */
+void runSkipList() {
+    auto processes = createTestProcesses();
+    
+    int rrInterval, numCpus, perCpu;
+    std::cout << "\nEnter rr_interval (recommended: 6): ";
+    std::cin >> rrInterval;
+    std::cout << "Enter number of CPUs (recommended: 2): ";
+    std::cin >> numCpus;
+    std::cout << "Run queues: 0 = one global list (BFS), 1 = per-CPU lists (MuQSS): ";
+    std::cin >> perCpu;
+    
+    SkipListScheduler scheduler(rrInterval, numCpus,
+                                perCpu ? RunQueueLayout::PER_CPU : RunQueueLayout::GLOBAL, 0);
+    for (const auto& process : processes) {
+        scheduler.addProcess(process);
+    }
+    
+    std::cout << "\nRunning " << scheduler.getName() << "...\n";
+    scheduler.schedule();
+    scheduler.displayResults();
+    std::cout << scheduler.getGanttChart();
+}
+
+/**
+ * @brief Run one sched_ext-style policy and show its results
+ */
+template <typename Policy>
+void runExtPolicy(int numCpus, int tickInterval) {
+    ExtScheduler<Policy> scheduler(numCpus, tickInterval, 0);
+    for (const auto& process : createTestProcesses()) {
+        scheduler.addProcess(process);
+    }
+    
+    std::cout << "\nRunning " << scheduler.getName() << "...\n";
+    scheduler.schedule();
+    scheduler.displayResults();
+    if (!scheduler.getExitReason().empty()) {
+        std::cout << "Policy aborted: " << scheduler.getExitReason() << "\n";
+    }
+    std::cout << scheduler.getGanttChart();
+}
+
+/**
+ * @brief Run a sched_ext-style example policy
+ */
+void runExt() {
+    int policy, numCpus, tickInterval;
+    std::cout << "\nPolicy: 0 = global FIFO, 1 = weighted vtime, 2 = priority bands: ";
+    std::cin >> policy;
+    std::cout << "Enter number of CPUs (recommended: 2): ";
+    std::cin >> numCpus;
+    std::cout << "Enter tick interval, 0 for none (recommended: 1): ";
+    std::cin >> tickInterval;
+    
+    if (policy == 1) {
+        runExtPolicy<ExtVtimePolicy>(numCpus, tickInterval);
+    } else if (policy == 2) {
+        runExtPolicy<ExtPriorityPolicy>(numCpus, tickInterval);
+    } else {
+        runExtPolicy<ExtPolicy>(numCpus, tickInterval);
+    }
+}
+
 /**
  * @brief Compare all scheduling algorithms
  */
@@ -207,6 +340,20 @@ void compareAll() {
     }
     schedulers.push_back(mlfq);
     
+    // 6. O(1) scheduler
+    auto o1 = std::make_shared<O1Scheduler>(4, 0);
+    for (const auto& p : testProcesses) {
+        o1->addProcess(std::make_shared<Process>(*p));
+    }
+    schedulers.push_back(o1);
+    
+    // 7. BFS (single CPU, so it is comparable with the others)
+    auto bfs = std::make_shared<SkipListScheduler>(6, 1, RunQueueLayout::GLOBAL, 0);
+    for (const auto& p : testProcesses) {
+        bfs->addProcess(std::make_shared<Process>(*p));
+    }
+    schedulers.push_back(bfs);
+    
     // Run all schedulers
     for (auto& scheduler : schedulers) {
         scheduler->schedule();
@@ -240,10 +387,1868 @@ void compareAll() {
     std::cout << std::string(80, '=') << "\n";
 }
 
+/**
+ * @brief Add the built-in policy line-up shared by all statistical comparisons
+ */
+void addStandardPolicies(MonteCarloComparison& comparison) {
+    comparison.addPolicy("Round Robin (Quantum=3)", []() {
+        return std::unique_ptr<Scheduler>(new RoundRobinScheduler(3, 0));
+    });
+    comparison.addPolicy("Non-Preemptive Priority", []() {
+        return std::unique_ptr<Scheduler>(new PriorityScheduler(false, true, 5, 0));
+    });
+    comparison.addPolicy("Preemptive Priority", []() {
+        return std::unique_ptr<Scheduler>(new PriorityScheduler(true, true, 5, 0));
+    });
+    comparison.addPolicy("Multilevel Queue", []() {
+        auto mlq = std::unique_ptr<MultilevelQueueScheduler>(new MultilevelQueueScheduler(0));
+        mlq->addQueueConfig(QueueConfig(0, QueueSchedulingAlgorithm::ROUND_ROBIN, 2));
+        mlq->addQueueConfig(QueueConfig(1, QueueSchedulingAlgorithm::ROUND_ROBIN, 4));
+        mlq->addQueueConfig(QueueConfig(2, QueueSchedulingAlgorithm::FCFS, 0));
+        mlq->addQueueConfig(QueueConfig(3, QueueSchedulingAlgorithm::FCFS, 0));
+        return std::unique_ptr<Scheduler>(std::move(mlq));
+    });
+    comparison.addPolicy("Multilevel Feedback Queue", []() {
+        return std::unique_ptr<Scheduler>(new MultilevelFeedbackQueueScheduler(3, true, 10, 0));
+    });
+    comparison.addPolicy("O(1) Scheduler", []() {
+        return std::unique_ptr<Scheduler>(new O1Scheduler(4, 0));
+    });
+    comparison.addPolicy("BFS Skip List", []() {
+        return std::unique_ptr<Scheduler>(new SkipListScheduler(6, 1, RunQueueLayout::GLOBAL, 0));
+    });
+}
+
+/**
+ * @brief Split "PATH[:ARGS]" into a plugin path and its arguments
+ */
+void splitPluginSpec(const std::string& spec, std::string& path, std::string& args) {
+    size_t slash = spec.rfind('/');
+    size_t colon = spec.find(':', slash == std::string::npos ? 0 : slash);
+    path = spec.substr(0, colon);
+    args = colon == std::string::npos ? "" : spec.substr(colon + 1);
+}
+
+/**
+ * @brief Compare all scheduling algorithms over random workload replicas
+ *
+ * Uses the same policy line-up as compareAll(), but on replicas drawn from a
+ * workload distribution, and reports confidence intervals instead of a
+ * single run.
+ */
+void runStatisticalComparison() {
+    WorkloadDistribution distribution;
+    MonteCarloConfig config;
+
+    std::cout << "\nEnter processes per replica (recommended: 20): ";
+    std::cin >> distribution.numProcesses;
+    std::cout << "Enter maximum number of replicas (recommended: 200): ";
+    std::cin >> config.maxReplicas;
+
+    MonteCarloComparison comparison(distribution, config);
+    addStandardPolicies(comparison);
+
+    std::cout << "\nRunning replicas...\n";
+    comparison.run();
+    comparison.displayResults();
+    
+    // Cross-check the policies that have a closed-form counterpart. The
+    // formulas assume strict priorities, so the priority policies are rerun
+    // without aging on the same replicas (same base seed). The replicas
+    // start empty and are finite, so expect some transient bias.
+    MonteCarloComparison reference(distribution, config);
+    reference.addPolicy("Round Robin (Quantum=3)", []() {
+        return std::unique_ptr<Scheduler>(new RoundRobinScheduler(3, 0));
+    });
+    reference.addPolicy("Non-Preemptive Priority (no aging)", []() {
+        return std::unique_ptr<Scheduler>(new PriorityScheduler(false, false, 5, 0));
+    });
+    reference.addPolicy("Preemptive Priority (no aging)", []() {
+        return std::unique_ptr<Scheduler>(new PriorityScheduler(true, false, 5, 0));
+    });
+    reference.run();
+    
+    QueueingParameters parameters = AnalyticEstimator::fromWorkload(distribution);
+    std::vector<PolicyStatistics> stats = reference.getStatistics();
+    const std::pair<int, QueueDiscipline> counterparts[] = {
+        {0, QueueDiscipline::PROCESSOR_SHARING},
+        {1, QueueDiscipline::NONPREEMPTIVE_PRIORITY},
+        {2, QueueDiscipline::PREEMPTIVE_PRIORITY}
+    };
+    
+    std::cout << "\nAnalytic cross-check (Avg TAT, tolerance 15%):\n";
+    std::cout << std::string(80, '-') << "\n";
+    for (const auto& counterpart : counterparts) {
+        AnalyticPrediction prediction = AnalyticEstimator::predict(parameters, counterpart.second);
+        const IntervalEstimate& simulated =
+            stats[counterpart.first].metrics[static_cast<int>(ComparisonMetric::TURNAROUND_TIME)];
+        AnalyticCheck check = AnalyticEstimator::check(prediction.meanTurnaroundTime, simulated, 0.15);
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << std::left << std::setw(35) << stats[counterpart.first].name
+                  << std::setw(12) << check.predicted
+                  << std::setw(12) << check.simulated
+                  << (check.disagrees ? "DISAGREES with " : "agrees with ")
+                  << prediction.model << "\n";
+    }
+    std::cout << std::string(80, '=') << "\n";
+}
+
+/**
+ * @brief Predict mean times from queueing theory without simulating
+ */
+void runAnalyticEstimate() {
+    WorkloadDistribution distribution;
+    int servers;
+    
+    std::cout << "\nEnter mean interarrival time (recommended: 4): ";
+    std::cin >> distribution.meanInterarrival;
+    std::cout << "Enter mean burst time (recommended: 3): ";
+    std::cin >> distribution.meanBurst;
+    std::cout << "Enter number of CPUs (recommended: 1): ";
+    std::cin >> servers;
+    
+    QueueingParameters parameters = AnalyticEstimator::fromWorkload(distribution, servers);
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "ANALYTIC ESTIMATE (utilization " << std::fixed << std::setprecision(2)
+              << parameters.utilization() * 100.0 << " %)\n";
+    std::cout << std::string(80, '=') << "\n\n";
+    std::cout << std::left << std::setw(26) << "Discipline"
+              << std::setw(12) << "Avg Wait"
+              << std::setw(12) << "Avg TAT"
+              << "Model\n";
+    std::cout << std::string(80, '-') << "\n";
+    
+    const QueueDiscipline disciplines[] = {
+        QueueDiscipline::FCFS,
+        QueueDiscipline::PROCESSOR_SHARING,
+        QueueDiscipline::NONPREEMPTIVE_PRIORITY,
+        QueueDiscipline::PREEMPTIVE_PRIORITY
+    };
+    for (QueueDiscipline discipline : disciplines) {
+        AnalyticPrediction prediction = AnalyticEstimator::predict(parameters, discipline);
+        std::cout << std::left << std::setw(26) << AnalyticEstimator::disciplineName(discipline);
+        if (prediction.stable) {
+            std::cout << std::setw(12) << prediction.meanWaitingTime
+                      << std::setw(12) << prediction.meanTurnaroundTime;
+        } else {
+            std::cout << std::setw(24) << "unstable";
+        }
+        std::cout << prediction.model << (prediction.exact ? "" : " (approx.)") << "\n";
+    }
+    std::cout << std::string(80, '=') << "\n";
+}
+
+/**
+ * @brief Load a policy plugin and run it on the test processes
+ */
+void runPlugin() {
+    std::string spec;
+    std::cout << "\nEnter plugin path[:args] (e.g. bin/srtf_policy.so:2): ";
+    std::cin >> spec;
+    
+    std::string path, args, error;
+    splitPluginSpec(spec, path, args);
+    std::shared_ptr<PolicyPlugin> plugin = PolicyPlugin::load(path, error);
+    if (!plugin) {
+        std::cout << "Cannot load plugin: " << error << "\n";
+        return;
+    }
+    std::unique_ptr<Scheduler> scheduler = plugin->create(args);
+    if (!scheduler) {
+        std::cout << "Plugin " << plugin->getName() << " rejected arguments '" << args << "'\n";
+        return;
+    }
+    
+    for (const auto& process : createTestProcesses()) {
+        scheduler->addProcess(process);
+    }
+    std::cout << "\nRunning " << scheduler->getName() << " from " << plugin->getPath() << "...\n";
+    scheduler->schedule();
+    scheduler->displayResults();
+    std::cout << scheduler->getGanttChart();
+}
+
+/**
+ * @brief Replay an SWF log under FCFS, EASY and conservative backfilling
+ *
+ * The log is streamed once per policy, so its length is not limited by
+ * memory.
+ *
+ * @param path SWF file
+ * @param cores Machine size (0 = the log's MaxProcs header)
+ * @return bool false if the file cannot be read or the machine size is unknown
+ */
+bool replaySwf(const std::string& path, int cores) {
+    const BackfillPolicy policies[] = {
+        BackfillPolicy::FCFS, BackfillPolicy::EASY, BackfillPolicy::CONSERVATIVE
+    };
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "BATCH BACKFILLING: " << path << "\n";
+    std::cout << std::string(80, '=') << "\n";
+    bool header = false;
+    for (BackfillPolicy policy : policies) {
+        std::ifstream in(path);
+        if (!in) {
+            std::cout << "Cannot open " << path << "\n";
+            return false;
+        }
+        SwfReader reader(in);
+        SwfJob record;
+        BatchJob job;
+        std::unique_ptr<BatchSimulator> simulator;
+        while (reader.next(record)) {
+            if (!simulator) {
+                // The header precedes the first job
+                int machine = cores > 0 ? cores : reader.getMaxProcs();
+                if (machine <= 0) {
+                    std::cout << "The log has no MaxProcs header; give the core count\n";
+                    return false;
+                }
+                simulator.reset(new BatchSimulator(machine, policy));
+                if (!header) {
+                    std::cout << machine << " cores\n\n";
+                    std::cout << std::left << std::setw(26) << "Policy"
+                              << std::right << std::setw(9) << "Jobs"
+                              << std::setw(11) << "Backfilled"
+                              << std::setw(11) << "Avg Wait"
+                              << std::setw(10) << "Avg BSLD"
+                              << std::setw(10) << "Max BSLD"
+                              << std::setw(8) << "Util %" << "\n";
+                    std::cout << std::string(85, '-') << "\n";
+                    header = true;
+                }
+            }
+            if (BatchSimulator::fromSwf(record, job)) {
+                simulator->submit(job);
+            }
+        }
+        if (!simulator) {
+            std::cout << "No jobs in " << path << "\n";
+            return false;
+        }
+        
+        BatchMetrics metrics = simulator->finish();
+        std::cout << std::left << std::setw(26) << simulator->getName()
+                  << std::right << std::setw(9) << metrics.jobs
+                  << std::setw(11) << metrics.backfilled
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(11) << metrics.averageWait
+                  << std::setprecision(2)
+                  << std::setw(10) << metrics.averageBoundedSlowdown
+                  << std::setw(10) << metrics.maxBoundedSlowdown
+                  << std::setprecision(1)
+                  << std::setw(8) << metrics.utilization * 100.0 << "\n";
+        if (metrics.rejected > 0) {
+            std::cout << "  (" << metrics.rejected << " jobs wider than the machine skipped)\n";
+        }
+    }
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "BSLD: bounded slowdown, max(1, (wait + run) / max(run, "
+              << BatchSimulator::DEFAULT_SLOWDOWN_THRESHOLD << "))\n";
+    return true;
+}
+
+/**
+ * @brief Ask for an SWF log and replay it
+ */
+void runBackfill() {
+    std::string path;
+    int cores;
+    std::cout << "\nEnter SWF log path: ";
+    std::cin >> path;
+    std::cout << "Enter number of cores (0 = from log header): ";
+    std::cin >> cores;
+    replaySwf(path, cores);
+}
+
+/**
+ * @brief Synthetic cluster job stream
+ *
+ * Each node sees the standard per-node workload (WorkloadDistribution
+ * defaults), so the cluster arrival rate grows with the node count.
+ *
+ * @param config Cluster parameters (numNodes, seed)
+ * @param tasksPerNode Mean processes per node
+ * @return std::vector<std::shared_ptr<Process>> Jobs
+ */
+std::vector<std::shared_ptr<Process>> generateClusterJobs(const ClusterConfig& config, int tasksPerNode) {
+    WorkloadDistribution distribution;
+    distribution.numProcesses = config.numNodes * tasksPerNode;
+    distribution.meanInterarrival /= config.numNodes;
+    return WorkloadGenerator(distribution).generate(config.seed);
+}
+
+/**
+ * @brief Route one job stream over a cluster under every placement policy
+ *
+ * @param config Cluster parameters
+ * @param jobs Job stream
+ * @param quantum Round Robin quantum on every node
+ */
+void runClusterComparison(const ClusterConfig& config,
+                          const std::vector<std::shared_ptr<Process>>& jobs, int quantum) {
+    const PlacementPolicy placements[] = {
+        PlacementPolicy::LEAST_LOADED, PlacementPolicy::POWER_OF_TWO, PlacementPolicy::BIN_PACKING
+    };
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "CLUSTER: " << config.numNodes << " nodes x Round Robin (q=" << quantum << "), "
+              << jobs.size() << " processes, epoch " << config.epochLength << "\n";
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::left << std::setw(22) << "Placement"
+              << std::right << std::setw(9) << "Avg Wait"
+              << std::setw(9) << "p50 TAT"
+              << std::setw(9) << "p99 TAT"
+              << std::setw(9) << "p99 Resp"
+              << std::setw(8) << "Util %"
+              << std::setw(8) << "Active"
+              << std::setw(9) << "Busiest"
+              << std::setw(8) << "Secs" << "\n";
+    std::cout << std::string(91, '-') << "\n";
+    
+    for (PlacementPolicy placement : placements) {
+        ClusterSimulator cluster(config, [quantum]() {
+            return std::unique_ptr<Scheduler>(new RoundRobinScheduler(quantum));
+        }, placement);
+        auto start = std::chrono::steady_clock::now();
+        ClusterMetrics metrics = cluster.run(jobs);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        
+        std::cout << std::left << std::setw(22) << ClusterSimulator::placementName(placement)
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << metrics.waiting.mean()
+                  << std::setw(9) << metrics.turnaround.quantile(0.5)
+                  << std::setw(9) << metrics.turnaround.quantile(0.99)
+                  << std::setw(9) << metrics.response.quantile(0.99)
+                  << std::setprecision(1)
+                  << std::setw(8) << metrics.utilization
+                  << std::setw(8) << metrics.activeNodes
+                  << std::setw(9) << metrics.busiestNode
+                  << std::setprecision(2)
+                  << std::setw(8) << elapsed.count() << "\n";
+    }
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "Percentiles from merged per-node sketches (within "
+              << QuantileSketch::DEFAULT_ACCURACY * 100 << "%); TAT = turnaround\n";
+}
+
+/**
+ * @brief Ask for a cluster shape and compare placement policies
+ */
+void runCluster() {
+    ClusterConfig config;
+    int tasksPerNode, quantum;
+    std::cout << "\nEnter number of nodes (e.g. 1000): ";
+    std::cin >> config.numNodes;
+    std::cout << "Enter mean processes per node (e.g. 100): ";
+    std::cin >> tasksPerNode;
+    std::cout << "Enter load-report epoch length (e.g. 10): ";
+    std::cin >> config.epochLength;
+    std::cout << "Enter Round Robin quantum for the nodes: ";
+    std::cin >> quantum;
+    if (config.numNodes < 1 || tasksPerNode < 1 || config.epochLength < 1 || quantum < 1) {
+        std::cout << "All values must be positive\n";
+        return;
+    }
+    runClusterComparison(config, generateClusterJobs(config, tasksPerNode), quantum);
+}
+
+/**
+ * @brief Import a cluster trace into simulator processes
+ *
+ * Arrivals are shifted so the first imported task arrives at time 0.
+ *
+ * @param format Trace schema
+ * @param path CSV file
+ * @param filter Time window and machine subset
+ * @param jobs Receives the processes
+ * @return bool false if the file cannot be read or is not in the format
+ */
+bool importTrace(TraceFormat format, const std::string& path, const TraceFilter& filter,
+                 std::vector<std::shared_ptr<Process>>& jobs) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cout << "Cannot open " << path << "\n";
+        return false;
+    }
+    TraceImporter importer(in, format, filter);
+    std::vector<TraceTask> tasks;
+    TraceTask task;
+    int64_t origin = INT64_MAX;
+    while (importer.next(task)) {
+        tasks.push_back(task);
+        origin = std::min(origin, task.arrival);
+    }
+    if (!importer.getError().empty()) {
+        std::cout << path << ": " << importer.getError() << "\n";
+        return false;
+    }
+    for (size_t i = 0; i < tasks.size(); i++) {
+        jobs.push_back(TraceImporter::toProcess(tasks[i], static_cast<int>(i) + 1, origin));
+    }
+    std::cout << "Imported " << jobs.size() << " tasks from " << importer.getRows() << " rows ("
+              << importer.getFiltered() << " filtered, " << importer.getMalformedRows()
+              << " malformed)\n";
+    return true;
+}
+
+/**
+ * @brief Parse "START:END" (END may be empty) into a trace window
+ */
+void parseTraceWindow(const std::string& text, TraceFilter& filter) {
+    size_t colon = text.find(':');
+    filter.windowStart = std::atoll(text.substr(0, colon).c_str());
+    if (colon != std::string::npos && colon + 1 < text.size()) {
+        filter.windowEnd = std::atoll(text.substr(colon + 1).c_str());
+    }
+}
+
+/**
+ * @brief Parse a comma-separated machine list into a trace filter
+ */
+void parseTraceMachines(const std::string& text, TraceFilter& filter) {
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t comma = text.find(',', start);
+        std::string id = text.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+        if (!id.empty()) {
+            filter.machines.insert(std::atoll(id.c_str()));
+        }
+        if (comma == std::string::npos) {
+            break;
+        }
+        start = comma + 1;
+    }
+}
+
+/**
+ * @brief Ask for a trace slice and run it on a cluster
+ */
+void runTrace() {
+    std::string name, path, window, machines;
+    ClusterConfig config;
+    TraceFormat format;
+    std::cout << "\nEnter trace format (google or alibaba): ";
+    std::cin >> name;
+    if (!TraceImporter::parseFormat(name, format)) {
+        std::cout << "Unknown format " << name << "\n";
+        return;
+    }
+    std::cout << "Enter CSV path: ";
+    std::cin >> path;
+    std::cout << "Enter time window in seconds START:END (e.g. 0:3600, or 0: for all): ";
+    std::cin >> window;
+    std::cout << "Enter machine IDs a,b,c (or - for all): ";
+    std::cin >> machines;
+    std::cout << "Enter number of nodes: ";
+    std::cin >> config.numNodes;
+    
+    TraceFilter filter;
+    parseTraceWindow(window, filter);
+    if (machines != "-") {
+        parseTraceMachines(machines, filter);
+    }
+    std::vector<std::shared_ptr<Process>> jobs;
+    if (config.numNodes >= 1 && importTrace(format, path, filter, jobs) && !jobs.empty()) {
+        runClusterComparison(config, jobs, 4);
+    }
+}
+
+/**
+ * @brief Schedule one workflow under every workflow policy
+ *
+ * @param workflow Finalized DAG
+ * @param cpus Identical CPUs
+ */
+void runWorkflowComparison(const Workflow& workflow, int cpus) {
+    const WorkflowPolicy policies[] = {
+        WorkflowPolicy::FIFO, WorkflowPolicy::LONGEST_PATH, WorkflowPolicy::HEFT
+    };
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "WORKFLOW: " << workflow.size() << " tasks, " << workflow.edgeCount()
+              << " edges on " << cpus << " CPUs\n";
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::left << std::setw(22) << "Policy"
+              << std::right << std::setw(12) << "Makespan"
+              << std::setw(12) << "Crit Path"
+              << std::setw(12) << "CP Slack"
+              << std::setw(10) << "Avg Wait"
+              << std::setw(8) << "Util %"
+              << std::setw(8) << "Secs" << "\n";
+    std::cout << std::string(84, '-') << "\n";
+    
+    WorkflowMetrics metrics = WorkflowMetrics();
+    for (WorkflowPolicy policy : policies) {
+        WorkflowScheduler scheduler(cpus, policy);
+        auto start = std::chrono::steady_clock::now();
+        metrics = scheduler.run(workflow);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        
+        std::cout << std::left << std::setw(22) << WorkflowScheduler::policyName(policy)
+                  << std::right << std::fixed
+                  << std::setw(12) << metrics.makespan
+                  << std::setw(12) << metrics.criticalPath
+                  << std::setw(12) << metrics.slack
+                  << std::setprecision(2) << std::setw(10) << metrics.averageWait
+                  << std::setprecision(1) << std::setw(8) << metrics.utilization
+                  << std::setprecision(2) << std::setw(8) << elapsed.count() << "\n";
+    }
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << metrics.criticalTasks << " tasks on a critical path; mean task slack "
+              << std::setprecision(2) << metrics.averageTaskSlack << "\n";
+    std::cout << "CP Slack = makespan - critical path (0 = the schedule is optimal)\n";
+}
+
+/**
+ * @brief Ask for a workflow shape and compare workflow policies
+ */
+void runWorkflow() {
+    int shape, tasks, width, cpus;
+    std::cout << "\nWorkflow shape (1 = fork-join stages, 2 = random layered DAG): ";
+    std::cin >> shape;
+    std::cout << (shape == 1 ? "Enter number of stages: " : "Enter number of tasks: ");
+    std::cin >> tasks;
+    std::cout << (shape == 1 ? "Enter tasks per stage: " : "Enter layer width: ");
+    std::cin >> width;
+    std::cout << "Enter number of CPUs: ";
+    std::cin >> cpus;
+    if (tasks < 1 || width < 1 || cpus < 1) {
+        std::cout << "All values must be positive\n";
+        return;
+    }
+    Workflow workflow = shape == 1 ? Workflow::forkJoin(tasks, width, 1, 20, 1)
+                                   : Workflow::layered(tasks, width, 4, 1, 20, 1);
+    runWorkflowComparison(workflow, cpus);
+}
+
+/**
+ * @brief Print the lock results of one preemptive priority run
+ */
+void printLockRun(LockProtocol protocol, const std::vector<std::shared_ptr<Process>>& processes) {
+    PriorityScheduler scheduler(true, false);
+    scheduler.setLockProtocol(protocol);
+    for (const auto& process : processes) {
+        scheduler.addProcess(std::make_shared<Process>(*process));
+    }
+    scheduler.schedule();
+    const LockMetrics& metrics = scheduler.getLockMetrics();
+    std::cout << std::left << std::setw(22) << PriorityScheduler::lockProtocolName(protocol)
+              << std::right
+              << std::setw(10) << metrics.acquisitions
+              << std::setw(11) << metrics.contended
+              << std::setw(11) << metrics.totalBlocking
+              << std::setw(11) << metrics.inversionTime
+              << std::setw(9) << metrics.maxWait
+              << std::setw(12) << metrics.deadlocked << "\n";
+}
+
+/**
+ * @brief Compare lock protocols on the classic inversion and a generated workload
+ *
+ * The classic case: low-priority L holds a lock that high-priority H needs,
+ * and medium-priority M, which needs no lock, preempts L.
+ */
+void runLockProtocols() {
+    const LockProtocol protocols[] = {
+        LockProtocol::NONE, LockProtocol::INHERITANCE, LockProtocol::CEILING
+    };
+    auto low = std::make_shared<Process>(1, "L", 0, 6, 3);
+    auto high = std::make_shared<Process>(2, "H", 2, 3, 0);
+    auto medium = std::make_shared<Process>(3, "M", 3, 10, 1);
+    low->addCriticalSection(0, 1, 4);
+    high->addCriticalSection(0, 0, 2);
+    std::vector<std::shared_ptr<Process>> classic = {low, high, medium};
+    
+    int count, numLocks;
+    std::cout << "\nEnter number of generated processes: ";
+    std::cin >> count;
+    std::cout << "Enter number of locks: ";
+    std::cin >> numLocks;
+    WorkloadDistribution distribution;
+    distribution.numProcesses = std::max(1, count);
+    distribution.meanInterarrival = 2.5;
+    distribution.numLocks = std::max(1, numLocks);
+    distribution.criticalSectionProbability = 0.8;
+    std::vector<std::shared_ptr<Process>> generated = WorkloadGenerator(distribution).generate(1);
+    
+    const std::pair<std::string, const std::vector<std::shared_ptr<Process>>*> workloads[] = {
+        {"L/M/H inversion (H needs L's lock, M preempts L)", &classic},
+        {std::to_string(distribution.numProcesses) + " processes, "
+            + std::to_string(distribution.numLocks) + " locks", &generated}
+    };
+    for (const auto& workload : workloads) {
+        std::cout << "\n" << std::string(86, '=') << "\n";
+        std::cout << "LOCKS: " << workload.first << "\n";
+        std::cout << std::string(86, '=') << "\n";
+        std::cout << std::left << std::setw(22) << "Protocol"
+                  << std::right << std::setw(10) << "Acquired"
+                  << std::setw(11) << "Contended"
+                  << std::setw(11) << "Blocking"
+                  << std::setw(11) << "Inversion"
+                  << std::setw(9) << "Max Wait"
+                  << std::setw(12) << "Deadlocked" << "\n";
+        std::cout << std::string(86, '-') << "\n";
+        for (LockProtocol protocol : protocols) {
+            printLockRun(protocol, *workload.second);
+        }
+    }
+    std::cout << std::string(86, '=') << "\n";
+    std::cout << "Inversion = time a process ran while a higher-priority process was blocked\n";
+}
+
+/**
+ * @brief Print the response-time-vs-users curve up to @p maxUsers
+ *
+ * The user counts double from 1 and always include N* and maxUsers; the
+ * points are simulated in parallel.
+ */
+void runClosedLoopSweep(const ClosedLoopConfig& config, int maxUsers) {
+    ClosedLoopSimulator simulator(config);
+    const ClosedLoopConfig& used = simulator.getConfig();
+    std::vector<int> users;
+    for (int n = 1; n < maxUsers; n *= 2) {
+        users.push_back(n);
+    }
+    users.push_back(maxUsers);
+    int knee = static_cast<int>(std::lround(simulator.saturationUsers()));
+    if (knee < maxUsers && std::find(users.begin(), users.end(), knee) == users.end()) {
+        users.push_back(knee);
+    }
+    std::sort(users.begin(), users.end());
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ClosedLoopMetrics> curve = simulator.sweep(users);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    
+    std::cout << "\n" << std::string(88, '=') << "\n";
+    std::cout << "CLOSED LOOP: " << ClosedLoopSimulator::disciplineName(used.discipline)
+              << " on " << used.cpus << " CPUs, think " << used.meanThink
+              << ", service " << used.meanService << ", time " << used.warmup
+              << " to " << used.horizon << "\n";
+    std::cout << std::string(88, '=') << "\n";
+    std::cout << std::right << std::setw(10) << "Users"
+              << std::setw(12) << "Requests"
+              << std::setw(12) << "Throughput"
+              << std::setw(10) << "Util %"
+              << std::setw(11) << "Resp Mean"
+              << std::setw(10) << "Resp p95"
+              << std::setw(10) << "Resp p99"
+              << std::setw(12) << "MVA Resp" << "\n";
+    std::cout << std::string(88, '-') << "\n";
+    for (const ClosedLoopMetrics& point : curve) {
+        std::cout << std::setw(10) << point.users
+                  << std::setw(12) << point.completed
+                  << std::fixed << std::setprecision(4) << std::setw(12) << point.throughput
+                  << std::setprecision(1) << std::setw(10) << point.utilization
+                  << std::setprecision(2) << std::setw(11) << point.response.mean()
+                  << std::setw(10) << point.response.quantile(0.95)
+                  << std::setw(10) << point.response.quantile(0.99)
+                  << std::setw(12) << point.predictedResponse << "\n";
+    }
+    std::cout << std::string(88, '=') << "\n";
+    std::cout << "Saturation at N* = c(D + Z)/D = " << std::setprecision(1)
+              << simulator.saturationUsers() << " users; sweep took "
+              << std::setprecision(2) << elapsed.count() << " s\n";
+}
+
+/**
+ * @brief Ask for a user population and print its closed-loop curve
+ */
+void runClosedLoop() {
+    ClosedLoopConfig config;
+    int maxUsers, discipline;
+    std::cout << "\nEnter maximum number of users: ";
+    std::cin >> maxUsers;
+    std::cout << "Enter mean think time: ";
+    std::cin >> config.meanThink;
+    std::cout << "Enter mean service time: ";
+    std::cin >> config.meanService;
+    std::cout << "Enter number of CPUs: ";
+    std::cin >> config.cpus;
+    std::cout << "Discipline (1 = FCFS, 2 = Round Robin, 3 = Shortest First): ";
+    std::cin >> discipline;
+    if (maxUsers < 1 || config.cpus < 1 || config.meanService < 1 || config.meanThink < 0) {
+        std::cout << "Users, CPUs and service time must be positive\n";
+        return;
+    }
+    config.discipline = discipline == 2 ? ClosedLoopDiscipline::ROUND_ROBIN
+                      : discipline == 3 ? ClosedLoopDiscipline::SHORTEST_FIRST
+                                        : ClosedLoopDiscipline::FCFS;
+    runClosedLoopSweep(config, maxUsers);
+}
+
+/**
+ * @brief Print p99.9 slowdown against load for every RPC server architecture
+ */
+void runRpcComparison(const RpcServerConfig& config) {
+    const RpcArchitecture architectures[] = {
+        RpcArchitecture::CENTRALIZED_FCFS, RpcArchitecture::WORK_STEALING,
+        RpcArchitecture::PROCESSOR_SHARING
+    };
+    const std::vector<double> loads = {0.1, 0.3, 0.5, 0.6, 0.7, 0.8, 0.9, 0.95};
+    RpcServerSimulator simulator(config);
+    const RpcServerConfig& used = simulator.getConfig();
+    
+    std::vector<std::vector<RpcMetrics>> curves;
+    for (RpcArchitecture architecture : architectures) {
+        curves.push_back(simulator.sweep(architecture, loads));
+    }
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "RPC SERVER: " << used.workers << " workers, dispatch " << used.dispatchCost
+              << " ns, quantum " << used.quantum << " ns, preemption " << used.preemptionCost
+              << " ns, steal " << used.stealCost << " ns\n";
+    std::cout << "Mix:";
+    for (const RpcRequestType& type : used.mix) {
+        std::cout << (&type == &used.mix.front() ? " " : ", ") << type.name << " " << std::fixed << std::setprecision(1)
+                  << 100.0 * type.share << "% x " << std::setprecision(0) << type.meanService << " ns";
+    }
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "p99.9 slowdown (latency / service time)\n";
+    std::cout << std::left << std::setw(8) << "Load" << std::right;
+    for (RpcArchitecture architecture : architectures) {
+        std::cout << std::setw(20) << RpcServerSimulator::architectureName(architecture);
+    }
+    std::cout << std::setw(12) << "Dispatch %" << "\n";
+    std::cout << std::string(80, '-') << "\n";
+    for (size_t k = 0; k < loads.size(); k++) {
+        std::cout << std::left << std::setw(8) << std::setprecision(2) << loads[k] << std::right;
+        for (const auto& curve : curves) {
+            std::cout << std::setw(20) << std::setprecision(1) << curve[k].slowdown.quantile(0.999);
+        }
+        std::cout << std::setw(12) << curves[0][k].dispatcherUtilization << "\n";
+    }
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "Dispatch % = centralized dispatcher core busy time\n";
+}
+
+/**
+ * @brief Ask for the server shape and compare RPC server architectures
+ */
+void runRpcServer() {
+    RpcServerConfig config;
+    std::cout << "\nEnter number of worker cores: ";
+    std::cin >> config.workers;
+    std::cout << "Enter dispatcher cost per request (ns): ";
+    std::cin >> config.dispatchCost;
+    std::cout << "Enter preemption quantum (ns, e.g. 5000-10000): ";
+    std::cin >> config.quantum;
+    std::cout << "Enter preemption cost (ns): ";
+    std::cin >> config.preemptionCost;
+    if (config.workers < 1 || config.dispatchCost < 0 || config.quantum < 1 || config.preemptionCost < 0) {
+        std::cout << "Workers and quantum must be positive, costs non-negative\n";
+        return;
+    }
+    runRpcComparison(config);
+}
+
+/**
+ * @brief Compare host policies for VMs whose tasks each take a lock
+ *
+ * Every VM runs a generated workload on Round Robin guests; each task holds
+ * a VM-wide lock over the middle half of its burst. The dedicated row gives
+ * every vCPU its own pCPU, so it is the bare-metal baseline.
+ */
+void runHypervisorComparison(int numVms, int vcpusPerVm, int pcpus, int timeslice) {
+    WorkloadDistribution distribution;
+    std::vector<VirtualMachine> vms(static_cast<size_t>(numVms));
+    for (size_t i = 0; i < vms.size(); i++) {
+        vms[i].vcpus = vcpusPerVm;
+        vms[i].tasks = WorkloadGenerator(distribution).generate(i + 1);
+        for (const auto& task : vms[i].tasks) {
+            task->addCriticalSection(1, task->getBurstTime() / 4, std::max(1, task->getBurstTime() / 2));
+        }
+    }
+    SchedulerFactory roundRobin = []() {
+        return std::unique_ptr<Scheduler>(new RoundRobinScheduler(4));
+    };
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "VIRTUALIZED HOST: " << numVms << " VMs x " << vcpusPerVm << " vCPUs on " << pcpus
+              << " pCPUs, timeslice " << timeslice << ", Round Robin guests (q=4)\n";
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::left << std::setw(16) << "Host"
+              << std::right << std::setw(9) << "Avg Wait"
+              << std::setw(9) << "p99 TAT"
+              << std::setw(10) << "p99 Steal"
+              << std::setw(9) << "Steal %"
+              << std::setw(11) << "LHP Sects"
+              << std::setw(10) << "Avg LHP"
+              << std::setw(8) << "Util %"
+              << std::setw(8) << "Secs" << "\n";
+    std::cout << std::string(90, '-') << "\n";
+    
+    const HostPolicy policies[] = {HostPolicy::ROUND_ROBIN, HostPolicy::FAIR_SHARE, HostPolicy::ROUND_ROBIN};
+    for (size_t k = 0; k < 3; k++) {
+        HostConfig host;
+        host.pcpus = k < 2 ? pcpus : numVms * vcpusPerVm;
+        host.timeslice = timeslice;
+        host.policy = policies[k];
+        auto start = std::chrono::steady_clock::now();
+        HypervisorMetrics metrics = HypervisorSimulator(host, roundRobin).run(vms);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        
+        double avgDelay = metrics.preemptedSections > 0
+            ? static_cast<double>(metrics.lockHolderDelay) / metrics.preemptedSections : 0.0;
+        std::cout << std::left << std::setw(16) << (k < 2 ? HypervisorSimulator::policyName(policies[k]) : "Dedicated")
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << metrics.waiting.mean()
+                  << std::setw(9) << metrics.turnaround.quantile(0.99)
+                  << std::setw(10) << metrics.steal.quantile(0.99)
+                  << std::setprecision(1)
+                  << std::setw(9) << metrics.stealPercent
+                  << std::setw(11) << metrics.preemptedSections
+                  << std::setw(10) << avgDelay
+                  << std::setw(8) << metrics.utilization
+                  << std::setprecision(2)
+                  << std::setw(8) << elapsed.count() << "\n";
+    }
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "Steal % = runnable-but-descheduled share of vCPU time; LHP Sects = lock-held\n"
+              << "sections whose vCPU lost its pCPU, Avg LHP = mean stretch of those sections\n";
+}
+
+/**
+ * @brief Ask for a host shape and compare host policies
+ */
+void runHypervisor() {
+    int numVms, vcpusPerVm, pcpus, timeslice;
+    std::cout << "\nEnter number of VMs (e.g. 1000): ";
+    std::cin >> numVms;
+    std::cout << "Enter vCPUs per VM: ";
+    std::cin >> vcpusPerVm;
+    std::cout << "Enter number of physical CPUs: ";
+    std::cin >> pcpus;
+    std::cout << "Enter host timeslice: ";
+    std::cin >> timeslice;
+    if (numVms < 1 || vcpusPerVm < 1 || pcpus < 1 || timeslice < 1) {
+        std::cout << "All values must be positive\n";
+        return;
+    }
+    runHypervisorComparison(numVms, vcpusPerVm, pcpus, timeslice);
+}
+
+/**
+ * @brief Compare policies on a core taking NIC interrupts, a core without, and bare metal
+ *
+ * Two cores share a periodic local timer; the NIC's receive interrupts
+ * are pinned to core 0, as with a single-queue NIC without irqbalance.
+ */
+void runInterruptComparison(double nicInterarrival, double hardirqCost, double softirqCost, int numProcesses) {
+    InterruptModel model(2, 1);
+    model.addSource({"local-timer", 4.0, BurstDistribution::CONSTANT, 0.02, 0.0, BurstDistribution::CONSTANT, 0});
+    if (!model.addSource({"nic-rx", nicInterarrival, BurstDistribution::EXPONENTIAL, hardirqCost, softirqCost,
+                          BurstDistribution::EXPONENTIAL, 1}) ||
+        model.coreLoad(0) >= 1.0) {
+        std::cout << "The interrupt handlers would need the whole core\n";
+        return;
+    }
+    WorkloadDistribution distribution;
+    distribution.numProcesses = numProcesses;
+    auto workload = WorkloadGenerator(distribution).generate(1);
+    const std::vector<std::pair<std::string, SchedulerFactory>> policies = {
+        {"Round Robin (q=3)", []() { return std::unique_ptr<Scheduler>(new RoundRobinScheduler(3)); }},
+        {"Preemptive Priority", []() { return std::unique_ptr<Scheduler>(new PriorityScheduler(true)); }},
+        {"MLFQ", []() { return std::unique_ptr<Scheduler>(new MultilevelFeedbackQueueScheduler()); }},
+        {"O(1) Scheduler", []() { return std::unique_ptr<Scheduler>(new O1Scheduler()); }},
+        {"BFS Skip List", []() { return std::unique_ptr<Scheduler>(new SkipListScheduler()); }}
+    };
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "INTERRUPT LOAD: " << numProcesses << " processes; NIC every " << nicInterarrival
+              << " (hardirq " << hardirqCost << ", softirq " << softirqCost << ") on core 0\n";
+    std::cout << std::fixed << std::setprecision(1) << "Handler share: core 0 " << 100.0 * model.coreLoad(0)
+              << "%, core 1 " << 100.0 * model.coreLoad(1) << "% (local timer only)\n";
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::left << std::setw(22) << "Policy"
+              << std::right << std::setw(10) << "Bare TAT"
+              << std::setw(10) << "Core1 TAT"
+              << std::setw(10) << "Core0 TAT"
+              << std::setw(11) << "Core0 Wait"
+              << std::setw(10) << "IRQ/proc"
+              << std::setw(7) << "Secs" << "\n";
+    std::cout << std::string(80, '-') << "\n";
+    for (const auto& policy : policies) {
+        double turnaround[3];
+        SchedulingMetrics noisy;
+        auto start = std::chrono::steady_clock::now();
+        for (int k = 0; k < 3; k++) {
+            std::unique_ptr<Scheduler> scheduler = policy.second();
+            for (const auto& p : workload) {
+                scheduler->addProcess(std::make_shared<Process>(p->getPID(), p->getName(), p->getArrivalTime(),
+                                                                p->getBurstTime(), p->getPriority()));
+            }
+            if (k > 0) {
+                scheduler->setInterrupts(model, 2 - k);
+            }
+            scheduler->schedule();
+            noisy = scheduler->calculateMetrics();
+            turnaround[k] = noisy.averageTurnaroundTime;
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << std::left << std::setw(22) << policy.first
+                  << std::right << std::setprecision(2)
+                  << std::setw(10) << turnaround[0]
+                  << std::setw(10) << turnaround[1]
+                  << std::setw(10) << turnaround[2]
+                  << std::setw(11) << noisy.averageWaitingTime
+                  << std::setw(10) << static_cast<double>(noisy.totalInterruptTime) / numProcesses
+                  << std::setw(7) << elapsed.count() << "\n";
+    }
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "IRQ/proc = handler time that preempted a process while it ran, per process\n";
+}
+
+/**
+ * @brief Ask for a NIC interrupt load and compare policies under it
+ */
+void runInterrupts() {
+    double interarrival, hardirq, softirq;
+    int numProcesses;
+    std::cout << "\nEnter mean time between NIC interrupts (e.g. 0.01): ";
+    std::cin >> interarrival;
+    std::cout << "Enter mean hardirq cost (e.g. 0.00005): ";
+    std::cin >> hardirq;
+    std::cout << "Enter mean softirq cost (e.g. 0.001): ";
+    std::cin >> softirq;
+    std::cout << "Enter number of processes: ";
+    std::cin >> numProcesses;
+    if (!(interarrival > 0) || hardirq < 0 || softirq < 0 || numProcesses < 1) {
+        std::cout << "Interarrival and processes must be positive, costs non-negative\n";
+        return;
+    }
+    runInterruptComparison(interarrival, hardirq, softirq, numProcesses);
+}
+
+/**
+ * @brief Run one affinity/hotplug scenario under a sched_ext-style policy and print its row
+ */
+template <typename Policy>
+void runHotplugScenario(const std::string& label, int numCpus,
+                        const std::vector<std::shared_ptr<Process>>& workload,
+                        const CpuSet* pinnedTo, int offlineFrom, int offlineUntil) {
+    ExtScheduler<Policy> scheduler(numCpus, 1, 0);
+    for (const auto& p : workload) {
+        scheduler.addProcess(std::make_shared<Process>(p->getPID(), p->getName(), p->getArrivalTime(),
+                                                       p->getBurstTime(), p->getPriority()));
+        if (pinnedTo != nullptr && p->getPID() % 4 == 0) {
+            scheduler.setAffinity(p->getPID(), *pinnedTo);
+        }
+    }
+    for (int cpu = numCpus / 2; offlineUntil > offlineFrom && cpu < numCpus; cpu++) {
+        scheduler.addHotplugEvent(offlineFrom, cpu, false);
+        scheduler.addHotplugEvent(offlineUntil, cpu, true);
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    scheduler.schedule();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    SchedulingMetrics metrics = scheduler.calculateMetrics();
+    std::cout << std::left << std::setw(16) << Policy().name()
+              << std::setw(22) << label
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(9) << metrics.averageTurnaroundTime
+              << std::setw(9) << metrics.averageWaitingTime
+              << std::setw(10) << scheduler.getMigrations()
+              << std::setw(8) << scheduler.getBrokenAffinities()
+              << std::setw(6) << elapsed.count() << "\n";
+}
+
+/**
+ * @brief Compare placement with cpuset pinning and with half the CPUs hotplugged out
+ *
+ * The workload keeps about 60% of the machine busy. A quarter of the tasks
+ * are pinned either to a cpuset in the lower half of the CPUs, or to one in
+ * the upper half, which goes offline for the middle third of the arrivals.
+ */
+void runHotplugComparison(int numCpus, int numProcesses) {
+    WorkloadDistribution distribution;
+    distribution.numProcesses = numProcesses;
+    distribution.meanInterarrival = distribution.meanBurst / (0.6 * numCpus);
+    auto workload = WorkloadGenerator(distribution).generate(1);
+    int span = workload.empty() ? 0 : workload.back()->getArrivalTime();
+    int from = span / 3;
+    int until = 2 * span / 3;
+    
+    int setSize = std::max(1, numCpus / 4);
+    CpuSet low(numCpus), high(numCpus);
+    for (int c = 0; c < setSize; c++) {
+        low.set(c);
+        high.set(numCpus - 1 - c);
+    }
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "CPU AFFINITY AND HOTPLUG: " << numProcesses << " processes on " << numCpus << " CPUs\n";
+    std::cout << "Pinned quarter: cpuset " << low.toString() << " (low) or " << high.toString()
+              << " (high); hotplug: CPUs " << numCpus / 2 << "-" << numCpus - 1
+              << " offline from " << from << " to " << until << "\n";
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::left << std::setw(16) << "Policy"
+              << std::setw(22) << "Scenario"
+              << std::right << std::setw(9) << "Avg TAT"
+              << std::setw(9) << "Avg Wait"
+              << std::setw(10) << "Migrated"
+              << std::setw(8) << "Broken"
+              << std::setw(6) << "Secs" << "\n";
+    std::cout << std::string(80, '-') << "\n";
+    runHotplugScenario<ExtPolicy>("All CPUs", numCpus, workload, nullptr, 0, 0);
+    runHotplugScenario<ExtPolicy>("Pinned low", numCpus, workload, &low, 0, 0);
+    runHotplugScenario<ExtPolicy>("Hotplug", numCpus, workload, nullptr, from, until);
+    runHotplugScenario<ExtPolicy>("Pinned high+hotplug", numCpus, workload, &high, from, until);
+    runHotplugScenario<ExtVtimePolicy>("All CPUs", numCpus, workload, nullptr, 0, 0);
+    runHotplugScenario<ExtVtimePolicy>("Pinned low", numCpus, workload, &low, 0, 0);
+    runHotplugScenario<ExtVtimePolicy>("Hotplug", numCpus, workload, nullptr, from, until);
+    runHotplugScenario<ExtVtimePolicy>("Pinned high+hotplug", numCpus, workload, &high, from, until);
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "Migrated = task starts on another CPU than its last; "
+              << "Broken = masks widened when no allowed CPU was online\n";
+}
+
+/**
+ * @brief Ask for a machine size and compare affinity and hotplug scenarios on it
+ */
+void runHotplug() {
+    int numCpus, numProcesses;
+    std::cout << "\nEnter number of CPUs (e.g. 64): ";
+    std::cin >> numCpus;
+    std::cout << "Enter number of processes: ";
+    std::cin >> numProcesses;
+    if (numCpus < 2 || numProcesses < 1) {
+        std::cout << "Need at least 2 CPUs and 1 process\n";
+        return;
+    }
+    runHotplugComparison(numCpus, numProcesses);
+}
+
+/**
+ * @brief Run one SMT configuration under the global FIFO policy and print its row
+ *
+ * @param tenants Core-scheduling cookies assigned round-robin by PID (0 = core scheduling off)
+ */
+void runSmtScenario(const std::string& label, int numCpus, const SmtConfig& smt, int tenants,
+                    const std::vector<std::shared_ptr<Process>>& workload) {
+    ExtScheduler<ExtPolicy> scheduler(numCpus, 1, 0);
+    SmtConfig config = smt;
+    config.coreScheduling = tenants > 0;
+    scheduler.setSmt(config);
+    for (const auto& p : workload) {
+        scheduler.addProcess(std::make_shared<Process>(p->getPID(), p->getName(), p->getArrivalTime(),
+                                                       p->getBurstTime(), p->getPriority()));
+        scheduler.setTaskClass(p->getPID(), p->getPID() % 2);
+        if (tenants > 0) {
+            scheduler.setCoreCookie(p->getPID(), static_cast<uint64_t>(p->getPID() % tenants));
+        }
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    scheduler.schedule();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    SchedulingMetrics metrics = scheduler.calculateMetrics();
+    double forcedIdle = metrics.totalTime > 0
+                            ? 100.0 * scheduler.getForcedIdleTime() / (static_cast<double>(numCpus) * metrics.totalTime)
+                            : 0.0;
+    std::cout << std::left << std::setw(24) << label
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << numCpus
+              << std::setw(10) << metrics.averageTurnaroundTime
+              << std::setw(10) << metrics.averageWaitingTime
+              << std::setw(11) << metrics.throughput
+              << std::setw(10) << forcedIdle
+              << std::setw(7) << elapsed.count() << "\n";
+}
+
+/**
+ * @brief Compare SMT off, SMT on and core scheduling with more and more tenants
+ *
+ * Half the tasks are compute-bound (class 0) and half memory-bound
+ * (class 1). Arrivals offer 120% of what the cores can do without SMT, so
+ * throughput shows what the sibling threads add and what core scheduling
+ * takes back.
+ */
+void runSmtComparison(int cores, int numProcesses) {
+    WorkloadDistribution distribution;
+    distribution.numProcesses = numProcesses;
+    distribution.meanInterarrival = distribution.meanBurst / (1.2 * cores);
+    auto workload = WorkloadGenerator(distribution).generate(1);
+    
+    SmtConfig smt;
+    smt.threadsPerCore = 2;
+    smt.slowdown = {{1.6, 1.3},     // compute next to compute, next to memory-bound
+                    {1.3, 1.8}};    // memory-bound next to compute, next to memory-bound
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "SMT INTERFERENCE AND CORE SCHEDULING: " << numProcesses << " processes on "
+              << cores << " cores\n";
+    std::cout << "Co-run slowdown: compute/compute 1.6x, memory/memory 1.8x, mixed 1.3x\n";
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::left << std::setw(24) << "Configuration"
+              << std::right << std::setw(8) << "Threads"
+              << std::setw(10) << "Avg TAT"
+              << std::setw(10) << "Avg Wait"
+              << std::setw(11) << "Throughput"
+              << std::setw(10) << "Forced %"
+              << std::setw(7) << "Secs" << "\n";
+    std::cout << std::string(80, '-') << "\n";
+    runSmtScenario("SMT off", cores, SmtConfig(), 0, workload);
+    runSmtScenario("SMT on", 2 * cores, smt, 0, workload);
+    for (int tenants : {1, 2, 4, 16}) {
+        runSmtScenario("Core sched, " + std::to_string(tenants) + " tenant" + (tenants > 1 ? "s" : ""),
+                       2 * cores, smt, tenants, workload);
+    }
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "Throughput = processes per time unit; Forced % = thread time idled by core scheduling\n";
+}
+
+/**
+ * @brief Ask for a machine size and compare SMT and core scheduling on it
+ */
+void runSmt() {
+    int cores, numProcesses;
+    std::cout << "\nEnter number of physical cores (e.g. 32): ";
+    std::cin >> cores;
+    std::cout << "Enter number of processes: ";
+    std::cin >> numProcesses;
+    if (cores < 1 || numProcesses < 1) {
+        std::cout << "Cores and processes must be positive\n";
+        return;
+    }
+    runSmtComparison(cores, numProcesses);
+}
+
+/**
+ * @brief Run one host memory configuration under the global FIFO policy and print its row
+ *
+ * @param memory Host memory (nullptr = unlimited)
+ */
+void runMemoryScenario(const std::string& label, int numCpus, const MemoryConfig* memory,
+                       const std::vector<std::shared_ptr<Process>>& workload) {
+    ExtScheduler<ExtPolicy> scheduler(numCpus, 1, 0);
+    if (memory != nullptr) {
+        scheduler.setMemory(*memory);
+    }
+    for (const auto& p : workload) {
+        auto copy = std::make_shared<Process>(p->getPID(), p->getName(), p->getArrivalTime(),
+                                              p->getBurstTime(), p->getPriority());
+        copy->setResidentSetSize(p->getResidentSetSize());
+        scheduler.addProcess(copy);
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    scheduler.schedule();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    SchedulingMetrics metrics = scheduler.calculateMetrics();
+    double pressure = metrics.totalTime > 0 ? 100.0 * scheduler.getMemoryPressureTime() / metrics.totalTime : 0.0;
+    std::cout << std::left << std::setw(22) << label
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << metrics.averageTurnaroundTime
+              << std::setw(10) << metrics.averageWaitingTime
+              << std::setw(11) << metrics.throughput
+              << std::setw(10) << static_cast<double>(metrics.totalMemoryStallTime) / workload.size()
+              << std::setw(10) << pressure
+              << std::setw(7) << elapsed.count() << "\n";
+}
+
+/**
+ * @brief Compare unlimited memory, a thrashing host and memory-aware admission
+ *
+ * Processes have an RSS of 100-500 MiB and touch half of it. The host has
+ * 400 MiB per CPU, room for the running processes and a short queue; arrivals
+ * offer 90% of the CPUs: bursts of arrivals admitted regardless of memory
+ * push the working sets past physical memory and everyone slows down.
+ */
+void runMemoryComparison(int numCpus, int numProcesses) {
+    WorkloadDistribution distribution;
+    distribution.numProcesses = numProcesses;
+    distribution.meanInterarrival = distribution.meanBurst / (0.9 * numCpus);
+    auto workload = WorkloadGenerator(distribution).generate(1);
+    std::mt19937 engine(1);
+    std::uniform_int_distribution<int> rss(100, 500);
+    for (auto& p : workload) {
+        p->setResidentSetSize(rss(engine));
+    }
+    
+    MemoryConfig memory;
+    memory.capacity = 400LL * numCpus;
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "MEMORY PRESSURE: " << numProcesses << " processes on " << numCpus << " CPUs, "
+              << memory.capacity << " MiB\n";
+    std::cout << "RSS 100-500 MiB, working set 50% of RSS, swap penalty " << memory.swapPenalty << "\n";
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::left << std::setw(22) << "Configuration"
+              << std::right << std::setw(10) << "Avg TAT"
+              << std::setw(10) << "Avg Wait"
+              << std::setw(11) << "Throughput"
+              << std::setw(10) << "Stall"
+              << std::setw(10) << "PSI %"
+              << std::setw(7) << "Secs" << "\n";
+    std::cout << std::string(80, '-') << "\n";
+    runMemoryScenario("Unlimited memory", numCpus, nullptr, workload);
+    MemoryConfig scenario = memory;
+    scenario.admissionLimit = 0;
+    runMemoryScenario("No admission control", numCpus, &scenario, workload);
+    for (double limit : {2.0, 1.5, 1.0}) {
+        scenario.admissionLimit = limit;
+        runMemoryScenario("Admit to " + std::to_string(static_cast<int>(limit * 100)) + "% RAM",
+                          numCpus, &scenario, workload);
+    }
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "Stall = mean time held back or lost to swapping per process; "
+              << "PSI % = time some process stalled\n";
+}
+
+/**
+ * @brief Ask for a machine size and compare memory admission policies on it
+ */
+void runMemory() {
+    int numCpus, numProcesses;
+    std::cout << "\nEnter number of CPUs (e.g. 16): ";
+    std::cin >> numCpus;
+    std::cout << "Enter number of processes: ";
+    std::cin >> numProcesses;
+    if (numCpus < 1 || numProcesses < 1) {
+        std::cout << "CPUs and processes must be positive\n";
+        return;
+    }
+    runMemoryComparison(numCpus, numProcesses);
+}
+
+/**
+ * @brief Run one fault-injection configuration under the global FIFO policy and print its row
+ */
+void runFailureScenario(const std::string& label, int numCpus, const FailureConfig& failures,
+                        const std::vector<std::shared_ptr<Process>>& workload) {
+    ExtScheduler<ExtPolicy> scheduler(numCpus, 1, 0);
+    scheduler.setFailures(failures);
+    for (const auto& p : workload) {
+        scheduler.addProcess(std::make_shared<Process>(p->getPID(), p->getName(), p->getArrivalTime(),
+                                                       p->getBurstTime(), p->getPriority()));
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    scheduler.schedule();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    SchedulingMetrics metrics = scheduler.calculateMetrics();
+    std::cout << std::left << std::setw(22) << label
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << metrics.averageTurnaroundTime
+              << std::setw(8) << scheduler.getTaskCrashes()
+              << std::setw(7) << scheduler.getCpuFailures()
+              << std::setw(8) << metrics.failedProcesses
+              << std::setw(9) << metrics.cpuUtilization - metrics.goodput
+              << std::setw(9) << metrics.goodput
+              << std::setw(7) << elapsed.count() << "\n";
+}
+
+/**
+ * @brief Compare task crash rates, retry budgets and CPU failures
+ *
+ * Arrivals offer 70% of the CPUs. The failure draws depend only on the
+ * seed, so every row with the same crash probability crashes the same runs.
+ */
+void runFailureComparison(int numCpus, int numProcesses) {
+    WorkloadDistribution distribution;
+    distribution.numProcesses = numProcesses;
+    distribution.meanInterarrival = distribution.meanBurst / (0.7 * numCpus);
+    auto workload = WorkloadGenerator(distribution).generate(1);
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "FAULT INJECTION: " << numProcesses << " processes on " << numCpus << " CPUs\n";
+    std::cout << "Retries back off 10, 20, 40, ...; failed CPUs are repaired after 100\n";
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::left << std::setw(22) << "Configuration"
+              << std::right << std::setw(10) << "Avg TAT"
+              << std::setw(8) << "Crashes"
+              << std::setw(7) << "CPUs"
+              << std::setw(8) << "Failed"
+              << std::setw(9) << "Wasted%"
+              << std::setw(9) << "Goodput"
+              << std::setw(7) << "Secs" << "\n";
+    std::cout << std::string(80, '-') << "\n";
+    FailureConfig failures;
+    runFailureScenario("No failures", numCpus, failures, workload);
+    for (double probability : {0.05, 0.2}) {
+        failures.crashProbability = probability;
+        runFailureScenario("Crash " + std::to_string(static_cast<int>(probability * 100)) + "%, 3 retries",
+                           numCpus, failures, workload);
+    }
+    failures.maxRetries = 0;
+    runFailureScenario("Crash 20%, no retry", numCpus, failures, workload);
+    failures = FailureConfig();
+    failures.cpuMtbf = 2000;
+    runFailureScenario("CPU MTBF 2000", numCpus, failures, workload);
+    failures.crashProbability = 0.05;
+    runFailureScenario("MTBF 2000 + crash 5%", numCpus, failures, workload);
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "Crashes = task runs lost; Wasted% and Goodput = share of CPU time on lost "
+              << "and completed runs\n";
+}
+
+/**
+ * @brief Ask for a machine size and compare failure scenarios on it
+ */
+void runFailures() {
+    int numCpus, numProcesses;
+    std::cout << "\nEnter number of CPUs (e.g. 16): ";
+    std::cin >> numCpus;
+    std::cout << "Enter number of processes: ";
+    std::cin >> numProcesses;
+    if (numCpus < 1 || numProcesses < 1) {
+        std::cout << "CPUs and processes must be positive\n";
+        return;
+    }
+    runFailureComparison(numCpus, numProcesses);
+}
+
+/**
+ * @brief Compare the scheduling latency of the uniprocessor policies by priority class
+ *
+ * Every READY -> RUNNING delay is recorded, not just the first dispatch.
+ * The histograms of several workload replicas are merged per policy before
+ * the quantiles are read.
+ */
+void runLatencyComparison(int numProcesses, int replicas) {
+    WorkloadDistribution distribution;
+    distribution.numProcesses = numProcesses;
+    distribution.meanInterarrival = distribution.meanBurst / 0.8;
+    WorkloadGenerator generator(distribution);
+    std::vector<std::pair<std::string, SchedulerFactory>> policies = {
+        {"Round Robin (Q=3)", []() { return std::unique_ptr<Scheduler>(new RoundRobinScheduler(3, 0)); }},
+        {"Preemptive Priority", []() {
+            return std::unique_ptr<Scheduler>(new PriorityScheduler(true, true, 5, 0));
+        }},
+        {"Priority, no aging", []() {
+            return std::unique_ptr<Scheduler>(new PriorityScheduler(true, false, 5, 0));
+        }},
+        {"MLFQ", []() { return std::unique_ptr<Scheduler>(new MultilevelFeedbackQueueScheduler(3, true, 10, 0)); }},
+        {"O(1) Scheduler", []() { return std::unique_ptr<Scheduler>(new O1Scheduler(4, 0)); }},
+        {"BFS Skip List", []() {
+            return std::unique_ptr<Scheduler>(new SkipListScheduler(6, 1, RunQueueLayout::GLOBAL, 0));
+        }},
+    };
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "SCHEDULING LATENCY: " << replicas << " x " << numProcesses
+              << " processes on 1 CPU at 80% load, priorities "
+              << distribution.minPriority << " (urgent) to " << distribution.maxPriority << "\n";
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::left << std::setw(22) << "Policy"
+              << std::right << std::setw(11) << "Dispatches"
+              << std::setw(8) << "p50"
+              << std::setw(8) << "p99"
+              << std::setw(11) << "p99 prio " + std::to_string(distribution.minPriority)
+              << std::setw(11) << "p99 prio " + std::to_string(distribution.maxPriority)
+              << std::setw(9) << "Max" << "\n";
+    std::cout << std::string(80, '-') << "\n";
+    for (const auto& policy : policies) {
+        LatencyHistogram merged;
+        for (int replica = 0; replica < replicas; replica++) {
+            auto scheduler = policy.second();
+            for (const auto& p : generator.generate(static_cast<uint64_t>(replica) + 1)) {
+                scheduler->addProcess(p);
+            }
+            scheduler->schedule();
+            merged.merge(scheduler->getSchedulingLatency());
+        }
+        const QuantileSketch& all = merged.overall();
+        std::cout << std::left << std::setw(22) << policy.first
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(11) << all.count()
+                  << std::setw(8) << all.quantile(0.5)
+                  << std::setw(8) << all.quantile(0.99)
+                  << std::setw(11) << merged.forClass(distribution.minPriority).quantile(0.99)
+                  << std::setw(11) << merged.forClass(distribution.maxPriority).quantile(0.99)
+                  << std::setw(9) << all.max() << "\n";
+    }
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "Latency = time from becoming ready (arrival, wakeup, preemption or requeue) "
+              << "to running\n";
+}
+
+/**
+ * @brief Ask for a workload size and compare scheduling latency on it
+ */
+void runLatency() {
+    int numProcesses, replicas;
+    std::cout << "\nEnter number of processes per replica (e.g. 200): ";
+    std::cin >> numProcesses;
+    std::cout << "Enter number of replicas: ";
+    std::cin >> replicas;
+    if (numProcesses < 1 || replicas < 1) {
+        std::cout << "Processes and replicas must be positive\n";
+        return;
+    }
+    runLatencyComparison(numProcesses, replicas);
+}
+
+/**
+ * @brief Compare aging settings of the priority and MLFQ policies on fairness
+ *
+ * Each row merges the fairness statistics of every replica. Round Robin,
+ * which ignores priorities, is the reference for an even share.
+ */
+void runFairnessComparison(int numProcesses, int replicas) {
+    WorkloadDistribution distribution;
+    distribution.numProcesses = numProcesses;
+    distribution.meanInterarrival = distribution.meanBurst / 0.9;
+    WorkloadGenerator generator(distribution);
+    std::vector<std::pair<std::string, SchedulerFactory>> policies = {
+        {"Round Robin (Q=3)", []() { return std::unique_ptr<Scheduler>(new RoundRobinScheduler(3, 0)); }},
+    };
+    policies.emplace_back("Priority, no aging", []() {
+        return std::unique_ptr<Scheduler>(new PriorityScheduler(true, false, 5, 0));
+    });
+    for (int interval : {20, 10, 5, 2}) {
+        policies.emplace_back("Priority, aging " + std::to_string(interval), [interval]() {
+            return std::unique_ptr<Scheduler>(new PriorityScheduler(true, true, interval, 0));
+        });
+    }
+    policies.emplace_back("MLFQ, no aging", []() {
+        return std::unique_ptr<Scheduler>(new MultilevelFeedbackQueueScheduler(3, false, 10, 0));
+    });
+    for (int threshold : {10, 5, 3}) {
+        policies.emplace_back("MLFQ, aging " + std::to_string(threshold), [threshold]() {
+            return std::unique_ptr<Scheduler>(new MultilevelFeedbackQueueScheduler(3, true, threshold, 0));
+        });
+    }
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "FAIRNESS AND AGING: " << replicas << " x " << numProcesses
+              << " processes on 1 CPU at 90% load, priorities "
+              << distribution.minPriority << " (urgent) to " << distribution.maxPriority << "\n";
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::left << std::setw(22) << "Policy"
+              << std::right << std::setw(9) << "Avg SD"
+              << std::setw(9) << "p99 SD"
+              << std::setw(11) << "p99 SD " + std::to_string(distribution.maxPriority)
+              << std::setw(9) << "Jain"
+              << std::setw(10) << "Classes"
+              << std::setw(10) << "Starved" << "\n";
+    std::cout << std::string(80, '-') << "\n";
+    for (const auto& policy : policies) {
+        FairnessStats merged;
+        for (int replica = 0; replica < replicas; replica++) {
+            auto scheduler = policy.second();
+            for (const auto& p : generator.generate(static_cast<uint64_t>(replica) + 1)) {
+                scheduler->addProcess(p);
+            }
+            scheduler->schedule();
+            merged.merge(scheduler->getFairness());
+        }
+        const ClassFairness& all = merged.overall();
+        std::cout << std::left << std::setw(22) << policy.first
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << all.slowdown.mean()
+                  << std::setw(9) << all.slowdown.quantile(0.99)
+                  << std::setw(11) << merged.forClass(distribution.maxPriority).slowdown.quantile(0.99)
+                  << std::setw(9) << all.jainIndex()
+                  << std::setw(10) << merged.classJainIndex()
+                  << std::setw(10) << all.maxStarvation << "\n";
+    }
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "SD = slowdown (turnaround / burst); Jain over process and class CPU shares "
+              << "(1 = equal);\nStarved = longest wait of a ready process for the CPU\n";
+}
+
+/**
+ * @brief Ask for a workload size and compare aging settings on it
+ */
+void runFairness() {
+    int numProcesses, replicas;
+    std::cout << "\nEnter number of processes per replica (e.g. 200): ";
+    std::cin >> numProcesses;
+    std::cout << "Enter number of replicas: ";
+    std::cin >> replicas;
+    if (numProcesses < 1 || replicas < 1) {
+        std::cout << "Processes and replicas must be positive\n";
+        return;
+    }
+    runFairnessComparison(numProcesses, replicas);
+}
+
+/**
+ * @brief Run one policy with top-consumer and starvation tracking and print its row
+ *
+ * @return The top five consumers of the run
+ */
+template <typename Policy>
+std::vector<HeavyHitter> runStarvationScenario(const std::string& label, int numCpus, int watchdog,
+                                               const std::vector<std::shared_ptr<Process>>& workload) {
+    ExtScheduler<Policy> scheduler(numCpus, 1, 0);
+    scheduler.setTopConsumers(64);
+    scheduler.setStarvationTracking(true);
+    scheduler.setWatchdogTimeout(watchdog);
+    for (const auto& p : workload) {
+        scheduler.addProcess(std::make_shared<Process>(p->getPID(), p->getName(), p->getArrivalTime(),
+                                                       p->getBurstTime(), p->getPriority()));
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    scheduler.schedule();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const StarvationTracker& starvation = *scheduler.getStarvation();
+    int worst = starvation.getWorstId();
+    std::cout << std::left << std::setw(26) << label
+              << std::right << std::setw(10) << worst
+              << std::setw(7) << (worst > 0 ? workload[static_cast<size_t>(worst - 1)]->getPriority() : 0)
+              << std::setw(11) << starvation.getWorstWait()
+              << std::setw(10) << (scheduler.getExitReason().empty() ? "no" : "yes")
+              << std::fixed << std::setprecision(2)
+              << std::setw(8) << elapsed.count() << "\n";
+    return scheduler.getTopConsumers()->top(5);
+}
+
+/**
+ * @brief Find the heaviest CPU consumers and the most-starved process without per-process history
+ *
+ * Arrivals offer 90% of the CPUs and nice values span -20 to 19. Eight
+ * long-running hogs each need 3% of all the work, enough for 64 counters
+ * to single them out. Global FIFO starves nobody for long; strict priority
+ * bands starve the nice 10..19 band, which the sched_ext watchdog then
+ * catches. Both trackers use memory independent of the number of
+ * processes: 64 counters, and one heap entry per READY process.
+ */
+void runStarvationComparison(int numCpus, int numProcesses) {
+    const int hogs = 8;
+    const double hogShare = 0.03;
+    WorkloadDistribution distribution;
+    distribution.numProcesses = numProcesses;
+    distribution.meanInterarrival = distribution.meanBurst / ((1.0 - hogs * hogShare) * 0.9 * numCpus);
+    distribution.minPriority = -20;
+    distribution.maxPriority = 19;
+    auto workload = WorkloadGenerator(distribution).generate(1);
+    int hogBurst = std::max(1, static_cast<int>(hogShare / (1.0 - hogs * hogShare) * numProcesses *
+                                                distribution.meanBurst));
+    for (int h = 1; h <= hogs; h++) {
+        size_t i = static_cast<size_t>(numProcesses) * h / (hogs + 1);
+        const Process& p = *workload[i];
+        workload[i] = std::make_shared<Process>(p.getPID(), p.getName(), p.getArrivalTime(), hogBurst,
+                                                p.getPriority());
+    }
+    const int watchdog = 50;
+    
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "TOP CONSUMERS AND STARVATION: " << numProcesses << " processes on " << numCpus
+              << " CPUs at 90% load\n";
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::left << std::setw(26) << "Policy"
+              << std::right << std::setw(10) << "Starved"
+              << std::setw(7) << "Nice"
+              << std::setw(11) << "Waited"
+              << std::setw(10) << "Aborted"
+              << std::setw(8) << "Secs" << "\n";
+    std::cout << std::string(80, '-') << "\n";
+    std::vector<HeavyHitter> top = runStarvationScenario<ExtPolicy>("Global FIFO", numCpus, 0, workload);
+    runStarvationScenario<ExtPriorityPolicy>("Priority Bands", numCpus, 0, workload);
+    runStarvationScenario<ExtPriorityPolicy>("Priority Bands, watchdog " + std::to_string(watchdog),
+                                             numCpus, watchdog, workload);
+    std::cout << std::string(80, '-') << "\n";
+    std::cout << "Top CPU consumers (64 counters):\n";
+    for (const HeavyHitter& hitter : top) {
+        std::cout << "  PID " << std::left << std::setw(10) << hitter.id
+                  << std::right << std::setw(10) << hitter.count << " time units";
+        if (hitter.error > 0) {
+            std::cout << " (may be " << hitter.error << " too high)";
+        }
+        std::cout << "\n";
+    }
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "Starved = PID of the longest wait for a CPU, Waited = that wait\n";
+}
+
+/**
+ * @brief Ask for a machine size and find its top consumers and most-starved process
+ */
+void runStarvation() {
+    int numCpus, numProcesses;
+    std::cout << "\nEnter number of CPUs (e.g. 16): ";
+    std::cin >> numCpus;
+    std::cout << "Enter number of processes: ";
+    std::cin >> numProcesses;
+    if (numCpus < 1 || numProcesses < 1) {
+        std::cout << "CPUs and processes must be positive\n";
+        return;
+    }
+    runStarvationComparison(numCpus, numProcesses);
+}
+
+/**
+ * @brief Non-interactive comparison of the standard line-up and plugins
+ *
+ * Usage: scheduler_sim --plugin PATH[:ARGS] ... [--processes N] [--replicas N]
+ *        scheduler_sim --swf PATH [--cores N]
+ *        scheduler_sim --cluster NODES [--tasks N] [--epoch N]
+ *        scheduler_sim --trace google|alibaba:PATH [--window START:END]
+ *                      [--machines A,B,...] [--cluster NODES] [--epoch N]
+ *        scheduler_sim --dag TASKS [--width N] [--cores N]
+ *        scheduler_sim --closed-loop MAXUSERS [--think N] [--service N] [--cores N]
+ *        scheduler_sim --rpc WORKERS [--quantum NS]
+ *        scheduler_sim --vms N [--vcpus N] [--cores N]
+ *        scheduler_sim --irq MEAN_INTERARRIVAL [--processes N]
+ *        scheduler_sim --hotplug CPUS [--processes N]
+ *        scheduler_sim --smt CORES [--processes N]
+ *        scheduler_sim --memory CPUS [--processes N]
+ *        scheduler_sim --failures CPUS [--processes N]
+ *        scheduler_sim --latency PROCESSES [--replicas N]
+ *        scheduler_sim --fairness PROCESSES [--replicas N]
+ *        scheduler_sim --starvation CPUS [--processes N]
+ *
+ * @return int Exit status (1 if an argument or plugin is invalid)
+ */
+int runBatch(int argc, char* argv[]) {
+    WorkloadDistribution distribution;
+    MonteCarloConfig config;
+    std::vector<std::string> specs;
+    std::string swfPath;
+    int cores = 0;
+    ClusterConfig cluster;
+    cluster.numNodes = 0;
+    int tasksPerNode = 100;
+    std::string traceSpec;
+    TraceFilter traceFilter;
+    int dagTasks = 0;
+    int dagWidth = 100;
+    int closedLoopUsers = 0;
+    ClosedLoopConfig closedLoop;
+    RpcServerConfig rpc;
+    rpc.workers = 0;
+    int numVms = 0;
+    int vcpusPerVm = 2;
+    double irqInterarrival = 0.0;
+    int hotplugCpus = 0;
+    int smtCores = 0;
+    int memoryCpus = 0;
+    int failureCpus = 0;
+    int latencyProcesses = 0;
+    int fairnessProcesses = 0;
+    int starvationCpus = 0;
+    
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << option << "\n";
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (option == "--plugin") {
+            specs.push_back(value);
+        } else if (option == "--processes") {
+            distribution.numProcesses = std::atoi(value.c_str());
+        } else if (option == "--replicas") {
+            config.maxReplicas = std::atoi(value.c_str());
+        } else if (option == "--swf") {
+            swfPath = value;
+        } else if (option == "--cores") {
+            cores = std::atoi(value.c_str());
+        } else if (option == "--cluster") {
+            cluster.numNodes = std::atoi(value.c_str());
+        } else if (option == "--tasks") {
+            tasksPerNode = std::atoi(value.c_str());
+        } else if (option == "--epoch") {
+            cluster.epochLength = std::atoi(value.c_str());
+        } else if (option == "--trace") {
+            traceSpec = value;
+        } else if (option == "--window") {
+            parseTraceWindow(value, traceFilter);
+        } else if (option == "--machines") {
+            parseTraceMachines(value, traceFilter);
+        } else if (option == "--dag") {
+            dagTasks = std::atoi(value.c_str());
+        } else if (option == "--width") {
+            dagWidth = std::atoi(value.c_str());
+        } else if (option == "--closed-loop") {
+            closedLoopUsers = std::atoi(value.c_str());
+        } else if (option == "--think") {
+            closedLoop.meanThink = std::atof(value.c_str());
+        } else if (option == "--service") {
+            closedLoop.meanService = std::atof(value.c_str());
+        } else if (option == "--rpc") {
+            rpc.workers = std::atoi(value.c_str());
+        } else if (option == "--quantum") {
+            rpc.quantum = std::atoll(value.c_str());
+        } else if (option == "--vms") {
+            numVms = std::atoi(value.c_str());
+        } else if (option == "--vcpus") {
+            vcpusPerVm = std::atoi(value.c_str());
+        } else if (option == "--irq") {
+            irqInterarrival = std::atof(value.c_str());
+        } else if (option == "--hotplug") {
+            hotplugCpus = std::atoi(value.c_str());
+        } else if (option == "--smt") {
+            smtCores = std::atoi(value.c_str());
+        } else if (option == "--memory") {
+            memoryCpus = std::atoi(value.c_str());
+        } else if (option == "--failures") {
+            failureCpus = std::atoi(value.c_str());
+        } else if (option == "--latency") {
+            latencyProcesses = std::atoi(value.c_str());
+        } else if (option == "--fairness") {
+            fairnessProcesses = std::atoi(value.c_str());
+        } else if (option == "--starvation") {
+            starvationCpus = std::atoi(value.c_str());
+        } else {
+            std::cerr << "Unknown option " << option << "\n"
+                      << "Usage: " << argv[0]
+                      << " --plugin PATH[:ARGS] ... [--processes N] [--replicas N]\n"
+                      << "       " << argv[0] << " --swf PATH [--cores N]\n"
+                      << "       " << argv[0] << " --cluster NODES [--tasks N] [--epoch N]\n"
+                      << "       " << argv[0] << " --trace google|alibaba:PATH [--window START:END]"
+                      << " [--machines A,B,...] [--cluster NODES] [--epoch N]\n"
+                      << "       " << argv[0] << " --dag TASKS [--width N] [--cores N]\n"
+                      << "       " << argv[0]
+                      << " --closed-loop MAXUSERS [--think N] [--service N] [--cores N]\n"
+                      << "       " << argv[0] << " --rpc WORKERS [--quantum NS]\n"
+                      << "       " << argv[0] << " --vms N [--vcpus N] [--cores N]\n"
+                      << "       " << argv[0] << " --irq MEAN_INTERARRIVAL [--processes N]\n"
+                      << "       " << argv[0] << " --hotplug CPUS [--processes N]\n"
+                      << "       " << argv[0] << " --smt CORES [--processes N]\n"
+                      << "       " << argv[0] << " --memory CPUS [--processes N]\n"
+                      << "       " << argv[0] << " --failures CPUS [--processes N]\n"
+                      << "       " << argv[0] << " --latency PROCESSES [--replicas N]\n"
+                      << "       " << argv[0] << " --fairness PROCESSES [--replicas N]\n"
+                      << "       " << argv[0] << " --starvation CPUS [--processes N]\n";
+            return 1;
+        }
+    }
+    if (!swfPath.empty()) {
+        return replaySwf(swfPath, cores) ? 0 : 1;
+    }
+    if (dagTasks > 0) {
+        if (dagWidth < 1) {
+            std::cerr << "--width must be positive\n";
+            return 1;
+        }
+        runWorkflowComparison(Workflow::layered(dagTasks, dagWidth, 4, 1, 20, 1),
+                              cores > 0 ? cores : 64);
+        return 0;
+    }
+    if (irqInterarrival > 0) {
+        // At 100 interrupts per time unit: 0.5% of core 0 in hardirq, 10% in softirq
+        runInterruptComparison(irqInterarrival, 0.00005, 0.001, std::max(1, distribution.numProcesses));
+        return 0;
+    }
+    if (latencyProcesses > 0 || fairnessProcesses > 0) {
+        // --replicas defaults to 5 here, not to the Monte Carlo bound
+        int replicas = config.maxReplicas == MonteCarloConfig().maxReplicas ? 5 : config.maxReplicas;
+        if (replicas < 1) {
+            std::cerr << "--replicas must be positive\n";
+            return 1;
+        }
+        if (latencyProcesses > 0) {
+            runLatencyComparison(latencyProcesses, replicas);
+        } else {
+            runFairnessComparison(fairnessProcesses, replicas);
+        }
+        return 0;
+    }
+    if (starvationCpus > 0) {
+        runStarvationComparison(starvationCpus, std::max(1, distribution.numProcesses));
+        return 0;
+    }
+    if (failureCpus > 0) {
+        runFailureComparison(failureCpus, std::max(1, distribution.numProcesses));
+        return 0;
+    }
+    if (memoryCpus > 0) {
+        runMemoryComparison(memoryCpus, std::max(1, distribution.numProcesses));
+        return 0;
+    }
+    if (smtCores > 0) {
+        runSmtComparison(smtCores, std::max(1, distribution.numProcesses));
+        return 0;
+    }
+    if (hotplugCpus > 0) {
+        if (hotplugCpus < 2) {
+            std::cerr << "--hotplug needs at least 2 CPUs\n";
+            return 1;
+        }
+        runHotplugComparison(hotplugCpus, std::max(1, distribution.numProcesses));
+        return 0;
+    }
+    if (numVms > 0) {
+        if (vcpusPerVm < 1) {
+            std::cerr << "--vcpus must be positive\n";
+            return 1;
+        }
+        // Default: overcommit vCPUs 4:1
+        runHypervisorComparison(numVms, vcpusPerVm, cores > 0 ? cores : std::max(1, numVms * vcpusPerVm / 4),
+                                HostConfig().timeslice);
+        return 0;
+    }
+    if (rpc.workers > 0) {
+        runRpcComparison(rpc);
+        return 0;
+    }
+    if (closedLoopUsers > 0) {
+        closedLoop.cpus = cores > 0 ? cores : 1;
+        runClosedLoopSweep(closedLoop, closedLoopUsers);
+        return 0;
+    }
+    if (!traceSpec.empty()) {
+        size_t colon = traceSpec.find(':');
+        TraceFormat format;
+        if (colon == std::string::npos || !TraceImporter::parseFormat(traceSpec.substr(0, colon), format)) {
+            std::cerr << "--trace expects google:PATH or alibaba:PATH\n";
+            return 1;
+        }
+        std::vector<std::shared_ptr<Process>> jobs;
+        if (!importTrace(format, traceSpec.substr(colon + 1), traceFilter, jobs)) {
+            return 1;
+        }
+        if (cluster.numNodes <= 0) {
+            cluster.numNodes = ClusterConfig().numNodes;
+        }
+        if (!jobs.empty()) {
+            runClusterComparison(cluster, jobs, 4);
+        }
+        return 0;
+    }
+    if (cluster.numNodes > 0) {
+        if (tasksPerNode < 1 || cluster.epochLength < 1) {
+            std::cerr << "--tasks and --epoch must be positive\n";
+            return 1;
+        }
+        runClusterComparison(cluster, generateClusterJobs(cluster, tasksPerNode), 4);
+        return 0;
+    }
+    
+    MonteCarloComparison comparison(distribution, config);
+    addStandardPolicies(comparison);
+    for (const auto& spec : specs) {
+        std::string path, args, error;
+        splitPluginSpec(spec, path, args);
+        std::shared_ptr<PolicyPlugin> plugin = PolicyPlugin::load(path, error);
+        if (!plugin || !plugin->create(args)) {
+            std::cerr << "Cannot load plugin " << spec << ": "
+                      << (plugin ? "arguments rejected" : error) << "\n";
+            return 1;
+        }
+        // The factory holds the plugin, so the library outlives every scheduler
+        std::string label = plugin->getName() + (args.empty() ? "" : " [" + args + "]");
+        comparison.addPolicy(label, [plugin, args]() {
+            return plugin->create(args);
+        });
+    }
+    
+    comparison.run();
+    comparison.displayResults();
+    return 0;
+}
+
 /**
  * @brief Main function
+ *
+ * Without arguments, runs the interactive menu; with arguments, runs
+ * runBatch().
  */
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return runBatch(argc, argv);
+    }
+    
     while (true) {
         int choice = displayMenu();
         
@@ -266,6 +2271,72 @@ int main() {
             case 6:
                 compareAll();
                 break;
+            case 7:
+                runStatisticalComparison();
+                break;
+            case 8:
+                runAnalyticEstimate();
+                break;
+            case 9:
+                runO1();
+                break;
+            case 10:
+                runSkipList();
+                break;
+            case 11:
+                runExt();
+                break;
+            case 12:
+                runPlugin();
+                break;
+            case 13:
+                runBackfill();
+                break;
+            case 14:
+                runCluster();
+                break;
+            case 15:
+                runTrace();
+                break;
+            case 16:
+                runWorkflow();
+                break;
+            case 17:
+                runLockProtocols();
+                break;
+            case 18:
+                runClosedLoop();
+                break;
+            case 19:
+                runRpcServer();
+                break;
+            case 20:
+                runHypervisor();
+                break;
+            case 21:
+                runInterrupts();
+                break;
+            case 22:
+                runHotplug();
+                break;
+            case 23:
+                runSmt();
+                break;
+            case 24:
+                runMemory();
+                break;
+            case 25:
+                runFailures();
+                break;
+            case 26:
+                runLatency();
+                break;
+            case 27:
+                runFairness();
+                break;
+            case 28:
+                runStarvation();
+                break;
             case 0:
                 std::cout << "\nThank you for using the CPU Scheduler Simulator!\n";
                 return 0;
@@ -3,10 +3,39 @@
 #include "../include/PriorityScheduler.h"
 #include "../include/MultilevelQueueScheduler.h"
 #include "../include/MultilevelFeedbackQueueScheduler.h"
+#include "../include/O1Scheduler.h"
+#include "../include/SkipListScheduler.h"
+#include "../include/ExtPolicies.h"
+#include "../include/PolicyPlugin.h"
+#include "../include/MonteCarloComparison.h"
+#include "../include/ParallelFor.h"
+#include "../include/AnalyticEstimator.h"
+#include "../include/TimerWheel.h"
+#include "../include/FutureEventSet.h"
+#include "../include/BatchSimulator.h"
+#include "../include/ClusterSimulator.h"
+#include "../include/TraceImporter.h"
+#include "../include/WorkflowScheduler.h"
+#include "../include/ClosedLoopSimulator.h"
+#include "../include/RpcServerSimulator.h"
+#include "../include/HypervisorSimulator.h"
+#include "../include/InterruptModel.h"
+#include "../include/CpuSet.h"
+#include "../include/MemoryModel.h"
 #include <iostream>
+#include <sstream>
 #include <cassert>
 #include <memory>
 #include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#ifndef PLUGIN_BIN_DIR
+#define PLUGIN_BIN_DIR "bin"
+#endif
 
 /**
  * @file test_scheduler.cpp
@@ -341,6 +370,32 @@ bool test_mlfq_aging() {
     return true;
 }
 
+/**
+ * @brief Test that MLFQ aging promotes a demoted process off the time grid
+ */
+bool test_mlfq_aging_promotes() {
+    // A stream of short arrivals keeps level 0 busy for 90 units. With a
+    // switch cost of 1 the clock seldom lands on a multiple of 4
+    int starvation[2];
+    for (int aging = 0; aging < 2; aging++) {
+        MultilevelFeedbackQueueScheduler scheduler(3, aging == 1, 4, 1);
+        scheduler.setTimeQuantum(0, 3);
+        scheduler.setTimeQuantum(1, 5);
+        scheduler.setTimeQuantum(2, 7);
+        scheduler.addProcess(std::make_shared<Process>(1, "Long", 0, 20, 0));
+        for (int i = 0; i < 30; i++) {
+            scheduler.addProcess(std::make_shared<Process>(i + 2, "S" + std::to_string(i), 1 + 3 * i, 3, 0));
+        }
+        scheduler.schedule();
+        starvation[aging] = scheduler.calculateMetrics().maxStarvationTime;
+    }
+
+    TEST_ASSERT(starvation[0] > 80, "Without aging the long process should wait out the stream");
+    TEST_ASSERT(starvation[1] < starvation[0] / 2, "Aging should promote it during the stream");
+
+    return true;
+}
+
 // ============================================================================
 // Performance and Edge Case Tests
 // ============================================================================
@@ -411,54 +466,2688 @@ bool test_context_switch_overhead() {
     return true;
 }
 
+/**
+ * @brief Test that quantum-based policies count and charge switches between quanta
+ */
+bool test_context_switches_between_quanta() {
+    // Quantum 2, overhead 1, two 4-unit processes: P1 0-2, switch, P2 3-5,
+    // switch, P1 6-8. P2 follows a completion, which is not a switch: 8-10
+    auto addPair = [](Scheduler& scheduler) {
+        scheduler.addProcess(std::make_shared<Process>(1, "P1", 0, 4, 0));
+        scheduler.addProcess(std::make_shared<Process>(2, "P2", 0, 4, 0));
+    };
+
+    RoundRobinScheduler rr(2, 1);
+    MultilevelQueueScheduler mlq(1);
+    mlq.addQueueConfig(QueueConfig(0, QueueSchedulingAlgorithm::ROUND_ROBIN, 2));
+    MultilevelFeedbackQueueScheduler mlfq(3, false, 10, 1);
+    mlfq.setTimeQuantum(0, 2);
+    mlfq.setTimeQuantum(1, 4);
+    mlfq.setTimeQuantum(2, 8);
+
+    for (Scheduler* scheduler : std::initializer_list<Scheduler*>{&rr, &mlq, &mlfq}) {
+        addPair(*scheduler);
+        scheduler->schedule();
+        SchedulingMetrics metrics = scheduler->calculateMetrics();
+
+        TEST_ASSERT(metrics.totalContextSwitches == 2, "Two switches between quanta");
+        TEST_ASSERT(metrics.totalTime == 10, "Each switch should cost its overhead");
+        TEST_ASSERT(scheduler->getProcesses()[0]->getTurnaroundTime() == 8, "P1 should finish at 8");
+        TEST_ASSERT(scheduler->getProcesses()[1]->getTurnaroundTime() == 10, "P2 should finish at 10");
+    }
+
+    // The interactive sample workload under Round Robin (quantum 2, free switches)
+    RoundRobinScheduler sample(2, 0);
+    sample.addProcess(std::make_shared<Process>(1, "P1", 0, 10, 2));
+    sample.addProcess(std::make_shared<Process>(2, "P2", 1, 5, 1));
+    sample.addProcess(std::make_shared<Process>(3, "P3", 2, 8, 3));
+    sample.addProcess(std::make_shared<Process>(4, "P4", 3, 4, 2));
+    sample.addProcess(std::make_shared<Process>(5, "P5", 4, 6, 1));
+    sample.schedule();
+    TEST_ASSERT(sample.calculateMetrics().totalContextSwitches == 12,
+               "Sample workload should switch 12 times");
+
+    return true;
+}
+
+/**
+ * @brief Test that every policy reports waiting time as turnaround minus burst
+ */
+bool test_waiting_time_accounting() {
+    // Arrivals land in the middle of quanta and every switch costs 1
+    WorkloadDistribution distribution;
+    distribution.numProcesses = 40;
+    distribution.meanInterarrival = 2.0;
+    distribution.meanBurst = 5.0;
+    auto workload = WorkloadGenerator(distribution).generate(17);
+
+    RoundRobinScheduler rr(3, 1);
+    MultilevelQueueScheduler mlq(1);
+    mlq.addQueueConfig(QueueConfig(1, QueueSchedulingAlgorithm::ROUND_ROBIN, 2));
+    mlq.addQueueConfig(QueueConfig(3, QueueSchedulingAlgorithm::FCFS, 0));
+    MultilevelFeedbackQueueScheduler mlfq(3, true, 5, 1);
+    PriorityScheduler priority(true, false, 10, 1);
+
+    for (Scheduler* scheduler : std::initializer_list<Scheduler*>{&rr, &mlq, &mlfq, &priority}) {
+        for (const auto& process : workload) {
+            scheduler->addProcess(std::make_shared<Process>(*process));
+        }
+        scheduler->schedule();
+        SchedulingMetrics metrics = scheduler->calculateMetrics();
+
+        double burst = 0;
+        for (const auto& p : scheduler->getProcesses()) {
+            TEST_ASSERT(p->getWaitingTime() == p->getTurnaroundTime() - p->getBurstTime(),
+                       "Waiting time should be turnaround minus burst");
+            burst += p->getBurstTime();
+        }
+        burst /= workload.size();
+        TEST_ASSERT(std::fabs(metrics.averageTurnaroundTime - metrics.averageWaitingTime - burst) < 1e-9,
+                   "Average waiting time should be average turnaround minus average burst");
+    }
+
+    return true;
+}
+
 // ============================================================================
-// Main Test Runner
+// Reproducibility Tests
 // ============================================================================
 
-int main() {
-    std::cout << "==========================================\n";
-    std::cout << "CPU SCHEDULER SIMULATOR - TEST SUITE\n";
-    std::cout << "==========================================\n\n";
+/**
+ * @brief Test that equal priority and arrival are broken by PID, not insertion order
+ */
+bool test_tie_break_by_pid() {
+    PriorityScheduler scheduler(false, false, 5, 0);
     
-    // Process tests
-    std::cout << "Process Class Tests:\n";
-    std::cout << "--------------------\n";
-    RUN_TEST(test_process_creation);
-    RUN_TEST(test_process_execution);
-    RUN_TEST(test_process_execution_overflow);
-    RUN_TEST(test_process_metrics);
-    RUN_TEST(test_process_reset);
+    // Added in reverse PID order on purpose
+    scheduler.addProcess(std::make_shared<Process>(2, "B", 0, 4, 1));
+    scheduler.addProcess(std::make_shared<Process>(1, "A", 0, 3, 1));
     
-    // Round Robin tests
-    std::cout << "\nRound Robin Scheduler Tests:\n";
-    std::cout << "----------------------------\n";
-    RUN_TEST(test_round_robin_basic);
-    RUN_TEST(test_round_robin_arrivals);
+    scheduler.schedule();
     
-    // Priority Scheduler tests
-    std::cout << "\nPriority Scheduler Tests:\n";
-    std::cout << "-------------------------\n";
-    RUN_TEST(test_priority_non_preemptive);
-    RUN_TEST(test_priority_preemptive);
-    RUN_TEST(test_priority_aging);
+    auto processes = scheduler.getProcesses();
+    TEST_ASSERT(processes[1]->getCompletionTime() == 3, "PID 1 should run first");
+    TEST_ASSERT(processes[0]->getCompletionTime() == 7, "PID 2 should run second");
     
-    // Multilevel Queue tests
-    std::cout << "\nMultilevel Queue Tests:\n";
-    std::cout << "----------------------\n";
-    RUN_TEST(test_multilevel_queue);
+    return true;
+}
+
+/**
+ * @brief Test that the seed orders processes sharing arrival time and PID
+ */
+bool test_tie_break_seed() {
+    // Which of two processes with PID 1, both arriving at 0, runs first under a seed
+    auto firstToRun = [](uint64_t seed, const std::string& policy) {
+        std::unique_ptr<Scheduler> scheduler;
+        if (policy == "priority") {
+            scheduler.reset(new PriorityScheduler(false, false, 5, 0));
+        } else {
+            scheduler.reset(new RoundRobinScheduler(10, 0));
+        }
+        scheduler->setTieBreakSeed(seed);
+        scheduler->addProcess(std::make_shared<Process>(1, "A", 0, 3, 1));
+        scheduler->addProcess(std::make_shared<Process>(1, "B", 0, 4, 1));
+        scheduler->schedule();
+        return scheduler->getProcesses()[0]->getStartTime() == 0 ? std::string("A") : std::string("B");
+    };
+    
+    for (const std::string policy : {"priority", "rr"}) {
+        bool aFirst = false;
+        bool bFirst = false;
+        for (uint64_t seed = 0; seed < 16; seed++) {
+            std::string first = firstToRun(seed, policy);
+            TEST_ASSERT(first == firstToRun(seed, policy), "The same seed should give the same order");
+            aFirst = aFirst || first == "A";
+            bFirst = bFirst || first == "B";
+        }
+        TEST_ASSERT(aFirst && bFirst, "Changing the seed should flip the order of tied processes");
+    }
     
-    // MLFQ tests
-    std::cout << "\nMultilevel Feedback Queue Tests:\n";
-    std::cout << "--------------------------------\n";
-    RUN_TEST(test_mlfq_basic);
-    RUN_TEST(test_mlfq_aging);
+    // Distinct PIDs are never reordered by the seed
+    for (uint64_t seed = 0; seed < 16; seed++) {
+        PriorityScheduler scheduler(false, false, 5, 0);
+        scheduler.setTieBreakSeed(seed);
+        scheduler.addProcess(std::make_shared<Process>(2, "B", 0, 4, 1));
+        scheduler.addProcess(std::make_shared<Process>(1, "A", 0, 3, 1));
+        scheduler.schedule();
+        TEST_ASSERT(scheduler.getProcesses()[1]->getStartTime() == 0, "PID 1 should always run first");
+    }
     
-    // Edge case tests
-    std::cout << "\nEdge Case and Performance Tests:\n";
-    std::cout << "--------------------------------\n";
-    RUN_TEST(test_single_process);
-    RUN_TEST(test_same_arrival_time);
-    RUN_TEST(test_context_switch_overhead);
+    return true;
+}
+
+/**
+ * @brief Test that the timeline does not depend on the order processes were added
+ */
+bool test_fingerprint_insertion_order() {
+    RoundRobinScheduler forward(2, 0);
+    RoundRobinScheduler backward(2, 0);
+    
+    for (int pid = 1; pid <= 4; pid++) {
+        forward.addProcess(std::make_shared<Process>(pid, "P" + std::to_string(pid), 0, 3 + pid, 0));
+    }
+    for (int pid = 4; pid >= 1; pid--) {
+        backward.addProcess(std::make_shared<Process>(pid, "P" + std::to_string(pid), 0, 3 + pid, 0));
+    }
+    
+    forward.schedule();
+    backward.schedule();
+    
+    TEST_ASSERT(forward.getRunFingerprint() == backward.getRunFingerprint(),
+               "Fingerprint should not depend on insertion order");
+    for (const auto& p : forward.getProcesses()) {
+        for (const auto& q : backward.getProcesses()) {
+            if (p->getPID() == q->getPID()) {
+                TEST_ASSERT(p->getCompletionTime() == q->getCompletionTime(),
+                           "Completion times should match per PID");
+            }
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Test that the fingerprint is stable across runs and sensitive to the schedule
+ */
+bool test_run_fingerprint() {
+    auto run = [](int quantum) {
+        RoundRobinScheduler scheduler(quantum, 0);
+        scheduler.addProcess(std::make_shared<Process>(1, "P1", 0, 5, 0));
+        scheduler.addProcess(std::make_shared<Process>(2, "P2", 1, 3, 0));
+        scheduler.schedule();
+        return scheduler.getRunFingerprint();
+    };
+    
+    TEST_ASSERT(run(2) == run(2), "Identical runs should have identical fingerprints");
+    TEST_ASSERT(run(2) != run(4), "Different schedules should have different fingerprints");
+    
+    // Executing one unit at a time or in one slice is the same timeline
+    PriorityScheduler unit(true, false, 5, 0);
+    PriorityScheduler whole(false, false, 5, 0);
+    unit.addProcess(std::make_shared<Process>(1, "P1", 0, 5, 0));
+    whole.addProcess(std::make_shared<Process>(1, "P1", 0, 5, 0));
+    unit.schedule();
+    whole.schedule();
+    TEST_ASSERT(unit.getRunFingerprint() == whole.getRunFingerprint(),
+               "Adjacent slices of one process should be merged");
+    
+    return true;
+}
+
+// ============================================================================
+// Monte Carlo Comparison Tests
+// ============================================================================
+
+/**
+ * @brief Test that workload replicas are reproducible from their seed
+ */
+bool test_workload_generator_reproducible() {
+    WorkloadDistribution distribution;
+    distribution.numProcesses = 50;
+    WorkloadGenerator generator(distribution);
+    
+    auto first = generator.generate(42);
+    auto second = generator.generate(42);
+    auto other = generator.generate(43);
+    
+    TEST_ASSERT(first.size() == 50, "Replica should contain 50 processes");
+    TEST_ASSERT(first[0]->getArrivalTime() == 0, "First process should arrive at time 0");
+    
+    bool differs = false;
+    for (size_t i = 0; i < first.size(); i++) {
+        TEST_ASSERT(first[i]->getArrivalTime() == second[i]->getArrivalTime() &&
+                    first[i]->getBurstTime() == second[i]->getBurstTime() &&
+                    first[i]->getPriority() == second[i]->getPriority(),
+                   "Same seed should give the same replica");
+        TEST_ASSERT(first[i]->getBurstTime() >= 1, "Bursts should be at least 1");
+        if (i > 0) {
+            TEST_ASSERT(first[i]->getArrivalTime() >= first[i-1]->getArrivalTime(),
+                       "Arrivals should be in order");
+        }
+        differs = differs || first[i]->getBurstTime() != other[i]->getBurstTime();
+    }
+    TEST_ASSERT(differs, "Different seeds should give different replicas");
+    
+    return true;
+}
+
+/**
+ * @brief Test Student-t critical values against tabulated values
+ */
+bool test_student_t_critical() {
+    TEST_ASSERT(std::fabs(studentTCritical(0.95, 1) - 12.706) < 1e-3, "t(0.975, 1) = 12.706");
+    TEST_ASSERT(std::fabs(studentTCritical(0.95, 2) - 4.303) < 1e-3, "t(0.975, 2) = 4.303");
+    TEST_ASSERT(std::fabs(studentTCritical(0.95, 10) - 2.228) < 1e-3, "t(0.975, 10) = 2.228");
+    TEST_ASSERT(std::fabs(studentTCritical(0.99, 30) - 2.750) < 1e-3, "t(0.995, 30) = 2.750");
+    
+    return true;
+}
+
+/**
+ * @brief Build a two-policy comparison used by the Monte Carlo tests
+ */
+static MonteCarloComparison makeComparison(const MonteCarloConfig& config) {
+    WorkloadDistribution distribution;
+    distribution.numProcesses = 15;
+    
+    MonteCarloComparison comparison(distribution, config);
+    comparison.addPolicy("Non-Preemptive Priority", []() {
+        return std::unique_ptr<Scheduler>(new PriorityScheduler(false, false, 5, 0));
+    });
+    comparison.addPolicy("MLFQ", []() {
+        return std::unique_ptr<Scheduler>(new MultilevelFeedbackQueueScheduler(3, true, 10, 0));
+    });
+    return comparison;
+}
+
+/**
+ * @brief Test that results do not depend on the number of worker threads
+ */
+bool test_monte_carlo_thread_independence() {
+    MonteCarloConfig config;
+    config.minReplicas = 24;
+    config.maxReplicas = 24;
+    
+    config.numThreads = 1;
+    MonteCarloComparison serial = makeComparison(config);
+    serial.run();
+    
+    config.numThreads = 4;
+    MonteCarloComparison parallel = makeComparison(config);
+    parallel.run();
+    
+    TEST_ASSERT(serial.getReplicasRun() == 24 && parallel.getReplicasRun() == 24,
+               "Both runs should execute all replicas");
+    for (size_t policy = 0; policy < 2; policy++) {
+        for (int r = 0; r < 24; r++) {
+            const SchedulingMetrics& a = serial.getSamples(policy)[r];
+            const SchedulingMetrics& b = parallel.getSamples(policy)[r];
+            TEST_ASSERT(a.averageTurnaroundTime == b.averageTurnaroundTime &&
+                        a.totalContextSwitches == b.totalContextSwitches,
+                       "Replica results should not depend on thread count");
+        }
+    }
+    
+    auto stats = serial.getStatistics();
+    const IntervalEstimate& tat = stats[0].metrics[static_cast<int>(ComparisonMetric::TURNAROUND_TIME)];
+    TEST_ASSERT(tat.samples == 24 && tat.halfWidth > 0 && tat.lower() < tat.mean,
+               "Turnaround interval should be estimated from all replicas");
+    
+    return true;
+}
+
+/**
+ * @brief Test that the run stops as soon as the intervals are tight enough
+ */
+bool test_monte_carlo_adaptive_stop() {
+    MonteCarloConfig config;
+    config.minReplicas = 20;
+    config.maxReplicas = 1000;
+    config.batchSize = 10;
+    config.relativePrecision = 10.0;   // Trivially satisfied
+    config.numThreads = 2;
+    
+    MonteCarloComparison comparison = makeComparison(config);
+    comparison.run();
+    
+    TEST_ASSERT(comparison.stoppedAdaptively(), "Loose precision target should stop early");
+    TEST_ASSERT(comparison.getReplicasRun() == 20, "Should stop right after the minimum replicas");
+    
+    auto paired = comparison.getPairedComparisons(0);
+    for (const auto& p : paired) {
+        if (p.policy == p.baseline) {
+            TEST_ASSERT(p.difference.mean == 0 && !p.significant,
+                       "A policy compared with itself should show no difference");
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Test that a throwing item reaches the caller after every thread is joined
+ */
+bool test_parallel_for_exception() {
+    std::vector<int> done(1000, 0);
+    bool caught = false;
+    try {
+        parallelFor(done.size(), 4, [&](size_t k) {
+            if (k == 10) {
+                throw std::runtime_error("item 10");
+            }
+            done[k] = 1;
+        });
+    } catch (const std::runtime_error& error) {
+        caught = std::string(error.what()) == "item 10";
+    }
+    TEST_ASSERT(caught, "The item's exception should be rethrown");
+    
+    caught = false;
+    try {
+        parallelForBlocks(100, 4, [](size_t begin, size_t) {
+            if (begin > 0) {
+                throw std::runtime_error("block");
+            }
+        });
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    TEST_ASSERT(caught, "A block's exception should be rethrown");
+    TEST_ASSERT(workerThreads(8, 3) == 3 && workerThreads(2, 0) == 1, "Threads are capped by the items");
+    
+    return true;
+}
+
+// ============================================================================
+// Analytic Estimator Tests
+// ============================================================================
+
+/**
+ * @brief Test the closed-form predictions against textbook values
+ */
+bool test_analytic_formulas() {
+    // M/M/1 with lambda = 0.5, E[S] = 1: T = E[S] / (1 - rho) = 2
+    QueueingParameters mm1;
+    mm1.arrivalRate = 0.5;
+    mm1.meanService = 1.0;
+    mm1.serviceSecondMoment = 2.0;
+    
+    AnalyticPrediction fcfs = AnalyticEstimator::predict(mm1, QueueDiscipline::FCFS);
+    AnalyticPrediction ps = AnalyticEstimator::predict(mm1, QueueDiscipline::PROCESSOR_SHARING);
+    TEST_ASSERT(fcfs.stable && std::fabs(fcfs.meanTurnaroundTime - 2.0) < 1e-9, "M/M/1 FCFS T should be 2");
+    TEST_ASSERT(std::fabs(ps.meanTurnaroundTime - 2.0) < 1e-9, "M/M/1 PS T should be 2");
+    
+    // Kleinrock's conservation law: with identical service, priority
+    // reorders the queue but leaves the mean waiting time unchanged
+    mm1.classShares = {0.25, 0.25, 0.5};
+    AnalyticPrediction np = AnalyticEstimator::predict(mm1, QueueDiscipline::NONPREEMPTIVE_PRIORITY);
+    TEST_ASSERT(std::fabs(np.meanTurnaroundTime - fcfs.meanTurnaroundTime) < 1e-9,
+               "Non-preemptive priority should conserve mean time in system");
+    TEST_ASSERT(np.classTurnaroundTimes.size() == 3 &&
+                np.classTurnaroundTimes[0] < np.classTurnaroundTimes[2],
+               "Higher priority class should see shorter turnaround");
+    
+    // Erlang C for 2 servers at 1 Erlang is 1/3
+    TEST_ASSERT(std::fabs(AnalyticEstimator::erlangC(2, 1.0) - 1.0 / 3.0) < 1e-12,
+               "Erlang C(2, 1) should be 1/3");
+    
+    mm1.arrivalRate = 1.5;
+    TEST_ASSERT(!AnalyticEstimator::predict(mm1, QueueDiscipline::FCFS).stable,
+               "Overloaded queue should be reported unstable");
+    
+    return true;
+}
+
+/**
+ * @brief Test that simulation agrees with Cobham's formula and that a wrong model is flagged
+ */
+bool test_analytic_matches_simulation() {
+    WorkloadDistribution distribution;
+    distribution.numProcesses = 1500;
+    distribution.meanInterarrival = 5.0;
+    distribution.meanBurst = 3.0;
+    
+    MonteCarloConfig config;
+    config.minReplicas = 8;
+    config.maxReplicas = 8;
+    MonteCarloComparison comparison(distribution, config);
+    comparison.addPolicy("Non-Preemptive Priority", []() {
+        return std::unique_ptr<Scheduler>(new PriorityScheduler(false, false, 5, 0));
+    });
+    comparison.run();
+    
+    QueueingParameters parameters = AnalyticEstimator::fromWorkload(distribution);
+    TEST_ASSERT(parameters.classShares.size() == 4, "Priorities 0..3 should give 4 classes");
+    
+    const IntervalEstimate& simulated =
+        comparison.getStatistics()[0].metrics[static_cast<int>(ComparisonMetric::TURNAROUND_TIME)];
+    AnalyticPrediction cobham =
+        AnalyticEstimator::predict(parameters, QueueDiscipline::NONPREEMPTIVE_PRIORITY);
+    AnalyticCheck check = AnalyticEstimator::check(cobham.meanTurnaroundTime, simulated, 0.15);
+    TEST_ASSERT(!check.disagrees, "Simulated turnaround should agree with Cobham's formula");
+    
+    // Same simulation against a much heavier load must be flagged
+    parameters.arrivalRate *= 1.5;
+    AnalyticPrediction wrong =
+        AnalyticEstimator::predict(parameters, QueueDiscipline::NONPREEMPTIVE_PRIORITY);
+    TEST_ASSERT(AnalyticEstimator::check(wrong.meanTurnaroundTime, simulated, 0.15).disagrees,
+               "A mismatched model should be flagged");
+    
+    return true;
+}
+
+// ============================================================================
+// Timer Wheel and Event-Driven Engine Tests
+// ============================================================================
+
+/**
+ * @brief Test that timers fire in expiry order across all wheel levels
+ */
+bool test_timer_wheel_ordering() {
+    TimerWheel wheel;
+    const int64_t expiries[] = {70, 5, 4100, 63, int64_t(1) << 26, 5, 64, 300000};
+    for (size_t i = 0; i < sizeof(expiries) / sizeof(expiries[0]); i++) {
+        wheel.schedule(expiries[i], i);
+    }
+    TEST_ASSERT(wheel.size() == 8, "All timers should be pending");
+    TEST_ASSERT(wheel.nextExpiry() == 5, "Earliest timer should expire at 5");
+    
+    TimerEvent event;
+    TEST_ASSERT(!wheel.popExpired(4, event), "No timer is due before 5");
+    
+    const int64_t expectedTimes[] = {5, 5, 63, 64, 70, 4100, 300000, int64_t(1) << 26};
+    const uint64_t expectedPayloads[] = {1, 5, 3, 6, 0, 2, 7, 4};
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT(wheel.popExpired(TimerWheel::NO_TIMER - 1, event), "Timer should fire");
+        TEST_ASSERT(event.expiry == expectedTimes[i], "Timers should fire in expiry order");
+        TEST_ASSERT(event.payload == expectedPayloads[i],
+                   "Equal expiries should fire in scheduling order");
+    }
+    TEST_ASSERT(wheel.empty(), "Wheel should be empty");
+    TEST_ASSERT(wheel.nextExpiry() == TimerWheel::NO_TIMER, "No timer should remain");
+    
+    return true;
+}
+
+/**
+ * @brief Test periodic re-arming and cancellation
+ */
+bool test_timer_wheel_periodic_cancel() {
+    TimerWheel wheel;
+    uint64_t tick = wheel.schedule(10, 1, 10);
+    uint64_t oneShot = wheel.schedule(25, 2);
+    
+    int ticks = 0;
+    TimerEvent event;
+    while (wheel.popExpired(35, event)) {
+        if (event.payload == 1) {
+            ticks++;
+        }
+    }
+    TEST_ASSERT(ticks == 3, "Periodic timer should fire at 10, 20 and 30");
+    TEST_ASSERT(!wheel.cancel(oneShot), "A fired one-shot timer cannot be cancelled");
+    TEST_ASSERT(wheel.nextExpiry() == 40, "Periodic timer should be re-armed at 40");
+    
+    TEST_ASSERT(wheel.cancel(tick), "Pending timer should be cancelled");
+    TEST_ASSERT(!wheel.cancel(tick), "A timer can only be cancelled once");
+    TEST_ASSERT(wheel.empty() && wheel.nextExpiry() == TimerWheel::NO_TIMER,
+               "No timer should remain after cancel");
+    TEST_ASSERT(!wheel.popExpired(1000, event), "Cancelled timer must not fire");
+    
+    return true;
+}
+
+/**
+ * @brief Test the event-driven priority scheduler: preemption, aging tick, idle skip
+ */
+bool test_priority_event_driven() {
+    PriorityScheduler preemptive(true, false, 5, 0);
+    preemptive.addProcess(std::make_shared<Process>(1, "P1", 0, 8, 3));
+    preemptive.addProcess(std::make_shared<Process>(2, "P2", 1, 4, 1));
+    preemptive.addProcess(std::make_shared<Process>(3, "P3", 5, 2, 2));
+    preemptive.schedule();
+    
+    auto processes = preemptive.getProcesses();
+    TEST_ASSERT(processes[1]->getCompletionTime() == 5, "P2 should preempt P1 and finish at 5");
+    TEST_ASSERT(processes[2]->getCompletionTime() == 7, "P3 should run before P1 resumes");
+    TEST_ASSERT(processes[0]->getCompletionTime() == 14, "P1 should finish at 14");
+    TEST_ASSERT(processes[0]->getWaitingTime() == 6, "P1 should wait 6 units");
+    
+    // Aging tick at multiples of 2 lifts P2 from 3 to 0, above P1's 1, at time 6
+    PriorityScheduler aging(true, true, 2, 0);
+    aging.addProcess(std::make_shared<Process>(1, "P1", 0, 10, 1));
+    aging.addProcess(std::make_shared<Process>(2, "P2", 0, 2, 3));
+    aging.schedule();
+    TEST_ASSERT(aging.getProcesses()[1]->getCompletionTime() == 8,
+               "Aged process should preempt at the tick and finish at 8");
+    TEST_ASSERT(aging.getProcesses()[0]->getCompletionTime() == 12, "P1 should finish at 12");
+    
+    // A long idle gap is skipped in one step, with the tick stopped meanwhile
+    PriorityScheduler idle(true, true, 5, 0);
+    idle.addProcess(std::make_shared<Process>(1, "P1", 0, 3, 2));
+    idle.addProcess(std::make_shared<Process>(2, "P2", 100000000, 2, 1));
+    idle.schedule();
+    TEST_ASSERT(idle.getProcesses()[1]->getCompletionTime() == 100000002,
+               "Process after an idle gap should complete on time");
+    
+    return true;
+}
+
+/**
+ * @brief Test that heap and timing-wheel event sets pop the same sequence
+ */
+bool test_future_event_sets_agree() {
+    HeapEventSet heap;
+    WheelEventSet wheel;
+    std::mt19937_64 engine(7);
+    
+    // Hold model with frequent ties and some far-future events
+    for (uint64_t i = 0; i < 2000; i++) {
+        int64_t time = static_cast<int64_t>(engine() % 100);
+        heap.push(time, i);
+        wheel.push(time, i);
+    }
+    for (uint64_t i = 0; i < 20000; i++) {
+        FutureEvent fromHeap, fromWheel;
+        TEST_ASSERT(heap.nextTime() == wheel.nextTime(), "Next event times should agree");
+        TEST_ASSERT(heap.pop(fromHeap) && wheel.pop(fromWheel), "Both sets should pop");
+        TEST_ASSERT(fromHeap.time == fromWheel.time && fromHeap.payload == fromWheel.payload,
+                   "Both sets should pop the same event");
+        int64_t delay = (i % 97 == 0) ? (int64_t(1) << 25) : static_cast<int64_t>(engine() % 300);
+        heap.push(fromHeap.time + delay, fromHeap.payload);
+        wheel.push(fromWheel.time + delay, fromWheel.payload);
+    }
+    TEST_ASSERT(heap.size() == 2000 && wheel.size() == 2000, "Sizes should be preserved");
+    
+    TEST_ASSERT(createFutureEventSet(FutureEventSetType::AUTO, 10)->getName() == "Binary Heap",
+               "Small sets should use the heap");
+    TEST_ASSERT(createFutureEventSet(FutureEventSetType::AUTO, 1000000)->getName() == "Timing Wheel",
+               "Large sets should use the timing wheel");
+    
+    // The arrival set implementation must not change the schedule
+    auto run = [](FutureEventSetType type) {
+        RoundRobinScheduler scheduler(3, 0);
+        scheduler.setArrivalSetType(type);
+        for (int i = 1; i <= 50; i++) {
+            scheduler.addProcess(std::make_shared<Process>(i, "P" + std::to_string(i),
+                                                           (i * 7) % 40, 1 + i % 6, 0));
+        }
+        scheduler.schedule();
+        return scheduler.getRunFingerprint();
+    };
+    TEST_ASSERT(run(FutureEventSetType::BINARY_HEAP) == run(FutureEventSetType::TIMING_WHEEL),
+               "Heap and wheel arrivals should give identical runs");
+    
+    return true;
+}
+
+// ============================================================================
+// O(1) Scheduler Tests
+// ============================================================================
+
+/**
+ * @brief Test the 2.6 static priority and timeslice mapping
+ */
+bool test_o1_timeslices() {
+    O1Scheduler scheduler(4, 0);
+    
+    TEST_ASSERT(O1Scheduler::staticPriority(0) == 120, "Priority 0 should be nice 0");
+    TEST_ASSERT(O1Scheduler::staticPriority(-50) == 100, "Nice should clamp at -20");
+    TEST_ASSERT(O1Scheduler::staticPriority(50) == 139, "Nice should clamp at 19");
+    
+    TEST_ASSERT(scheduler.timeslice(120) == 4, "Nice 0 should get the base timeslice");
+    TEST_ASSERT(scheduler.timeslice(119) == 16, "Nice -1 should get about 4x the base");
+    TEST_ASSERT(scheduler.timeslice(100) == 32, "Nice -20 should get 8x the base");
+    TEST_ASSERT(scheduler.timeslice(139) == 1, "Nice 19 should get the minimum timeslice");
+    
+    return true;
+}
+
+/**
+ * @brief Test timeslice expiry into the expired array and the array swap
+ */
+bool test_o1_array_swap() {
+    O1Scheduler scheduler(4, 0);
+    scheduler.addProcess(std::make_shared<Process>(1, "P1", 0, 8, 0));
+    scheduler.addProcess(std::make_shared<Process>(2, "P2", 0, 8, 0));
+    scheduler.schedule();
+    
+    auto processes = scheduler.getProcesses();
+    TEST_ASSERT(processes[0]->getCompletionTime() == 12, "P1 should finish at 12");
+    TEST_ASSERT(processes[1]->getCompletionTime() == 16, "P2 should finish at 16");
+    TEST_ASSERT(scheduler.getArraySwitches() == 1,
+               "CPU hogs should expire and trigger one array swap");
+    TEST_ASSERT(processes[1]->getWaitingTime() == 8, "P2 should wait 8 units");
+    
+    return true;
+}
+
+/**
+ * @brief Test that a better-priority arrival preempts the running task
+ */
+bool test_o1_preemption() {
+    O1Scheduler scheduler(4, 0);
+    scheduler.addProcess(std::make_shared<Process>(1, "P1", 0, 10, 5));
+    scheduler.addProcess(std::make_shared<Process>(2, "P2", 2, 3, 0));
+    scheduler.schedule();
+    
+    auto processes = scheduler.getProcesses();
+    TEST_ASSERT(processes[1]->getCompletionTime() == 5, "P2 should preempt and finish at 5");
+    TEST_ASSERT(processes[1]->getWaitingTime() == 0, "P2 should not wait");
+    TEST_ASSERT(processes[0]->getCompletionTime() == 13, "P1 should finish at 13");
+    
+    return true;
+}
+
+// ============================================================================
+// Skip List Scheduler Tests
+// ============================================================================
+
+/**
+ * @brief Test skip list order, ties and agreement with a sort
+ */
+bool test_deadline_skip_list() {
+    DeadlineSkipList list(7);
+    list.insert(50, 0);
+    list.insert(10, 1);
+    list.insert(30, 2);
+    list.insert(10, 3);
+    
+    TEST_ASSERT(list.firstDeadline() == 10, "Earliest deadline should be first");
+    TEST_ASSERT(list.popFirst() == 1, "Equal deadlines should keep insertion order");
+    TEST_ASSERT(list.popFirst() == 3, "Second deadline-10 entry should follow");
+    TEST_ASSERT(list.popFirst() == 2, "Deadline 30 should be third");
+    TEST_ASSERT(list.popFirst() == 0, "Deadline 50 should be last");
+    TEST_ASSERT(list.popFirst() == -1 && list.empty(), "List should be empty");
+    TEST_ASSERT(list.firstDeadline() == DeadlineSkipList::NO_DEADLINE,
+               "Empty list should report NO_DEADLINE");
+    
+    // Interleaved inserts and pops against a sorted reference
+    std::mt19937 rng(3);
+    std::vector<int64_t> reference;
+    for (int round = 0; round < 2000; round++) {
+        if (rng() % 3 != 0 || reference.empty()) {
+            int64_t deadline = rng() % 500;
+            list.insert(deadline, static_cast<int>(deadline));
+            reference.push_back(deadline);
+        } else {
+            std::sort(reference.begin(), reference.end());
+            TEST_ASSERT(list.firstDeadline() == reference.front(), "Head should be the minimum");
+            TEST_ASSERT(list.popFirst() == reference.front(), "Pop should return the minimum");
+            reference.erase(reference.begin());
+        }
+    }
+    TEST_ASSERT(list.size() == reference.size(), "Sizes should agree");
+    
+    return true;
+}
+
+/**
+ * @brief Test that an earlier virtual deadline preempts on one CPU
+ */
+bool test_bfs_deadline_preemption() {
+    SkipListScheduler scheduler(6, 1, RunQueueLayout::GLOBAL, 0);
+    TEST_ASSERT(scheduler.deadlineOffset(-20) == 6 * 128, "Nice -20 should have ratio 128");
+    TEST_ASSERT(scheduler.deadlineOffset(-19) == 6 * 140, "Ratio should grow 10% per level");
+    
+    scheduler.addProcess(std::make_shared<Process>(1, "P1", 0, 10, 0));
+    scheduler.addProcess(std::make_shared<Process>(2, "P2", 2, 3, -20));
+    scheduler.schedule();
+    
+    auto processes = scheduler.getProcesses();
+    TEST_ASSERT(processes[1]->getCompletionTime() == 5, "P2 should preempt and finish at 5");
+    TEST_ASSERT(processes[1]->getWaitingTime() == 0, "P2 should not wait");
+    TEST_ASSERT(processes[0]->getCompletionTime() == 13, "P1 should finish at 13");
+    TEST_ASSERT(processes[0]->getWaitingTime() == 3, "P1 should wait 3 units");
+    
+    return true;
+}
+
+/**
+ * @brief Test BFS and MuQSS on two CPUs
+ */
+bool test_muqss_two_cpus() {
+    const RunQueueLayout layouts[] = {RunQueueLayout::GLOBAL, RunQueueLayout::PER_CPU};
+    for (RunQueueLayout layout : layouts) {
+        SkipListScheduler scheduler(6, 2, layout, 0);
+        for (int i = 1; i <= 4; i++) {
+            scheduler.addProcess(std::make_shared<Process>(i, "P" + std::to_string(i), 0, 4, 0));
+        }
+        scheduler.schedule();
+        
+        auto processes = scheduler.getProcesses();
+        TEST_ASSERT(processes[0]->getCompletionTime() == 4, "P1 should finish at 4");
+        TEST_ASSERT(processes[1]->getCompletionTime() == 4, "P2 should run on the other CPU");
+        TEST_ASSERT(processes[2]->getCompletionTime() == 8, "P3 should finish at 8");
+        TEST_ASSERT(processes[3]->getCompletionTime() == 8, "P4 should finish at 8");
+        TEST_ASSERT(std::fabs(scheduler.calculateMetrics().cpuUtilization - 100.0) < 1e-9,
+                   "Both CPUs should be busy the whole time");
+        
+        // Staggered arrivals: tasks keep running across other CPUs' events
+        SkipListScheduler staggered(6, 2, layout, 0);
+        staggered.addProcess(std::make_shared<Process>(1, "P1", 0, 10, 2));
+        staggered.addProcess(std::make_shared<Process>(2, "P2", 1, 5, 1));
+        staggered.addProcess(std::make_shared<Process>(3, "P3", 2, 8, 3));
+        staggered.addProcess(std::make_shared<Process>(4, "P4", 3, 4, 2));
+        staggered.schedule();
+        int executed = 0;
+        for (const auto& process : staggered.getProcesses()) {
+            TEST_ASSERT(process->isComplete(), "Every process should complete");
+            executed += process->getTurnaroundTime() - process->getWaitingTime();
+        }
+        TEST_ASSERT(executed == 27, "Turnaround minus waiting should equal the bursts");
+        TEST_ASSERT(staggered.calculateMetrics().cpuUtilization <= 100.0,
+                   "Utilization should be relative to both CPUs");
+    }
+    
+    return true;
+}
+
+// ============================================================================
+// sched_ext-Style Engine Tests
+// ============================================================================
+
+/**
+ * @brief Test FIFO, head and vtime ordering of dispatch queues
+ */
+bool test_dispatch_queue() {
+    DispatchQueue fifo(1, DsqOrder::FIFO);
+    fifo.insert(10);
+    fifo.insert(11);
+    fifo.insert(12, true);
+    TEST_ASSERT(fifo.pop() == 12, "Head insert should come first");
+    TEST_ASSERT(fifo.pop() == 10 && fifo.pop() == 11, "FIFO order should be kept");
+    TEST_ASSERT(fifo.pop() == -1, "Empty queue should return -1");
+    
+    DispatchQueue vtime(2, DsqOrder::VTIME);
+    vtime.insertVtime(20, 300);
+    vtime.insertVtime(21, 100);
+    vtime.insertVtime(22, 100);
+    vtime.insertVtime(23, 200);
+    TEST_ASSERT(vtime.peek() == 21, "Lowest vtime should be first");
+    TEST_ASSERT(vtime.pop() == 21 && vtime.pop() == 22, "Equal vtimes should keep insertion order");
+    TEST_ASSERT(vtime.pop() == 23 && vtime.pop() == 20, "Vtime order should be kept");
+    
+    return true;
+}
+
+/**
+ * @brief Test the default policy and the weighted vtime policy
+ */
+bool test_ext_default_and_vtime() {
+    ExtScheduler<ExtPolicy> fifo(1);
+    fifo.addProcess(std::make_shared<Process>(1, "P1", 0, 10, 0));
+    fifo.addProcess(std::make_shared<Process>(2, "P2", 1, 5, 0));
+    fifo.schedule();
+    auto processes = fifo.getProcesses();
+    TEST_ASSERT(processes[1]->getCompletionTime() == 10, "P2 should run after P1's slice");
+    TEST_ASSERT(processes[0]->getCompletionTime() == 15, "P1 should finish at 15");
+    TEST_ASSERT(fifo.getExitReason().empty(), "Default policy should not be aborted");
+    
+    // Nice -5 has about ten times the weight of nice 5
+    ExtScheduler<ExtVtimePolicy> vtime(1);
+    vtime.addProcess(std::make_shared<Process>(1, "P1", 0, 20, 5));
+    vtime.addProcess(std::make_shared<Process>(2, "P2", 0, 20, -5));
+    vtime.schedule();
+    processes = vtime.getProcesses();
+    TEST_ASSERT(processes[1]->getCompletionTime() == 25, "Heavier P2 should run back to back");
+    TEST_ASSERT(processes[0]->getCompletionTime() == 40, "P1 should finish last");
+    
+    // Two CPUs: direct dispatch to idle CPUs, then the global DSQ
+    ExtScheduler<ExtPolicy> smp(2);
+    for (int i = 1; i <= 4; i++) {
+        smp.addProcess(std::make_shared<Process>(i, "P" + std::to_string(i), 0, 4, 0));
+    }
+    smp.schedule();
+    processes = smp.getProcesses();
+    TEST_ASSERT(processes[1]->getCompletionTime() == 4, "P2 should run on the second CPU");
+    TEST_ASSERT(processes[3]->getCompletionTime() == 8, "P4 should finish at 8");
+    
+    return true;
+}
+
+/**
+ * @brief Test tick-based preemption across per-band DSQs
+ */
+bool test_ext_tick_preemption() {
+    ExtScheduler<ExtPriorityPolicy> scheduler(1, 1);
+    scheduler.addProcess(std::make_shared<Process>(1, "P1", 0, 10, 15));
+    scheduler.addProcess(std::make_shared<Process>(2, "P2", 2, 3, -15));
+    scheduler.schedule();
+    
+    auto processes = scheduler.getProcesses();
+    TEST_ASSERT(processes[1]->getCompletionTime() == 6, "P2 should preempt at the next tick");
+    TEST_ASSERT(processes[0]->getCompletionTime() == 13, "P1 should finish at 13");
+    
+    return true;
+}
+
+/**
+ * @brief Policy that inserts into a DSQ it never created
+ */
+struct BrokenExtPolicy : ExtPolicy {
+    void enqueue(ExtContext& ctx, int task, uint64_t) {
+        ctx.insert(task, 42, ExtContext::SLICE_DFL);
+    }
+};
+
+/**
+ * @brief Test that a misbehaving policy is aborted and the run still completes
+ */
+bool test_ext_policy_abort() {
+    ExtScheduler<BrokenExtPolicy> scheduler(1);
+    scheduler.addProcess(std::make_shared<Process>(1, "P1", 0, 4, 0));
+    scheduler.addProcess(std::make_shared<Process>(2, "P2", 1, 4, 0));
+    scheduler.schedule();
+    
+    TEST_ASSERT(!scheduler.getExitReason().empty(), "Policy should be aborted");
+    for (const auto& process : scheduler.getProcesses()) {
+        TEST_ASSERT(process->isComplete(), "Every process should still complete");
+    }
+    
+    return true;
+}
+
+// ============================================================================
+// Policy Plugin Tests
+// ============================================================================
+
+/**
+ * @brief Test loading the example plugin and rejecting a missing one
+ */
+bool test_policy_plugin() {
+    std::string error;
+    TEST_ASSERT(!PolicyPlugin::load("no_such_plugin.so", error), "Missing plugin should fail");
+    TEST_ASSERT(!error.empty(), "Failure should come with a reason");
+    
+    std::shared_ptr<PolicyPlugin> plugin =
+        PolicyPlugin::load(std::string(PLUGIN_BIN_DIR) + "/srtf_policy.so", error);
+    TEST_ASSERT(plugin != nullptr, "Example plugin should load (run make plugins)");
+    TEST_ASSERT(plugin->getName() == "SRTF (plugin)", "Plugin name should be exported");
+    
+    std::unique_ptr<Scheduler> scheduler = plugin->create("");
+    TEST_ASSERT(scheduler != nullptr, "Plugin should create a scheduler");
+    scheduler->addProcess(std::make_shared<Process>(1, "P1", 0, 10, 0));
+    scheduler->addProcess(std::make_shared<Process>(2, "P2", 2, 3, 0));
+    scheduler->schedule();
+    
+    auto processes = scheduler->getProcesses();
+    TEST_ASSERT(processes[1]->getCompletionTime() == 5, "Shorter P2 should preempt and finish at 5");
+    TEST_ASSERT(processes[0]->getCompletionTime() == 13, "P1 should finish at 13");
+    
+    return true;
+}
+
+// ============================================================================
+// Batch Backfilling Tests
+// ============================================================================
+
+bool test_swf_reader() {
+    std::istringstream log(
+        "; Version: 2.2\n"
+        "; MaxNodes: 64\n"
+        "; MaxProcs: 128\n"
+        "1 0 5 100 8 -1 -1 8 300 -1 1 3 7 -1 1 -1 -1 -1\n"
+        "\n"
+        "this line is not a job\n"
+        "  2 10 -1 50 4 -1 -1 -1 -1 -1 1 4 7 -1 1 -1 -1 -1\n");
+    SwfReader reader(log);
+    SwfJob job;
+    
+    TEST_ASSERT(reader.next(job), "First job should be read");
+    TEST_ASSERT(reader.getMaxProcs() == 128, "MaxProcs should win over MaxNodes");
+    TEST_ASSERT(job.jobNumber == 1 && job.submitTime == 0 && job.runTime == 100, "Fields 1-4 should parse");
+    TEST_ASSERT(job.requestedProcessors == 8 && job.requestedTime == 300, "Request fields should parse");
+    TEST_ASSERT(job.userId == 3 && job.groupId == 7, "User and group should parse");
+    
+    TEST_ASSERT(reader.next(job), "Second job should be read past the junk");
+    TEST_ASSERT(reader.getMalformedLines() == 1, "One malformed line should be counted");
+    BatchJob batch;
+    TEST_ASSERT(BatchSimulator::fromSwf(job, batch), "Job should convert");
+    TEST_ASSERT(batch.procs == 4, "Missing request should fall back to allocated processors");
+    TEST_ASSERT(batch.estimate == 50, "Missing estimate should fall back to the run time");
+    TEST_ASSERT(!reader.next(job), "End of log");
+    
+    return true;
+}
+
+bool test_availability_profile() {
+    AvailabilityProfile profile(8, 0);
+    profile.reserve(0, 10, 6);
+    profile.reserve(5, 20, 2);
+    
+    TEST_ASSERT(profile.freeAt(0) == 2 && profile.freeAt(5) == 0, "Reservations should stack");
+    TEST_ASSERT(profile.freeAt(10) == 6 && profile.freeAt(20) == 8, "Reservations should end");
+    TEST_ASSERT(profile.minFree(0, 10) == 0 && profile.minFree(10, 30) == 6, "Range minimum");
+    TEST_ASSERT(profile.earliestStart(0, 5, 2) == 0, "Two processors fit at once");
+    TEST_ASSERT(profile.earliestStart(0, 10, 2) == 10, "A long job must skip the full window");
+    TEST_ASSERT(profile.earliestStart(0, 1, 8) == 20, "The whole machine is free at 20");
+    TEST_ASSERT(profile.earliestStart(0, 1, 9) == AvailabilityProfile::NEVER, "Too wide never fits");
+    
+    profile.release(5, 20, 2);
+    TEST_ASSERT(profile.size() == 2, "Released breakpoints should be merged away");
+    profile.advance(7);
+    TEST_ASSERT(profile.freeAt(7) == 2 && profile.freeAt(10) == 8, "Advance should keep the present");
+    
+    return true;
+}
+
+bool test_backfill_policies() {
+    // 4 cores: J2 needs the whole machine and waits for J1; J3 fits in the
+    // hole before J1 ends, J4 does not
+    const BatchJob jobs[] = {
+        {1, 0, 10, 10, 2, -1, -1},
+        {2, 1, 5, 5, 4, -1, -1},
+        {3, 2, 5, 5, 2, -1, -1},
+        {4, 3, 20, 20, 2, -1, -1},
+    };
+    
+    BatchSimulator fcfs(4, BackfillPolicy::FCFS);
+    BatchSimulator easy(4, BackfillPolicy::EASY);
+    BatchSimulator conservative(4, BackfillPolicy::CONSERVATIVE);
+    for (const BatchJob& job : jobs) {
+        fcfs.submit(job);
+        easy.submit(job);
+        conservative.submit(job);
+    }
+    TEST_ASSERT(!fcfs.submit(BatchJob{5, 4, 1, 1, 8, -1, -1}), "A job wider than the machine is rejected");
+    
+    BatchMetrics f = fcfs.finish();
+    BatchMetrics e = easy.finish();
+    BatchMetrics c = conservative.finish();
+    TEST_ASSERT(f.jobs == 4 && f.rejected == 1, "FCFS should run every valid job");
+    TEST_ASSERT(std::abs(f.averageWait - 8.5) < 1e-9, "FCFS waits: 0, 9, 13, 12");
+    TEST_ASSERT(f.backfilled == 0, "FCFS never backfills");
+    TEST_ASSERT(std::abs(e.averageWait - 5.25) < 1e-9 && e.backfilled == 1, "EASY backfills J3 only");
+    TEST_ASSERT(std::abs(c.averageWait - 5.25) < 1e-9 && c.backfilled == 1, "Conservative backfills J3 only");
+    TEST_ASSERT(f.makespan == 35 && std::abs(f.utilization - 90.0 / 140.0) < 1e-9, "Utilization over the makespan");
+    // J3 under FCFS: wait 13, run 5 -> (13 + 5) / max(5, 10)
+    TEST_ASSERT(std::abs(f.maxBoundedSlowdown - 1.8) < 1e-9, "Bounded slowdown uses the 10 s floor");
+    
+    return true;
+}
+
+bool test_conservative_compression() {
+    // J1 reserves 20 s but finishes after 10; J2's reservation must move up
+    BatchSimulator conservative(4, BackfillPolicy::CONSERVATIVE);
+    conservative.submit(BatchJob{1, 0, 10, 20, 2, -1, -1});
+    conservative.submit(BatchJob{2, 1, 5, 5, 4, -1, -1});
+    TEST_ASSERT(conservative.queued() == 1, "J2 should wait for J1");
+    
+    BatchMetrics metrics = conservative.finish();
+    TEST_ASSERT(metrics.jobs == 2, "Both jobs should complete");
+    TEST_ASSERT(std::abs(metrics.averageWait - 4.5) < 1e-9, "J2 should start at 10, not 20");
+    
+    return true;
+}
+
+// ============================================================================
+// Cluster Simulation Tests
+// ============================================================================
+
+bool test_quantile_sketch() {
+    QuantileSketch all;
+    QuantileSketch low;
+    QuantileSketch high;
+    for (int v = 0; v <= 1000; v++) {
+        all.add(v);
+        (v < 300 ? low : high).add(v);
+    }
+    
+    TEST_ASSERT(all.count() == 1001 && all.min() == 0 && all.max() == 1000, "Exact count, min, max");
+    TEST_ASSERT(std::abs(all.mean() - 500.0) < 1e-9, "Exact mean");
+    TEST_ASSERT(all.quantile(0.0) == 0.0, "Zero is kept exactly");
+    TEST_ASSERT(std::abs(all.quantile(0.5) - 500.0) <= 5.0, "Median within 1%");
+    TEST_ASSERT(std::abs(all.quantile(0.99) - 990.0) <= 9.9, "p99 within 1%");
+    
+    TEST_ASSERT(low.merge(high), "Same accuracy should merge");
+    for (double q : {0.1, 0.5, 0.9, 0.99}) {
+        TEST_ASSERT(low.quantile(q) == all.quantile(q), "Merged sketch should equal the combined one");
+    }
+    QuantileSketch coarse(0.05);
+    TEST_ASSERT(!coarse.merge(all), "Different accuracies must not merge");
+    
+    return true;
+}
+
+bool test_cluster_placement() {
+    WorkloadDistribution distribution;
+    distribution.numProcesses = 2000;
+    distribution.meanInterarrival = 0.2;
+    auto jobs = WorkloadGenerator(distribution).generate(7);
+    SchedulerFactory roundRobin = []() {
+        return std::unique_ptr<Scheduler>(new RoundRobinScheduler(4));
+    };
+    
+    ClusterConfig config;
+    config.numNodes = 50;
+    config.numThreads = 1;
+    ClusterSimulator serial(config, roundRobin, PlacementPolicy::POWER_OF_TWO);
+    ClusterMetrics one = serial.run(jobs);
+    config.numThreads = 4;
+    ClusterSimulator parallel(config, roundRobin, PlacementPolicy::POWER_OF_TWO);
+    ClusterMetrics four = parallel.run(jobs);
+    
+    TEST_ASSERT(one.processes == 2000, "Every process should complete on some node");
+    TEST_ASSERT(serial.getAssignment() == parallel.getAssignment(), "Placement must not depend on threads");
+    TEST_ASSERT(one.turnaround.quantile(0.99) == four.turnaround.quantile(0.99) &&
+                one.waiting.mean() == four.waiting.mean(), "Results must not depend on threads");
+    
+    ClusterSimulator least(config, roundRobin, PlacementPolicy::LEAST_LOADED);
+    ClusterSimulator packing(config, roundRobin, PlacementPolicy::BIN_PACKING);
+    ClusterMetrics spread = least.run(jobs);
+    ClusterMetrics packed = packing.run(jobs);
+    TEST_ASSERT(spread.activeNodes == 50, "Least loaded should use every node");
+    TEST_ASSERT(packed.activeNodes < spread.activeNodes, "Bin packing should leave nodes empty");
+    TEST_ASSERT(spread.waiting.mean() <= packed.waiting.mean(), "Spreading should not wait longer than packing");
+    
+    return true;
+}
+
+// ============================================================================
+// Cluster Trace Import Tests
+// ============================================================================
+
+bool test_google_trace_import() {
+    // Task 0 runs 1 s -> 11 s; task 1 runs 3 s -> 13 s on machine 8; task 2
+    // fails before it is scheduled; QUEUE events are ignored
+    const std::string trace =
+        "time,type,collection_id,scheduling_class,priority,instance_index,machine_id,resource_request.cpus\n"
+        "0,0,100,2,200,0,,0.02\n"
+        "1000000,3,100,2,200,0,7,0.02\n"
+        "1500000,1,100,2,200,1,,0.03\n"
+        "2000000,0,100,2,200,1,,0.03\n"
+        "3000000,3,100,2,200,1,8,0.03\n"
+        "11000000,6,100,2,200,0,7,0.02\n"
+        "13000000,7,100,2,200,1,8,0.03\n"
+        "20000000,0,101,0,0,0,,0.5\n"
+        "21000000,5,101,0,0,0,,0.5\n";
+    
+    std::istringstream in(trace);
+    TraceImporter importer(in, TraceFormat::GOOGLE_2019, TraceFilter(), 3);
+    TraceTask task;
+    TEST_ASSERT(importer.next(task), "First finished task");
+    TEST_ASSERT(task.jobId == 100 && task.taskIndex == 0 && task.arrival == 0, "Identity and submit time");
+    TEST_ASSERT(task.duration == 10 && task.machineId == 7, "Duration runs from SCHEDULE to FINISH");
+    TEST_ASSERT(task.priority == 200 && task.schedulingClass == 2, "Priority and class from SUBMIT");
+    TEST_ASSERT(std::abs(task.cpuRequest - 0.02) < 1e-12, "CPU request column by header name");
+    TEST_ASSERT(importer.next(task) && task.taskIndex == 1 && task.arrival == 2, "Killed task still ran");
+    TEST_ASSERT(!importer.next(task), "A task that never ran is not imported");
+    TEST_ASSERT(importer.getRows() == 9 && importer.getMalformedRows() == 0, "Row accounting");
+    
+    TraceFilter filter;
+    filter.machines.insert(8);
+    std::istringstream again(trace);
+    TraceImporter subset(again, TraceFormat::GOOGLE_2019, filter, 1);
+    TEST_ASSERT(subset.next(task) && task.machineId == 8 && !subset.next(task), "Machine subset");
+    
+    std::istringstream headless("0,0,100,2,200,0,,0.02\n");
+    TraceImporter broken(headless, TraceFormat::GOOGLE_2019);
+    TEST_ASSERT(!broken.next(task) && !broken.getError().empty(), "Missing header is reported");
+    
+    return true;
+}
+
+bool test_alibaba_trace_import() {
+    std::string trace;
+    for (int i = 0; i < 500; i++) {
+        // batch_instance: 14 columns, machine m_<i % 10>, one task per second
+        trace += "ins_" + std::to_string(i) + ",M1,j_" + std::to_string(i / 10) + ",1,Terminated," +
+                 std::to_string(100 + i) + "," + std::to_string(160 + i) + ",m_" +
+                 std::to_string(i % 10) + ",1,1,50,80,0.1,0.2\n";
+    }
+    trace += "garbage\nins_9,M1,j_9,1,Waiting,0,0,m_1,1,1,0,0,0,0\n";
+    
+    TraceFilter filter;
+    filter.windowStart = 200;
+    filter.windowEnd = 300;
+    filter.machines.insert(3);
+    std::vector<TraceTask> one, many;
+    TraceTask task;
+    std::istringstream a(trace), b(trace);
+    TraceImporter serial(a, TraceFormat::ALIBABA_2018, filter, 1);
+    TraceImporter parallel(b, TraceFormat::ALIBABA_2018, filter, 4);
+    while (serial.next(task)) {
+        one.push_back(task);
+    }
+    while (parallel.next(task)) {
+        many.push_back(task);
+    }
+    
+    TEST_ASSERT(one.size() == 10, "Window [200, 300) on machine 3 holds 10 instances");
+    TEST_ASSERT(one.size() == many.size(), "Thread count must not change the result");
+    for (size_t i = 0; i < one.size(); i++) {
+        TEST_ASSERT(one[i].taskIndex == many[i].taskIndex, "Tasks must come out in file order");
+    }
+    TEST_ASSERT(one[0].arrival == 203 && one[0].duration == 60 && one[0].machineId == 3, "First kept instance");
+    TEST_ASSERT(std::abs(one[0].cpuRequest - 0.5) < 1e-12, "cpu_avg is in percent of a core");
+    TEST_ASSERT(serial.getMalformedRows() == 2, "Garbage and never-started rows are malformed");
+    
+    auto process = TraceImporter::toProcess(one[0], 1, 200);
+    TEST_ASSERT(process->getArrivalTime() == 3 && process->getBurstTime() == 60, "Process relative to origin");
+    
+    return true;
+}
+
+// ============================================================================
+// Workflow (DAG) Tests
+// ============================================================================
+
+/**
+ * @brief Check that no process started before all of its predecessors ended
+ */
+static bool respectsDependencies(const Scheduler& scheduler, const Workflow& workflow) {
+    const auto& processes = scheduler.getProcesses();
+    const auto& start = workflow.getSuccessorStart();
+    const auto& successors = workflow.getSuccessors();
+    for (size_t task = 0; task < workflow.size(); task++) {
+        for (size_t k = start[task]; k < start[task + 1]; k++) {
+            const Process& before = *processes[task];
+            const Process& after = *processes[static_cast<size_t>(successors[k])];
+            if (before.getState() != ProcessState::TERMINATED ||
+                after.getState() != ProcessState::TERMINATED ||
+                after.getStartTime() < before.getCompletionTime()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool test_dependency_admission() {
+    Workflow workflow = Workflow::forkJoin(3, 4, 1, 6, 7);
+    TEST_ASSERT(workflow.size() == 16 && workflow.edgeCount() == 24, "Fork-join shape");
+    
+    RoundRobinScheduler rr(2);
+    SkipListScheduler skipList(6, 2);
+    MultilevelFeedbackQueueScheduler mlfq;
+    PriorityScheduler priority(true);
+    std::vector<Scheduler*> schedulers = {&rr, &skipList, &mlfq, &priority};
+    for (Scheduler* scheduler : schedulers) {
+        workflow.addToScheduler(*scheduler);
+        scheduler->schedule();
+        TEST_ASSERT(respectsDependencies(*scheduler, workflow),
+                    "Every policy must wait for predecessors: " + scheduler->getName());
+    }
+    
+    // Rerunning after reset() resolves the dependencies again
+    rr.reset();
+    rr.schedule();
+    TEST_ASSERT(respectsDependencies(rr, workflow), "Dependencies survive reset()");
+    
+    // A cycle never becomes ready, and must not stall the simulation
+    RoundRobinScheduler cyclic(2);
+    cyclic.addProcess(std::make_shared<Process>(1, "A", 0, 3));
+    cyclic.addProcess(std::make_shared<Process>(2, "B", 0, 3));
+    cyclic.addProcess(std::make_shared<Process>(3, "C", 0, 3));
+    TEST_ASSERT(!cyclic.addDependency(1, 1), "Self-dependency is rejected");
+    cyclic.addDependency(2, 3);
+    cyclic.addDependency(3, 2);
+    cyclic.schedule();
+    TEST_ASSERT(cyclic.getProcesses()[0]->getState() == ProcessState::TERMINATED, "Independent process runs");
+    TEST_ASSERT(cyclic.getProcesses()[1]->getState() == ProcessState::NEW &&
+                cyclic.getProcesses()[2]->getState() == ProcessState::NEW, "Cycle stays NEW");
+    
+    return true;
+}
+
+bool test_workflow_policies() {
+    // A short task c leads to a long task d; a and b are independent.
+    // FIFO starts a and b first and pushes d late; longest path and HEFT
+    // start c first and reach the critical path length.
+    Workflow workflow;
+    workflow.addTask(5);
+    workflow.addTask(5);
+    int c = workflow.addTask(1);
+    int d = workflow.addTask(10);
+    TEST_ASSERT(workflow.addEdge(c, d) && !workflow.addEdge(d, d) && !workflow.addEdge(0, 9), "Edge validation");
+    TEST_ASSERT(workflow.finalize(), "Acyclic");
+    
+    WorkflowMetrics fifo = WorkflowScheduler(2, WorkflowPolicy::FIFO).run(workflow);
+    WorkflowMetrics longest = WorkflowScheduler(2, WorkflowPolicy::LONGEST_PATH).run(workflow);
+    WorkflowMetrics heft = WorkflowScheduler(2, WorkflowPolicy::HEFT).run(workflow);
+    TEST_ASSERT(fifo.criticalPath == 11 && fifo.criticalTasks == 2, "Critical path c -> d");
+    TEST_ASSERT(fifo.makespan == 16 && fifo.slack == 5, "FIFO delays the critical path");
+    TEST_ASSERT(longest.makespan == 11 && longest.slack == 0, "Longest path first meets the bound");
+    TEST_ASSERT(heft.makespan == 11, "HEFT meets the bound");
+    TEST_ASSERT(std::abs(fifo.averageTaskSlack - 3.0) < 1e-12, "a and b can slip 6 each");
+    
+    // Random layered DAG: precedence holds and no schedule beats the bounds
+    Workflow layered = Workflow::layered(20000, 50, 4, 1, 20, 3);
+    TEST_ASSERT(layered.isAcyclic() && layered.edgeCount() > 20000, "Layered DAG");
+    int64_t work = 0;
+    for (size_t task = 0; task < layered.size(); task++) {
+        work += layered.getCost(static_cast<int>(task));
+    }
+    std::vector<double> speeds = {2.0, 1.0, 1.0, 1.0};
+    for (WorkflowPolicy policy : {WorkflowPolicy::FIFO, WorkflowPolicy::LONGEST_PATH, WorkflowPolicy::HEFT}) {
+        WorkflowScheduler scheduler(speeds, policy);
+        WorkflowMetrics metrics = scheduler.run(layered);
+        const auto& start = layered.getSuccessorStart();
+        const auto& successors = layered.getSuccessors();
+        bool ordered = true;
+        for (size_t task = 0; task < layered.size() && ordered; task++) {
+            for (size_t k = start[task]; k < start[task + 1]; k++) {
+                ordered = ordered && scheduler.getStartTimes()[static_cast<size_t>(successors[k])] >=
+                                         scheduler.getFinishTimes()[task];
+            }
+        }
+        TEST_ASSERT(metrics.tasks == layered.size() && ordered,
+                    "Successors start after predecessors: " + WorkflowScheduler::policyName(policy));
+        TEST_ASSERT(metrics.slack >= 0 && metrics.makespan * 5 >= work, "Makespan respects both lower bounds");
+    }
+    
+    Workflow cycle;
+    cycle.addTask(1);
+    cycle.addTask(1);
+    cycle.addEdge(0, 1);
+    cycle.addEdge(1, 0);
+    TEST_ASSERT(!cycle.finalize() && WorkflowScheduler(2, WorkflowPolicy::HEFT).run(cycle).tasks == 0,
+                "A cyclic workflow is refused");
+    
+    return true;
+}
+
+// ============================================================================
+// Lock Protocol Tests
+// ============================================================================
+
+/**
+ * @brief Low-priority L holds lock 0 when high-priority H needs it; medium M
+ *        arrives in between and, without a protocol, runs ahead of both
+ */
+static PriorityScheduler* inversionScenario(LockProtocol protocol) {
+    PriorityScheduler* scheduler = new PriorityScheduler(true, false);
+    scheduler->setLockProtocol(protocol);
+    auto low = std::make_shared<Process>(1, "L", 0, 6, 3);
+    auto high = std::make_shared<Process>(2, "H", 2, 3, 0);
+    low->addCriticalSection(0, 1, 4);
+    high->addCriticalSection(0, 0, 2);
+    scheduler->addProcess(low);
+    scheduler->addProcess(high);
+    scheduler->addProcess(std::make_shared<Process>(3, "M", 3, 10, 1));
+    scheduler->schedule();
+    return scheduler;
+}
+
+bool test_priority_inversion() {
+    std::unique_ptr<PriorityScheduler> none(inversionScenario(LockProtocol::NONE));
+    std::unique_ptr<PriorityScheduler> pip(inversionScenario(LockProtocol::INHERITANCE));
+    std::unique_ptr<PriorityScheduler> pcp(inversionScenario(LockProtocol::CEILING));
+    
+    // Without a protocol M's whole burst lands inside H's wait
+    TEST_ASSERT(none->getProcesses()[1]->getCompletionTime() == 18, "H finishes after M");
+    TEST_ASSERT(none->getBlockingTimes()[1] == 13 && none->getLockMetrics().inversionTime == 13,
+                "Unbounded inversion: L, then M, then L again");
+    
+    // With inheritance L runs at H's priority and M cannot preempt it
+    TEST_ASSERT(pip->getProcesses()[1]->getCompletionTime() == 8, "H finishes before M");
+    TEST_ASSERT(pip->getBlockingTimes()[1] == 3 && pip->getLockMetrics().inversionTime == 3,
+                "Inversion bounded by L's critical section");
+    TEST_ASSERT(pip->getProcesses()[2]->getWaitingTime() == 5, "M waits for L's boosted section and H");
+    TEST_ASSERT(pcp->getProcesses()[1]->getCompletionTime() == 8 && pcp->getBlockingTimes()[1] == 3,
+                "Ceiling bounds the inversion too");
+    
+    const LockMetrics& metrics = pip->getLockMetrics();
+    TEST_ASSERT(metrics.acquisitions == 2 && metrics.contended == 1 && metrics.maxWait == 3,
+                "Lock accounting");
+    TEST_ASSERT(metrics.waitHistogram.size() == 3 && metrics.waitHistogram[2] == 1,
+                "A wait of 3 lands in bucket [2, 4)");
+    TEST_ASSERT(pip->getProcesses()[0]->getInheritedPriority() == INT_MAX, "Inheritance ends with the section");
+    
+    return true;
+}
+
+bool test_lock_deadlock_and_scale() {
+    // L takes A then B; H takes B then A: a deadlock unless the ceiling
+    // keeps H from taking B while L holds A
+    for (LockProtocol protocol : {LockProtocol::NONE, LockProtocol::INHERITANCE, LockProtocol::CEILING}) {
+        PriorityScheduler scheduler(true, false);
+        scheduler.setLockProtocol(protocol);
+        auto low = std::make_shared<Process>(1, "L", 0, 6, 2);
+        auto high = std::make_shared<Process>(2, "H", 1, 6, 0);
+        TEST_ASSERT(low->addCriticalSection(1, 1, 4) && low->addCriticalSection(2, 2, 2), "Nested sections");
+        TEST_ASSERT(!low->addCriticalSection(1, 6, 1) && !low->addCriticalSection(1, 0, 0), "Section outside burst");
+        high->addCriticalSection(2, 0, 4);
+        high->addCriticalSection(1, 1, 2);
+        scheduler.addProcess(low);
+        scheduler.addProcess(high);
+        scheduler.schedule();
+        bool ceiling = protocol == LockProtocol::CEILING;
+        TEST_ASSERT(scheduler.getLockMetrics().deadlocked == (ceiling ? 0u : 2u),
+                    "Only the ceiling protocol avoids the deadlock: " + PriorityScheduler::lockProtocolName(protocol));
+    }
+    
+    // Hundreds of locks: per-lock wait queues keep this fast
+    WorkloadDistribution distribution;
+    distribution.numProcesses = 5000;
+    distribution.meanInterarrival = 2.5;
+    distribution.numLocks = 200;
+    distribution.criticalSectionProbability = 0.8;
+    std::vector<std::shared_ptr<Process>> workload = WorkloadGenerator(distribution).generate(5);
+    size_t sections = 0;
+    for (const auto& process : workload) {
+        sections += process->getCriticalSections().size();
+    }
+    for (LockProtocol protocol : {LockProtocol::INHERITANCE, LockProtocol::CEILING}) {
+        PriorityScheduler scheduler(true, false);
+        scheduler.setLockProtocol(protocol);
+        for (const auto& process : workload) {
+            scheduler.addProcess(std::make_shared<Process>(*process));
+        }
+        scheduler.schedule();
+        const LockMetrics& metrics = scheduler.getLockMetrics();
+        size_t histogram = 0;
+        for (size_t count : metrics.waitHistogram) {
+            histogram += count;
+        }
+        TEST_ASSERT(metrics.acquisitions == sections && metrics.deadlocked == 0, "Every section entered once");
+        TEST_ASSERT(histogram == metrics.contended && metrics.contended > 0, "Every wait is in the histogram");
+        TEST_ASSERT(scheduler.calculateMetrics().throughput > 0, "Run completes");
+    }
+    
+    return true;
+}
+
+// ============================================================================
+// Closed-Loop Workload Tests
+// ============================================================================
+
+bool test_closed_loop_mva() {
+    // Exponential think and service on one FCFS CPU: MVA is exact
+    ClosedLoopConfig config;
+    config.meanService = 20;
+    config.meanThink = 200;
+    config.warmup = 100000;
+    config.horizon = 2100000;
+    ClosedLoopSimulator simulator(config);
+    TEST_ASSERT(std::abs(simulator.saturationUsers() - 11.0) < 1e-9, "N* = (D + Z) / D");
+    
+    for (int users : {1, 5, 10, 40}) {
+        ClosedLoopMetrics metrics = simulator.run(users);
+        double mean = metrics.response.mean();
+        TEST_ASSERT(std::abs(mean - metrics.predictedResponse) < 0.05 * metrics.predictedResponse,
+                    "Mean response matches MVA for N = " + std::to_string(users));
+        TEST_ASSERT(std::abs(mean - metrics.responseTimeLaw) < 0.1 * mean + 2.0,
+                    "Response time law R = N / X - Z holds");
+        TEST_ASSERT(metrics.throughput <= 1.0 / config.meanService * 1.01, "X <= c / D");
+    }
+    
+    // Past saturation every extra user adds about D / c
+    ClosedLoopMetrics saturated = simulator.run(40);
+    TEST_ASSERT(saturated.utilization > 99.0, "CPU saturated");
+    TEST_ASSERT(std::abs(saturated.response.mean() - (40 * 20.0 - 200.0)) < 0.05 * 600.0,
+                "R approaches N * D - Z");
+    return true;
+}
+
+bool test_closed_loop_sweep() {
+    ClosedLoopConfig config;
+    config.cpus = 4;
+    config.discipline = ClosedLoopDiscipline::ROUND_ROBIN;
+    config.horizon = 60000;
+    std::vector<int> users = {200, 50, 400, 100};
+    
+    config.numThreads = 1;
+    std::vector<ClosedLoopMetrics> serial = ClosedLoopSimulator(config).sweep(users);
+    config.numThreads = 4;
+    std::vector<ClosedLoopMetrics> parallel = ClosedLoopSimulator(config).sweep(users);
+    TEST_ASSERT(serial.size() == users.size(), "One result per user count");
+    for (size_t i = 0; i < users.size(); i++) {
+        TEST_ASSERT(serial[i].users == users[i], "Results in input order");
+        TEST_ASSERT(serial[i].completed == parallel[i].completed &&
+                    serial[i].response.mean() == parallel[i].response.mean(),
+                    "Sweep does not depend on the thread count");
+    }
+    TEST_ASSERT(serial[1].response.mean() < serial[0].response.mean() &&
+                serial[0].response.mean() < serial[2].response.mean(),
+                "Response grows with users");
+    
+    // Same request streams under another discipline: only the order differs
+    config.discipline = ClosedLoopDiscipline::SHORTEST_FIRST;
+    ClosedLoopMetrics shortest = ClosedLoopSimulator(config).run(400);
+    TEST_ASSERT(shortest.response.mean() < serial[2].response.mean(), "Shortest first beats RR when saturated");
+    
+    // Arrivals are generated lazily: 200000 users, none of them pre-scheduled
+    config.users = 200000;
+    config.cpus = 256;
+    config.warmup = 2000;
+    config.horizon = 12000;
+    ClosedLoopMetrics large = ClosedLoopSimulator(config).run();
+    TEST_ASSERT(large.completed > 100000 && large.utilization <= 100.0, "Large population runs");
+    return true;
+}
+
+// ============================================================================
+// RPC Server Tests
+// ============================================================================
+
+bool test_rpc_queueing_sanity() {
+    // One worker, free dispatch and preemption: M/M/1, and PS has the same mean
+    RpcServerConfig config;
+    config.workers = 1;
+    config.mix = {{"exp", 1.0, 1000.0, BurstDistribution::EXPONENTIAL}};
+    config.dispatchCost = 0;
+    config.preemptionCost = 0;
+    config.stealCost = 0;
+    config.quantum = 50;
+    RpcServerSimulator simulator(config);
+    TEST_ASSERT(std::abs(simulator.meanService() - 1000.0) < 1e-9, "Mean service of the mix");
+    for (RpcArchitecture architecture : {RpcArchitecture::CENTRALIZED_FCFS, RpcArchitecture::WORK_STEALING,
+                                         RpcArchitecture::PROCESSOR_SHARING}) {
+        RpcMetrics metrics = simulator.run(architecture, 0.5);
+        TEST_ASSERT(metrics.completed == 180000, "Warmup requests are not measured");
+        TEST_ASSERT(std::abs(metrics.latency.mean() - 2000.0) < 100.0,
+                    "M/M/1 mean latency S / (1 - rho): " + RpcServerSimulator::architectureName(architecture));
+        TEST_ASSERT(std::abs(metrics.workerUtilization - 50.0) < 2.0, "Utilization equals the load");
+    }
+    
+    // A dispatcher slower than the workers' combined rate is the bottleneck
+    RpcServerConfig slow;
+    slow.mix = {{"short", 1.0, 500.0, BurstDistribution::CONSTANT}};
+    slow.dispatchCost = 1000;
+    slow.requests = 50000;
+    RpcMetrics bottleneck = RpcServerSimulator(slow).run(RpcArchitecture::CENTRALIZED_FCFS, 0.5);
+    TEST_ASSERT(bottleneck.dispatcherUtilization > 99.0 && bottleneck.workerUtilization < 10.0,
+                "Dispatcher saturates first");
+    return true;
+}
+
+bool test_rpc_architectures() {
+    // Bimodal mix: preemption protects short requests from long ones
+    RpcServerConfig config;
+    RpcServerSimulator simulator(config);
+    RpcMetrics centralized = simulator.run(RpcArchitecture::CENTRALIZED_FCFS, 0.7);
+    RpcMetrics stealing = simulator.run(RpcArchitecture::WORK_STEALING, 0.7);
+    RpcMetrics sharing = simulator.run(RpcArchitecture::PROCESSOR_SHARING, 0.7);
+    TEST_ASSERT(sharing.slowdown.quantile(0.999) < centralized.slowdown.quantile(0.999),
+                "Processor sharing has the lowest tail slowdown");
+    TEST_ASSERT(centralized.slowdown.quantile(0.999) <= stealing.slowdown.quantile(0.999),
+                "A central queue beats per-core queues");
+    TEST_ASSERT(sharing.preemptions > 0 && centralized.preemptions == 0 && stealing.preemptions == 0,
+                "Only processor sharing preempts");
+    TEST_ASSERT(stealing.steals > 0 && centralized.steals == 0, "Only work stealing steals");
+    TEST_ASSERT(sharing.typeLatency.size() == 2 && sharing.typeLatency[1].count() > 0, "Latency per type");
+    
+    // Parallel sweep: same results whatever the thread count
+    std::vector<double> loads = {0.3, 0.9, 0.6};
+    config.requests = 50000;
+    config.numThreads = 1;
+    std::vector<RpcMetrics> serial = RpcServerSimulator(config).sweep(RpcArchitecture::WORK_STEALING, loads);
+    config.numThreads = 3;
+    std::vector<RpcMetrics> parallel = RpcServerSimulator(config).sweep(RpcArchitecture::WORK_STEALING, loads);
+    for (size_t i = 0; i < loads.size(); i++) {
+        TEST_ASSERT(serial[i].load == loads[i] && serial[i].steals == parallel[i].steals &&
+                    serial[i].slowdown.quantile(0.999) == parallel[i].slowdown.quantile(0.999),
+                    "Sweep does not depend on the thread count");
+    }
+    TEST_ASSERT(serial[0].slowdown.quantile(0.999) < serial[1].slowdown.quantile(0.999),
+                "Tail grows with load");
+    return true;
+}
+
+// ============================================================================
+// Virtualization Tests
+// ============================================================================
+
+bool test_hypervisor_steal_accounting() {
+    SchedulerFactory roundRobin = []() {
+        return std::unique_ptr<Scheduler>(new RoundRobinScheduler(2));
+    };
+    
+    // Two single-vCPU VMs on one pCPU, each with a 10-unit task; timeslice 5:
+    // vCPU 0 runs 0-5 and 10-15, vCPU 1 runs 5-10 and 15-20
+    std::vector<VirtualMachine> vms(2);
+    vms[0].tasks.push_back(std::make_shared<Process>(1, "A", 0, 10));
+    vms[1].tasks.push_back(std::make_shared<Process>(2, "B", 0, 10));
+    vms[0].tasks[0]->addCriticalSection(1, 3, 4);
+    vms[1].tasks[0]->addCriticalSection(2, 0, 2);
+    HostConfig host;
+    host.pcpus = 1;
+    host.timeslice = 5;
+    HypervisorSimulator hypervisor(host, roundRobin);
+    HypervisorMetrics metrics = hypervisor.run(vms);
+    TEST_ASSERT(metrics.processes == 2 && metrics.vcpus == 2, "Every guest task completes");
+    TEST_ASSERT(metrics.turnaround.mean() == 17.5 && metrics.response.mean() == 2.5, "Real turnaround and response");
+    TEST_ASSERT(metrics.steal.mean() == 7.5 && metrics.stolenTime == 15, "Steal per task and per host");
+    TEST_ASSERT(hypervisor.getVcpuSteal() == std::vector<int64_t>({5, 10}), "Steal per vCPU");
+    TEST_ASSERT(std::abs(metrics.stealPercent - 100.0 * 15 / 35) < 1e-9 && metrics.utilization == 100.0,
+                "Steal share and pCPU utilization");
+    // A holds its lock over CPU time 3-7, and loses the pCPU at 5 for 5 units
+    TEST_ASSERT(metrics.criticalSections == 2 && metrics.preemptedSections == 1 &&
+                metrics.lockHolderDelay == 5 && metrics.maxLockHolderDelay == 5,
+                "Lock-holder preemption stretches the section");
+    
+    // Enough pCPUs: no steal, and guest metrics equal a direct run
+    WorkloadDistribution distribution;
+    distribution.numProcesses = 200;
+    distribution.meanInterarrival = 6.0;
+    VirtualMachine vm;
+    vm.tasks = WorkloadGenerator(distribution).generate(3);
+    RoundRobinScheduler direct(2);
+    for (const auto& task : vm.tasks) {
+        direct.addProcess(std::make_shared<Process>(task->getPID(), task->getName(), task->getArrivalTime(),
+                                                    task->getBurstTime()));
+    }
+    direct.schedule();
+    SchedulingMetrics expected = direct.calculateMetrics();
+    host.pcpus = 1;
+    HypervisorMetrics alone = HypervisorSimulator(host, roundRobin).run({vm});
+    TEST_ASSERT(alone.stolenTime == 0 && alone.steal.max() == 0.0, "A dedicated pCPU steals nothing");
+    TEST_ASSERT(std::abs(alone.turnaround.mean() - expected.averageTurnaroundTime) < 1e-6 &&
+                std::abs(alone.waiting.mean() - expected.averageWaitingTime) < 1e-6,
+                "Guest metrics equal a bare-metal run");
+    
+    // Overcommitted: steal inflates turnaround, and weights share the pCPU
+    std::vector<VirtualMachine> pair = {vm, vm};
+    pair[0].weight = 3;
+    HypervisorMetrics shared = HypervisorSimulator(host, roundRobin).run(pair);
+    TEST_ASSERT(shared.stolenTime > 0 && shared.turnaround.mean() > alone.turnaround.mean(),
+                "Overcommit adds steal time");
+    host.policy = HostPolicy::FAIR_SHARE;
+    HypervisorSimulator fair(host, roundRobin);
+    fair.run(pair);
+    TEST_ASSERT(fair.getVcpuSteal()[0] < fair.getVcpuSteal()[1], "The heavier VM is stolen from less");
+    return true;
+}
+
+bool test_hypervisor_scale() {
+    // 1000 VMs with 2 vCPUs each on a 500-pCPU host
+    WorkloadDistribution distribution;
+    distribution.numProcesses = 20;
+    distribution.meanInterarrival = 4.0;
+    std::vector<VirtualMachine> vms(1000);
+    for (size_t i = 0; i < vms.size(); i++) {
+        vms[i].vcpus = 2;
+        vms[i].tasks = WorkloadGenerator(distribution).generate(i + 1);
+    }
+    SchedulerFactory roundRobin = []() {
+        return std::unique_ptr<Scheduler>(new RoundRobinScheduler(4));
+    };
+    HostConfig host;
+    host.pcpus = 500;
+    host.numThreads = 1;
+    HypervisorMetrics serial = HypervisorSimulator(host, roundRobin).run(vms);
+    host.numThreads = 4;
+    HypervisorMetrics parallel = HypervisorSimulator(host, roundRobin).run(vms);
+    TEST_ASSERT(serial.processes == 20000 && serial.vcpus == 2000, "Every guest task completes");
+    TEST_ASSERT(serial.stolenTime > 0 && serial.utilization <= 100.0, "Overcommitted host steals");
+    TEST_ASSERT(serial.stolenTime == parallel.stolenTime &&
+                serial.turnaround.quantile(0.99) == parallel.turnaround.quantile(0.99) &&
+                serial.lockHolderDelay == parallel.lockHolderDelay,
+                "Results must not depend on threads");
+    return true;
+}
+
+// ============================================================================
+// Interrupt Tests
+// ============================================================================
+
+bool test_interrupt_timeline() {
+    // A periodic 2-unit handler every 10 units takes 20% of its core
+    InterruptModel model(4, 1);
+    TEST_ASSERT(model.addSource({"timer", 10.0, BurstDistribution::CONSTANT, 1.0, 1.0,
+                                 BurstDistribution::CONSTANT, 1}), "Source pinned to core 0");
+    TEST_ASSERT(model.addSource({"nic", 4.0, BurstDistribution::EXPONENTIAL, 0.1, 0.3,
+                                 BurstDistribution::EXPONENTIAL, 6}), "Source spread over cores 1-2");
+    TEST_ASSERT(!model.addSource({"bad", 0.0, BurstDistribution::CONSTANT, 1.0, 0.0,
+                                  BurstDistribution::CONSTANT, 0}), "Interarrival must be positive");
+    TEST_ASSERT(!model.addSource({"bad", 1.0, BurstDistribution::CONSTANT, 1.0, 0.0,
+                                  BurstDistribution::CONSTANT, 16}), "Affinity must name a core");
+    TEST_ASSERT(std::abs(model.coreLoad(0) - 0.2) < 1e-12 && std::abs(model.coreLoad(1) - 0.05) < 1e-12 &&
+                model.coreLoad(3) == 0.0, "Load follows affinity and spreading");
+    
+    std::shared_ptr<InterruptTimeline> timeline = model.createTimeline(0);
+    TEST_ASSERT(timeline != nullptr && model.createTimeline(4) == nullptr, "Timelines exist for real cores");
+    int64_t end = timeline->toRealTime(8000);
+    TEST_ASSERT(std::abs(static_cast<double>(end) - 10000.0) <= 10.0, "Processes get 80% of the core");
+    for (int64_t t = 0; t < 2000; t += 7) {
+        TEST_ASSERT(timeline->toProcessTime(timeline->toRealTime(t)) == t, "Mappings are inverse");
+        TEST_ASSERT(timeline->toRealTime(t + 1) > timeline->toRealTime(t), "Process time advances");
+    }
+    InterruptModel overloaded(1, 1);
+    overloaded.addSource({"storm", 1.0, BurstDistribution::EXPONENTIAL, 0.6, 0.5,
+                          BurstDistribution::EXPONENTIAL, 0});
+    TEST_ASSERT(overloaded.createTimeline(0) == nullptr, "A core without time left is refused");
+    
+    // A million interrupts cost time per interrupt, not per time unit
+    InterruptModel busy(1, 2);
+    busy.addSource({"nic-rx", 0.01, BurstDistribution::EXPONENTIAL, 0.0005, 0.0015,
+                    BurstDistribution::EXPONENTIAL, 0});
+    std::shared_ptr<InterruptTimeline> fast = busy.createTimeline(0);
+    fast->toProcessTime(10000);
+    TEST_ASSERT(fast->getInterruptCount() > 950000 && fast->getInterruptCount() < 1050000,
+                "About 100 interrupts per time unit");
+    TEST_ASSERT(std::abs(static_cast<double>(fast->getStolenTime()) / 10000.0 - 0.2) < 0.01,
+                "Sub-unit handlers add up to the offered load");
+    return true;
+}
+
+bool test_interrupt_scheduling() {
+    InterruptModel model(2, 3);
+    model.addSource({"timer", 10.0, BurstDistribution::CONSTANT, 1.0, 1.0, BurstDistribution::CONSTANT, 1});
+    
+    // One process alone: it needs 80 units of a core that has 80% left
+    RoundRobinScheduler alone(4);
+    alone.addProcess(std::make_shared<Process>(1, "P1", 0, 80));
+    TEST_ASSERT(alone.setInterrupts(model, 0), "Single-CPU policies accept interrupts");
+    alone.schedule();
+    const auto& process = alone.getProcesses()[0];
+    TEST_ASSERT(std::abs(process->getCompletionTime() - 100) <= 2, "Completion stretched by handlers");
+    TEST_ASSERT(process->getInterruptTime() == process->getTurnaroundTime() - 80 &&
+                process->getWaitingTime() == 0, "Handler time while running is interrupt time");
+    TEST_ASSERT(alone.calculateMetrics().totalInterruptTime == process->getInterruptTime(), "Metric totals it");
+    
+    // Any policy, same workload: core 1 has no sources and matches bare metal
+    WorkloadDistribution distribution;
+    distribution.numProcesses = 300;
+    distribution.meanInterarrival = 5.0;
+    auto workload = WorkloadGenerator(distribution).generate(11);
+    std::vector<SchedulerFactory> factories = {
+        []() { return std::unique_ptr<Scheduler>(new RoundRobinScheduler(3)); },
+        []() { return std::unique_ptr<Scheduler>(new PriorityScheduler(true)); },
+        []() { return std::unique_ptr<Scheduler>(new MultilevelFeedbackQueueScheduler()); },
+        []() { return std::unique_ptr<Scheduler>(new O1Scheduler()); },
+        []() { return std::unique_ptr<Scheduler>(new SkipListScheduler()); }
+    };
+    for (const SchedulerFactory& factory : factories) {
+        // Fresh schedulers: bare metal, core 1 (no sources), core 0 (timer)
+        std::unique_ptr<Scheduler> runs[3] = {factory(), factory(), factory()};
+        SchedulingMetrics metrics[3];
+        for (int k = 0; k < 3; k++) {
+            for (const auto& p : workload) {
+                runs[k]->addProcess(std::make_shared<Process>(p->getPID(), p->getName(), p->getArrivalTime(),
+                                                              p->getBurstTime(), p->getPriority()));
+            }
+            TEST_ASSERT(k == 0 || runs[k]->setInterrupts(model, 2 - k), "Cores 0 and 1 exist");
+            runs[k]->schedule();
+            metrics[k] = runs[k]->calculateMetrics();
+        }
+        std::string name = runs[0]->getName();
+        TEST_ASSERT(runs[1]->getRunFingerprint() == runs[0]->getRunFingerprint() &&
+                    metrics[1].averageWaitingTime == metrics[0].averageWaitingTime &&
+                    metrics[1].totalInterruptTime == 0, "A core without interrupts changes nothing: " + name);
+        TEST_ASSERT(metrics[2].totalInterruptTime > 0 &&
+                    metrics[2].averageTurnaroundTime > metrics[0].averageTurnaroundTime &&
+                    metrics[2].averageWaitingTime >= metrics[0].averageWaitingTime,
+                    "Handlers slow every policy down: " + name);
+        for (const auto& p : runs[2]->getProcesses()) {
+            TEST_ASSERT(p->getState() == ProcessState::TERMINATED && p->getStartTime() >= p->getArrivalTime() &&
+                        p->getCompletionTime() >= p->getStartTime() + p->getBurstTime() &&
+                        p->getInterruptTime() >= 0,
+                        "Times are real and consistent: " + name);
+        }
+    }
+    
+    SkipListScheduler multi(6, 2);
+    TEST_ASSERT(!multi.setInterrupts(model, 0), "Multi-CPU policies are refused");
+    return true;
+}
+
+// ============================================================================
+// CPU Affinity and Hotplug Tests
+// ============================================================================
+
+/**
+ * @brief Test word-parallel CPU set operations across word boundaries
+ */
+bool test_cpu_set() {
+    CpuSet full(130, true);
+    TEST_ASSERT(full.count() == 130 && !full.test(130), "Full set should stop at the last CPU");
+    
+    CpuSet a(130);
+    a.set(3);
+    a.set(64);
+    a.set(129);
+    TEST_ASSERT(a.count() == 3 && a.test(64) && !a.test(65), "Bits should be set individually");
+    TEST_ASSERT(a.first() == 3 && a.next(4) == 64 && a.next(65) == 129 && a.next(130) == -1,
+                "next() should walk the set across words");
+    
+    CpuSet b(130);
+    b.set(64);
+    b.set(100);
+    TEST_ASSERT(a.firstAnd(b) == 64 && a.intersects(b), "firstAnd() should find the common CPU");
+    a.andNot(b);
+    TEST_ASSERT(!a.intersects(b) && a.count() == 2, "andNot() should remove common CPUs");
+    a |= b;
+    TEST_ASSERT(a.count() == 4, "|= should add CPUs");
+    a &= b;
+    TEST_ASSERT(a == b, "&= should keep common CPUs");
+    
+    CpuSet parsed;
+    TEST_ASSERT(CpuSet::parse("0-2,64,127-129", 130, parsed), "Cpulist should parse");
+    TEST_ASSERT(parsed.count() == 7 && parsed.toString() == "0-2,64,127-129", "Cpulist should round-trip");
+    TEST_ASSERT(!CpuSet::parse("0-130", 130, parsed) && !CpuSet::parse("3-1", 130, parsed) &&
+                !CpuSet::parse("x", 130, parsed) && !CpuSet::parse("", 130, parsed),
+                "Bad cpulists should be rejected");
+    
+    return true;
+}
+
+/**
+ * @brief Policy that queues every task on CPU 0's local DSQ
+ */
+struct Cpu0ExtPolicy : ExtPolicy {
+    int selectCpu(ExtContext&, int, int) { return 0; }
+    
+    void enqueue(ExtContext& ctx, int task, uint64_t) {
+        ctx.insert(task, ExtContext::localOn(0), ExtContext::SLICE_DFL);
+    }
+};
+
+/**
+ * @brief Test that placement, consumption and balancing respect affinity
+ */
+bool test_ext_affinity_and_balancing() {
+    // Everything pinned to CPU 1: CPU 0 stays idle
+    ExtScheduler<ExtPolicy> pinned(2);
+    CpuSet cpu1(2);
+    cpu1.set(1);
+    for (int i = 1; i <= 3; i++) {
+        pinned.addProcess(std::make_shared<Process>(i, "P" + std::to_string(i), 0, 4, 0));
+        TEST_ASSERT(pinned.setAffinity(i, cpu1), "Affinity should be accepted");
+    }
+    TEST_ASSERT(!pinned.setAffinity(1, CpuSet(3, true)) && !pinned.setAffinity(1, CpuSet(2)),
+                "Wrongly sized or empty masks should be rejected");
+    pinned.schedule();
+    auto processes = pinned.getProcesses();
+    TEST_ASSERT(processes[2]->getCompletionTime() == 12, "Pinned tasks should share CPU 1");
+    TEST_ASSERT(pinned.getGanttChart().find("CPU0 |------------") != std::string::npos,
+                "CPU 0 should stay idle");
+    
+    // A shared VTIME DSQ is consumed past tasks the CPU may not run
+    ExtScheduler<ExtVtimePolicy> vtime(2);
+    CpuSet cpu0(2);
+    cpu0.set(0);
+    for (int i = 1; i <= 3; i++) {
+        vtime.addProcess(std::make_shared<Process>(i, "P" + std::to_string(i), 0, 4, 0));
+    }
+    vtime.setAffinity(1, cpu0);
+    vtime.setAffinity(2, cpu0);
+    vtime.schedule();
+    processes = vtime.getProcesses();
+    TEST_ASSERT(processes[2]->getCompletionTime() == 4, "Unpinned P3 should take CPU 1");
+    TEST_ASSERT(processes[1]->getCompletionTime() == 8, "Pinned P2 should wait for CPU 0");
+    TEST_ASSERT(vtime.getMigrations() == 0, "Nothing should migrate");
+    
+    // An idle CPU pulls from a busy CPU's local DSQ, but never a task pinned there
+    ExtScheduler<Cpu0ExtPolicy> balanced(2);
+    for (int i = 1; i <= 4; i++) {
+        balanced.addProcess(std::make_shared<Process>(i, "P" + std::to_string(i), 0, 4, 0));
+    }
+    balanced.setAffinity(2, cpu0);
+    balanced.schedule();
+    processes = balanced.getProcesses();
+    TEST_ASSERT(processes[0]->getCompletionTime() == 4 && processes[2]->getCompletionTime() == 4,
+                "CPU 1 should pull P3, skipping pinned P2");
+    TEST_ASSERT(processes[1]->getCompletionTime() == 8 && processes[3]->getCompletionTime() == 8,
+                "P2 and P4 should run next on both CPUs");
+    
+    return true;
+}
+
+/**
+ * @brief Policy that records any task running where it may not
+ */
+struct CheckedExtPolicy : ExtVtimePolicy {
+    bool violated = false;
+    
+    void running(ExtContext& ctx, int task) {
+        ExtVtimePolicy::running(ctx, task);
+        violated = violated || !ctx.canRun(task, ctx.task(task).cpu);
+    }
+};
+
+/**
+ * @brief Test hotplug migration, broken affinity and a large machine
+ */
+bool test_ext_hotplug() {
+    // CPU 1 goes offline at 4 and returns at 12; B migrates to CPU 0 and back
+    ExtScheduler<ExtPolicy> scheduler(2);
+    scheduler.addProcess(std::make_shared<Process>(1, "A", 0, 10, 0));
+    scheduler.addProcess(std::make_shared<Process>(2, "B", 0, 10, 0));
+    TEST_ASSERT(scheduler.addHotplugEvent(4, 1, false) && scheduler.addHotplugEvent(12, 1, true),
+                "Hotplug events should be accepted");
+    TEST_ASSERT(scheduler.addHotplugEvent(6, 0, false), "Offlining the last CPU is accepted, then ignored");
+    TEST_ASSERT(!scheduler.addHotplugEvent(1, 2, false), "Unknown CPUs should be rejected");
+    scheduler.schedule();
+    auto processes = scheduler.getProcesses();
+    TEST_ASSERT(processes[1]->getCompletionTime() == 13, "B should finish back on CPU 1");
+    TEST_ASSERT(processes[1]->getWaitingTime() == 3, "B should wait only while displaced");
+    TEST_ASSERT(processes[0]->getCompletionTime() == 15, "A should keep CPU 0");
+    TEST_ASSERT(scheduler.getMigrations() == 2, "B should migrate twice");
+    TEST_ASSERT(scheduler.getGanttChart().find("CPU1 |BBBBxxxxxxxxB") != std::string::npos,
+                "CPU 1 should show as offline");
+    
+    // Offlining the only allowed CPU breaks the affinity
+    ExtScheduler<ExtPolicy> broken(2);
+    CpuSet cpu1(2);
+    cpu1.set(1);
+    broken.addProcess(std::make_shared<Process>(1, "P1", 0, 6, 0));
+    broken.setAffinity(1, cpu1);
+    broken.addHotplugEvent(2, 1, false);
+    broken.schedule();
+    TEST_ASSERT(broken.getProcesses()[0]->getCompletionTime() == 6, "P1 should finish on CPU 0");
+    TEST_ASSERT(broken.getBrokenAffinities() == 1 && broken.getMigrations() == 1,
+                "P1's affinity should be broken once");
+    
+    // 256 CPUs, a quarter of the tasks pinned to a 4-CPU cpuset, half the machine cycling
+    ExtScheduler<CheckedExtPolicy> large(256, 1);
+    WorkloadDistribution distribution;
+    distribution.numProcesses = 4000;
+    distribution.meanInterarrival = 0.05;
+    CpuSet small;
+    CpuSet::parse("200-203", 256, small);
+    for (const auto& process : WorkloadGenerator(distribution).generate(3)) {
+        large.addProcess(process);
+        if (process->getPID() % 4 == 0) {
+            large.setAffinity(process->getPID(), small);
+        }
+    }
+    for (int cpu = 32; cpu < 160; cpu++) {
+        large.addHotplugEvent(50, cpu, false);
+        large.addHotplugEvent(150, cpu, true);
+    }
+    large.schedule();
+    for (const auto& process : large.getProcesses()) {
+        TEST_ASSERT(process->isComplete(), "Every task should complete");
+    }
+    TEST_ASSERT(!large.getPolicy().violated, "No task should run outside its mask or offline");
+    TEST_ASSERT(large.getBrokenAffinities() == 0, "The cpuset keeps an online CPU");
+    
+    return true;
+}
+
+/**
+ * @brief Test SMT interference: siblings slow each other by class
+ */
+bool test_ext_smt_interference() {
+    SmtConfig config;
+    config.threadsPerCore = 2;
+    config.slowdown = {{2.0, 1.0}, {1.0, 1.0}};
+    
+    // Two class-0 tasks on one core run at half speed, across a slice end
+    ExtScheduler<ExtPolicy> shared(2);
+    TEST_ASSERT(shared.setSmt(config), "SMT2 on 2 CPUs should be accepted");
+    shared.addProcess(std::make_shared<Process>(1, "A", 0, 4, 0));
+    shared.addProcess(std::make_shared<Process>(2, "B", 0, 4, 0));
+    shared.schedule();
+    auto processes = shared.getProcesses();
+    TEST_ASSERT(processes[0]->getCompletionTime() == 8 && processes[1]->getCompletionTime() == 8,
+                "Both should take twice as long");
+    
+    // A class-1 sibling does not interfere; a lone task runs at full speed
+    ExtScheduler<ExtPolicy> mixed(2);
+    mixed.setSmt(config);
+    mixed.addProcess(std::make_shared<Process>(1, "A", 0, 4, 0));
+    mixed.addProcess(std::make_shared<Process>(2, "B", 0, 4, 0));
+    mixed.addProcess(std::make_shared<Process>(3, "C", 8, 4, 0));
+    mixed.setTaskClass(2, 1);
+    mixed.schedule();
+    processes = mixed.getProcesses();
+    TEST_ASSERT(processes[0]->getCompletionTime() == 4 && processes[2]->getCompletionTime() == 12,
+                "Non-interfering classes should run at full speed");
+    
+    SmtConfig odd;
+    odd.threadsPerCore = 3;
+    TEST_ASSERT(!shared.setSmt(odd), "SMT width must divide the CPUs");
+    config.slowdown = {{0.5}};
+    TEST_ASSERT(!shared.setSmt(config), "Slowdowns below 1 should be rejected");
+    
+    return true;
+}
+
+/**
+ * @brief Test core scheduling: untrusted tasks never share a core
+ */
+bool test_ext_core_scheduling() {
+    SmtConfig config;
+    config.threadsPerCore = 2;
+    config.coreScheduling = true;
+    
+    // Different cookies: B waits while A holds the core, and CPU 1 is forced idle
+    ExtScheduler<ExtPolicy> split(2);
+    split.setSmt(config);
+    split.addProcess(std::make_shared<Process>(1, "A", 0, 4, 0));
+    split.addProcess(std::make_shared<Process>(2, "B", 0, 4, 0));
+    split.setCoreCookie(1, 1);
+    split.setCoreCookie(2, 2);
+    split.schedule();
+    auto processes = split.getProcesses();
+    TEST_ASSERT(processes[0]->getCompletionTime() == 4 && processes[1]->getCompletionTime() == 8,
+                "B should run only after A");
+    TEST_ASSERT(split.getForcedIdleTime() == 4, "CPU 1 should be forced idle while A runs");
+    
+    // Equal cookies co-run
+    split.setCoreCookie(2, 1);
+    split.reset();
+    split.schedule();
+    processes = split.getProcesses();
+    TEST_ASSERT(processes[1]->getCompletionTime() == 4 && split.getForcedIdleTime() == 0,
+                "Trusted tasks should share the core");
+    
+    // 64 CPUs, 4 tenants: no sibling pair ever runs two tenants
+    ExtScheduler<CheckedExtPolicy> large(64, 1);
+    large.setSmt(config);
+    WorkloadDistribution distribution;
+    distribution.numProcesses = 3000;
+    distribution.meanInterarrival = 0.05;
+    for (const auto& process : WorkloadGenerator(distribution).generate(5)) {
+        large.addProcess(process);
+        large.setCoreCookie(process->getPID(), process->getPID() % 4);
+    }
+    large.schedule();
+    for (const auto& process : large.getProcesses()) {
+        TEST_ASSERT(process->isComplete(), "Every task should complete");
+    }
+    TEST_ASSERT(!large.getPolicy().violated, "Siblings should never co-run different cookies");
+    TEST_ASSERT(large.getForcedIdleTime() > 0, "Some forced idle time should be counted");
+    
+    return true;
+}
+
+// ============================================================================
+// Memory Capacity Tests
+// ============================================================================
+
+/**
+ * @brief Test the incremental memory account and swap slowdown
+ */
+bool test_memory_account() {
+    MemoryConfig config;
+    config.capacity = 100;
+    MemoryAccount account(config);
+    TEST_ASSERT(account.admits(150), "An empty host should admit anything");
+    account.charge(60);
+    TEST_ASSERT(!account.admits(50) && account.admits(40), "Admission should stop at the capacity");
+    TEST_ASSERT(account.getWorkingSet() == 30 && account.speed() == 1000,
+                "A working set that fits should run at full speed");
+    
+    // Four 60-unit processes touch 120 units: 20/120 overflow at penalty 20
+    account.charge(60);
+    account.charge(60);
+    account.charge(60);
+    TEST_ASSERT(account.speed() == 231, "Overflow should slow progress to 1 / (1 + 20/6)");
+    account.release(60);
+    account.release(60);
+    TEST_ASSERT(account.getResident() == 120 && account.speed() == 1000, "Release should undo the charge");
+    
+    MemoryConfig bad = config;
+    bad.capacity = 0;
+    TEST_ASSERT(!MemoryAccount::isValid(bad), "Zero capacity should be rejected");
+    bad = config;
+    bad.workingSetFraction = 1.5;
+    TEST_ASSERT(!MemoryAccount::isValid(bad), "Working sets cannot exceed the RSS");
+    
+    return true;
+}
+
+/**
+ * @brief Test memory-aware admission: held processes wait in FIFO order
+ */
+bool test_memory_admission() {
+    MemoryConfig config;
+    config.capacity = 100;
+    
+    RoundRobinScheduler rr(2);
+    TEST_ASSERT(rr.setMemory(config), "Valid memory parameters should be accepted");
+    auto a = std::make_shared<Process>(1, "A", 0, 4, 0);
+    auto b = std::make_shared<Process>(2, "B", 0, 4, 0);
+    auto c = std::make_shared<Process>(3, "C", 2, 2, 0);
+    a->setResidentSetSize(60);
+    b->setResidentSetSize(60);
+    c->setResidentSetSize(10);
+    rr.addProcess(a);
+    rr.addProcess(b);
+    rr.addProcess(c);
+    rr.schedule();
+    
+    // C would fit next to A but queues behind B; both enter when A finishes
+    TEST_ASSERT(a->getCompletionTime() == 4, "A should run alone");
+    TEST_ASSERT(b->getMemoryStallTime() == 4 && c->getMemoryStallTime() == 2,
+                "B and C should be held until A completes");
+    TEST_ASSERT(b->getStartTime() >= 4 && c->getStartTime() >= 4, "Held processes should not run");
+    TEST_ASSERT(rr.getMemoryPressureTime() == 4, "Pressure should cover the hold");
+    TEST_ASSERT(rr.calculateMetrics().totalMemoryStallTime == 6, "Metrics should sum the stalls");
+    for (const auto& process : rr.getProcesses()) {
+        TEST_ASSERT(process->getWaitingTime() == process->getTurnaroundTime() - process->getBurstTime(),
+                    "The hold should count as waiting");
+    }
+    
+    // Policies that time waiting from readiness count the hold once too
+    ExtScheduler<ExtPolicy> ext(1);
+    ext.setMemory(config);
+    for (const auto& process : rr.getProcesses()) {
+        auto copy = std::make_shared<Process>(process->getPID(), process->getName(),
+                                              process->getArrivalTime(), process->getBurstTime(), 0);
+        copy->setResidentSetSize(process->getResidentSetSize());
+        ext.addProcess(copy);
+    }
+    ext.schedule();
+    for (const auto& process : ext.getProcesses()) {
+        TEST_ASSERT(process->getWaitingTime() == process->getTurnaroundTime() - process->getBurstTime(),
+                    "The hold should count as waiting exactly once");
+    }
+    
+    // Without the limit nothing is held
+    config.admissionLimit = 0;
+    rr.setMemory(config);
+    rr.reset();
+    rr.schedule();
+    TEST_ASSERT(rr.getMemoryPressureTime() == 0 && b->getMemoryStallTime() == 0,
+                "Nothing should be held without admission control");
+    
+    return true;
+}
+
+/**
+ * @brief Test thrashing in the sched_ext engine, and admission avoiding it
+ */
+bool test_ext_thrashing() {
+    MemoryConfig config;
+    config.capacity = 100;
+    config.admissionLimit = 0;
+    config.workingSetFraction = 1.0;
+    config.swapPenalty = 1.0;
+    
+    // Twice the memory: half the working set overflows, 1 / 1.5 speed
+    ExtScheduler<ExtPolicy> thrash(2);
+    thrash.setMemory(config);
+    thrash.addProcess(std::make_shared<Process>(1, "A", 0, 10, 0));
+    thrash.addProcess(std::make_shared<Process>(2, "B", 0, 10, 0));
+    for (const auto& process : thrash.getProcesses()) {
+        process->setResidentSetSize(100);
+    }
+    thrash.schedule();
+    auto processes = thrash.getProcesses();
+    TEST_ASSERT(processes[0]->getCompletionTime() == 15 && processes[1]->getCompletionTime() == 15,
+                "Thrashing tasks should take 1.5x as long");
+    TEST_ASSERT(processes[0]->getMemoryStallTime() == 5, "Lost progress should count as stall");
+    TEST_ASSERT(thrash.getMemoryPressureTime() == 15, "The whole run should be under pressure");
+    
+    // Admission runs them one after the other at full speed
+    config.admissionLimit = 1.0;
+    thrash.setMemory(config);
+    thrash.reset();
+    thrash.schedule();
+    TEST_ASSERT(processes[0]->getCompletionTime() == 10 && processes[1]->getCompletionTime() == 20,
+                "Admitted tasks should not thrash");
+    TEST_ASSERT(processes[1]->getMemoryStallTime() == 10 && thrash.getMemoryPressureTime() == 10,
+                "Only the hold should stall");
+    
+    return true;
+}
+
+// ============================================================================
+// Fault Injection Tests
+// ============================================================================
+
+/**
+ * @brief Test task crashes: retries with backoff, permanent failure, goodput
+ */
+bool test_ext_task_crashes() {
+    FailureConfig config;
+    config.crashProbability = 0.999999;
+    config.maxRetries = 2;
+    config.retryBackoff = 5;
+    config.backoffMultiplier = 2.0;
+    
+    // Every run crashes: three runs, backoffs of 5 and 10, then failure
+    ExtScheduler<ExtPolicy> doomed(1);
+    TEST_ASSERT(doomed.setFailures(config), "Valid failure parameters should be accepted");
+    doomed.addProcess(std::make_shared<Process>(1, "A", 0, 10, 0));
+    doomed.schedule();
+    auto a = doomed.getProcesses()[0];
+    TEST_ASSERT(a->isFailed() && a->getState() == ProcessState::TERMINATED, "A should fail for good");
+    TEST_ASSERT(doomed.getTaskCrashes() == 3, "A should crash once per run");
+    TEST_ASSERT(a->getWastedTime() > 0 && a->getCompletionTime() == a->getWastedTime() + 15,
+                "A should alternate lost runs and backoffs");
+    SchedulingMetrics metrics = doomed.calculateMetrics();
+    TEST_ASSERT(metrics.failedProcesses == 1 && metrics.goodput == 0, "Failed runs are not goodput");
+    
+    // Crashes depend only on seed, PID and attempt: equal across policies
+    config.crashProbability = 0.2;
+    config.maxRetries = 3;
+    WorkloadDistribution distribution;
+    distribution.numProcesses = 2000;
+    distribution.meanInterarrival = 0.5;
+    auto workload = WorkloadGenerator(distribution).generate(3);
+    ExtScheduler<ExtPolicy> fifo(4);
+    ExtScheduler<ExtVtimePolicy> vtime(4);
+    fifo.setFailures(config);
+    vtime.setFailures(config);
+    for (const auto& p : workload) {
+        fifo.addProcess(std::make_shared<Process>(p->getPID(), p->getName(), p->getArrivalTime(),
+                                                  p->getBurstTime(), 0));
+        vtime.addProcess(std::make_shared<Process>(p->getPID(), p->getName(), p->getArrivalTime(),
+                                                   p->getBurstTime(), 0));
+    }
+    fifo.schedule();
+    vtime.schedule();
+    TEST_ASSERT(fifo.getTaskCrashes() == vtime.getTaskCrashes(), "Crash counts should not depend on the policy");
+    TEST_ASSERT(fifo.getTaskCrashes() > 300 && fifo.getTaskCrashes() < 700, "About a quarter retry per task");
+    metrics = fifo.calculateMetrics();
+    TEST_ASSERT(metrics.failedProcesses == vtime.calculateMetrics().failedProcesses, "Failures should match");
+    TEST_ASSERT(metrics.totalWastedTime > 0 && metrics.goodput < metrics.cpuUtilization,
+                "Wasted time should separate goodput from utilization");
+    for (const auto& process : fifo.getProcesses()) {
+        TEST_ASSERT(process->getState() == ProcessState::TERMINATED, "Every task should finish or fail");
+    }
+    
+    fifo.reset();
+    uint64_t first = (fifo.schedule(), fifo.getRunFingerprint());
+    fifo.reset();
+    fifo.schedule();
+    TEST_ASSERT(fifo.getRunFingerprint() == first, "Runs with the same seed should be identical");
+    
+    config.crashProbability = 1.0;
+    TEST_ASSERT(!fifo.setFailures(config), "Certain crashes should be rejected");
+    config.crashProbability = 0.1;
+    config.backoffMultiplier = 0.5;
+    TEST_ASSERT(!fifo.setFailures(config), "Shrinking backoff should be rejected");
+    
+    return true;
+}
+
+/**
+ * @brief Test CPU failures: the running task is requeued, CPUs come back
+ */
+bool test_ext_cpu_failures() {
+    FailureConfig config;
+    config.cpuMtbf = 40;
+    config.cpuRepairTime = 20;
+    
+    ExtScheduler<CheckedExtPolicy> scheduler(4);
+    scheduler.setFailures(config);
+    WorkloadDistribution distribution;
+    distribution.numProcesses = 1000;
+    distribution.meanInterarrival = 2.0;
+    for (const auto& process : WorkloadGenerator(distribution).generate(4)) {
+        scheduler.addProcess(process);
+    }
+    scheduler.schedule();
+    TEST_ASSERT(scheduler.getCpuFailures() > 10, "CPUs should fail during the run");
+    TEST_ASSERT(!scheduler.getPolicy().violated, "Nothing should run on a failed CPU");
+    SchedulingMetrics metrics = scheduler.calculateMetrics();
+    TEST_ASSERT(metrics.failedProcesses == 0 && scheduler.getTaskCrashes() == 0,
+                "CPU failures should not use up retries");
+    TEST_ASSERT(metrics.totalWastedTime > 0, "Killed runs should count as wasted");
+    for (const auto& process : scheduler.getProcesses()) {
+        TEST_ASSERT(process->isComplete(), "Every task should complete");
+    }
+    
+    // Four tasks on three CPUs, 5-unit slices and a 1000-unit switch: after
+    // the first slices, failures land in the switch of a task that already
+    // ran, and it must lose that progress as well
+    FailureConfig slow;
+    slow.cpuMtbf = 3000;
+    ExtScheduler<ExtPolicy> switching(3, 1, 1000);
+    switching.setFailures(slow);
+    for (int i = 1; i <= 4; i++) {
+        switching.addProcess(std::make_shared<Process>(i, "T" + std::to_string(i), 0, 10, 0));
+    }
+    switching.schedule();
+    TEST_ASSERT(switching.getCpuFailures() > 0 && switching.calculateMetrics().totalWastedTime > 0,
+                "A failure during switch overhead should discard earlier progress");
+    
+    // The last online CPU never fails
+    ExtScheduler<ExtPolicy> single(1);
+    config.cpuMtbf = 1;
+    single.setFailures(config);
+    single.addProcess(std::make_shared<Process>(1, "A", 0, 50, 0));
+    single.schedule();
+    TEST_ASSERT(single.getCpuFailures() == 0 && single.getProcesses()[0]->getCompletionTime() == 50,
+                "A lone CPU should keep running");
+    
+    return true;
+}
+
+// ============================================================================
+// Scheduling Latency Tests
+// ============================================================================
+
+/**
+ * @brief Test per-class latency histograms and their exact merge
+ */
+bool test_latency_histogram() {
+    LatencyHistogram low;
+    LatencyHistogram high;
+    LatencyHistogram together;
+    for (int i = 1; i <= 100; i++) {
+        (i % 2 == 0 ? low : high).record(i % 3 == 0 ? 10 : 0, i);
+        together.record(i % 3 == 0 ? 10 : 0, i);
+    }
+    high.record(-5, 7);
+    together.record(-5, 7);
+    TEST_ASSERT((high.getClasses() == std::vector<int>{-5, 0, 10}), "Classes should grow in both directions");
+    TEST_ASSERT(low.forClass(3).count() == 0 && low.forClass(99).count() == 0, "Unknown classes should be empty");
+    
+    TEST_ASSERT(low.merge(high), "Equal accuracies should merge");
+    TEST_ASSERT(low.count() == together.count(), "Merge should keep every delay");
+    for (int priority : together.getClasses()) {
+        for (double q : {0.5, 0.9, 0.99}) {
+            TEST_ASSERT(low.forClass(priority).quantile(q) == together.forClass(priority).quantile(q),
+                        "Merged classes should equal one histogram of all delays");
+        }
+    }
+    TEST_ASSERT(!low.merge(LatencyHistogram(0.05)), "Different accuracies should not merge");
+    
+    return true;
+}
+
+/**
+ * @brief Test that every READY -> RUNNING delay is recorded, not just the first
+ */
+bool test_scheduling_latency() {
+    // A 0-2, B 2-4, A 4-6, B 6-8: four dispatches, two per process
+    RoundRobinScheduler rr(2);
+    rr.addProcess(std::make_shared<Process>(1, "A", 0, 4, 1));
+    rr.addProcess(std::make_shared<Process>(2, "B", 0, 4, 2));
+    rr.schedule();
+    const LatencyHistogram& latency = rr.getSchedulingLatency();
+    TEST_ASSERT(latency.count() == 4, "Every dispatch should be recorded");
+    TEST_ASSERT(latency.forClass(1).count() == 2 && latency.forClass(1).min() == 0 &&
+                latency.forClass(1).max() == 2, "A waits 0, then 2");
+    TEST_ASSERT(latency.forClass(2).count() == 2 && latency.forClass(2).mean() == 2, "B waits 2 both times");
+    TEST_ASSERT(rr.getProcesses()[0]->getResponseTime() == 0, "Response time covers only the first dispatch");
+    
+    rr.reset();
+    rr.schedule();
+    TEST_ASSERT(rr.getSchedulingLatency().count() == 4, "A new run should start a new histogram");
+    
+    // Multi-CPU engines record at dispatch too, switch overhead included
+    ExtScheduler<ExtPolicy> ext(2, 0, 1);
+    for (int pid = 1; pid <= 3; pid++) {
+        ext.addProcess(std::make_shared<Process>(pid, "P" + std::to_string(pid), 0, 10, 0));
+    }
+    ext.schedule();
+    const QuantileSketch& all = ext.getSchedulingLatency().overall();
+    TEST_ASSERT(all.count() >= 3, "Each process should be dispatched at least once");
+    TEST_ASSERT(all.max() > 0, "The third process should wait for a CPU");
+    
+    SkipListScheduler bfs(2);
+    for (int pid = 1; pid <= 3; pid++) {
+        bfs.addProcess(std::make_shared<Process>(pid, "P" + std::to_string(pid), 0, 10, pid));
+    }
+    bfs.schedule();
+    TEST_ASSERT(bfs.getSchedulingLatency().getClasses().size() == 3, "One class per priority");
+    
+    return true;
+}
+
+// ============================================================================
+// Fairness Tests
+// ============================================================================
+
+/**
+ * @brief Test Jain's index, slowdown and starvation totals and their merge
+ */
+bool test_fairness_stats() {
+    FairnessStats stats;
+    TEST_ASSERT(stats.overall().jainIndex() == 1.0 && stats.classJainIndex() == 1.0,
+                "Nothing completed should count as fair");
+    
+    // Shares 1 and 1/2: Jain = 1.5^2 / (2 * 1.25) = 0.9
+    stats.recordCompletion(0, 4, 4);
+    stats.recordCompletion(3, 4, 8);
+    stats.recordWait(3, 4);
+    stats.recordWait(0, 1);
+    TEST_ASSERT(std::fabs(stats.overall().jainIndex() - 0.9) < 1e-9, "Jain's index over processes");
+    TEST_ASSERT(std::fabs(stats.classJainIndex() - 0.9) < 1e-9, "Jain's index over classes");
+    TEST_ASSERT(std::fabs(stats.overall().slowdown.mean() - 1.5) < 0.02, "Slowdowns are 1 and 2");
+    TEST_ASSERT(stats.forClass(3).maxStarvation == 4 && stats.overall().maxStarvation == 4,
+                "Longest wait per class and overall");
+    TEST_ASSERT((stats.getClasses() == std::vector<int>{0, 3}), "Classes with data");
+    
+    // A class share is its total burst over its total turnaround, not a mean of shares
+    FairnessStats more;
+    more.recordCompletion(3, 12, 12);
+    TEST_ASSERT(stats.merge(more), "Equal accuracies should merge");
+    TEST_ASSERT(stats.forClass(3).completed == 2 && std::fabs(stats.forClass(3).share() - 0.8) < 1e-9,
+                "Merged class share = 16 / 20");
+    TEST_ASSERT(stats.overall().completed == 3, "Merge should keep every completion");
+    TEST_ASSERT(!stats.merge(FairnessStats(0.05)), "Different accuracies should not merge");
+    
+    stats.clear();
+    TEST_ASSERT(stats.overall().completed == 0 && stats.getClasses().empty(), "Clear should forget everything");
+    
+    return true;
+}
+
+/**
+ * @brief Test that aging reduces the starvation of a low-priority process
+ */
+bool test_fairness_aging() {
+    int starvation[2];
+    double classFairness[2];
+    for (int aging = 0; aging < 2; aging++) {
+        // A priority-3 process among back-to-back priority-0 arrivals
+        PriorityScheduler scheduler(true, aging == 1, 3, 0);
+        scheduler.addProcess(std::make_shared<Process>(1, "Low", 0, 2, 3));
+        for (int i = 0; i < 6; i++) {
+            scheduler.addProcess(std::make_shared<Process>(2 + i, "High" + std::to_string(i), i * 4, 4, 0));
+        }
+        scheduler.schedule();
+        SchedulingMetrics metrics = scheduler.calculateMetrics();
+        starvation[aging] = metrics.maxStarvationTime;
+        classFairness[aging] = metrics.classFairnessIndex;
+        TEST_ASSERT(scheduler.getFairness().forClass(0).completed == 6, "Classes use the base priority");
+        TEST_ASSERT(aging == 1 || scheduler.getFairness().forClass(0).maxStarvation == 0,
+                    "Without aging High never waits");
+        TEST_ASSERT(metrics.averageSlowdown >= 1.0, "Slowdown is at least 1");
+    }
+    TEST_ASSERT(starvation[0] == 24, "Without aging Low waits for all six");
+    TEST_ASSERT(starvation[1] < starvation[0], "Aging should shorten the starvation");
+    TEST_ASSERT(classFairness[1] > classFairness[0], "Aging should even out the classes' shares");
+    
+    // Equal processes under Round Robin share the CPU almost equally
+    RoundRobinScheduler rr(1);
+    rr.addProcess(std::make_shared<Process>(1, "A", 0, 4, 1));
+    rr.addProcess(std::make_shared<Process>(2, "B", 0, 4, 1));
+    rr.schedule();
+    TEST_ASSERT(rr.calculateMetrics().jainFairnessIndex > 0.99, "Round Robin should be fair");
+    
+    return true;
+}
+
+// ============================================================================
+// Top Consumer and Starvation Tracking Tests
+// ============================================================================
+
+/**
+ * @brief Test the Space-Saving error bounds on a skewed stream
+ */
+bool test_space_saving() {
+    SpaceSaving exact(8);
+    exact.add(3, 5);
+    exact.add(1, 7);
+    exact.add(3, 4);
+    std::vector<HeavyHitter> top = exact.top(5);
+    TEST_ASSERT(top.size() == 2 && top[0].id == 3 && top[0].count == 9 && top[0].error == 0,
+                "With spare counters the counts should be exact");
+    TEST_ASSERT(exact.estimate(42) == 0, "An unseen id has weight 0 while counters are spare");
+    
+    // One heavy id among 200 light ones, 4 counters
+    SpaceSaving sketch(4);
+    std::unordered_map<int, int64_t> truth;
+    for (int round = 0; round < 200; round++) {
+        sketch.add(1000, 3);
+        truth[1000] += 3;
+        sketch.add(round, 1);
+        truth[round] += 1;
+    }
+    TEST_ASSERT(sketch.size() == 4 && sketch.getTotal() == 800, "Memory bounded by the capacity");
+    top = sketch.top(4);
+    TEST_ASSERT(top[0].id == 1000, "The heavy hitter should be on top");
+    for (const HeavyHitter& hitter : top) {
+        TEST_ASSERT(hitter.count >= truth[hitter.id] && hitter.count - hitter.error <= truth[hitter.id],
+                    "True weight within [count - error, count]");
+        TEST_ASSERT(hitter.error <= sketch.getTotal() / 4, "Error bounded by total / k");
+    }
+    TEST_ASSERT(sketch.estimate(0) >= truth[0], "Estimates of evicted ids are upper bounds");
+    
+    return true;
+}
+
+/**
+ * @brief Test the indexed heap of READY tasks
+ */
+bool test_starvation_tracker() {
+    StarvationTracker tracker;
+    TEST_ASSERT(tracker.oldest() == -1 && tracker.currentWait(100) == 0, "Nothing READY");
+    tracker.enter(5, 10);
+    tracker.enter(3, 4);
+    tracker.enter(7, 4);
+    TEST_ASSERT(tracker.oldest() == 3 && tracker.oldestSince() == 4, "Oldest first, ties to the lower id");
+    TEST_ASSERT(tracker.leave(3, 20) == 16, "Leaving returns the wait");
+    TEST_ASSERT(tracker.oldest() == 7, "Next oldest takes over");
+    tracker.enter(7, 15);
+    TEST_ASSERT(tracker.oldest() == 5 && tracker.currentWait(30) == 20, "Re-entering moves a task back");
+    TEST_ASSERT(tracker.leave(42, 30) == 0, "Unknown tasks are ignored");
+    tracker.leave(5, 30);
+    tracker.leave(7, 30);
+    TEST_ASSERT(tracker.empty(), "Every task left");
+    TEST_ASSERT(tracker.getWorstId() == 5 && tracker.getWorstWait() == 20, "Longest finished wait kept");
+    
+    tracker.clear();
+    TEST_ASSERT(tracker.getWorstId() == -1 && tracker.getWorstWait() == 0, "Clear forgets the worst wait");
+    
+    return true;
+}
+
+/**
+ * @brief Test top consumers and starvation through a scheduler, and the sched_ext watchdog
+ */
+bool test_top_consumers_and_watchdog() {
+    RoundRobinScheduler rr(2);
+    TEST_ASSERT(rr.getTopConsumers() == nullptr && rr.getStarvation() == nullptr, "Off by default");
+    rr.setTopConsumers(4);
+    rr.setStarvationTracking(true);
+    rr.addProcess(std::make_shared<Process>(1, "Big", 0, 100, 0));
+    for (int pid = 2; pid <= 50; pid++) {
+        rr.addProcess(std::make_shared<Process>(pid, "Small" + std::to_string(pid), pid, 2, 0));
+    }
+    rr.schedule();
+    std::vector<HeavyHitter> top = rr.getTopConsumers()->top(1);
+    TEST_ASSERT(top[0].id == 1 && top[0].count >= 100 && top[0].count - top[0].error <= 100,
+                "The long process is the top consumer");
+    TEST_ASSERT(rr.getTopConsumers()->getTotal() == 198, "Every slice charged");
+    TEST_ASSERT(rr.getStarvation()->empty(), "Nothing READY after the run");
+    TEST_ASSERT(rr.getStarvation()->getWorstWait() == rr.calculateMetrics().maxStarvationTime,
+                "Worst wait matches the fairness statistics");
+    
+    // Strict bands starve Low behind back-to-back urgent tasks, until the watchdog fires
+    int lowTurnaround[2];
+    for (int watchdog = 0; watchdog < 2; watchdog++) {
+        ExtScheduler<ExtPriorityPolicy> ext(1, 1, 0);
+        ext.setStarvationTracking(true);
+        ext.setWatchdogTimeout(watchdog * 10);
+        ext.addProcess(std::make_shared<Process>(1, "Low", 0, 2, 15));
+        for (int i = 0; i < 6; i++) {
+            ext.addProcess(std::make_shared<Process>(2 + i, "Urgent" + std::to_string(i), i * 4, 4, -20));
+        }
+        ext.schedule();
+        lowTurnaround[watchdog] = ext.getProcesses()[0]->getTurnaroundTime();
+        TEST_ASSERT(ext.getStarvation()->getWorstId() == 1, "Low is the most starved");
+        TEST_ASSERT((ext.getExitReason().find("runnable task stall") != std::string::npos) == (watchdog == 1),
+                    "Only the watchdog aborts the policy");
+    }
+    TEST_ASSERT(lowTurnaround[0] == 26 && lowTurnaround[1] < 26, "The watchdog should end the starvation");
+    
+    return true;
+}
+
+// ============================================================================
+// Main Test Runner
+// ============================================================================
+
+int main() {
+    std::cout << "==========================================\n";
+    std::cout << "CPU SCHEDULER SIMULATOR - TEST SUITE\n";
+    std::cout << "==========================================\n\n";
+    
+    // Process tests
+    std::cout << "Process Class Tests:\n";
+    std::cout << "--------------------\n";
+    RUN_TEST(test_process_creation);
+    RUN_TEST(test_process_execution);
+    RUN_TEST(test_process_execution_overflow);
+    RUN_TEST(test_process_metrics);
+    RUN_TEST(test_process_reset);
+    
+    // Round Robin tests
+    std::cout << "\nRound Robin Scheduler Tests:\n";
+    std::cout << "----------------------------\n";
+    RUN_TEST(test_round_robin_basic);
+    RUN_TEST(test_round_robin_arrivals);
+    
+    // Priority Scheduler tests
+    std::cout << "\nPriority Scheduler Tests:\n";
+    std::cout << "-------------------------\n";
+    RUN_TEST(test_priority_non_preemptive);
+    RUN_TEST(test_priority_preemptive);
+    RUN_TEST(test_priority_aging);
+    
+    // Multilevel Queue tests
+    std::cout << "\nMultilevel Queue Tests:\n";
+    std::cout << "----------------------\n";
+    RUN_TEST(test_multilevel_queue);
+    
+    // MLFQ tests
+    std::cout << "\nMultilevel Feedback Queue Tests:\n";
+    std::cout << "--------------------------------\n";
+    RUN_TEST(test_mlfq_basic);
+    RUN_TEST(test_mlfq_aging);
+    RUN_TEST(test_mlfq_aging_promotes);
+    
+    // Edge case tests
+    std::cout << "\nEdge Case and Performance Tests:\n";
+    std::cout << "--------------------------------\n";
+    RUN_TEST(test_single_process);
+    RUN_TEST(test_same_arrival_time);
+    RUN_TEST(test_context_switch_overhead);
+    RUN_TEST(test_context_switches_between_quanta);
+    RUN_TEST(test_waiting_time_accounting);
+    
+    // Reproducibility tests
+    std::cout << "\nReproducibility Tests:\n";
+    std::cout << "----------------------\n";
+    RUN_TEST(test_tie_break_by_pid);
+    RUN_TEST(test_tie_break_seed);
+    RUN_TEST(test_fingerprint_insertion_order);
+    RUN_TEST(test_run_fingerprint);
+    
+    // Monte Carlo comparison tests
+    std::cout << "\nMonte Carlo Comparison Tests:\n";
+    std::cout << "-----------------------------\n";
+    RUN_TEST(test_workload_generator_reproducible);
+    RUN_TEST(test_student_t_critical);
+    RUN_TEST(test_monte_carlo_thread_independence);
+    RUN_TEST(test_monte_carlo_adaptive_stop);
+    RUN_TEST(test_parallel_for_exception);
+    
+    // Analytic estimator tests
+    std::cout << "\nAnalytic Estimator Tests:\n";
+    std::cout << "-------------------------\n";
+    RUN_TEST(test_analytic_formulas);
+    RUN_TEST(test_analytic_matches_simulation);
+    
+    // Timer wheel and event-driven engine tests
+    std::cout << "\nTimer Wheel Tests:\n";
+    std::cout << "------------------\n";
+    RUN_TEST(test_timer_wheel_ordering);
+    RUN_TEST(test_timer_wheel_periodic_cancel);
+    RUN_TEST(test_priority_event_driven);
+    RUN_TEST(test_future_event_sets_agree);
+    
+    // O(1) scheduler tests
+    std::cout << "\nO(1) Scheduler Tests:\n";
+    std::cout << "---------------------\n";
+    RUN_TEST(test_o1_timeslices);
+    RUN_TEST(test_o1_array_swap);
+    RUN_TEST(test_o1_preemption);
+    
+    // Skip list scheduler tests
+    std::cout << "\nSkip List Scheduler Tests:\n";
+    std::cout << "--------------------------\n";
+    RUN_TEST(test_deadline_skip_list);
+    RUN_TEST(test_bfs_deadline_preemption);
+    RUN_TEST(test_muqss_two_cpus);
+    
+    // sched_ext-style engine tests
+    std::cout << "\nsched_ext-Style Engine Tests:\n";
+    std::cout << "-----------------------------\n";
+    RUN_TEST(test_dispatch_queue);
+    RUN_TEST(test_ext_default_and_vtime);
+    RUN_TEST(test_ext_tick_preemption);
+    RUN_TEST(test_ext_policy_abort);
+    
+    // Policy plugin tests
+    std::cout << "\nPolicy Plugin Tests:\n";
+    std::cout << "--------------------\n";
+    RUN_TEST(test_policy_plugin);
+    
+    // Batch backfilling tests
+    std::cout << "\nBatch Backfilling Tests:\n";
+    std::cout << "------------------------\n";
+    RUN_TEST(test_swf_reader);
+    RUN_TEST(test_availability_profile);
+    RUN_TEST(test_backfill_policies);
+    RUN_TEST(test_conservative_compression);
+    
+    // Cluster simulation tests
+    std::cout << "\nCluster Simulation Tests:\n";
+    std::cout << "-------------------------\n";
+    RUN_TEST(test_quantile_sketch);
+    RUN_TEST(test_cluster_placement);
+    
+    // Cluster trace import tests
+    std::cout << "\nCluster Trace Import Tests:\n";
+    std::cout << "---------------------------\n";
+    RUN_TEST(test_google_trace_import);
+    RUN_TEST(test_alibaba_trace_import);
+    
+    // Workflow tests
+    std::cout << "\nWorkflow (DAG) Tests:\n";
+    std::cout << "---------------------\n";
+    RUN_TEST(test_dependency_admission);
+    RUN_TEST(test_workflow_policies);
+    
+    // Lock protocol tests
+    std::cout << "\nLock Protocol Tests:\n";
+    std::cout << "--------------------\n";
+    RUN_TEST(test_priority_inversion);
+    RUN_TEST(test_lock_deadlock_and_scale);
+    
+    // Closed-loop workload tests
+    std::cout << "\nClosed-Loop Workload Tests:\n";
+    std::cout << "---------------------------\n";
+    RUN_TEST(test_closed_loop_mva);
+    RUN_TEST(test_closed_loop_sweep);
+    
+    // RPC server tests
+    std::cout << "\nRPC Server Tests:\n";
+    std::cout << "-----------------\n";
+    RUN_TEST(test_rpc_queueing_sanity);
+    RUN_TEST(test_rpc_architectures);
+    
+    // Virtualization tests
+    std::cout << "\nVirtualization Tests:\n";
+    std::cout << "---------------------\n";
+    RUN_TEST(test_hypervisor_steal_accounting);
+    RUN_TEST(test_hypervisor_scale);
+    
+    // Interrupt tests
+    std::cout << "\nInterrupt Tests:\n";
+    std::cout << "----------------\n";
+    RUN_TEST(test_interrupt_timeline);
+    RUN_TEST(test_interrupt_scheduling);
+    
+    // Affinity and hotplug tests
+    std::cout << "\nCPU Affinity and Hotplug Tests:\n";
+    std::cout << "-------------------------------\n";
+    RUN_TEST(test_cpu_set);
+    RUN_TEST(test_ext_affinity_and_balancing);
+    RUN_TEST(test_ext_hotplug);
+    
+    // SMT tests
+    std::cout << "\nSMT and Core Scheduling Tests:\n";
+    std::cout << "------------------------------\n";
+    RUN_TEST(test_ext_smt_interference);
+    RUN_TEST(test_ext_core_scheduling);
+    
+    // Memory tests
+    std::cout << "\nMemory Capacity Tests:\n";
+    std::cout << "----------------------\n";
+    RUN_TEST(test_memory_account);
+    RUN_TEST(test_memory_admission);
+    RUN_TEST(test_ext_thrashing);
+    
+    // Fault injection tests
+    std::cout << "\nFault Injection Tests:\n";
+    std::cout << "----------------------\n";
+    RUN_TEST(test_ext_task_crashes);
+    RUN_TEST(test_ext_cpu_failures);
+    
+    // Scheduling latency tests
+    std::cout << "\nScheduling Latency Tests:\n";
+    std::cout << "-------------------------\n";
+    RUN_TEST(test_latency_histogram);
+    RUN_TEST(test_scheduling_latency);
+    
+    // Fairness tests
+    std::cout << "\nFairness Tests:\n";
+    std::cout << "---------------\n";
+    RUN_TEST(test_fairness_stats);
+    RUN_TEST(test_fairness_aging);
+    
+    // Top consumer and starvation tracking tests
+    std::cout << "\nTop Consumer and Starvation Tracking Tests:\n";
+    std::cout << "-------------------------------------------\n";
+    RUN_TEST(test_space_saving);
+    RUN_TEST(test_starvation_tracker);
+    RUN_TEST(test_top_consumers_and_watchdog);
     
     // Summary
     std::cout << "\n==========================================\n";